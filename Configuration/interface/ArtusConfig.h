@@ -6,22 +6,30 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <sstream>
+#include <thread>
 #include <vector>
 
 #include <TFile.h>
+#include <TROOT.h>
 
 #include <boost/foreach.hpp>
 #include <boost/algorithm/string.hpp>
 #include <boost/property_tree/json_parser.hpp>
 #include <boost/property_tree/ptree.hpp>
+#include <boost/scoped_ptr.hpp>
 
 #include "Artus/Core/interface/ProcessNodeBase.h"
 #include "Artus/Core/interface/ProducerBase.h"
 #include "Artus/Core/interface/FilterBase.h"
 
+#include "Artus/Configuration/interface/SettingsTable.h"
+
 #include "Artus/Utility/interface/Collections.h"
 #include "Artus/Utility/interface/ArtusLogging.h"
+#include "Artus/Utility/interface/LogBuffer.h"
 
 class ArtusConfig {
 public:
@@ -58,6 +66,7 @@ public:
 		TSettings pset;
 		pset.SetPropTreePath("");
 		pset.SetPropTree(&m_propTreeRoot);
+		pset.SetSettingsTable(m_settingsTable.get());
 		return pset;
 	}
 
@@ -66,6 +75,12 @@ public:
 		return m_outputPath;
 	}
 
+	// sidecar file of the event loop checkpoints, empty if checkpointing is disabled
+	std::string const& GetCheckpointFile() const
+	{
+		return m_checkpointFile;
+	}
+
 	typedef std::pair< ProcessNodeType, std::string > NodeTypePair;
 
 	static NodeTypePair ParseProcessNode ( std::string const& sInp );
@@ -112,6 +127,8 @@ private:
 
 	// create all pipelines and add all filter/consumer/producer according the
 	// pipelines configuration
+	// the pipelines are created and initialised in parallel, if configured, and added to the
+	// runner in the order of the configuration
 	// don't use directly but call LoadConfiguration
 	template<class TPipelineInitializer, class TPipelineRunner, class TFactory>
 	void LoadPipelines(TPipelineInitializer& pInit, TPipelineRunner& runner,
@@ -122,74 +139,147 @@ private:
 		typedef typename TPipelineInitializer::setting_type setting_type;
 		typedef typename TPipelineInitializer::pipeline_type pipeline_type;
 
+		// the key name of the dictionary will also become the 
+		// pipeline name
+		stringvector pipelineNames;
 		BOOST_FOREACH(boost::property_tree::ptree::value_type& v,
 				m_propTreeRoot.get_child("Pipelines"))
 		{
-			setting_type pset;
-
-			// the key name of the dictionary will also become the 
-			// pipeline name
-			std::string sKeyName = v.first.data();
-
-			// set up the Settings class access to the property tree
-			// in order to be able to load additional settings
-			pset.SetName(sKeyName);
-			pset.SetPropTreePath("Pipelines." + sKeyName);
-			pset.SetPropTree(&m_propTreeRoot);
-			pset.SetRootOutFile(outputFile);
-
-			pipeline_type* pLine = new pipeline_type; //CreateDefaultPipeline();
-
-			// add local producer
-			stringvector localProducers = pset.GetProcessors();
-			for (stringvector::const_iterator it = localProducers.begin(); it != localProducers.end(); ++it) {
-
-					NodeTypePair ntype = ParseProcessNode( *it );
-
-					if (ntype.first == ProcessNodeType::Producer ) {
-						auto * pProducer = factory.createProducer ( ntype.second );
-
-						if ( pProducer == nullptr ){
-							 LOG(FATAL) << "Local Producer with id " << ntype.second << " not found!";
-						} else {
-							pLine->AddProducer ( pProducer );
-						}
-					} else if (ntype.first == ProcessNodeType::Filter ) {
-						auto * pProducer = factory.createFilter ( ntype.second );
-
-						if ( pProducer == nullptr ){
-							 LOG(FATAL) << "Local Filter with id " << ntype.second << " not found!";
-						} else {
-							pLine->AddFilter ( pProducer );
-						}
-					}
+			pipelineNames.push_back(v.first.data());
+		}
+
+		size_t nThreads = std::min(std::max(GetSettings<setting_type>().GetPipelineInitThreads(), size_t(1)),
+		                           std::max(pipelineNames.size(), size_t(1)));
+		bool parallel = (nThreads > 1);
+
+		// the log messages of every pipeline are buffered while initialising in parallel
+		// and written afterwards in the order of the configuration
+		std::vector<pipeline_type*> pipelines(pipelineNames.size(), nullptr);
+		std::vector<LogBuffer> logBuffers(parallel ? pipelineNames.size() : 0);
+		std::atomic<size_t> nextPipeline(0);
+		auto loadPipelines = [this, &pipelineNames, &pipelines, &logBuffers, &nextPipeline, &pInit, &factory, outputFile] ()
+		{
+			for (size_t index = nextPipeline++; index < pipelineNames.size(); index = nextPipeline++)
+			{
+				if (! logBuffers.empty())
+				{
+					logBuffers[index].Activate();
 				}
+				pipelines[index] = LoadPipeline<TPipelineInitializer, TFactory>(pipelineNames[index], pInit,
+				                                                                factory, outputFile);
+				if (! logBuffers.empty())
+				{
+					logBuffers[index].Deactivate();
+				}
+			}
+		};
 
-			// add consumer
-			stringvector localConsumers = pset.GetConsumers();
-			for (stringvector::const_iterator it = localConsumers.begin(); it != localConsumers.end(); ++it) {
-					auto * pConsumer = factory.createConsumer ( *it );
-
-					// special case for consumer:
-					// it is ok if they cannot be created here, because some might
-					// only be produced in the InitPipeline method below
-					// for example when using an alias for a set of producer
-					if ( pConsumer != nullptr ){
-						pLine->AddConsumer ( pConsumer );
+		if (parallel)
+		{
+			// ROOT has to be prepared before any other thread creates ROOT objects
+			ROOT::EnableThreadSafety();
+			LogBuffer::Install();
+		}
+		std::vector<std::thread> threads;
+		for (size_t thread = 1; thread < nThreads; ++thread)
+		{
+			threads.push_back(std::thread(loadPipelines));
+		}
+		loadPipelines();
+		for (std::thread & thread : threads)
+		{
+			thread.join();
+		}
+		if (parallel)
+		{
+			LogBuffer::Uninstall();
+			for (LogBuffer & logBuffer : logBuffers)
+			{
+				logBuffer.Flush();
+			}
+		}
+
+		runner.AddPipelines(pipelines);
+		LOG(DEBUG) << "Initialised " << pipelines.size() << " pipelines using " << nThreads << " thread(s).";
+	}
+
+	// create a single pipeline with all its filter/consumer/producer and initialise it
+	// the factory and the pipeline initialiser have to be thread-safe if the pipelines are
+	// initialised in parallel
+	template<class TPipelineInitializer, class TFactory>
+	typename TPipelineInitializer::pipeline_type* LoadPipeline(std::string const& sKeyName,
+			TPipelineInitializer& pInit, TFactory & factory,
+			// can be null
+			TFile * outputFile)
+	{
+		typedef typename TPipelineInitializer::setting_type setting_type;
+		typedef typename TPipelineInitializer::pipeline_type pipeline_type;
+
+		setting_type pset;
+
+		// set up the Settings class access to the property tree
+		// in order to be able to load additional settings
+		pset.SetName(sKeyName);
+		pset.SetPropTreePath("Pipelines." + sKeyName);
+		pset.SetPropTree(&m_propTreeRoot);
+		pset.SetSettingsTable(m_settingsTable.get());
+		pset.SetRootOutFile(outputFile);
+
+		pipeline_type* pLine = new pipeline_type; //CreateDefaultPipeline();
+
+		// add local producer
+		stringvector localProducers = pset.GetProcessors();
+		for (stringvector::const_iterator it = localProducers.begin(); it != localProducers.end(); ++it) {
+
+				NodeTypePair ntype = ParseProcessNode( *it );
+
+				if (ntype.first == ProcessNodeType::Producer ) {
+					auto * pProducer = factory.createProducer ( ntype.second );
+
+					if ( pProducer == nullptr ){
+						 LOG(FATAL) << "Local Producer with id " << ntype.second << " not found!";
+					} else {
+						pLine->AddProducer ( pProducer );
+					}
+				} else if (ntype.first == ProcessNodeType::Filter ) {
+					auto * pProducer = factory.createFilter ( ntype.second );
+
+					if ( pProducer == nullptr ){
+						 LOG(FATAL) << "Local Filter with id " << ntype.second << " not found!";
+					} else {
+						pLine->AddFilter ( pProducer );
 					}
 				}
+			}
 
-			pLine->InitPipeline(pset, pInit);
-			runner.AddPipeline(pLine);
-		}
+		// add consumer
+		stringvector localConsumers = pset.GetConsumers();
+		for (stringvector::const_iterator it = localConsumers.begin(); it != localConsumers.end(); ++it) {
+				auto * pConsumer = factory.createConsumer ( *it );
+
+				// special case for consumer:
+				// it is ok if they cannot be created here, because some might
+				// only be produced in the InitPipeline method below
+				// for example when using an alias for a set of producer
+				if ( pConsumer != nullptr ){
+					pLine->AddConsumer ( pConsumer );
+				}
+			}
+
+		pLine->InitPipeline(pset, pInit);
+		return pLine;
 	}
 
 	std::string m_jsonConfigFileName;
 	std::string m_outputPath;
+	std::string m_checkpointFile;
 	stringvector m_fileNames;
 	boost::property_tree::ptree m_propTreeRoot;
+	// index of m_propTreeRoot, which must not be modified after InitConfig
+	boost::scoped_ptr<SettingsTable> m_settingsTable;
 
 	std::string m_minimumLogLevelString;
+	size_t m_forkWorkers;
 
 };
 
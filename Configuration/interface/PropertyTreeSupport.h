@@ -43,4 +43,11 @@ public:
 
 	static uint64vector GetAsUInt64List(boost::property_tree::ptree * propTree,
 	                                    std::string path);
+
+	// read the list from the node itself, e.g. as found in the SettingsTable
+	static stringvector GetAsStringList(boost::property_tree::ptree const& node);
+	static doublevector GetAsDoubleList(boost::property_tree::ptree const& node);
+	static floatvector GetAsFloatList(boost::property_tree::ptree const& node);
+	static intvector GetAsIntList(boost::property_tree::ptree const& node);
+	static uint64vector GetAsUInt64List(boost::property_tree::ptree const& node);
 };
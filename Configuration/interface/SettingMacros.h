@@ -6,9 +6,42 @@
 
 #pragma once
 
+#include <type_traits>
+
+#include <boost/optional.hpp>
+
 #include "VarCache.h"
+#include "SettingsTable.h"
 #include "Artus/Utility/interface/Utility.h"
 
+class SettingsBase;
+
+/// Reads a setting into its cache, returns false if it is not available in the configuration.
+typedef bool (SettingsBase::*SettingResolver)() const;
+
+/**
+   Adds the resolver of a setting to the list in SettingsBase, which is used to resolve all
+   settings at once in SettingsBase::Freeze. The list is copied together with the settings
+   object, therefore copies must not register their resolvers again.
+*/
+class SettingResolverRegistration {
+public:
+	/// the resolvers of derived settings classes are called on SettingsBase
+	template<class TSettings>
+	SettingResolverRegistration(std::vector<SettingResolver> & resolvers, bool (TSettings::*resolver)() const) {
+		resolvers.push_back(static_cast<SettingResolver>(resolver));
+	}
+	SettingResolverRegistration(SettingResolverRegistration const&) {
+	}
+	SettingResolverRegistration& operator=(SettingResolverRegistration const&) {
+		return *this;
+	}
+};
+
+#define REGISTER_SETTING_RESOLVER(SNAME) \
+	SettingResolverRegistration m_resolverRegistration##SNAME = SettingResolverRegistration(m_settingResolvers, \
+			&std::remove_pointer<decltype(this)>::type::Resolve##SNAME);
+
 
 /**
    Implements a Setting with automatic read + caching from a Boost PropertyTree
@@ -17,7 +50,7 @@
 
 #define IMPL_SETTING_PRIVATE(TYPE, SNAME, READGLOBAL) \
 private: \
-	TYPE m_##SNAME; \
+	REGISTER_SETTING_RESOLVER(SNAME) \
 public: \
 	std::string Key##SNAME () const { \
 		return (#SNAME); \
@@ -29,23 +62,30 @@ public: \
 			return GetPropTreePath() + "." + #SNAME; \
 		} \
 	} \
-	mutable VarCache<TYPE> Cache##SNAME; \
-	TYPE Get##SNAME ( ) const { \
+	mutable SharedVarCache<TYPE> Cache##SNAME; \
+	bool Resolve##SNAME ( ) const { \
 		if (Cache##SNAME.IsCached()) { \
-			return Cache##SNAME.GetValue(); \
+			return true; \
+		} \
+		static const SettingsTable::KeyId keyId = SettingsTable::GetKeyId(#SNAME); \
+		TYPE const* val = ResolveSetting< TYPE >(&keyId, keyId, #SNAME, READGLOBAL, \
+				[](boost::property_tree::ptree const& node) -> boost::optional< TYPE > { \
+					return node.get_value_optional< TYPE >(); \
+				}); \
+		if (val == nullptr) { \
+			return false; \
 		} \
-		TYPE val = TYPE(); \
-		try { \
-			val = GetPropTree()->get< TYPE >( FullKey##SNAME ()); \
-		} catch(...) { \
-			try { \
-				val = GetPropTree()->get< TYPE >( Key##SNAME ()); \
-			} catch(...) { \
+		Cache##SNAME.SetCache( val ); \
+		return true; \
+	} \
+	TYPE const& Get##SNAME ( ) const { \
+		if (! Cache##SNAME.IsCached()) { \
+			ReportLazySetting(#SNAME); \
+			if (! Resolve##SNAME ()) { \
 				LOG(FATAL) << "Could not read value for config tag \"" << (#SNAME) << "\" in pipeline or global settings! It is either not specified or the specified type is incompatible!"; \
 			} \
 		} \
-		Cache##SNAME.SetCache( val ); \
-		return val; \
+		return Cache##SNAME.GetValue(); \
 	}
 
 /**
@@ -56,7 +96,7 @@ public: \
 
 #define IMPL_SETTING_DEFAULT_PRIVATE(TYPE, SNAME, DEFAULT_VAL, READGLOBAL) \
 private: \
-	TYPE m_##SNAME; \
+	REGISTER_SETTING_RESOLVER(SNAME) \
 public: \
 	std::string Key##SNAME () const { \
 		return (#SNAME); \
@@ -68,19 +108,29 @@ public: \
 			return GetPropTreePath() + "." + #SNAME; \
 		} \
 	} \
-	mutable VarCache<TYPE> Cache##SNAME; \
-	TYPE Get##SNAME ( ) const { \
+	mutable SharedVarCache<TYPE> Cache##SNAME; \
+	bool Resolve##SNAME ( ) const { \
 		if (Cache##SNAME.IsCached()) { \
-			return Cache##SNAME.GetValue(); \
+			return true; \
 		} \
-		TYPE val; \
-		try { \
-		val = GetPropTree()->get< TYPE >( FullKey##SNAME () ); \
-		} catch(...) { \
-		val = GetPropTree()->get< TYPE >( Key##SNAME (), DEFAULT_VAL ); \
+		static const SettingsTable::KeyId keyId = SettingsTable::GetKeyId(#SNAME); \
+		TYPE const* val = ResolveSetting< TYPE >(&keyId, keyId, #SNAME, READGLOBAL, \
+				[](boost::property_tree::ptree const& node) -> boost::optional< TYPE > { \
+					return node.get_value_optional< TYPE >(); \
+				}); \
+		if (val == nullptr) { \
+			static const TYPE defaultValue = DEFAULT_VAL; \
+			val = &defaultValue; \
 		} \
 		Cache##SNAME.SetCache( val ); \
-		return val; \
+		return true; \
+	} \
+	TYPE const& Get##SNAME ( ) const { \
+		if (! Cache##SNAME.IsCached()) { \
+			ReportLazySetting(#SNAME); \
+			Resolve##SNAME (); \
+		} \
+		return Cache##SNAME.GetValue(); \
 	}
 
 #define IMPL_SETTING(TYPE, SNAME) IMPL_SETTING_PRIVATE(TYPE, SNAME, false)
@@ -89,346 +139,83 @@ public: \
 // #define IMPL_GLOBAL_SETTING(TYPE, SNAME) IMPL_SETTING_PRIVATE(TYPE, SNAME, true)
 // #define IMPL_GLOBAL_SETTING_DEFAULT(TYPE, SNAME, DEFAULT_VAL) IMPL_SETTING_DEFAULT_PRIVATE(TYPE, SNAME, DEFAULT_VAL, true)
 
-#define IMPL_SETTING_STRINGLIST( SNAME ) \
-VarCache<stringvector> m_##SNAME; \
-virtual stringvector& Get##SNAME () const { \
-	try { \
-		RETURN_CACHED(m_##SNAME, PropertyTreeSupport::GetAsStringList(GetPropTree(), GetPipelinePrefix() + #SNAME )) \
-	} \
-	catch(...) { \
-		try { \
-			RETURN_CACHED(m_##SNAME, PropertyTreeSupport::GetAsStringList(GetPropTree(), #SNAME )) \
-		} \
-		catch(...) { \
-			LOG(FATAL) << "Could not read value for config tag \"" << (#SNAME) << "\" in pipeline or global settings! It is either not specified or the specified type is incompatible!"; \
-			throw; \
-		} \
-	} \
-}
-
-#define IMPL_GLOBAL_SETTING_STRINGLIST( SNAME ) \
-VarCache<stringvector> m_##SNAME; \
-stringvector& Get##SNAME () const { \
-	try { \
-		RETURN_CACHED(m_##SNAME, PropertyTreeSupport::GetAsStringList(GetPropTree(), #SNAME )) \
-	} \
-	catch(...) { \
-		LOG(FATAL) << "Could not read value for config tag \"" << (#SNAME) << "\" in pipeline or global settings! It is either not specified or the specified type is incompatible!"; \
-		throw; \
-	} \
-}
-
-#define IMPL_SETTING_STRINGLIST_DEFAULT( SNAME, DEFAULT_VAL ) \
-VarCache<stringvector> m_##SNAME; \
-virtual stringvector& Get##SNAME () const { \
-	try { \
-		RETURN_CACHED(m_##SNAME, PropertyTreeSupport::GetAsStringList(GetPropTree(), GetPipelinePrefix() + #SNAME )) \
-	} \
-	catch(...) { \
-		try { \
-			RETURN_CACHED(m_##SNAME, PropertyTreeSupport::GetAsStringList(GetPropTree(), #SNAME )) \
-		} \
-		catch(...) { \
-			RETURN_CACHED(m_##SNAME, DEFAULT_VAL ) \
-		} \
-	} \
-}
-
-#define IMPL_SETTING_SORTED_STRINGLIST( SNAME ) \
-VarCache<stringvector> m_##SNAME; \
-virtual stringvector& Get##SNAME () const { \
-	try { \
-		RETURN_CACHED(m_##SNAME, Utility::Sorted(PropertyTreeSupport::GetAsStringList(GetPropTree(), GetPipelinePrefix() + #SNAME ))) \
-	} \
-	catch(...) { \
-		try { \
-			RETURN_CACHED(m_##SNAME, Utility::Sorted(PropertyTreeSupport::GetAsStringList(GetPropTree(), #SNAME ))) \
-		} \
-		catch(...) { \
-			LOG(FATAL) << "Could not read value for config tag \"" << (#SNAME) << "\" in pipeline or global settings! It is either not specified or the specified type is incompatible!"; \
-			throw; \
-		} \
-	} \
-}
-
-#define IMPL_SETTING_SORTED_STRINGLIST_DEFAULT( SNAME, DEFAULT_VAL ) \
-VarCache<stringvector> m_##SNAME; \
-virtual stringvector& Get##SNAME () const { \
-	try { \
-		RETURN_CACHED(m_##SNAME, Utility::Sorted(PropertyTreeSupport::GetAsStringList(GetPropTree(), GetPipelinePrefix() + #SNAME ))) \
-	} \
-	catch(...) { \
-		try { \
-			RETURN_CACHED(m_##SNAME, Utility::Sorted(PropertyTreeSupport::GetAsStringList(GetPropTree(), #SNAME ))) \
-		} \
-		catch(...) { \
-			RETURN_CACHED(m_##SNAME, DEFAULT_VAL ) \
-		} \
-	} \
-}
-
-#define IMPL_SETTING_DOUBLELIST( SNAME ) \
-VarCache<doublevector> m_##SNAME; \
-virtual doublevector& Get##SNAME () const { \
-	try { \
-		RETURN_CACHED(m_##SNAME, PropertyTreeSupport::GetAsDoubleList(GetPropTree(), GetPipelinePrefix() + #SNAME )) \
-	} \
-	catch(...) { \
-		try { \
-			RETURN_CACHED(m_##SNAME, PropertyTreeSupport::GetAsDoubleList(GetPropTree(), #SNAME )) \
-		} \
-		catch(...) { \
-			LOG(FATAL) << "Could not read value for config tag \"" << (#SNAME) << "\" in pipeline or global settings! It is either not specified or the specified type is incompatible!"; \
-			throw; \
-		} \
-	} \
-}
-
-#define IMPL_SETTING_DOUBLELIST_DEFAULT( SNAME, DEFAULT_VAL ) \
-VarCache<doublevector> m_##SNAME; \
-virtual doublevector& Get##SNAME () const { \
-	try { \
-		RETURN_CACHED(m_##SNAME, PropertyTreeSupport::GetAsDoubleList(GetPropTree(), GetPipelinePrefix() + #SNAME )) \
-	} \
-	catch(...) { \
-		try { \
-			RETURN_CACHED(m_##SNAME, PropertyTreeSupport::GetAsDoubleList(GetPropTree(), #SNAME )) \
-		} \
-		catch(...) { \
-			RETURN_CACHED(m_##SNAME, DEFAULT_VAL ) \
-		} \
-	} \
-}
-
-#define IMPL_SETTING_SORTED_DOUBLELIST( SNAME ) \
-VarCache<doublevector> m_##SNAME; \
-virtual doublevector& Get##SNAME () const { \
-	try { \
-		RETURN_CACHED(m_##SNAME, Utility::Sorted(PropertyTreeSupport::GetAsDoubleList(GetPropTree(), GetPipelinePrefix() + #SNAME ))) \
-	} \
-	catch(...) { \
-		try { \
-			RETURN_CACHED(m_##SNAME, Utility::Sorted(PropertyTreeSupport::GetAsDoubleList(GetPropTree(), #SNAME ))) \
-		} \
-		catch(...) { \
-			LOG(FATAL) << "Could not read value for config tag \"" << (#SNAME) << "\" in pipeline or global settings! It is either not specified or the specified type is incompatible!"; \
-			throw; \
-		} \
-	} \
-}
-
-#define IMPL_SETTING_SORTED_DOUBLELIST_DEFAULT( SNAME, DEFAULT_VAL ) \
-VarCache<doublevector> m_##SNAME; \
-virtual doublevector& Get##SNAME () const { \
-	try { \
-		RETURN_CACHED(m_##SNAME, Utility::Sorted(PropertyTreeSupport::GetAsDoubleList(GetPropTree(), GetPipelinePrefix() + #SNAME ))) \
-	} \
-	catch(...) { \
-		try { \
-			RETURN_CACHED(m_##SNAME, Utility::Sorted(PropertyTreeSupport::GetAsDoubleList(GetPropTree(), #SNAME ))) \
-		} \
-		catch(...) { \
-			RETURN_CACHED(m_##SNAME, DEFAULT_VAL ) \
-		} \
-	} \
-}
-
-#define IMPL_SETTING_FLOATLIST( SNAME ) \
-VarCache<floatvector> m_##SNAME; \
-virtual floatvector& Get##SNAME () const { \
-	try { \
-		RETURN_CACHED(m_##SNAME, PropertyTreeSupport::GetAsFloatList(GetPropTree(), GetPipelinePrefix() + #SNAME )) \
-	} \
-	catch(...) { \
-		try { \
-			RETURN_CACHED(m_##SNAME, PropertyTreeSupport::GetAsFloatList(GetPropTree(), #SNAME )) \
-		} \
-		catch(...) { \
-			LOG(FATAL) << "Could not read value for config tag \"" << (#SNAME) << "\" in pipeline or global settings! It is either not specified or the specified type is incompatible!"; \
-			throw; \
-		} \
-	} \
-}
-
-#define IMPL_SETTING_FLOATLIST_DEFAULT( SNAME, DEFAULT_VAL) \
-VarCache<floatvector> m_##SNAME; \
-virtual floatvector& Get##SNAME () const { \
-	try { \
-		RETURN_CACHED(m_##SNAME, PropertyTreeSupport::GetAsFloatList(GetPropTree(), GetPipelinePrefix() + #SNAME )) \
-	} \
-	catch(...) { \
-		try { \
-			RETURN_CACHED(m_##SNAME, PropertyTreeSupport::GetAsFloatList(GetPropTree(), #SNAME )) \
-		} \
-		catch(...) { \
-			RETURN_CACHED(m_##SNAME, DEFAULT_VAL ) \
-		} \
-	} \
-}
-
-#define IMPL_SETTING_SORTED_FLOATLIST( SNAME ) \
-VarCache<floatvector> m_##SNAME; \
-virtual floatvector& Get##SNAME () const { \
-	try { \
-		RETURN_CACHED(m_##SNAME, Utility::Sorted(PropertyTreeSupport::GetAsFloatList(GetPropTree(), GetPipelinePrefix() + #SNAME ))) \
-	} \
-	catch(...) { \
-		try { \
-			RETURN_CACHED(m_##SNAME, Utility::Sorted(PropertyTreeSupport::GetAsFloatList(GetPropTree(), #SNAME ))) \
-		} \
-		catch(...) { \
-			LOG(FATAL) << "Could not read value for config tag \"" << (#SNAME) << "\" in pipeline or global settings! It is either not specified or the specified type is incompatible!"; \
-			throw; \
-		} \
-	} \
-}
-
-#define IMPL_SETTING_SORTED_FLOATLIST_DEFAULT( SNAME, DEFAULT_VAL ) \
-VarCache<floatvector> m_##SNAME; \
-virtual floatvector& Get##SNAME () const { \
-	try { \
-		RETURN_CACHED(m_##SNAME, Utility::Sorted(PropertyTreeSupport::GetAsFloatList(GetPropTree(), GetPipelinePrefix() + #SNAME ))) \
-	} \
-	catch(...) { \
-		try { \
-			RETURN_CACHED(m_##SNAME, Utility::Sorted(PropertyTreeSupport::GetAsFloatList(GetPropTree(), #SNAME ))) \
-		} \
-		catch(...) { \
-			RETURN_CACHED(m_##SNAME, DEFAULT_VAL ) \
-		} \
-	} \
-}
-
-#define IMPL_SETTING_INTLIST( SNAME ) \
-VarCache<intvector> m_##SNAME; \
-virtual intvector& Get##SNAME () const { \
-	try { \
-		RETURN_CACHED(m_##SNAME, PropertyTreeSupport::GetAsIntList(GetPropTree(), GetPipelinePrefix() + #SNAME )) \
-	} \
-	catch(...) { \
-		try { \
-			RETURN_CACHED(m_##SNAME, PropertyTreeSupport::GetAsIntList(GetPropTree(), #SNAME )) \
-		} \
-		catch(...) { \
-			LOG(FATAL) << "Could not read value for config tag \"" << (#SNAME) << "\" in pipeline or global settings! It is either not specified or the specified type is incompatible!"; \
-			throw; \
-		} \
-	} \
-}
-
-#define IMPL_SETTING_INTLIST_DEFAULT( SNAME, DEFAULT_VAL ) \
-VarCache<intvector> m_##SNAME; \
-virtual intvector& Get##SNAME () const { \
-	try { \
-		RETURN_CACHED(m_##SNAME, PropertyTreeSupport::GetAsIntList(GetPropTree(), GetPipelinePrefix() + #SNAME )) \
-	} \
-	catch(...) { \
-		try { \
-			RETURN_CACHED(m_##SNAME, PropertyTreeSupport::GetAsIntList(GetPropTree(), #SNAME )) \
-		} \
-		catch(...) { \
-			RETURN_CACHED(m_##SNAME, DEFAULT_VAL) \
-		} \
-	} \
-}
+/**
+   Implements a list Setting read from the pipeline or the global settings. READ_LIST is one
+   of the PropertyTreeSupport::GetAs*List functions, TRANSFORM is applied to the list after
+   reading (e.g. Utility::Sorted) and can be empty. If REQUIRED is false, DEFAULT_VAL is used
+   for settings not found in the PropertyTree.
+*/
 
-#define IMPL_SETTING_SORTED_INTLIST( SNAME ) \
-VarCache<intvector> m_##SNAME; \
-virtual intvector& Get##SNAME () const { \
-	try { \
-		RETURN_CACHED(m_##SNAME, Utility::Sorted(PropertyTreeSupport::GetAsIntList(GetPropTree(), GetPipelinePrefix() + #SNAME ))) \
-	} \
-	catch(...) { \
-		try { \
-			RETURN_CACHED(m_##SNAME, Utility::Sorted(PropertyTreeSupport::GetAsIntList(GetPropTree(), #SNAME ))) \
-		} \
-		catch(...) { \
+#define IMPL_SETTING_LIST_PRIVATE(TYPE, SNAME, READ_LIST, TRANSFORM, REQUIRED, DEFAULT_VAL) \
+SharedVarCache<TYPE> m_##SNAME; \
+REGISTER_SETTING_RESOLVER(SNAME) \
+bool Resolve##SNAME () const { \
+	if (m_##SNAME.IsCached()) { \
+		return true; \
+	} \
+	static const SettingsTable::KeyId keyId = SettingsTable::GetKeyId(#SNAME); \
+	TYPE const* val = ResolveSetting< TYPE >(&keyId, keyId, #SNAME, false, \
+			[](boost::property_tree::ptree const& node) -> boost::optional< TYPE > { \
+				try { \
+					return boost::optional< TYPE >( TRANSFORM(READ_LIST(node)) ); \
+				} \
+				catch(...) { \
+					return boost::optional< TYPE >(); \
+				} \
+			}); \
+	if (val == nullptr) { \
+		if (REQUIRED) { \
+			return false; \
+		} \
+		static const TYPE defaultValue = DEFAULT_VAL; \
+		val = &defaultValue; \
+	} \
+	m_##SNAME.SetCache( val ); \
+	return true; \
+} \
+virtual TYPE const& Get##SNAME () const { \
+	if (! m_##SNAME.IsCached()) { \
+		ReportLazySetting(#SNAME); \
+		if (! Resolve##SNAME ()) { \
 			LOG(FATAL) << "Could not read value for config tag \"" << (#SNAME) << "\" in pipeline or global settings! It is either not specified or the specified type is incompatible!"; \
-			throw; \
 		} \
 	} \
+	return m_##SNAME.GetValue(); \
 }
 
-#define IMPL_SETTING_SORTED_INTLIST_DEFAULT( SNAME, DEFAULT_VAL ) \
-VarCache<intvector> m_##SNAME; \
-virtual intvector& Get##SNAME () const { \
-	try { \
-		RETURN_CACHED(m_##SNAME, Utility::Sorted(PropertyTreeSupport::GetAsIntList(GetPropTree(), GetPipelinePrefix() + #SNAME ))) \
-	} \
-	catch(...) { \
-		try { \
-			RETURN_CACHED(m_##SNAME, Utility::Sorted(PropertyTreeSupport::GetAsIntList(GetPropTree(), #SNAME ))) \
-		} \
-		catch(...) { \
-			RETURN_CACHED(m_##SNAME, DEFAULT_VAL) \
-		} \
-	} \
-}
+#define IMPL_SETTING_STRINGLIST( SNAME ) IMPL_SETTING_LIST_PRIVATE(stringvector, SNAME, PropertyTreeSupport::GetAsStringList, , true, stringvector())
+#define IMPL_SETTING_STRINGLIST_DEFAULT( SNAME, DEFAULT_VAL ) IMPL_SETTING_LIST_PRIVATE(stringvector, SNAME, PropertyTreeSupport::GetAsStringList, , false, DEFAULT_VAL)
+#define IMPL_SETTING_SORTED_STRINGLIST( SNAME ) IMPL_SETTING_LIST_PRIVATE(stringvector, SNAME, PropertyTreeSupport::GetAsStringList, Utility::Sorted, true, stringvector())
+#define IMPL_SETTING_SORTED_STRINGLIST_DEFAULT( SNAME, DEFAULT_VAL ) IMPL_SETTING_LIST_PRIVATE(stringvector, SNAME, PropertyTreeSupport::GetAsStringList, Utility::Sorted, false, DEFAULT_VAL)
 
+#define IMPL_SETTING_DOUBLELIST( SNAME ) IMPL_SETTING_LIST_PRIVATE(doublevector, SNAME, PropertyTreeSupport::GetAsDoubleList, , true, doublevector())
+#define IMPL_SETTING_DOUBLELIST_DEFAULT( SNAME, DEFAULT_VAL ) IMPL_SETTING_LIST_PRIVATE(doublevector, SNAME, PropertyTreeSupport::GetAsDoubleList, , false, DEFAULT_VAL)
+#define IMPL_SETTING_SORTED_DOUBLELIST( SNAME ) IMPL_SETTING_LIST_PRIVATE(doublevector, SNAME, PropertyTreeSupport::GetAsDoubleList, Utility::Sorted, true, doublevector())
+#define IMPL_SETTING_SORTED_DOUBLELIST_DEFAULT( SNAME, DEFAULT_VAL ) IMPL_SETTING_LIST_PRIVATE(doublevector, SNAME, PropertyTreeSupport::GetAsDoubleList, Utility::Sorted, false, DEFAULT_VAL)
 
-#define IMPL_SETTING_UINT64LIST( SNAME ) \
-VarCache<uint64vector> m_##SNAME; \
-virtual uint64vector& Get##SNAME () const { \
-	try { \
-		RETURN_CACHED(m_##SNAME, PropertyTreeSupport::GetAsUInt64List(GetPropTree(), GetPipelinePrefix() + #SNAME )) \
-	} \
-	catch(...) { \
-		try { \
-			RETURN_CACHED(m_##SNAME, PropertyTreeSupport::GetAsUInt64List(GetPropTree(), #SNAME )) \
-		} \
-		catch(...) { \
-			LOG(FATAL) << "Could not read value for config tag \"" << (#SNAME) << "\" in pipeline or global settings! It is either not specified or the specified type is incompatible!"; \
-			throw; \
-		} \
-	} \
-}
-
-#define IMPL_SETTING_UINT64LIST_DEFAULT( SNAME, DEFAULT_VAL ) \
-VarCache<uint64vector> m_##SNAME; \
-virtual uint64vector& Get##SNAME () const { \
-	try { \
-		RETURN_CACHED(m_##SNAME, PropertyTreeSupport::GetAsUInt64List(GetPropTree(), GetPipelinePrefix() + #SNAME )) \
-	} \
-	catch(...) { \
-		try { \
-			RETURN_CACHED(m_##SNAME, PropertyTreeSupport::GetAsUInt64List(GetPropTree(), #SNAME )) \
-		} \
-		catch(...) { \
-			RETURN_CACHED(m_##SNAME, DEFAULT_VAL ) \
-		} \
-	} \
-}
+#define IMPL_SETTING_FLOATLIST( SNAME ) IMPL_SETTING_LIST_PRIVATE(floatvector, SNAME, PropertyTreeSupport::GetAsFloatList, , true, floatvector())
+#define IMPL_SETTING_FLOATLIST_DEFAULT( SNAME, DEFAULT_VAL ) IMPL_SETTING_LIST_PRIVATE(floatvector, SNAME, PropertyTreeSupport::GetAsFloatList, , false, DEFAULT_VAL)
+#define IMPL_SETTING_SORTED_FLOATLIST( SNAME ) IMPL_SETTING_LIST_PRIVATE(floatvector, SNAME, PropertyTreeSupport::GetAsFloatList, Utility::Sorted, true, floatvector())
+#define IMPL_SETTING_SORTED_FLOATLIST_DEFAULT( SNAME, DEFAULT_VAL ) IMPL_SETTING_LIST_PRIVATE(floatvector, SNAME, PropertyTreeSupport::GetAsFloatList, Utility::Sorted, false, DEFAULT_VAL)
 
+#define IMPL_SETTING_INTLIST( SNAME ) IMPL_SETTING_LIST_PRIVATE(intvector, SNAME, PropertyTreeSupport::GetAsIntList, , true, intvector())
+#define IMPL_SETTING_INTLIST_DEFAULT( SNAME, DEFAULT_VAL ) IMPL_SETTING_LIST_PRIVATE(intvector, SNAME, PropertyTreeSupport::GetAsIntList, , false, DEFAULT_VAL)
+#define IMPL_SETTING_SORTED_INTLIST( SNAME ) IMPL_SETTING_LIST_PRIVATE(intvector, SNAME, PropertyTreeSupport::GetAsIntList, Utility::Sorted, true, intvector())
+#define IMPL_SETTING_SORTED_INTLIST_DEFAULT( SNAME, DEFAULT_VAL ) IMPL_SETTING_LIST_PRIVATE(intvector, SNAME, PropertyTreeSupport::GetAsIntList, Utility::Sorted, false, DEFAULT_VAL)
 
-#define IMPL_SETTING_SORTED_UINT64LIST( SNAME ) \
-VarCache<uint64vector> m_##SNAME; \
-virtual uint64vector& Get##SNAME () const { \
-	try { \
-		RETURN_CACHED(m_##SNAME, Utility::Sorted(PropertyTreeSupport::GetAsUInt64List(GetPropTree(), GetPipelinePrefix() + #SNAME ))) \
-	} \
-	catch(...) { \
-		try { \
-			RETURN_CACHED(m_##SNAME, Utility::Sorted(PropertyTreeSupport::GetAsUInt64List(GetPropTree(), #SNAME ))) \
-		} \
-		catch(...) { \
-			LOG(FATAL) << "Could not read value for config tag \"" << (#SNAME) << "\" in pipeline or global settings! It is either not specified or the specified type is incompatible!"; \
-			throw; \
-		} \
-	} \
-}
+#define IMPL_SETTING_UINT64LIST( SNAME ) IMPL_SETTING_LIST_PRIVATE(uint64vector, SNAME, PropertyTreeSupport::GetAsUInt64List, , true, uint64vector())
+#define IMPL_SETTING_UINT64LIST_DEFAULT( SNAME, DEFAULT_VAL ) IMPL_SETTING_LIST_PRIVATE(uint64vector, SNAME, PropertyTreeSupport::GetAsUInt64List, , false, DEFAULT_VAL)
+#define IMPL_SETTING_SORTED_UINT64LIST( SNAME ) IMPL_SETTING_LIST_PRIVATE(uint64vector, SNAME, PropertyTreeSupport::GetAsUInt64List, Utility::Sorted, true, uint64vector())
+#define IMPL_SETTING_SORTED_UINT64LIST_DEFAULT( SNAME, DEFAULT_VAL ) IMPL_SETTING_LIST_PRIVATE(uint64vector, SNAME, PropertyTreeSupport::GetAsUInt64List, Utility::Sorted, false, DEFAULT_VAL)
 
-#define IMPL_SETTING_SORTED_UINT64LIST_DEFAULT( SNAME, DEFAULT_VAL ) \
-VarCache<uint64vector> m_##SNAME; \
-virtual uint64vector& Get##SNAME () const { \
+#define IMPL_GLOBAL_SETTING_STRINGLIST( SNAME ) \
+VarCache<stringvector> m_##SNAME; \
+stringvector& Get##SNAME () const { \
 	try { \
-		RETURN_CACHED(m_##SNAME, Utility::Sorted(PropertyTreeSupport::GetAsUInt64List(GetPropTree(), GetPipelinePrefix() + #SNAME ))) \
+		RETURN_CACHED(m_##SNAME, PropertyTreeSupport::GetAsStringList(GetPropTree(), #SNAME )) \
 	} \
 	catch(...) { \
-		try { \
-			RETURN_CACHED(m_##SNAME, Utility::Sorted(PropertyTreeSupport::GetAsUInt64List(GetPropTree(), #SNAME ))) \
-		} \
-		catch(...) { \
-			RETURN_CACHED(m_##SNAME, DEFAULT_VAL ) \
-		} \
+		LOG(FATAL) << "Could not read value for config tag \"" << (#SNAME) << "\" in pipeline or global settings! It is either not specified or the specified type is incompatible!"; \
+		throw; \
 	} \
 }
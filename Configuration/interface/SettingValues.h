@@ -0,0 +1,63 @@
+/* Copyright (c) 2013 - All Rights Reserved
+ *   Thomas Hauth  <Thomas.Hauth@cern.ch>
+ *   Joram Berger  <Joram.Berger@cern.ch>
+ *   Dominik Haitz <Dominik.Haitz@kit.edu>
+ */
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include <boost/noncopyable.hpp>
+#include <boost/optional.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+/**
+   \brief Immutable values of the settings, shared by the settings objects of all pipelines.
+
+   Every value is read once per setting declaration and node of the configuration. Pipelines,
+   which do not override a setting, therefore share the global value and only the overridden
+   settings are stored per pipeline. The settings objects only point to the values stored here.
+
+   Values are never changed or removed once they are stored. They can be read concurrently.
+ */
+class SettingValues: public boost::noncopyable {
+public:
+
+	/// returns the value of the setting declared at setting (any address unique to the
+	/// declaration) read from node, reader is only called for the first request and returns
+	/// an empty optional if the node cannot be read, in which case nullptr is returned
+	template<class T, class TReader>
+	T const* Get(void const* setting, boost::property_tree::ptree const* node, TReader const& reader)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		Key key(setting, node);
+		std::map<Key, std::shared_ptr<void const> >::const_iterator value = m_values.find(key);
+		if (value == m_values.end())
+		{
+			boost::optional<T> newValue = reader(*node);
+			if (! newValue)
+			{
+				return nullptr;
+			}
+			value = m_values.insert(std::make_pair(key, std::shared_ptr<void const>(new T(*newValue)))).first;
+		}
+		return static_cast<T const*>(value->second.get());
+	}
+
+	size_t GetNumberOfValues() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_values.size();
+	}
+
+private:
+
+	typedef std::pair<void const*, boost::property_tree::ptree const*> Key;
+
+	std::map<Key, std::shared_ptr<void const> > m_values;
+	mutable std::mutex m_mutex;
+};
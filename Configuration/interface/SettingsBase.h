@@ -26,6 +26,11 @@ public:
 };
 
 class SettingsBase {
+protected:
+	// resolvers of all settings declared with the IMPL_SETTING* macros, has to be declared
+	// before the first setting
+	std::vector<SettingResolver> m_settingResolvers;
+
 public:
 	SettingsBase() :
 			m_RootOutFile(nullptr) {
@@ -42,16 +47,80 @@ public:
 	/// pointer to the global, loaded property tree
 	IMPL_PROPERTY_INITIALIZE(boost::property_tree::ptree*, PropTree, nullptr)
 
+	/// Use the index of the configuration instead of looking up the settings in the property
+	/// tree and share the setting values with all other settings objects using the same index.
+	/// Has to be called after the name of the pipeline has been set.
+	void SetSettingsTable(SettingsTable const* settingsTable) {
+		m_settingsTable = settingsTable;
+		m_settingsTablePipeline = ((settingsTable == nullptr || GetName() == "") ?
+		                           SettingsTable::GlobalSettings : settingsTable->GetPipelineIndex(GetName()));
+		m_settingValues = ((settingsTable == nullptr) ? std::make_shared<SettingValues>() : settingsTable->GetValues());
+	}
+
+	/// nodes of a setting in the pipeline and in the global settings, nullptr if not configured
+	typedef std::pair<boost::property_tree::ptree const*, boost::property_tree::ptree const*> SettingNodes;
+	SettingNodes FindSetting(SettingsTable::KeyId keyId, const char * key, bool readGlobal) const;
+
+	/// shared value of a setting in the pipeline or, as a fallback, in the global settings, which
+	/// is also used if the value in the pipeline cannot be read, nullptr if neither can be read
+	template<class T, class TReader>
+	T const* ResolveSetting(void const* setting, SettingsTable::KeyId keyId, const char * key, bool readGlobal,
+	                        TReader const& reader) const {
+		SettingNodes nodes = FindSetting(keyId, key, readGlobal);
+		for (boost::property_tree::ptree const* node : { nodes.first, nodes.second }) {
+			if (node != nullptr) {
+				T const* value = m_settingValues->Get<T>(setting, node, reader);
+				if (value != nullptr) {
+					return value;
+				}
+			}
+		}
+		return nullptr;
+	}
+
 	/// pipeline level, the default if no entry is in the json file will be 1
 	IMPL_SETTING_DEFAULT(size_t, Level, 1 )
 
 	IMPL_SETTING_DEFAULT(long long, FirstEvent, 0)
 	IMPL_SETTING_DEFAULT(long long, ProcessNEvents, -1) // -1 for no limit
 
+	/// number of threads used to run the pipelines with a level greater than one
+	IMPL_SETTING_DEFAULT(size_t, PostProcessingThreads, 1)
+
+	/// number of threads used to create and initialise the pipelines
+	IMPL_SETTING_DEFAULT(size_t, PipelineInitThreads, 1)
+
+	/// sidecar file to store the state of the event loop, no checkpoints are written if empty
+	IMPL_SETTING_DEFAULT(std::string, CheckpointFile, "")
+	/// write a checkpoint every N events and/or every N seconds, 0 to disable
+	IMPL_SETTING_DEFAULT(long long, CheckpointEveryNEvents, 0)
+	IMPL_SETTING_DEFAULT(long long, CheckpointEveryNSeconds, 0)
+
+	/// number of forked worker processes for the event loop, can be set via --fork N
+	IMPL_SETTING_DEFAULT(size_t, ForkWorkers, 1)
+
 	IMPL_PROPERTY( std::string, Name )
 
 	IMPL_SETTING_DEFAULT( std::string , LogLevel, "unknown" )
 
+	/// do not resolve the settings in Freeze, but report all settings which are read for the
+	/// first time afterwards, i.e. during the event loop
+	IMPL_SETTING_DEFAULT(bool, DebugLazySettings, false)
+
+	/// Resolves all settings declared with the IMPL_SETTING* macros, which are available in the
+	/// configuration. Afterwards, the getters only return references to the values, which are
+	/// read once and shared with the settings of all other pipelines, and the settings can be
+	/// shared between threads. Called at the end of InitPipeline and
+	/// before the event loop.
+	void Freeze() const;
+
+	/// reports the first access to a setting after Freeze in the debug mode
+	void ReportLazySetting(const char * settingName) const {
+		if (m_reportLazySettings) {
+			LOG(WARNING) << "Setting \"" << settingName << "\" of pipeline \"" << GetName() << "\" is first read during the event loop.";
+		}
+	}
+
 	/// the folder name in the output root file where plots or ntuples of this pipeline will end 
 	/// up, if you want it not to be the pipeline name, override it
 	virtual std::string GetRootFileFolder() const {
@@ -103,6 +172,9 @@ public:
 	IMPL_SETTING_STRINGLIST(Quantities);
 	//IMPL_SETTING_SORTED_STRINGLIST(Quantities);
 
+	// quantities defined as "name := expression" over other quantities, compiled by the DerivedQuantitiesProducer
+	IMPL_SETTING_STRINGLIST_DEFAULT(DerivedQuantities, std::vector<std::string>());
+
 	virtual stringvector GetFilters () const {
 		return SettingsUtil::ExtractFilters(GetProcessors());
 	}
@@ -119,5 +191,12 @@ public:
 private:
 	VarCache < PipelineInfos > m_pipelineInfos;
 
+	mutable bool m_reportLazySettings = false;
+
+	SettingsTable const* m_settingsTable = nullptr;
+	size_t m_settingsTablePipeline = SettingsTable::GlobalSettings;
+	// values of settings objects without a table are shared with their copies
+	std::shared_ptr<SettingValues> m_settingValues = std::make_shared<SettingValues>();
+
 };
 
@@ -0,0 +1,77 @@
+/* Copyright (c) 2013 - All Rights Reserved
+ *   Thomas Hauth  <Thomas.Hauth@cern.ch>
+ *   Joram Berger  <Joram.Berger@cern.ch>
+ *   Dominik Haitz <Dominik.Haitz@kit.edu>
+ */
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+#include "Artus/Configuration/interface/SettingValues.h"
+
+/**
+   \brief Index of all settings in the loaded configuration.
+
+   The setting names are interned once into integer ids, which are used by the IMPL_SETTING*
+   macros to look up their values without building and parsing paths for every pipeline.
+   The global values are stored once. For every pipeline, only the settings it overrides are
+   stored. Therefore, the size of the table and the time to build it scale with the size of the
+   configuration and not with the number of pipelines times the number of settings. The same
+   holds for the typed values read from these nodes, which are stored once in the SettingValues
+   of the table and shared by the settings objects of all pipelines.
+
+   The table points to the nodes of the property tree it is built from, which has to outlive it.
+ */
+class SettingsTable: public boost::noncopyable {
+public:
+
+	typedef size_t KeyId;
+
+	// index used for global settings, which are not read from any pipeline
+	static const size_t GlobalSettings;
+
+	explicit SettingsTable(boost::property_tree::ptree const& propTreeRoot);
+
+	// unique id of a setting name, can be called concurrently
+	static KeyId GetKeyId(std::string const& key);
+
+	// returns GlobalSettings for unknown pipelines
+	size_t GetPipelineIndex(std::string const& pipelineName) const;
+
+	// the value of the pipeline overrides the global value, nullptr if the setting is not configured
+	boost::property_tree::ptree const* Find(size_t pipelineIndex, KeyId keyId) const;
+
+	// only the value of the pipeline or only the global value, nullptr if it is not configured
+	boost::property_tree::ptree const* FindOverride(size_t pipelineIndex, KeyId keyId) const;
+	boost::property_tree::ptree const* FindGlobal(KeyId keyId) const;
+
+	size_t GetNumberOfOverrides() const;
+
+	// typed values shared by all settings objects using this table
+	std::shared_ptr<SettingValues> GetValues() const
+	{
+		return m_values;
+	}
+
+private:
+
+	typedef std::unordered_map<KeyId, boost::property_tree::ptree const*> Overrides;
+
+	// indexed by the key id, nullptr for settings which are only configured in pipelines
+	std::vector<boost::property_tree::ptree const*> m_globalValues;
+	std::vector<Overrides> m_pipelineOverrides;
+	std::map<std::string, size_t> m_pipelineIndices;
+	std::shared_ptr<SettingValues> m_values;
+
+	static std::unordered_map<std::string, KeyId> s_keyIds;
+	static std::mutex s_mutex;
+};
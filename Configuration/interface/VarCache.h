@@ -50,6 +50,46 @@ private:
 	mutable TData m_val;
 };
 
+/*
+ * Same as VarCache, but only points to a value owned elsewhere, e.g. to a setting value shared
+ * between the pipelines. Copies point to the same value.
+ */
+template<class TData>
+class SharedVarCache {
+public:
+	SharedVarCache() :
+			m_val(nullptr) {
+
+	}
+
+	/*
+	 * Points the cache to a value, which has to outlive the cache
+	 */
+	inline void SetCache(TData const* t) const {
+		m_val = t;
+	}
+
+	/*
+	 * Returns the cached value
+	 */
+	inline TData const& GetValue() const {
+		if (m_val == nullptr)
+			LOG(FATAL) << "Non-cached variable used!";
+
+		return *m_val;
+	}
+
+	/*
+	 * Returns true, if the value has already been cached
+	 */
+	inline bool IsCached() const {
+		return (m_val != nullptr);
+	}
+
+private:
+	mutable TData const* m_val;
+};
+
 /*
  * Implements a implicit caching using the VarCache class
  */
@@ -9,11 +9,13 @@
 
 #include "Artus/Configuration/interface/ArtusConfig.h"
 #include "Artus/Configuration/interface/PropertyTreeSupport.h"
+#include "Artus/Core/interface/ProcessorRegistry.h"
 #include "Artus/Utility/interface/Utility.h"
 
 ArtusConfig::ArtusConfig(int argc, char** argv) :
 	m_jsonConfigFileName(""),
-	m_minimumLogLevelString("")
+	m_minimumLogLevelString(""),
+	m_forkWorkers(0)
 {
 	boost::program_options::options_description programOptions("Options");
 	programOptions.add_options()
@@ -21,7 +23,10 @@ ArtusConfig::ArtusConfig(int argc, char** argv) :
 		("log-level", boost::program_options::value< std::string >(&m_minimumLogLevelString),
 		 "Detail level of logging (debug, info, warning, error, critical). [Default: taken from JSON config or info]")
 		("json-config", boost::program_options::value< std::string >(&m_jsonConfigFileName),
-		 "JSON config file");
+		 "JSON config file")
+		("fork", boost::program_options::value< size_t >(&m_forkWorkers),
+		 "Number of forked worker processes for the event loop. [Default: taken from JSON config or 1]")
+		("list-processors", "Print the ids of all available producers, filters and consumers");
 
 	
 	boost::program_options::positional_options_description positionalProgramOptions;
@@ -39,6 +44,11 @@ ArtusConfig::ArtusConfig(int argc, char** argv) :
 		std::cout << programOptions << std::endl;
 		exit(0);
 	}
+
+	if(optionsVariablesMap.count("list-processors")) {
+		ProcessorRegistry::Print(std::cout);
+		exit(0);
+	}
 	
 	InitConfig();
 	// logging can be uses from here on
@@ -71,7 +81,8 @@ std::pair<bool, el::Level> ArtusConfig::parseLogLevel(
 	return std::make_pair(false, el::Level::Fatal);
 }
 
-ArtusConfig::ArtusConfig(std::stringstream & sStream)
+ArtusConfig::ArtusConfig(std::stringstream & sStream) :
+	m_forkWorkers(0)
 {
 	boost::property_tree::json_parser::read_json(sStream, m_propTreeRoot);
 
@@ -90,6 +101,11 @@ void ArtusConfig::InitConfig( bool configPreLoaded )
 	    boost::property_tree::json_parser::read_json(m_jsonConfigFileName, m_propTreeRoot);
     }
 	
+	// command line parameters overwrite the config
+	if (m_forkWorkers > 0) {
+		m_propTreeRoot.put("ForkWorkers", m_forkWorkers);
+	}
+
 	// init logging
 	if(m_minimumLogLevelString.empty()) {
 		m_minimumLogLevelString = m_propTreeRoot.get<std::string>("LogLevel", "info");
@@ -131,6 +147,7 @@ void ArtusConfig::InitConfig( bool configPreLoaded )
 	el::Loggers::reconfigureLogger("default", defaultLoggingConfig);
 
 	m_outputPath = m_propTreeRoot.get<std::string>("OutputPath", "output.root");
+	m_checkpointFile = m_propTreeRoot.get<std::string>("CheckpointFile", "");
 	m_fileNames = PropertyTreeSupport::GetAsStringList(&m_propTreeRoot, "InputFiles");
 	LOG(INFO) << "Loading " << m_fileNames.size() << " input files.";
 
@@ -138,6 +155,9 @@ void ArtusConfig::InitConfig( bool configPreLoaded )
 	{
 		LOG(FATAL) << "No input files specified!";
 	}
+
+	// the settings of all pipelines are read via this index
+	m_settingsTable.reset(new SettingsTable(m_propTreeRoot));
 }
 
 void ArtusConfig::SaveConfig(TFile * outputFile) const
@@ -145,7 +165,7 @@ void ArtusConfig::SaveConfig(TFile * outputFile) const
 	TObjString jsonConfigContent(
 			Utility::ReadStringFromFile(m_jsonConfigFileName).c_str());
 	outputFile->cd();
-	jsonConfigContent.Write("config");
+	jsonConfigContent.Write("config", TObject::kOverwrite);
 }
 
 ArtusConfig::NodeTypePair ArtusConfig::ParseProcessNode(std::string const& sInp)
@@ -115,3 +115,53 @@ uint64vector PropertyTreeSupport::GetAsUInt64List(boost::property_tree::ptree *
 	}
 	return vec;
 }
+
+stringvector PropertyTreeSupport::GetAsStringList(boost::property_tree::ptree const& node)
+{
+	stringvector vec;
+	BOOST_FOREACH(boost::property_tree::ptree::value_type const& v, node)
+	{
+		vec.push_back(v.second.data());
+	}
+	return vec;
+}
+
+doublevector PropertyTreeSupport::GetAsDoubleList(boost::property_tree::ptree const& node)
+{
+	doublevector vec;
+	BOOST_FOREACH(boost::property_tree::ptree::value_type const& v, node)
+	{
+		vec.push_back(boost::lexical_cast<double>(v.second.data().c_str()));
+	}
+	return vec;
+}
+
+floatvector PropertyTreeSupport::GetAsFloatList(boost::property_tree::ptree const& node)
+{
+	floatvector vec;
+	BOOST_FOREACH(boost::property_tree::ptree::value_type const& v, node)
+	{
+		vec.push_back(boost::lexical_cast<float>(v.second.data().c_str()));
+	}
+	return vec;
+}
+
+intvector PropertyTreeSupport::GetAsIntList(boost::property_tree::ptree const& node)
+{
+	intvector vec;
+	BOOST_FOREACH(boost::property_tree::ptree::value_type const& v, node)
+	{
+		vec.push_back(boost::lexical_cast<int>(v.second.data().c_str()));
+	}
+	return vec;
+}
+
+uint64vector PropertyTreeSupport::GetAsUInt64List(boost::property_tree::ptree const& node)
+{
+	uint64vector vec;
+	BOOST_FOREACH(boost::property_tree::ptree::value_type const& v, node)
+	{
+		vec.push_back(boost::lexical_cast<uint64_t>(v.second.data().c_str()));
+	}
+	return vec;
+}
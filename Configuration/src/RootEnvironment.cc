@@ -1,5 +1,6 @@
 
 #include <iostream>
+#include <fstream>
 
 #include "Artus/Configuration/interface/RootEnvironment.h"
 
@@ -7,8 +8,18 @@
 RootEnvironment::RootEnvironment(const ArtusConfig & artusConfig) :
 	m_rootFileName(artusConfig.GetOutputPath())
 {
-	m_rootFile = new TFile(m_rootFileName.c_str(), "RECREATE");
-	LOG(INFO) << "Output file \"" << m_rootFileName << "\" created.";
+	// a job resumed from a checkpoint continues to write into the existing output file
+	std::string checkpointFile = artusConfig.GetCheckpointFile();
+	if ((! checkpointFile.empty()) && std::ifstream(checkpointFile.c_str()).good())
+	{
+		m_rootFile = new TFile(m_rootFileName.c_str(), "UPDATE");
+		LOG(INFO) << "Output file \"" << m_rootFileName << "\" opened to resume from checkpoint \"" << checkpointFile << "\".";
+	}
+	else
+	{
+		m_rootFile = new TFile(m_rootFileName.c_str(), "RECREATE");
+		LOG(INFO) << "Output file \"" << m_rootFileName << "\" created.";
+	}
 
 	artusConfig.SaveConfig(m_rootFile);
 }
@@ -32,6 +32,7 @@ std::vector <SettingsBase::PipelineInfo> SettingsBase::GetPipelineInfos () const
 			pset.SetName(sKeyName);
 			pset.SetPropTreePath("Pipelines." + sKeyName);
 			pset.SetPropTree( GetPropTree() );
+			pset.SetSettingsTable( m_settingsTable );
 
 			pinfo.push_back( std::make_pair ( sKeyName, pset.GetLevel() ));
 		}
@@ -41,3 +42,45 @@ std::vector <SettingsBase::PipelineInfo> SettingsBase::GetPipelineInfos () const
 
 	return m_pipelineInfos.GetValue();
 }
+
+SettingsBase::SettingNodes SettingsBase::FindSetting(SettingsTable::KeyId keyId, const char * key,
+                                                     bool readGlobal) const {
+	if (m_settingsTable != nullptr) {
+		return SettingNodes((readGlobal ? nullptr : m_settingsTable->FindOverride(m_settingsTablePipeline, keyId)),
+		                    m_settingsTable->FindGlobal(keyId));
+	}
+
+	// settings set up without a loaded configuration
+	SettingNodes nodes(nullptr, nullptr);
+	if ((! readGlobal) && (GetPropTreePath() != "")) {
+		boost::optional<boost::property_tree::ptree&> node = GetPropTree()->get_child_optional(GetPropTreePath() + "." + key);
+		nodes.first = (node ? &(*node) : nullptr);
+	}
+	boost::optional<boost::property_tree::ptree&> node = GetPropTree()->get_child_optional(key);
+	nodes.second = (node ? &(*node) : nullptr);
+	return nodes;
+}
+
+void SettingsBase::Freeze() const {
+
+	// nothing to resolve, e.g. for settings set up in the code
+	if (GetPropTree() == nullptr) {
+		return;
+	}
+
+	if (GetDebugLazySettings()) {
+		m_reportLazySettings = true;
+		return;
+	}
+
+	size_t nResolved = 0;
+	for (std::vector<SettingResolver>::const_iterator resolver = m_settingResolvers.begin();
+	     resolver != m_settingResolvers.end(); ++resolver) {
+		// settings without default value, which are not configured, stay unresolved and fail
+		// only when they are accessed
+		if ((this->*(*resolver))()) {
+			++nResolved;
+		}
+	}
+	LOG(DEBUG) << "Resolved " << nResolved << " of " << m_settingResolvers.size() << " settings of pipeline \"" << GetName() << "\".";
+}
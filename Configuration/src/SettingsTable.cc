@@ -0,0 +1,95 @@
+
+#include "Artus/Configuration/interface/SettingsTable.h"
+#include "Artus/Utility/interface/ArtusLogging.h"
+
+
+const size_t SettingsTable::GlobalSettings = static_cast<size_t>(-1);
+std::unordered_map<std::string, SettingsTable::KeyId> SettingsTable::s_keyIds;
+std::mutex SettingsTable::s_mutex;
+
+SettingsTable::SettingsTable(boost::property_tree::ptree const& propTreeRoot) :
+		m_values(new SettingValues()) {
+
+	for (boost::property_tree::ptree::const_iterator setting = propTreeRoot.begin();
+	     setting != propTreeRoot.end(); ++setting)
+	{
+		if (setting->first == "Pipelines")
+		{
+			for (boost::property_tree::ptree::const_iterator pipeline = setting->second.begin();
+			     pipeline != setting->second.end(); ++pipeline)
+			{
+				m_pipelineIndices[pipeline->first] = m_pipelineOverrides.size();
+				m_pipelineOverrides.push_back(Overrides());
+				for (boost::property_tree::ptree::const_iterator pipelineSetting = pipeline->second.begin();
+				     pipelineSetting != pipeline->second.end(); ++pipelineSetting)
+				{
+					m_pipelineOverrides.back()[GetKeyId(pipelineSetting->first)] = &(pipelineSetting->second);
+				}
+			}
+		}
+		else
+		{
+			KeyId keyId = GetKeyId(setting->first);
+			if (keyId >= m_globalValues.size())
+			{
+				m_globalValues.resize(keyId + 1, nullptr);
+			}
+			// the first occurence wins as for lookups in the property tree
+			if (m_globalValues[keyId] == nullptr)
+			{
+				m_globalValues[keyId] = &(setting->second);
+			}
+		}
+	}
+
+	LOG(DEBUG) << "Indexed " << m_globalValues.size() << " global settings and " << GetNumberOfOverrides()
+	           << " settings overridden in " << m_pipelineOverrides.size() << " pipelines.";
+}
+
+SettingsTable::KeyId SettingsTable::GetKeyId(std::string const& key) {
+	std::lock_guard<std::mutex> lock(s_mutex);
+	std::unordered_map<std::string, KeyId>::const_iterator keyId = s_keyIds.find(key);
+	if (keyId != s_keyIds.end())
+	{
+		return keyId->second;
+	}
+	KeyId newKeyId = s_keyIds.size();
+	s_keyIds[key] = newKeyId;
+	return newKeyId;
+}
+
+size_t SettingsTable::GetPipelineIndex(std::string const& pipelineName) const {
+	std::map<std::string, size_t>::const_iterator pipelineIndex = m_pipelineIndices.find(pipelineName);
+	return ((pipelineIndex == m_pipelineIndices.end()) ? GlobalSettings : pipelineIndex->second);
+}
+
+boost::property_tree::ptree const* SettingsTable::Find(size_t pipelineIndex, KeyId keyId) const {
+	boost::property_tree::ptree const* value = FindOverride(pipelineIndex, keyId);
+	return ((value != nullptr) ? value : FindGlobal(keyId));
+}
+
+boost::property_tree::ptree const* SettingsTable::FindOverride(size_t pipelineIndex, KeyId keyId) const {
+	if (pipelineIndex < m_pipelineOverrides.size())
+	{
+		Overrides::const_iterator value = m_pipelineOverrides[pipelineIndex].find(keyId);
+		if (value != m_pipelineOverrides[pipelineIndex].end())
+		{
+			return value->second;
+		}
+	}
+	return nullptr;
+}
+
+boost::property_tree::ptree const* SettingsTable::FindGlobal(KeyId keyId) const {
+	return ((keyId < m_globalValues.size()) ? m_globalValues[keyId] : nullptr);
+}
+
+size_t SettingsTable::GetNumberOfOverrides() const {
+	size_t nOverrides = 0;
+	for (std::vector<Overrides>::const_iterator overrides = m_pipelineOverrides.begin();
+	     overrides != m_pipelineOverrides.end(); ++overrides)
+	{
+		nOverrides += overrides->size();
+	}
+	return nOverrides;
+}
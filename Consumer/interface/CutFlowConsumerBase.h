@@ -6,8 +6,12 @@
 
 #pragma once
 
+#include <algorithm>
+#include <memory>
+
 #include "Artus/Core/interface/CutFlow.h"
 #include "Artus/Core/interface/Pipeline.h"
+#include "Artus/Core/interface/PipelineResults.h"
 
 template < class TTypes >
 class CutFlowConsumerBase: public ConsumerBase< TTypes > {
@@ -22,6 +26,11 @@ public:
 		return "cutflow";
 	}
 
+	bool SupportsCheckpoints() const override
+	{
+		return true;
+	}
+
 	void Init(setting_type const& pset) override {
 		ConsumerBase<TTypes>::Init(pset);
 
@@ -39,10 +48,59 @@ public:
 	void Finish(setting_type const& setting) override {
 		// at this point, m_flow contains all the filter results of all events
 		// overwrite this to analyze
+		// a copy of the cut flow is made available to pipelines of higher levels,
+		// which may outlive this consumer
+		std::shared_ptr<CutFlow> flow(new CutFlow());
+		flow->SetCutCount(m_flow.GetCutCount(), m_flow.GetEventCount());
+		PipelineResults::Register(setting.GetName(), "cutFlow", flow);
+	}
+
+	void SaveCheckpoint(setting_type const& setting, Checkpoint & checkpoint) override {
+		std::string key = Checkpoint::GetKey(setting.GetName(), this->GetConsumerId(), "cutFlow");
+
+		std::vector<std::string> filterNames;
+		std::vector<long> passedEvents;
+		for (CutFlow::CutCount::const_iterator it = m_flow.GetCutCount().begin();
+		     it != m_flow.GetCutCount().end(); ++it)
+		{
+			filterNames.push_back(it->first);
+			passedEvents.push_back(it->second);
+		}
+		checkpoint.SetValue(key + "/events", m_flow.GetEventCount());
+		checkpoint.SetList(key + "/filters", filterNames);
+		checkpoint.SetList(key + "/passed", passedEvents);
+	}
+
+	void RestoreCheckpoint(setting_type const& setting, Checkpoint const& checkpoint) override {
+		std::string key = Checkpoint::GetKey(setting.GetName(), this->GetConsumerId(), "cutFlow");
+		m_flow.SetCutCount(GetCutCount(checkpoint, key), checkpoint.GetValue(key + "/events", 0l));
+	}
+
+	// the counts are not stored in the output file, therefore they are merged separately
+	void SaveWorkerState(setting_type const& setting, Checkpoint & workerState) override {
+		CutFlowConsumerBase<TTypes>::SaveCheckpoint(setting, workerState);
+	}
+
+	void MergeWorkerState(setting_type const& setting, Checkpoint const& workerState) override {
+		std::string key = Checkpoint::GetKey(setting.GetName(), this->GetConsumerId(), "cutFlow");
+		m_flow.AddCutCount(GetCutCount(workerState, key), workerState.GetValue(key + "/events", 0l));
 	}
 
 protected:
 
 	CutFlow m_flow;
 	std::string m_pipelineName;
+
+private:
+
+	static CutFlow::CutCount GetCutCount(Checkpoint const& checkpoint, std::string const& key) {
+		std::vector<std::string> filterNames = checkpoint.GetList<std::string>(key + "/filters");
+		std::vector<long> passedEvents = checkpoint.GetList<long>(key + "/passed");
+		CutFlow::CutCount cutCount;
+		for (size_t index = 0; index < std::min(filterNames.size(), passedEvents.size()); ++index)
+		{
+			cutCount.push_back(std::make_pair(filterNames[index], passedEvents[index]));
+		}
+		return cutCount;
+	}
 };
@@ -90,10 +90,52 @@ public:
 			RootFileHelper::SafeCd(setting.GetRootOutFile(),
 					setting.GetRootFileFolder());
 
-			m_cutFlowUnweightedHist->Write(m_cutFlowUnweightedHist->GetName());
+			m_cutFlowUnweightedHist->Write(m_cutFlowUnweightedHist->GetName(), TObject::kOverwrite);
+			PipelineResults::Register(setting.GetName(), "cutFlowUnweighted", m_cutFlowUnweightedHist);
 
 			if(m_addWeightedCutFlow) {
-				m_cutFlowWeightedHist->Write(m_cutFlowWeightedHist->GetName());
+				m_cutFlowWeightedHist->Write(m_cutFlowWeightedHist->GetName(), TObject::kOverwrite);
+				PipelineResults::Register(setting.GetName(), "cutFlowWeighted", m_cutFlowWeightedHist);
+			}
+		}
+	}
+
+	void SaveCheckpoint(setting_type const& setting, Checkpoint & checkpoint) override {
+		CutFlowConsumerBase<TTypes>::SaveCheckpoint(setting, checkpoint);
+
+		if (m_histogramsInitialised)
+		{
+			std::vector<std::string> binLabels;
+			for (int bin = 1; bin <= m_cutFlowUnweightedHist->GetNbinsX(); ++bin)
+			{
+				binLabels.push_back(m_cutFlowUnweightedHist->GetXaxis()->GetBinLabel(bin));
+			}
+			checkpoint.SetList(Checkpoint::GetKey(setting.GetName(), this->GetConsumerId(), "binLabels"), binLabels);
+
+			checkpoint.SetHistogram(Checkpoint::GetKey(setting.GetName(), this->GetConsumerId(), "cutFlowUnweighted"),
+			                        *m_cutFlowUnweightedHist);
+			if(m_addWeightedCutFlow) {
+				checkpoint.SetHistogram(Checkpoint::GetKey(setting.GetName(), this->GetConsumerId(), "cutFlowWeighted"),
+				                        *m_cutFlowWeightedHist);
+			}
+		}
+	}
+
+	void RestoreCheckpoint(setting_type const& setting, Checkpoint const& checkpoint) override {
+		CutFlowConsumerBase<TTypes>::RestoreCheckpoint(setting, checkpoint);
+
+		std::vector<std::string> binLabels = checkpoint.GetList<std::string>(
+				Checkpoint::GetKey(setting.GetName(), this->GetConsumerId(), "binLabels"));
+		if (! binLabels.empty())
+		{
+			CreateHistograms(setting, binLabels);
+			m_histogramsInitialised = true;
+
+			checkpoint.GetHistogram(Checkpoint::GetKey(setting.GetName(), this->GetConsumerId(), "cutFlowUnweighted"),
+			                        *m_cutFlowUnweightedHist);
+			if(m_addWeightedCutFlow) {
+				checkpoint.GetHistogram(Checkpoint::GetKey(setting.GetName(), this->GetConsumerId(), "cutFlowWeighted"),
+				                        *m_cutFlowWeightedHist);
 			}
 		}
 	}
@@ -112,7 +154,28 @@ private:
 
 		// filters
 		std::vector<std::string> filterNames = filterResult.GetFilterNames();
-		int nFilters = filterNames.size();
+
+		// names for bins
+		std::vector<std::string> binLabels;
+		binLabels.push_back("without filters");
+
+		for(std::vector<std::string>::const_iterator filterName = filterNames.begin();
+		    filterName != filterNames.end(); ++filterName)
+		{
+			std::string filterNameLabel = *filterName;
+			if (filterResult.IsTaggingFilter(filterNameLabel) == FilterResult::TaggingMode::Tagging) {
+				filterNameLabel += " (T)";
+			}
+			binLabels.push_back(filterNameLabel);
+		}
+
+		CreateHistograms(setting, binLabels);
+		return true;
+	}
+
+	void CreateHistograms( setting_type const& setting, std::vector<std::string> const& binLabels) {
+
+		int nBins = binLabels.size();
 
 		// histograms
 		RootFileHelper::SafeCd( setting.GetRootOutFile(),
@@ -122,39 +185,22 @@ private:
 
 		m_cutFlowUnweightedHist = new TH1F("cutFlowUnweighted",
 		                                   cutFlowHistTitle.c_str(),
-		                                   nFilters+1, 0.0, nFilters+1.0);
+		                                   nBins, 0.0, static_cast<double>(nBins));
 
 		if(m_addWeightedCutFlow) {
 			m_cutFlowWeightedHist = new TH1F("cutFlowWeighted",
 			                                 cutFlowHistTitle.c_str(),
-			                                 nFilters+1, 0.0, nFilters+1.0);
+			                                 nBins, 0.0, static_cast<double>(nBins));
 		}
 
-		// names for bins
-		int bin = 1;
-
-		m_cutFlowUnweightedHist->GetXaxis()->SetBinLabel(bin, "without filters");
-
-		if(m_addWeightedCutFlow) {
-			m_cutFlowWeightedHist->GetXaxis()->SetBinLabel(bin, "without filters");
-		}
-
-		for(std::vector<std::string>::const_iterator filterName = filterNames.begin();
-		    filterName != filterNames.end(); ++filterName)
+		for (int bin = 1; bin <= nBins; ++bin)
 		{
-			++bin;
-			std::string filterNameLabel = *filterName;
-			if (filterResult.IsTaggingFilter(filterNameLabel) == FilterResult::TaggingMode::Tagging) {
-				filterNameLabel += " (T)";
-			}
-			m_cutFlowUnweightedHist->GetXaxis()->SetBinLabel(bin, filterNameLabel.c_str());
+			m_cutFlowUnweightedHist->GetXaxis()->SetBinLabel(bin, binLabels[bin-1].c_str());
 
 			if(m_addWeightedCutFlow) {
-				m_cutFlowWeightedHist->GetXaxis()->SetBinLabel(bin, filterNameLabel.c_str());
+				m_cutFlowWeightedHist->GetXaxis()->SetBinLabel(bin, binLabels[bin-1].c_str());
 			}
 		}
-
-		return true;
 	}
 
 };
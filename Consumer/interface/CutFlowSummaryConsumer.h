@@ -0,0 +1,52 @@
+
+#pragma once
+
+#include <map>
+#include <memory>
+
+#include "Artus/Core/interface/CutFlow.h"
+#include "Artus/Core/interface/ConsumerBase.h"
+#include "Artus/Core/interface/PipelineResults.h"
+#include "Artus/Utility/interface/ArtusLogging.h"
+
+
+/**
+   Consumer for pipelines of level two and higher, which collects the cut flows of all
+   pipelines of lower levels with a cut flow consumer and prints them in the order of
+   the pipeline names. The cut flows are handed over in memory via PipelineResults.
+*/
+template < class TTypes >
+class CutFlowSummaryConsumer: public ConsumerBase< TTypes > {
+public:
+
+	typedef typename TTypes::setting_type setting_type;
+
+	std::string GetConsumerId() const override
+	{
+		return "cutflow_summary";
+	}
+
+	void Process(setting_type const& setting) override {
+		ConsumerBase<TTypes>::Process(setting);
+
+		m_cutFlows = PipelineResults::GetAll<CutFlow>("cutFlow");
+	}
+
+	void Finish(setting_type const& setting) override {
+		for (typename std::map<std::string, std::shared_ptr<CutFlow> >::const_iterator cutFlow = m_cutFlows.begin();
+		     cutFlow != m_cutFlows.end(); ++cutFlow)
+		{
+			LOG(INFO) << "Cut flow of pipeline \"" << cutFlow->first << "\":" << cutFlow->second->ToString();
+		}
+	}
+
+	// cut flows of all pipelines of lower levels, key is the pipeline name
+	std::map<std::string, std::shared_ptr<CutFlow> > const& GetCutFlows() const
+	{
+		return m_cutFlows;
+	}
+
+private:
+
+	std::map<std::string, std::shared_ptr<CutFlow> > m_cutFlows;
+};
@@ -24,6 +24,12 @@ public:
 	{
 		return "CutFlowTreeConsumer";
 	}
+
+	// the entries of the tree are not restored from checkpoints
+	bool SupportsCheckpoints() const override
+	{
+		return false;
+	}
 	
 	CutFlowTreeConsumer() :
 		CutFlowConsumerBase< TTypes >(),
@@ -85,7 +91,7 @@ public:
 		
 			for (std::vector<TTree*>::iterator cutFlowTree = m_cutFlowTrees.begin(); cutFlowTree != m_cutFlowTrees.end(); ++cutFlowTree)
 			{
-				(*cutFlowTree)->Write((*cutFlowTree)->GetName());
+				(*cutFlowTree)->Write((*cutFlowTree)->GetName(), TObject::kOverwrite);
 			}
 		}
 	}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+
+#include <boost/noncopyable.hpp>
+
+#include "Artus/Core/interface/EventBase.h"
+#include "Artus/Core/interface/ProductBase.h"
+#include "Artus/Utility/interface/Expression.h"
+
+
+/**
+   \brief Quantities defined in the config as expressions over other quantities.
+
+   Every entry of the setting DerivedQuantities has the form "name := expression", e.g.
+       "DerivedQuantities" : ["deltaEtaJets := (nJets >= 2) ? abs(leadingJetEta - trailingJetEta) : -1"]
+   The expressions (see Expression) are compiled once per pipeline by the DerivedQuantitiesProducer.
+   They can use all numeric quantities registered before as well as the derived quantities defined
+   earlier in the list. Every derived quantity is registered as double quantity for the pipeline,
+   whose extractor evaluates the expression for a single event.
+
+   The compiled quantities are immutable. Consumers filling many events can evaluate them with a
+   DerivedQuantitiesBuffer for blocks of events at once.
+*/
+class DerivedQuantities: public boost::noncopyable
+{
+public:
+	typedef std::function<double(EventBase const&, ProductBase const&)> double_extractor_lambda;
+
+	/// compiles the definitions and registers the derived quantities for the pipeline
+	DerivedQuantities(std::string const& pipelineName, std::vector<std::string> const& definitions);
+
+	size_t GetNQuantities() const
+	{
+		return m_names.size();
+	}
+
+	/// index of the derived quantity with this name, GetNQuantities() for other quantities
+	size_t GetIndex(std::string const& name) const;
+
+	/// derived quantities compiled for a pipeline, nullptr if they have not been compiled
+	static void Register(std::string const& pipelineName, std::shared_ptr<DerivedQuantities const> derivedQuantities);
+	static std::shared_ptr<DerivedQuantities const> Get(std::string const& pipelineName);
+
+private:
+	friend class DerivedQuantitiesBuffer;
+
+	std::vector<std::string> m_names;
+	std::vector<std::shared_ptr<Expression> > m_expressions;
+
+	// variables shared by all expressions, which are either inputs or derived quantities
+	std::vector<std::string> m_variableNames;
+	std::shared_ptr<std::vector<double_extractor_lambda> > m_variableExtractors;
+	// index of the input column or of the derived quantity for each variable
+	std::vector<size_t> m_variableColumns;
+	std::vector<bool> m_variableIsDerived;
+
+	std::vector<size_t> m_inputVariables;
+
+	static std::map<std::string, std::shared_ptr<DerivedQuantities const> > s_pipelineDerivedQuantities;
+	static std::mutex s_mutex;
+};
+
+
+/**
+   \brief Evaluation of derived quantities for blocks of events.
+
+   BufferInputs stores the inputs of the derived quantities for one event and EvaluateBuffer
+   evaluates all derived quantities for the buffered events at once. This runs the batch
+   programs of the expressions over the columns of input values.
+*/
+class DerivedQuantitiesBuffer
+{
+public:
+	/// no derived quantities are evaluated for nullptr
+	void Init(std::shared_ptr<DerivedQuantities const> derivedQuantities);
+
+	size_t GetNQuantities() const
+	{
+		return (m_derivedQuantities ? m_derivedQuantities->GetNQuantities() : 0);
+	}
+
+	size_t GetIndex(std::string const& name) const
+	{
+		return (m_derivedQuantities ? m_derivedQuantities->GetIndex(name) : 0);
+	}
+
+	/// stores the input values of one event for the evaluation in EvaluateBuffer
+	void BufferInputs(EventBase const& event, ProductBase const& product);
+
+	size_t GetNBufferedEntries() const
+	{
+		return m_nBufferedEntries;
+	}
+
+	/// evaluates all derived quantities for the buffered events and clears the buffer
+	/// returns the number of evaluated events, whose values are available in GetValue
+	size_t EvaluateBuffer();
+
+	double GetValue(size_t quantityIndex, size_t entry) const
+	{
+		return m_values[quantityIndex][entry];
+	}
+
+private:
+	std::shared_ptr<DerivedQuantities const> m_derivedQuantities;
+
+	std::vector<std::vector<double> > m_inputColumns;
+	size_t m_nBufferedEntries = 0;
+	std::vector<std::vector<double> > m_values;
+};
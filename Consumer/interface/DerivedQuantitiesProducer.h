@@ -0,0 +1,41 @@
+#pragma once
+
+#include <memory>
+
+#include "Artus/Core/interface/ProducerBase.h"
+#include "Artus/Consumer/interface/DerivedQuantities.h"
+
+
+/**
+   \brief Producer compiling the quantities defined in the setting DerivedQuantities.
+
+   The derived quantities are compiled and registered for the pipeline in Init. Therefore, this
+   producer has to be run after the producers registering the quantities used in the expressions
+   and before the filters and consumers using the derived quantities. The quantities are evaluated
+   on demand by their extractors, there is nothing to be done per event.
+*/
+template<class TTypes>
+class DerivedQuantitiesProducer: public ProducerBase<TTypes> {
+public:
+
+	typedef typename TTypes::event_type event_type;
+	typedef typename TTypes::product_type product_type;
+	typedef typename TTypes::setting_type setting_type;
+
+	std::string GetProducerId() const override
+	{
+		return "DerivedQuantitiesProducer";
+	}
+
+	void Init(setting_type const& settings) override
+	{
+		ProducerBase<TTypes>::Init(settings);
+
+		DerivedQuantities::Register(settings.GetName(), std::make_shared<DerivedQuantities const>(
+				settings.GetName(), settings.GetDerivedQuantities()));
+	}
+
+	void Produce(event_type const& event, product_type& product, setting_type const& settings) const override
+	{
+	}
+};
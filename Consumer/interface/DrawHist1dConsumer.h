@@ -38,6 +38,10 @@ public:
 		return "hist1d";
 	}
 
+	bool SupportsCheckpoints() const override {
+		return true;
+	}
+
 	void Init(setting_type const& pset) override {
 		DrawConsumerBase<TTypes>::Init(pset);
 
@@ -56,6 +60,16 @@ public:
 		m_hist->Store(setting.GetRootOutFile());
 	}
 
+	void SaveCheckpoint(setting_type const& setting, Checkpoint & checkpoint) override {
+		checkpoint.SetHistogram(Checkpoint::GetKey(setting.GetName(), this->GetConsumerId(), m_histName),
+		                        *(m_hist->m_hist));
+	}
+
+	void RestoreCheckpoint(setting_type const& setting, Checkpoint const& checkpoint) override {
+		checkpoint.GetHistogram(Checkpoint::GetKey(setting.GetName(), this->GetConsumerId(), m_histName),
+		                        *(m_hist->m_hist));
+	}
+
 	void ProcessFilteredEvent(event_type const& event,
 			product_type const& product,
 			setting_type const& setting ) override {
@@ -3,15 +3,23 @@
 
 #include <cstdint>
 #include <cassert>
+#include <mutex>
+#include <stdexcept>
+#include <typeinfo>
+#include <type_traits>
 
 #include <boost/algorithm/string/predicate.hpp>
 
 #include <TTree.h>
+#include <TBranch.h>
+#include <TKey.h>
 
 #include "Artus/Core/interface/EventBase.h"
 #include "Artus/Core/interface/ProductBase.h"
 #include "Artus/Core/interface/ConsumerBase.h"
+#include "Artus/Core/interface/PipelineResults.h"
 #include "Artus/Configuration/interface/SettingsBase.h"
+#include "Artus/Consumer/interface/DerivedQuantities.h"
 #include "Artus/Utility/interface/DefaultValues.h"
 #include "Artus/Utility/interface/SafeMap.h"
 #include "Artus/Utility/interface/RootFileHelper.h"
@@ -22,22 +30,197 @@
  * This removes the string operations from its base class
  * This consumer can only be fully initilised in the constructor of an derived class
  * where the map LambdaNtupleConsumer<TTypes>::Quantities is filled with analysis specific code
+ *
+ * The quantities defined in the setting DerivedQuantities (see DerivedQuantities) are compiled by
+ * the DerivedQuantitiesProducer. If some of them are written, the inputs of the derived quantities
+ * are buffered for s_derivedQuantitiesBatchSize events and the derived quantities are evaluated
+ * for all of them at once. The other branches are filled event by event and the branches of the
+ * derived quantities are filled when the buffer is evaluated. Since TTree::Fill is not called in
+ * this case, the tree does not flush its baskets automatically. The baskets are flushed after
+ * every s_derivedQuantitiesClusterSize entries instead, which is set as cluster size of the tree,
+ * such that all branches have the same clusters as for trees filled with TTree::Fill. The buffer
+ * is evaluated at the end of every cluster, also if it is not full.
  */
 
 
+/**
+   \brief Process-wide registry of the quantities which can be filled by the LambdaNtupleConsumer.
+
+   Quantities are identified by interned ids. Registering the same lambda expression for the same
+   quantity again, as it happens in the Init of every pipeline, does not rebuild the extractor.
+   Extractors which depend on the settings or processors of a pipeline have to be registered
+   for this pipeline explicitly. They take precedence over the extractors common to all pipelines.
+ */
 class LambdaNtupleQuantities {
 
 public:
-	static std::map<std::string, std::function<bool(EventBase const&, ProductBase const& ) >> CommonBoolQuantities;
-	static std::map<std::string, std::function<int(EventBase const&, ProductBase const& ) >> CommonIntQuantities;
-	static std::map<std::string, std::function<uint64_t(EventBase const&, ProductBase const& ) >> CommonUInt64Quantities;
-	static std::map<std::string, std::function<float(EventBase const&, ProductBase const& ) >> CommonFloatQuantities;
-	static std::map<std::string, std::function<double(EventBase const&, ProductBase const& ) >> CommonDoubleQuantities;
-	static std::map<std::string, std::function<std::string(EventBase const&, ProductBase const& ) >> CommonStringQuantities;
-	static std::map<std::string, std::function<std::vector<double>(EventBase const&, ProductBase const& ) >> CommonVDoubleQuantities;
-	static std::map<std::string, std::function<std::vector<float>(EventBase const&, ProductBase const& ) >> CommonVFloatQuantities;
-	static std::map<std::string, std::function<std::vector<std::string>(EventBase const&, ProductBase const& ) >> CommonVStringQuantities;
-	static std::map<std::string, std::function<std::vector<int>(EventBase const&, ProductBase const& ) >> CommonVIntQuantities;
+	enum class Type : int
+	{
+		None = 0,
+		Bool,
+		Int,
+		UInt64,
+		Float,
+		Double,
+		String,
+		VDouble,
+		VFloat,
+		VString,
+		VInt
+	};
+
+	typedef size_t QuantityId;
+
+	template<class T>
+	struct Extractor
+	{
+		typedef std::function<T(EventBase const&, ProductBase const&)> type;
+	};
+
+	struct Registration
+	{
+		Type type = Type::None;
+		// index in the table of extractors of this type
+		size_t index = 0;
+		// type of the registered lambda expression, nullptr if it does not identify the extractor
+		std::type_info const* origin = nullptr;
+	};
+
+	static QuantityId GetQuantityId(std::string const& name);
+
+	/// extractor registered for the pipeline or, as a fallback, for all pipelines
+	/// the type of the registration is Type::None for unknown quantities
+	static Registration Find(std::string const& pipelineName, QuantityId quantityId);
+
+	static bool HasQuantity(std::string const& pipelineName, std::string const& name, Type type);
+
+	/// true if the extractor from this origin has already been registered
+	/// the pipeline name is nullptr for quantities common to all pipelines
+	static bool IsRegistered(std::string const* pipelineName, QuantityId quantityId, Type type,
+	                         std::type_info const& origin);
+
+	template<class T>
+	static void Register(std::string const* pipelineName, QuantityId quantityId, Type type,
+	                     std::type_info const* origin, typename Extractor<T>::type const& extractor)
+	{
+		std::lock_guard<std::mutex> lock(GetMutex());
+		Registration & registration = GetRegistration(pipelineName, quantityId);
+		std::vector<typename Extractor<T>::type> & extractors = GetExtractors<T>();
+		if (registration.type == type)
+		{
+			extractors[registration.index] = extractor;
+		}
+		else
+		{
+			registration.type = type;
+			registration.index = extractors.size();
+			extractors.push_back(extractor);
+		}
+		registration.origin = origin;
+	}
+
+	template<class T>
+	static typename Extractor<T>::type GetExtractor(size_t index)
+	{
+		std::lock_guard<std::mutex> lock(GetMutex());
+		return GetExtractors<T>().at(index);
+	}
+
+	/// extractor of a bool, int, uint64, float or double quantity converting the value to double
+	/// an empty function is returned for quantities of other types
+	static Extractor<double>::type GetNumericExtractor(Registration const& registration);
+
+	/**
+	   \brief Compatibility layer for the maps of common quantities used before the registry.
+
+	   Looking up and assigning extractors by name works as for the former std::map,
+	   e.g. LambdaNtupleConsumer<TTypes>::GetFloatQuantities()["jetPt"] = ...
+	   Assigned extractors are registered for all pipelines. Iterating over the quantities is not supported.
+	 */
+	template<class T, Type TType>
+	class CommonQuantities
+	{
+	public:
+		class Entry
+		{
+		public:
+			explicit Entry(std::string const& name) : m_name(name) {}
+			Entry(Entry const&) = default;
+
+			Entry & operator=(typename Extractor<T>::type const& extractor)
+			{
+				Register<T>(nullptr, GetQuantityId(m_name), TType, nullptr, extractor);
+				return *this;
+			}
+			Entry & operator=(Entry const& entry)
+			{
+				return (*this = typename Extractor<T>::type(entry));
+			}
+
+			operator typename Extractor<T>::type() const
+			{
+				return CommonQuantities<T, TType>().at(m_name);
+			}
+
+		private:
+			std::string m_name;
+		};
+
+		size_t count(std::string const& name) const
+		{
+			return ((FindCommon(GetQuantityId(name)).type == TType) ? 1 : 0);
+		}
+
+		typename Extractor<T>::type at(std::string const& name) const
+		{
+			Registration registration = FindCommon(GetQuantityId(name));
+			if (registration.type != TType)
+			{
+				throw std::out_of_range("No common quantity \"" + name + "\" of the requested type registered!");
+			}
+			return GetExtractor<T>(registration.index);
+		}
+
+		Entry operator[](std::string const& name)
+		{
+			return Entry(name);
+		}
+	};
+
+	static CommonQuantities<bool, Type::Bool> CommonBoolQuantities;
+	static CommonQuantities<int, Type::Int> CommonIntQuantities;
+	static CommonQuantities<uint64_t, Type::UInt64> CommonUInt64Quantities;
+	static CommonQuantities<float, Type::Float> CommonFloatQuantities;
+	static CommonQuantities<double, Type::Double> CommonDoubleQuantities;
+	static CommonQuantities<std::string, Type::String> CommonStringQuantities;
+	static CommonQuantities<std::vector<double>, Type::VDouble> CommonVDoubleQuantities;
+	static CommonQuantities<std::vector<float>, Type::VFloat> CommonVFloatQuantities;
+	static CommonQuantities<std::vector<std::string>, Type::VString> CommonVStringQuantities;
+	static CommonQuantities<std::vector<int>, Type::VInt> CommonVIntQuantities;
+
+private:
+	// extractor registered for all pipelines
+	static Registration FindCommon(QuantityId quantityId);
+
+	// has to be called with the mutex locked, the registration of unknown quantities is of
+	// Type::None and is not added to the tables
+	static Registration FindRegistration(std::string const* pipelineName, QuantityId quantityId);
+
+	// has to be called with the mutex locked, creates the registration, only used by Register
+	static Registration & GetRegistration(std::string const* pipelineName, QuantityId quantityId);
+
+	typedef std::vector<Registration> Registrations;
+	static Registrations & GetCommonRegistrations();
+	static std::map<std::string, Registrations> & GetPipelineRegistrations();
+
+	// function-local statics to be independent of the static initialisation order
+	template<class T>
+	static std::vector<typename Extractor<T>::type> & GetExtractors()
+	{
+		static std::vector<typename Extractor<T>::type> extractors;
+		return extractors;
+	}
+	static std::mutex & GetMutex();
 };
 
 template<class TTypes>
@@ -61,142 +244,199 @@ public:
 	typedef std::function<std::vector<int>(EventBase const&, ProductBase const&)> vInt_extractor_lambda_base;
 
 
-	static void AddBoolQuantity(std::string const& name,
-	                            std::function<bool(event_type const&, product_type const&)> valueExtractor)
+	/// Add*Quantity(name, valueExtractor) registers an extractor common to all pipelines. Repeated
+	/// registrations of the same lambda expression without captures are ignored. Other extractors
+	/// replace the registered one, the last registration is used by all pipelines.
+	/// Add*Quantity(settings, name, valueExtractor) registers an extractor for this pipeline only.
+	template<class TExtractor>
+	static void AddBoolQuantity(std::string const& name, TExtractor valueExtractor)
 	{
-		LambdaNtupleQuantities::CommonBoolQuantities[name] = [valueExtractor](EventBase const& ev, ProductBase const& pd) -> bool
-		{
-			auto const& specEv = static_cast<event_type const&>(ev);
-			auto const& specPd = static_cast<product_type const&>(pd);
-			return valueExtractor(specEv, specPd);
-		};
+		AddQuantity<bool>(nullptr, name, LambdaNtupleQuantities::Type::Bool, valueExtractor);
 	}
-	static void AddIntQuantity(std::string const& name,
-	                           std::function<int(event_type const&, product_type const&)> valueExtractor)
+	template<class TExtractor>
+	static void AddBoolQuantity(setting_type const& settings, std::string const& name, TExtractor valueExtractor)
 	{
-		LambdaNtupleQuantities::CommonIntQuantities[name] = [valueExtractor](EventBase const& ev, ProductBase const& pd) -> int
-		{
-			auto const& specEv = static_cast<event_type const&>(ev);
-			auto const& specPd = static_cast<product_type const&>(pd);
-			return valueExtractor(specEv, specPd);
-		};
+		std::string pipelineName = settings.GetName();
+		AddQuantity<bool>(&pipelineName, name, LambdaNtupleQuantities::Type::Bool, valueExtractor);
 	}
-	static void AddUInt64Quantity(std::string const& name,
-	                              std::function<uint64_t(event_type const&, product_type const&)> valueExtractor)
+	template<class TExtractor>
+	static void AddIntQuantity(std::string const& name, TExtractor valueExtractor)
 	{
-		LambdaNtupleQuantities::CommonUInt64Quantities[name] = [valueExtractor](EventBase const& ev, ProductBase const& pd) -> uint64_t
-		{
-			auto const& specEv = static_cast<event_type const&>(ev);
-			auto const& specPd = static_cast<product_type const&>(pd);
-			return valueExtractor(specEv, specPd);
-		};
+		AddQuantity<int>(nullptr, name, LambdaNtupleQuantities::Type::Int, valueExtractor);
 	}
-	static void AddFloatQuantity(std::string const& name,
-	                             std::function<float(event_type const&, product_type const&)> valueExtractor)
+	template<class TExtractor>
+	static void AddIntQuantity(setting_type const& settings, std::string const& name, TExtractor valueExtractor)
 	{
-		LambdaNtupleQuantities::CommonFloatQuantities[name] = [valueExtractor](EventBase const& ev, ProductBase const& pd) -> float
-		{
-			auto const& specEv = static_cast<event_type const&>(ev);
-			auto const& specPd = static_cast<product_type const&>(pd);
-			return valueExtractor(specEv, specPd);
-		};
+		std::string pipelineName = settings.GetName();
+		AddQuantity<int>(&pipelineName, name, LambdaNtupleQuantities::Type::Int, valueExtractor);
 	}
-	static void AddDoubleQuantity(std::string const& name,
-	                              std::function<double(event_type const&, product_type const&)> valueExtractor)
+	template<class TExtractor>
+	static void AddUInt64Quantity(std::string const& name, TExtractor valueExtractor)
 	{
-		LambdaNtupleQuantities::CommonDoubleQuantities[name] = [valueExtractor](EventBase const& ev, ProductBase const& pd) -> double
-		{
-			auto const& specEv = static_cast<event_type const&>(ev);
-			auto const& specPd = static_cast<product_type const&>(pd);
-			return valueExtractor(specEv, specPd);
-		};
+		AddQuantity<uint64_t>(nullptr, name, LambdaNtupleQuantities::Type::UInt64, valueExtractor);
 	}
-	static void AddStringQuantity(std::string const& name,
-	                              std::function<std::string(event_type const&, product_type const&)> valueExtractor)
+	template<class TExtractor>
+	static void AddUInt64Quantity(setting_type const& settings, std::string const& name, TExtractor valueExtractor)
 	{
-		LambdaNtupleQuantities::CommonStringQuantities[name] = [valueExtractor](EventBase const& ev, ProductBase const& pd) -> std::string
-		{
-			auto const& specEv = static_cast<event_type const&>(ev);
-			auto const& specPd = static_cast<product_type const&>(pd);
-			return valueExtractor(specEv, specPd);
-		};
+		std::string pipelineName = settings.GetName();
+		AddQuantity<uint64_t>(&pipelineName, name, LambdaNtupleQuantities::Type::UInt64, valueExtractor);
 	}
-	static void AddVDoubleQuantity(std::string const& name,
-	                              std::function<std::vector<double>(event_type const&, product_type const&)> valueExtractor)
+	template<class TExtractor>
+	static void AddFloatQuantity(std::string const& name, TExtractor valueExtractor)
 	{
-		LambdaNtupleQuantities::CommonVDoubleQuantities[name] = [valueExtractor](EventBase const& ev, ProductBase const& pd) -> std::vector<double>
-		{
-			auto const& specEv = static_cast<event_type const&>(ev);
-			auto const& specPd = static_cast<product_type const&>(pd);
-			return valueExtractor(specEv, specPd);
-		};
+		AddQuantity<float>(nullptr, name, LambdaNtupleQuantities::Type::Float, valueExtractor);
 	}
-	static void AddVFloatQuantity(std::string const& name,
-	                              std::function<std::vector<float>(event_type const&, product_type const&)> valueExtractor)
+	template<class TExtractor>
+	static void AddFloatQuantity(setting_type const& settings, std::string const& name, TExtractor valueExtractor)
 	{
-		LambdaNtupleQuantities::CommonVFloatQuantities[name] = [valueExtractor](EventBase const& ev, ProductBase const& pd) -> std::vector<float>
-		{
-			auto const& specEv = static_cast<event_type const&>(ev);
-			auto const& specPd = static_cast<product_type const&>(pd);
-			return valueExtractor(specEv, specPd);
-		};
+		std::string pipelineName = settings.GetName();
+		AddQuantity<float>(&pipelineName, name, LambdaNtupleQuantities::Type::Float, valueExtractor);
 	}
-	static void AddVStringQuantity(std::string const& name,
-	                              std::function<std::vector<std::string>(event_type const&, product_type const&)> valueExtractor)
+	template<class TExtractor>
+	static void AddDoubleQuantity(std::string const& name, TExtractor valueExtractor)
 	{
-		LambdaNtupleQuantities::CommonVStringQuantities[name] = [valueExtractor](EventBase const& ev, ProductBase const& pd) -> std::vector<std::string>
-		{
-			auto const& specEv = static_cast<event_type const&>(ev);
-			auto const& specPd = static_cast<product_type const&>(pd);
-			return valueExtractor(specEv, specPd);
-		};
+		AddQuantity<double>(nullptr, name, LambdaNtupleQuantities::Type::Double, valueExtractor);
 	}
-	static void AddVIntQuantity(std::string const& name,
-	                              std::function<std::vector<int>(event_type const&, product_type const&)> valueExtractor)
+	template<class TExtractor>
+	static void AddDoubleQuantity(setting_type const& settings, std::string const& name, TExtractor valueExtractor)
 	{
-		LambdaNtupleQuantities::CommonVIntQuantities[name] = [valueExtractor](EventBase const& ev, ProductBase const& pd) -> std::vector<int>
-		{
-			auto const& specEv = static_cast<event_type const&>(ev);
-			auto const& specPd = static_cast<product_type const&>(pd);
-			return valueExtractor(specEv, specPd);
-		};
+		std::string pipelineName = settings.GetName();
+		AddQuantity<double>(&pipelineName, name, LambdaNtupleQuantities::Type::Double, valueExtractor);
+	}
+	template<class TExtractor>
+	static void AddStringQuantity(std::string const& name, TExtractor valueExtractor)
+	{
+		AddQuantity<std::string>(nullptr, name, LambdaNtupleQuantities::Type::String, valueExtractor);
+	}
+	template<class TExtractor>
+	static void AddStringQuantity(setting_type const& settings, std::string const& name, TExtractor valueExtractor)
+	{
+		std::string pipelineName = settings.GetName();
+		AddQuantity<std::string>(&pipelineName, name, LambdaNtupleQuantities::Type::String, valueExtractor);
+	}
+	template<class TExtractor>
+	static void AddVDoubleQuantity(std::string const& name, TExtractor valueExtractor)
+	{
+		AddQuantity<std::vector<double>>(nullptr, name, LambdaNtupleQuantities::Type::VDouble, valueExtractor);
+	}
+	template<class TExtractor>
+	static void AddVDoubleQuantity(setting_type const& settings, std::string const& name, TExtractor valueExtractor)
+	{
+		std::string pipelineName = settings.GetName();
+		AddQuantity<std::vector<double>>(&pipelineName, name, LambdaNtupleQuantities::Type::VDouble, valueExtractor);
+	}
+	template<class TExtractor>
+	static void AddVFloatQuantity(std::string const& name, TExtractor valueExtractor)
+	{
+		AddQuantity<std::vector<float>>(nullptr, name, LambdaNtupleQuantities::Type::VFloat, valueExtractor);
+	}
+	template<class TExtractor>
+	static void AddVFloatQuantity(setting_type const& settings, std::string const& name, TExtractor valueExtractor)
+	{
+		std::string pipelineName = settings.GetName();
+		AddQuantity<std::vector<float>>(&pipelineName, name, LambdaNtupleQuantities::Type::VFloat, valueExtractor);
+	}
+	template<class TExtractor>
+	static void AddVStringQuantity(std::string const& name, TExtractor valueExtractor)
+	{
+		AddQuantity<std::vector<std::string>>(nullptr, name, LambdaNtupleQuantities::Type::VString, valueExtractor);
+	}
+	template<class TExtractor>
+	static void AddVStringQuantity(setting_type const& settings, std::string const& name, TExtractor valueExtractor)
+	{
+		std::string pipelineName = settings.GetName();
+		AddQuantity<std::vector<std::string>>(&pipelineName, name, LambdaNtupleQuantities::Type::VString, valueExtractor);
+	}
+	template<class TExtractor>
+	static void AddVIntQuantity(std::string const& name, TExtractor valueExtractor)
+	{
+		AddQuantity<std::vector<int>>(nullptr, name, LambdaNtupleQuantities::Type::VInt, valueExtractor);
+	}
+	template<class TExtractor>
+	static void AddVIntQuantity(setting_type const& settings, std::string const& name, TExtractor valueExtractor)
+	{
+		std::string pipelineName = settings.GetName();
+		AddQuantity<std::vector<int>>(&pipelineName, name, LambdaNtupleQuantities::Type::VInt, valueExtractor);
 	}
-	
 
-	static std::map<std::string, std::function<bool(EventBase const&, ProductBase const& ) >> & GetBoolQuantities () {
+	static bool HasQuantity(setting_type const& settings, std::string const& name, LambdaNtupleQuantities::Type type)
+	{
+		return LambdaNtupleQuantities::HasQuantity(settings.GetName(), name, type);
+	}
+
+	/// compatibility with the former maps of common quantities, see LambdaNtupleQuantities::CommonQuantities
+	static LambdaNtupleQuantities::CommonQuantities<bool, LambdaNtupleQuantities::Type::Bool> & GetBoolQuantities() {
 		return LambdaNtupleQuantities::CommonBoolQuantities;
 	}
-	static std::map<std::string, std::function<int(EventBase const&, ProductBase const& ) >> & GetIntQuantities () {
+	static LambdaNtupleQuantities::CommonQuantities<int, LambdaNtupleQuantities::Type::Int> & GetIntQuantities() {
 		return LambdaNtupleQuantities::CommonIntQuantities;
 	}
-	static std::map<std::string, std::function<uint64_t(EventBase const&, ProductBase const& ) >> & GetUInt64Quantities () {
+	static LambdaNtupleQuantities::CommonQuantities<uint64_t, LambdaNtupleQuantities::Type::UInt64> & GetUInt64Quantities() {
 		return LambdaNtupleQuantities::CommonUInt64Quantities;
 	}
-	static std::map<std::string, std::function<float(EventBase const&, ProductBase const& ) >> & GetFloatQuantities () {
+	static LambdaNtupleQuantities::CommonQuantities<float, LambdaNtupleQuantities::Type::Float> & GetFloatQuantities() {
 		return LambdaNtupleQuantities::CommonFloatQuantities;
 	}
-	static std::map<std::string, std::function<double(EventBase const&, ProductBase const& ) >> & GetDoubleQuantities () {
+	static LambdaNtupleQuantities::CommonQuantities<double, LambdaNtupleQuantities::Type::Double> & GetDoubleQuantities() {
 		return LambdaNtupleQuantities::CommonDoubleQuantities;
 	}
-	static std::map<std::string, std::function<std::string(EventBase const&, ProductBase const& ) >> & GetStringQuantities () {
+	static LambdaNtupleQuantities::CommonQuantities<std::string, LambdaNtupleQuantities::Type::String> & GetStringQuantities() {
 		return LambdaNtupleQuantities::CommonStringQuantities;
 	}
-	static std::map<std::string, std::function<std::vector<double>(EventBase const&, ProductBase const& ) >> & GetVDoubleQuantities () {
+	static LambdaNtupleQuantities::CommonQuantities<std::vector<double>, LambdaNtupleQuantities::Type::VDouble> & GetVDoubleQuantities() {
 		return LambdaNtupleQuantities::CommonVDoubleQuantities;
 	}
-	static std::map<std::string, std::function<std::vector<float>(EventBase const&, ProductBase const& ) >> & GetVFloatQuantities () {
+	static LambdaNtupleQuantities::CommonQuantities<std::vector<float>, LambdaNtupleQuantities::Type::VFloat> & GetVFloatQuantities() {
 		return LambdaNtupleQuantities::CommonVFloatQuantities;
 	}
-	static std::map<std::string, std::function<std::vector<std::string>(EventBase const&, ProductBase const& ) >> & GetVStringQuantities () {
+	static LambdaNtupleQuantities::CommonQuantities<std::vector<std::string>, LambdaNtupleQuantities::Type::VString> & GetVStringQuantities() {
 		return LambdaNtupleQuantities::CommonVStringQuantities;
 	}
-	static std::map<std::string, std::function<std::vector<int>(EventBase const&, ProductBase const& ) >> & GetVIntQuantities () {
+	static LambdaNtupleQuantities::CommonQuantities<std::vector<int>, LambdaNtupleQuantities::Type::VInt> & GetVIntQuantities() {
 		return LambdaNtupleQuantities::CommonVIntQuantities;
 	}
 
+private:
+	template<class T, class TExtractor>
+	static void AddQuantity(std::string const* pipelineName, std::string const& name,
+	                        LambdaNtupleQuantities::Type type, TExtractor valueExtractor)
+	{
+		LambdaNtupleQuantities::QuantityId quantityId = LambdaNtupleQuantities::GetQuantityId(name);
+
+		// the type of a lambda expression without captures identifies the extractor
+		// lambda expressions with captures, std::function objects and function pointers are always registered again
+		std::type_info const* origin = (std::is_empty<TExtractor>::value ? &typeid(TExtractor) : nullptr);
+		if ((origin != nullptr) && LambdaNtupleQuantities::IsRegistered(pipelineName, quantityId, type, *origin))
+		{
+			return;
+		}
+
+		LambdaNtupleQuantities::Register<T>(pipelineName, quantityId, type, origin,
+				[valueExtractor](EventBase const& ev, ProductBase const& pd) -> T
+		{
+			auto const& specEv = static_cast<event_type const&>(ev);
+			auto const& specPd = static_cast<product_type const&>(pd);
+			return valueExtractor(specEv, specPd);
+		});
+	}
+
+public:
 	void Init(setting_type const& settings) override {
 		ConsumerBase<TTypes>::Init(settings);
 
+		// the derived quantities are compiled by the DerivedQuantitiesProducer
+		std::shared_ptr<DerivedQuantities const> derivedQuantities;
+		if (! settings.GetDerivedQuantities().empty())
+		{
+			derivedQuantities = DerivedQuantities::Get(settings.GetName());
+			if (! derivedQuantities)
+			{
+				LOG(FATAL) << "Derived quantities of pipeline \"" << settings.GetName() << "\" are not compiled, "
+				           << "the DerivedQuantitiesProducer needs to be run before the consumers!";
+			}
+		}
+		m_derivedQuantities.Init(derivedQuantities);
+
 		// construct value extractors
 		m_boolValueExtractors.clear();
 		m_floatValueExtractors.clear();
@@ -220,76 +460,64 @@ public:
 		m_vStringQuantities.clear();
 		m_vIntQuantities.clear();
 		
-		size_t quantityIndex = 0;
-		for (std::vector<std::string>::iterator quantity = settings.GetQuantities().begin();
+		m_quantityTypes.clear();
+		m_doubleDerivedIndices.clear();
+
+		for (std::vector<std::string>::const_iterator quantity = settings.GetQuantities().begin();
 		     quantity != settings.GetQuantities().end(); ++quantity)
 		{
-			if (LambdaNtupleConsumer<TTypes>::GetFloatQuantities().count(*quantity) > 0)
-			{
-				//LOG(DEBUG) << "Init float quantity: " <<  << *quantity << " (index " << m_floatValueExtractors.size() << ")");
-				m_floatValueExtractors.push_back(SafeMap::Get(LambdaNtupleConsumer<TTypes>::GetFloatQuantities(), *quantity));
+			LambdaNtupleQuantities::Registration registration = LambdaNtupleQuantities::Find(
+					settings.GetName(),
+					LambdaNtupleQuantities::GetQuantityId(*quantity)
+			);
+			switch (registration.type)
+			{
+			case LambdaNtupleQuantities::Type::Float:
+				m_floatValueExtractors.push_back(LambdaNtupleQuantities::GetExtractor<float>(registration.index));
 				m_floatQuantities.push_back(*quantity);
-			}
-			else if (LambdaNtupleConsumer<TTypes>::GetIntQuantities().count(*quantity) > 0)
-			{
-				//LOG(DEBUG) << "Init int quantity: " <<  << *quantity << " (index " << m_floatValueExtractors.size() << ")");
-				m_intValueExtractors.push_back(SafeMap::Get(LambdaNtupleConsumer<TTypes>::GetIntQuantities(), *quantity));
+				break;
+			case LambdaNtupleQuantities::Type::Int:
+				m_intValueExtractors.push_back(LambdaNtupleQuantities::GetExtractor<int>(registration.index));
 				m_intQuantities.push_back(*quantity);
-			}
-			else if (LambdaNtupleConsumer<TTypes>::GetUInt64Quantities().count(*quantity) > 0)
-			{
-				//LOG(DEBUG) << "Init uint64 quantity: " <<  << *quantity << " (index " << m_floatValueExtractors.size() << ")");
-				m_uint64ValueExtractors.push_back(SafeMap::Get(LambdaNtupleConsumer<TTypes>::GetUInt64Quantities(), *quantity));
+				break;
+			case LambdaNtupleQuantities::Type::UInt64:
+				m_uint64ValueExtractors.push_back(LambdaNtupleQuantities::GetExtractor<uint64_t>(registration.index));
 				m_uint64Quantities.push_back(*quantity);
-			}
-			else if (LambdaNtupleConsumer<TTypes>::GetDoubleQuantities().count(*quantity) > 0)
-			{
-				//LOG(DEBUG) << "Init double quantity: " <<  << *quantity << " (index " << m_floatValueExtractors.size() << ")");
-				m_doubleValueExtractors.push_back(SafeMap::Get(LambdaNtupleConsumer<TTypes>::GetDoubleQuantities(), *quantity));
+				break;
+			case LambdaNtupleQuantities::Type::Double:
+				m_doubleValueExtractors.push_back(LambdaNtupleQuantities::GetExtractor<double>(registration.index));
 				m_doubleQuantities.push_back(*quantity);
-			}
-			else if (LambdaNtupleConsumer<TTypes>::GetVDoubleQuantities().count(*quantity) > 0)
-			{
-				//LOG(DEBUG) << "Init vDouble quantity: " <<  << *quantity << " (index " << m_floatValueExtractors.size() << ")");
-				m_vDoubleValueExtractors.push_back(SafeMap::Get(LambdaNtupleConsumer<TTypes>::GetVDoubleQuantities(), *quantity));
+				m_doubleDerivedIndices.push_back(m_derivedQuantities.GetIndex(*quantity));
+				break;
+			case LambdaNtupleQuantities::Type::VDouble:
+				m_vDoubleValueExtractors.push_back(LambdaNtupleQuantities::GetExtractor<std::vector<double>>(registration.index));
 				m_vDoubleQuantities.push_back(*quantity);
-			}
-			else if (LambdaNtupleConsumer<TTypes>::GetVFloatQuantities().count(*quantity) > 0)
-			{
-				//LOG(DEBUG) << "Init vFloat quantity: " <<  << *quantity << " (index " << m_floatValueExtractors.size() << ")");
-				m_vFloatValueExtractors.push_back(SafeMap::Get(LambdaNtupleConsumer<TTypes>::GetVFloatQuantities(), *quantity));
+				break;
+			case LambdaNtupleQuantities::Type::VFloat:
+				m_vFloatValueExtractors.push_back(LambdaNtupleQuantities::GetExtractor<std::vector<float>>(registration.index));
 				m_vFloatQuantities.push_back(*quantity);
-			}
-			else if (LambdaNtupleConsumer<TTypes>::GetBoolQuantities().count(*quantity) > 0)
-			{
-				//LOG(DEBUG) << "Init bool quantity: " <<  << *quantity << " (index " << m_floatValueExtractors.size() << ")");
-				m_boolValueExtractors.push_back(SafeMap::Get(LambdaNtupleConsumer<TTypes>::GetBoolQuantities(), *quantity));
+				break;
+			case LambdaNtupleQuantities::Type::Bool:
+				m_boolValueExtractors.push_back(LambdaNtupleQuantities::GetExtractor<bool>(registration.index));
 				m_boolQuantities.push_back(*quantity);
-			}
-			else if (LambdaNtupleConsumer<TTypes>::GetVIntQuantities().count(*quantity) > 0)
-			{
-				//LOG(DEBUG) << "Init vBool quantity: " <<  << *quantity << " (index " << m_floatValueExtractors.size() << ")");
-				m_vIntValueExtractors.push_back(SafeMap::Get(LambdaNtupleConsumer<TTypes>::GetVIntQuantities(), *quantity));
+				break;
+			case LambdaNtupleQuantities::Type::VInt:
+				m_vIntValueExtractors.push_back(LambdaNtupleQuantities::GetExtractor<std::vector<int>>(registration.index));
 				m_vIntQuantities.push_back(*quantity);
-			}
-			else if (LambdaNtupleConsumer<TTypes>::GetStringQuantities().count(*quantity) > 0)
-			{
-				//LOG(DEBUG) << "Init string quantity: " <<  << *quantity << " (index " << m_floatValueExtractors.size() << ")");
-				m_stringValueExtractors.push_back(SafeMap::Get(LambdaNtupleConsumer<TTypes>::GetStringQuantities(), *quantity));
+				break;
+			case LambdaNtupleQuantities::Type::String:
+				m_stringValueExtractors.push_back(LambdaNtupleQuantities::GetExtractor<std::string>(registration.index));
 				m_stringQuantities.push_back(*quantity);
-			}
-			else if (LambdaNtupleConsumer<TTypes>::GetVStringQuantities().count(*quantity) > 0)
-			{
-				//LOG(DEBUG) << "Init vString quantity: " <<  << *quantity << " (index " << m_floatValueExtractors.size() << ")");
-				m_vStringValueExtractors.push_back(SafeMap::Get(LambdaNtupleConsumer<TTypes>::GetVStringQuantities(), *quantity));
+				break;
+			case LambdaNtupleQuantities::Type::VString:
+				m_vStringValueExtractors.push_back(LambdaNtupleQuantities::GetExtractor<std::vector<std::string>>(registration.index));
 				m_vStringQuantities.push_back(*quantity);
-			}
-			else
-			{
+				break;
+			case LambdaNtupleQuantities::Type::None:
+			default:
 				LOG(FATAL) << "No lambda expression available for quantity \"" << *quantity << "\"!";
 			}
-
-			++quantityIndex;
+			m_quantityTypes.push_back(registration.type);
 		}
 
 		// create tree
@@ -317,58 +545,76 @@ public:
 		size_t vFloatQuantityIndex = 0;
 		size_t vStringQuantityIndex = 0;
 		size_t vIntQuantityIndex = 0;
-		for (std::vector<std::string>::iterator quantity = settings.GetQuantities().begin();
-		     quantity != settings.GetQuantities().end(); ++quantity)
+		m_batchDerivedQuantities = false;
+		for (std::vector<size_t>::const_iterator derivedIndex = m_doubleDerivedIndices.begin();
+		     derivedIndex != m_doubleDerivedIndices.end(); ++derivedIndex)
+		{
+			m_batchDerivedQuantities = m_batchDerivedQuantities || (*derivedIndex < m_derivedQuantities.GetNQuantities());
+		}
+		if (m_batchDerivedQuantities)
 		{
-			if (LambdaNtupleQuantities::CommonFloatQuantities.count(*quantity) > 0)
+			m_tree->SetAutoFlush(s_derivedQuantitiesClusterSize);
+		}
+		m_directBranches.clear();
+		m_derivedBranches.clear();
+		for (size_t quantityIndex = 0; quantityIndex < m_quantityTypes.size(); ++quantityIndex)
+		{
+			std::string const& quantity = settings.GetQuantities()[quantityIndex];
+			TBranch* branch = nullptr;
+			switch (m_quantityTypes[quantityIndex])
 			{
-				m_tree->Branch(quantity->c_str(), &(m_floatValues[floatQuantityIndex]), (*quantity + "/F").c_str());
+			case LambdaNtupleQuantities::Type::Float:
+				branch = m_tree->Branch(quantity.c_str(), &(m_floatValues[floatQuantityIndex]), (quantity + "/F").c_str());
 				++floatQuantityIndex;
-			}
-			else if (LambdaNtupleQuantities::CommonIntQuantities.count(*quantity) > 0)
-			{
-				m_tree->Branch(quantity->c_str(), &(m_intValues[intQuantityIndex]), (*quantity + "/I").c_str());
+				break;
+			case LambdaNtupleQuantities::Type::Int:
+				branch = m_tree->Branch(quantity.c_str(), &(m_intValues[intQuantityIndex]), (quantity + "/I").c_str());
 				++intQuantityIndex;
-			}
-			else if (LambdaNtupleQuantities::CommonUInt64Quantities.count(*quantity) > 0)
-			{
-				m_tree->Branch(quantity->c_str(), &(m_uint64Values[uint64QuantityIndex]), (*quantity + "/l").c_str());
+				break;
+			case LambdaNtupleQuantities::Type::UInt64:
+				branch = m_tree->Branch(quantity.c_str(), &(m_uint64Values[uint64QuantityIndex]), (quantity + "/l").c_str());
 				++uint64QuantityIndex;
-			}
-			else if (LambdaNtupleQuantities::CommonDoubleQuantities.count(*quantity) > 0)
-			{
-				m_tree->Branch(quantity->c_str(), &(m_doubleValues[doubleQuantityIndex]), (*quantity + "/D").c_str());
+				break;
+			case LambdaNtupleQuantities::Type::Double:
+				branch = m_tree->Branch(quantity.c_str(), &(m_doubleValues[doubleQuantityIndex]), (quantity + "/D").c_str());
+				if (m_doubleDerivedIndices[doubleQuantityIndex] < m_derivedQuantities.GetNQuantities())
+				{
+					m_derivedBranches.push_back(std::make_pair(doubleQuantityIndex, branch));
+					branch = nullptr;
+				}
 				++doubleQuantityIndex;
-			}
-			else if (LambdaNtupleQuantities::CommonVDoubleQuantities.count(*quantity) > 0)
-			{
-				m_tree->Branch(quantity->c_str(), &(m_vDoubleValues[vDoubleQuantityIndex]));
+				break;
+			case LambdaNtupleQuantities::Type::VDouble:
+				branch = m_tree->Branch(quantity.c_str(), &(m_vDoubleValues[vDoubleQuantityIndex]));
 				++vDoubleQuantityIndex;
-			}
-			else if (LambdaNtupleQuantities::CommonVFloatQuantities.count(*quantity) > 0)
-			{
-				m_tree->Branch(quantity->c_str(), &(m_vFloatValues[vFloatQuantityIndex]));
+				break;
+			case LambdaNtupleQuantities::Type::VFloat:
+				branch = m_tree->Branch(quantity.c_str(), &(m_vFloatValues[vFloatQuantityIndex]));
 				++vFloatQuantityIndex;
-			}
-			else if (LambdaNtupleQuantities::CommonBoolQuantities.count(*quantity) > 0)
-			{
-				m_tree->Branch(quantity->c_str(), &(m_boolValues[boolQuantityIndex]), (*quantity + "/O").c_str());
+				break;
+			case LambdaNtupleQuantities::Type::Bool:
+				branch = m_tree->Branch(quantity.c_str(), &(m_boolValues[boolQuantityIndex]), (quantity + "/O").c_str());
 				++boolQuantityIndex;
-			}
-			else if (LambdaNtupleQuantities::CommonStringQuantities.count(*quantity) > 0)
-			{
-				m_tree->Branch(quantity->c_str(), &(m_stringValues[stringQuantityIndex]));
+				break;
+			case LambdaNtupleQuantities::Type::VInt:
+				branch = m_tree->Branch(quantity.c_str(), &(m_vIntValues[vIntQuantityIndex]));
+				++vIntQuantityIndex;
+				break;
+			case LambdaNtupleQuantities::Type::String:
+				branch = m_tree->Branch(quantity.c_str(), &(m_stringValues[stringQuantityIndex]));
 				++stringQuantityIndex;
-			}
-			else if (LambdaNtupleQuantities::CommonVStringQuantities.count(*quantity) > 0)
-			{
-				m_tree->Branch(quantity->c_str(), &(m_vStringValues[vStringQuantityIndex]));
+				break;
+			case LambdaNtupleQuantities::Type::VString:
+				branch = m_tree->Branch(quantity.c_str(), &(m_vStringValues[vStringQuantityIndex]));
 				++vStringQuantityIndex;
+				break;
+			case LambdaNtupleQuantities::Type::None:
+			default:
+				break;
 			}
-			else if (LambdaNtupleQuantities::CommonVIntQuantities.count(*quantity) > 0)
+			if (branch != nullptr)
 			{
-				m_tree->Branch(quantity->c_str(), &(m_vIntValues[vIntQuantityIndex]));
-				++vIntQuantityIndex;
+				m_directBranches.push_back(branch);
 			}
 		}
 	}
@@ -442,6 +688,12 @@ public:
 		for(typename std::vector<double_extractor_lambda_base>::iterator valueExtractor = m_doubleValueExtractors.begin();
 		    valueExtractor != m_doubleValueExtractors.end(); ++valueExtractor)
 		{
+			if (m_batchDerivedQuantities && (m_doubleDerivedIndices[doubleValueIndex] < m_derivedQuantities.GetNQuantities()))
+			{
+				// evaluated in FillDerivedQuantities
+				++doubleValueIndex;
+				continue;
+			}
 			try
 			{
 				m_doubleValues[doubleValueIndex] = (*valueExtractor)(event, product);
@@ -529,19 +781,118 @@ public:
 		}
 
 		// fill tree
-		this->m_tree->Fill();
+		if (m_batchDerivedQuantities)
+		{
+			for (std::vector<TBranch*>::iterator branch = m_directBranches.begin(); branch != m_directBranches.end(); ++branch)
+			{
+				(*branch)->Fill();
+			}
+			m_derivedQuantities.BufferInputs(event, product);
+			// the tree only counts the entries completed by FillDerivedQuantities
+			long long nEntries = this->m_tree->GetEntries() + static_cast<long long>(m_derivedQuantities.GetNBufferedEntries());
+			if ((m_derivedQuantities.GetNBufferedEntries() >= s_derivedQuantitiesBatchSize) ||
+			    ((nEntries % s_derivedQuantitiesClusterSize) == 0))
+			{
+				FillDerivedQuantities();
+			}
+		}
+		else
+		{
+			this->m_tree->Fill();
+		}
 	}
 
 	void Finish(setting_type const& setting) override
 	{
+		FillDerivedQuantities();
+
+		RootFileHelper::SafeCd(setting.GetRootOutFile(), setting.GetRootFileFolder());
+		// replace the versions of the tree written for checkpoints
+		m_tree->Write(m_tree->GetName(), TObject::kOverwrite);
+
+		// pipelines of higher levels can read the tree directly from memory
+		PipelineResults::Register(setting.GetName(), "ntuple", m_tree);
+	}
+
+
+	bool SupportsCheckpoints() const override
+	{
+		return true;
+	}
+
+	void SaveCheckpoint(setting_type const& setting, Checkpoint & checkpoint) override
+	{
+		// flush the entries filled so far to the output file
+		FillDerivedQuantities();
 		RootFileHelper::SafeCd(setting.GetRootOutFile(), setting.GetRootFileFolder());
-		m_tree->Write(m_tree->GetName());
+		m_tree->AutoSave("SaveSelf");
+		checkpoint.SetValue(Checkpoint::GetKey(setting.GetName(), this->GetConsumerId(), "entries"), m_tree->GetEntries());
 	}
 
+	void RestoreCheckpoint(setting_type const& setting, Checkpoint const& checkpoint) override
+	{
+		long long nEntries = checkpoint.GetValue(Checkpoint::GetKey(setting.GetName(), this->GetConsumerId(), "entries"), 0ll);
+		if (nEntries > 0)
+		{
+			// the tree on disk may contain more entries than the checkpoint due to automatic flushes
+			TDirectory* directory = setting.GetRootOutFile()->GetDirectory(setting.GetRootFileFolder().c_str());
+			TKey* key = ((directory != nullptr) ? directory->GetKey(m_tree->GetName()) : nullptr);
+			TTree* previousTree = ((key != nullptr) ? dynamic_cast<TTree*>(key->ReadObj()) : nullptr);
+			if ((previousTree == nullptr) || (previousTree->GetEntries() < nEntries))
+			{
+				LOG(FATAL) << "Cannot restore " << nEntries << " entries of the ntuple of pipeline \"" << setting.GetName() << "\" from the output file!";
+			}
+			m_tree->CopyEntries(previousTree, nEntries);
+			delete previousTree;
+		}
+	}
 
 private:
+	/// evaluates the buffered derived quantities and completes the entries of the tree
+	void FillDerivedQuantities()
+	{
+		if ((! m_batchDerivedQuantities) || (m_derivedQuantities.GetNBufferedEntries() == 0))
+		{
+			return;
+		}
+
+		size_t nEntries = m_derivedQuantities.EvaluateBuffer();
+		for (size_t entry = 0; entry < nEntries; ++entry)
+		{
+			for (std::vector<std::pair<size_t, TBranch*> >::iterator derivedBranch = m_derivedBranches.begin();
+			     derivedBranch != m_derivedBranches.end(); ++derivedBranch)
+			{
+				m_doubleValues[derivedBranch->first] = m_derivedQuantities.GetValue(m_doubleDerivedIndices[derivedBranch->first], entry);
+				derivedBranch->second->Fill();
+			}
+		}
+		// all branches have the same number of entries again
+		m_tree->SetEntries(-1);
+
+		// complete the cluster, which TTree::Fill would do for the automatic flushes
+		if ((m_tree->GetEntries() % s_derivedQuantitiesClusterSize) == 0)
+		{
+			m_tree->FlushBaskets();
+		}
+	}
+
+	static const size_t s_derivedQuantitiesBatchSize = 256;
+	// the buffer is also evaluated at the end of every cluster, e.g. after partial batches for checkpoints
+	static const long long s_derivedQuantitiesClusterSize = 64 * s_derivedQuantitiesBatchSize;
+
 	TTree* m_tree = nullptr;
 
+	DerivedQuantitiesBuffer m_derivedQuantities;
+	// index in m_derivedQuantities for every double quantity, m_derivedQuantities.GetNQuantities() if not derived
+	std::vector<size_t> m_doubleDerivedIndices;
+	bool m_batchDerivedQuantities = false;
+	std::vector<TBranch*> m_directBranches;
+	// index in m_doubleValues and branch of the derived quantities written
+	std::vector<std::pair<size_t, TBranch*> > m_derivedBranches;
+
+	// type of each quantity in the order of the settings
+	std::vector<LambdaNtupleQuantities::Type> m_quantityTypes;
+
 	std::vector<bool_extractor_lambda_base> m_boolValueExtractors;
 	std::vector<int_extractor_lambda_base> m_intValueExtractors;
 	std::vector<uint64_extractor_lambda_base> m_uint64ValueExtractors;
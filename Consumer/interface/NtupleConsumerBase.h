@@ -77,7 +77,7 @@ public:
 		RootFileHelper::SafeCd(setting.GetRootOutFile(),
 								setting.GetRootFileFolder());
 		
-		m_ntuple->Write(m_ntuple->GetName());
+		m_ntuple->Write(m_ntuple->GetName(), TObject::kOverwrite);
 	}
 
 
@@ -60,7 +60,7 @@ public:
 		RootFileHelper::SafeCd(setting.GetRootOutFile(),
 				setting.GetRootFileFolder());
 
-		m_tree->Write("runTime");
+		m_tree->Write("runTime", TObject::kOverwrite);
 	}
 
 	void ProcessEvent(event_type const& event,
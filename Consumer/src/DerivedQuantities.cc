@@ -0,0 +1,167 @@
+
+#include <algorithm>
+
+#include <boost/algorithm/string/trim.hpp>
+
+#include "Artus/Consumer/interface/DerivedQuantities.h"
+#include "Artus/Consumer/interface/LambdaNtupleConsumer.h"
+
+
+std::map<std::string, std::shared_ptr<DerivedQuantities const> > DerivedQuantities::s_pipelineDerivedQuantities;
+std::mutex DerivedQuantities::s_mutex;
+
+DerivedQuantities::DerivedQuantities(std::string const& pipelineName, std::vector<std::string> const& definitions) :
+	m_variableExtractors(std::make_shared<std::vector<double_extractor_lambda> >())
+{
+	std::vector<std::string> texts;
+	for (std::vector<std::string>::const_iterator definition = definitions.begin();
+	     definition != definitions.end(); ++definition)
+	{
+		size_t separator = definition->find(":=");
+		std::string name = boost::algorithm::trim_copy(definition->substr(0, separator));
+		if ((separator == std::string::npos) || name.empty())
+		{
+			LOG(FATAL) << "Derived quantity \"" << *definition << "\" is not of the form \"name := expression\"!";
+		}
+		if (GetIndex(name) < GetNQuantities())
+		{
+			LOG(FATAL) << "Derived quantity \"" << name << "\" is defined twice!";
+		}
+		m_names.push_back(name);
+		texts.push_back(definition->substr(separator + 2));
+	}
+
+	for (size_t quantityIndex = 0; quantityIndex < m_names.size(); ++quantityIndex)
+	{
+		m_expressions.push_back(std::make_shared<Expression>(texts[quantityIndex], m_variableNames));
+
+		// resolve the variables used for the first time in this expression
+		for (size_t variableIndex = m_variableExtractors->size(); variableIndex < m_variableNames.size(); ++variableIndex)
+		{
+			std::string const& variableName = m_variableNames[variableIndex];
+			size_t derivedIndex = GetIndex(variableName);
+			if ((derivedIndex >= quantityIndex) && (derivedIndex < GetNQuantities()))
+			{
+				LOG(FATAL) << "Derived quantity \"" << variableName << "\" is used in the definition of \""
+				           << m_names[quantityIndex] << "\" before its own definition!";
+			}
+
+			LambdaNtupleQuantities::Registration registration = LambdaNtupleQuantities::Find(
+					pipelineName,
+					LambdaNtupleQuantities::GetQuantityId(variableName)
+			);
+			m_variableExtractors->push_back(LambdaNtupleQuantities::GetNumericExtractor(registration));
+			if (registration.type == LambdaNtupleQuantities::Type::None)
+			{
+				LOG(FATAL) << "Quantity \"" << variableName << "\" used in the derived quantity \""
+				           << m_names[quantityIndex] << "\" is not registered!";
+			}
+			else if (! m_variableExtractors->back())
+			{
+				LOG(FATAL) << "Quantity \"" << variableName << "\" used in the derived quantity \""
+				           << m_names[quantityIndex] << "\" is not a number!";
+			}
+
+			m_variableIsDerived.push_back(derivedIndex < GetNQuantities());
+			if (m_variableIsDerived.back())
+			{
+				m_variableColumns.push_back(derivedIndex);
+			}
+			else
+			{
+				m_variableColumns.push_back(m_inputVariables.size());
+				m_inputVariables.push_back(variableIndex);
+			}
+		}
+
+		// the extractors of the variables are complete at the end of the constructor, before any evaluation
+		std::shared_ptr<Expression const> expression = m_expressions.back();
+		std::shared_ptr<std::vector<double_extractor_lambda> const> variableExtractors = m_variableExtractors;
+		LambdaNtupleQuantities::Register<double>(
+				&pipelineName,
+				LambdaNtupleQuantities::GetQuantityId(m_names[quantityIndex]),
+				LambdaNtupleQuantities::Type::Double,
+				nullptr,
+				[expression, variableExtractors](EventBase const& event, ProductBase const& product) -> double
+		{
+			return expression->Evaluate([&](size_t variableIndex) {
+				return (*variableExtractors)[variableIndex](event, product);
+			});
+		});
+	}
+}
+
+size_t DerivedQuantities::GetIndex(std::string const& name) const
+{
+	return static_cast<size_t>(std::find(m_names.begin(), m_names.end(), name) - m_names.begin());
+}
+
+void DerivedQuantities::Register(std::string const& pipelineName, std::shared_ptr<DerivedQuantities const> derivedQuantities)
+{
+	std::lock_guard<std::mutex> lock(s_mutex);
+	s_pipelineDerivedQuantities[pipelineName] = derivedQuantities;
+}
+
+std::shared_ptr<DerivedQuantities const> DerivedQuantities::Get(std::string const& pipelineName)
+{
+	std::lock_guard<std::mutex> lock(s_mutex);
+	std::map<std::string, std::shared_ptr<DerivedQuantities const> >::const_iterator derivedQuantities =
+			s_pipelineDerivedQuantities.find(pipelineName);
+	return ((derivedQuantities != s_pipelineDerivedQuantities.end()) ? derivedQuantities->second : nullptr);
+}
+
+void DerivedQuantitiesBuffer::Init(std::shared_ptr<DerivedQuantities const> derivedQuantities)
+{
+	m_derivedQuantities = derivedQuantities;
+	m_inputColumns.assign((m_derivedQuantities ? m_derivedQuantities->m_inputVariables.size() : 0), std::vector<double>());
+	m_nBufferedEntries = 0;
+	m_values.assign(GetNQuantities(), std::vector<double>());
+}
+
+void DerivedQuantitiesBuffer::BufferInputs(EventBase const& event, ProductBase const& product)
+{
+	for (size_t inputIndex = 0; inputIndex < m_inputColumns.size(); ++inputIndex)
+	{
+		size_t variableIndex = m_derivedQuantities->m_inputVariables[inputIndex];
+		m_inputColumns[inputIndex].push_back((*(m_derivedQuantities->m_variableExtractors))[variableIndex](event, product));
+	}
+	++m_nBufferedEntries;
+}
+
+size_t DerivedQuantitiesBuffer::EvaluateBuffer()
+{
+	if (! m_derivedQuantities)
+	{
+		m_nBufferedEntries = 0;
+		return 0;
+	}
+
+	DerivedQuantities const& derivedQuantities = *m_derivedQuantities;
+	size_t nEntries = m_nBufferedEntries;
+	for (std::vector<std::vector<double> >::iterator values = m_values.begin(); values != m_values.end(); ++values)
+	{
+		values->resize(nEntries);
+	}
+
+	// the derived quantities only depend on the inputs and on derived quantities evaluated before
+	std::vector<double const*> variableValues(derivedQuantities.m_variableNames.size(), nullptr);
+	for (size_t variableIndex = 0; variableIndex < variableValues.size(); ++variableIndex)
+	{
+		size_t column = derivedQuantities.m_variableColumns[variableIndex];
+		variableValues[variableIndex] = (derivedQuantities.m_variableIsDerived[variableIndex] ?
+		                                 m_values[column].data() : m_inputColumns[column].data());
+	}
+	for (size_t quantityIndex = 0; quantityIndex < derivedQuantities.m_expressions.size(); ++quantityIndex)
+	{
+		derivedQuantities.m_expressions[quantityIndex]->EvaluateBatch(variableValues, nEntries, m_values[quantityIndex].data());
+	}
+
+	for (std::vector<std::vector<double> >::iterator inputColumn = m_inputColumns.begin();
+	     inputColumn != m_inputColumns.end(); ++inputColumn)
+	{
+		inputColumn->clear();
+	}
+	m_nBufferedEntries = 0;
+	return nEntries;
+}
+
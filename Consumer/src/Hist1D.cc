@@ -52,7 +52,7 @@ void Hist1D::Store(TFile* pRootFile) {
 	LOG(INFO) << "Storing Histogram " << this->GetRootFileFolder() << "/" << this->GetName() << ".";
 
 	RootFileHelper::SafeCd(pRootFile, GetRootFileFolder());
-	m_hist->Write((this->GetName()).c_str());
+	m_hist->Write((this->GetName()).c_str(), TObject::kOverwrite);
 }
 
 void Hist1D::Fill(double val, double weight) {
@@ -1,35 +1,123 @@
+
+#include <unordered_map>
+
 #include "Artus/Consumer/interface/LambdaNtupleConsumer.h"
 
 
-std::map<std::string, std::function<bool(EventBase const&, ProductBase const& ) >> LambdaNtupleQuantities::CommonBoolQuantities
-	= std::map<std::string, std::function<bool(EventBase const&, ProductBase const& ) >>();
+LambdaNtupleQuantities::QuantityId LambdaNtupleQuantities::GetQuantityId(std::string const& name)
+{
+	static std::unordered_map<std::string, QuantityId> quantityIds;
+	std::lock_guard<std::mutex> lock(GetMutex());
+	return quantityIds.emplace(name, quantityIds.size()).first->second;
+}
 
-std::map<std::string, std::function<int(EventBase const&, ProductBase const& ) >> LambdaNtupleQuantities::CommonIntQuantities
-	= std::map<std::string, std::function<int(EventBase const&, ProductBase const& ) >>();
+LambdaNtupleQuantities::CommonQuantities<bool, LambdaNtupleQuantities::Type::Bool> LambdaNtupleQuantities::CommonBoolQuantities;
+LambdaNtupleQuantities::CommonQuantities<int, LambdaNtupleQuantities::Type::Int> LambdaNtupleQuantities::CommonIntQuantities;
+LambdaNtupleQuantities::CommonQuantities<uint64_t, LambdaNtupleQuantities::Type::UInt64> LambdaNtupleQuantities::CommonUInt64Quantities;
+LambdaNtupleQuantities::CommonQuantities<float, LambdaNtupleQuantities::Type::Float> LambdaNtupleQuantities::CommonFloatQuantities;
+LambdaNtupleQuantities::CommonQuantities<double, LambdaNtupleQuantities::Type::Double> LambdaNtupleQuantities::CommonDoubleQuantities;
+LambdaNtupleQuantities::CommonQuantities<std::string, LambdaNtupleQuantities::Type::String> LambdaNtupleQuantities::CommonStringQuantities;
+LambdaNtupleQuantities::CommonQuantities<std::vector<double>, LambdaNtupleQuantities::Type::VDouble> LambdaNtupleQuantities::CommonVDoubleQuantities;
+LambdaNtupleQuantities::CommonQuantities<std::vector<float>, LambdaNtupleQuantities::Type::VFloat> LambdaNtupleQuantities::CommonVFloatQuantities;
+LambdaNtupleQuantities::CommonQuantities<std::vector<std::string>, LambdaNtupleQuantities::Type::VString> LambdaNtupleQuantities::CommonVStringQuantities;
+LambdaNtupleQuantities::CommonQuantities<std::vector<int>, LambdaNtupleQuantities::Type::VInt> LambdaNtupleQuantities::CommonVIntQuantities;
 
-std::map<std::string, std::function<uint64_t(EventBase const&, ProductBase const& ) >> LambdaNtupleQuantities::CommonUInt64Quantities
-	= std::map<std::string, std::function<uint64_t(EventBase const&, ProductBase const& ) >>();
+LambdaNtupleQuantities::Registration LambdaNtupleQuantities::Find(std::string const& pipelineName, QuantityId quantityId)
+{
+	std::lock_guard<std::mutex> lock(GetMutex());
+	Registration registration = FindRegistration(&pipelineName, quantityId);
+	if (registration.type == Type::None)
+	{
+		registration = FindRegistration(nullptr, quantityId);
+	}
+	return registration;
+}
 
-std::map<std::string, std::function<float(EventBase const&, ProductBase const& ) >> LambdaNtupleQuantities::CommonFloatQuantities
-	= std::map<std::string, std::function<float(EventBase const&, ProductBase const& ) >>();
+LambdaNtupleQuantities::Registration LambdaNtupleQuantities::FindCommon(QuantityId quantityId)
+{
+	std::lock_guard<std::mutex> lock(GetMutex());
+	return FindRegistration(nullptr, quantityId);
+}
 
-std::map<std::string, std::function<double(EventBase const&, ProductBase const& ) >> LambdaNtupleQuantities::CommonDoubleQuantities
-	= std::map<std::string, std::function<double(EventBase const&, ProductBase const& ) >>();
+bool LambdaNtupleQuantities::HasQuantity(std::string const& pipelineName, std::string const& name, Type type)
+{
+	return (Find(pipelineName, GetQuantityId(name)).type == type);
+}
 
-std::map<std::string, std::function<std::string(EventBase const&, ProductBase const& ) >> LambdaNtupleQuantities::CommonStringQuantities
-	= std::map<std::string, std::function<std::string(EventBase const&, ProductBase const& ) >>();
+bool LambdaNtupleQuantities::IsRegistered(std::string const* pipelineName, QuantityId quantityId, Type type,
+                                          std::type_info const& origin)
+{
+	std::lock_guard<std::mutex> lock(GetMutex());
+	Registration registration = FindRegistration(pipelineName, quantityId);
+	return ((registration.type == type) && (registration.origin != nullptr) && (*(registration.origin) == origin));
+}
 
-std::map<std::string, std::function<std::vector<double>(EventBase const&, ProductBase const& ) >> LambdaNtupleQuantities::CommonVDoubleQuantities
-	= std::map<std::string, std::function<std::vector<double>(EventBase const&, ProductBase const& ) >>();
+LambdaNtupleQuantities::Extractor<double>::type LambdaNtupleQuantities::GetNumericExtractor(Registration const& registration)
+{
+	switch (registration.type)
+	{
+	case Type::Bool:
+		return GetExtractor<bool>(registration.index);
+	case Type::Int:
+		return GetExtractor<int>(registration.index);
+	case Type::UInt64:
+		return GetExtractor<uint64_t>(registration.index);
+	case Type::Float:
+		return GetExtractor<float>(registration.index);
+	case Type::Double:
+		return GetExtractor<double>(registration.index);
+	case Type::None:
+	case Type::String:
+	case Type::VDouble:
+	case Type::VFloat:
+	case Type::VString:
+	case Type::VInt:
+	default:
+		// no numeric quantity
+		return Extractor<double>::type();
+	}
+}
 
-std::map<std::string, std::function<std::vector<float>(EventBase const&, ProductBase const& ) >> LambdaNtupleQuantities::CommonVFloatQuantities
-	= std::map<std::string, std::function<std::vector<float>(EventBase const&, ProductBase const& ) >>();
+LambdaNtupleQuantities::Registration LambdaNtupleQuantities::FindRegistration(std::string const* pipelineName, QuantityId quantityId)
+{
+	Registrations const* registrations = &GetCommonRegistrations();
+	if (pipelineName != nullptr)
+	{
+		std::map<std::string, Registrations>::const_iterator pipelineRegistrations = GetPipelineRegistrations().find(*pipelineName);
+		if (pipelineRegistrations == GetPipelineRegistrations().end())
+		{
+			return Registration();
+		}
+		registrations = &(pipelineRegistrations->second);
+	}
+	return ((quantityId < registrations->size()) ? (*registrations)[quantityId] : Registration());
+}
 
-std::map<std::string, std::function<std::vector<std::string>(EventBase const&, ProductBase const& ) >> LambdaNtupleQuantities::CommonVStringQuantities
-	= std::map<std::string, std::function<std::vector<std::string>(EventBase const&, ProductBase const& ) >>();
+LambdaNtupleQuantities::Registration & LambdaNtupleQuantities::GetRegistration(std::string const* pipelineName, QuantityId quantityId)
+{
+	Registrations & registrations = ((pipelineName == nullptr) ? GetCommonRegistrations() : GetPipelineRegistrations()[*pipelineName]);
+	if (registrations.size() <= quantityId)
+	{
+		registrations.resize(quantityId + 1);
+	}
+	return registrations[quantityId];
+}
 
-std::map<std::string, std::function<std::vector<int>(EventBase const&, ProductBase const& ) >> LambdaNtupleQuantities::CommonVIntQuantities
-	= std::map<std::string, std::function<std::vector<int>(EventBase const&, ProductBase const& ) >>();
+LambdaNtupleQuantities::Registrations & LambdaNtupleQuantities::GetCommonRegistrations()
+{
+	static Registrations commonRegistrations;
+	return commonRegistrations;
+}
 
+std::map<std::string, LambdaNtupleQuantities::Registrations> & LambdaNtupleQuantities::GetPipelineRegistrations()
+{
+	static std::map<std::string, Registrations> pipelineRegistrations;
+	return pipelineRegistrations;
+}
 
+std::mutex & LambdaNtupleQuantities::GetMutex()
+{
+	static std::mutex mutex;
+	return mutex;
+}
 
@@ -14,7 +14,7 @@ void Profile2d::Init() {
 
 void Profile2d::Store(TFile * pRootFile) {
 	RootFileHelper::SafeCd(pRootFile, GetRootFileFolder());
-	m_profile->Write(GetName().c_str());
+	m_profile->Write(GetName().c_str(), TObject::kOverwrite);
 }
 
 void Profile2d::AddPoint(double x, double y, double weight) {
@@ -0,0 +1,141 @@
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+#include "Artus/Utility/interface/ArtusLogging.h"
+
+/**
+   \brief State of an interrupted event loop which allows to resume the processing.
+
+   The PipelineRunner stores the index of the next event to process, the accumulated run time
+   and a fingerprint of the configuration and the input. All consumers of the level one pipelines
+   can add their state (histogram contents, cut flows, number of ntuple entries flushed to the
+   output file, ...) in ConsumerBase::SaveCheckpoint and read it back in
+   ConsumerBase::RestoreCheckpoint.
+
+   The state is stored as JSON in a sidecar file next to the output file. Keys are paths
+   separated by '/', use GetKey to create unique keys per pipeline and consumer.
+ */
+class Checkpoint: public boost::noncopyable {
+public:
+
+	explicit Checkpoint(std::string const& fileName);
+
+	std::string const& GetFileName() const;
+
+	// checkpointing is disabled if no file name is configured
+	bool IsEnabled() const;
+	bool Exists() const;
+
+	// fails if the file cannot be parsed
+	void Read();
+	// the file is replaced atomically, a job killed while writing keeps the previous checkpoint
+	void Write() const;
+	void Remove() const;
+
+	long long GetNextEvent() const;
+	void SetNextEvent(long long nextEvent);
+
+	// accumulated run time of the event loop in seconds
+	double GetRunTime() const;
+	void SetRunTime(double runTime);
+
+	std::string GetFingerprint() const;
+	void SetFingerprint(std::string const& fingerprint);
+
+	static std::string GetKey(std::string const& pipelineName, std::string const& consumerId,
+	                          std::string const& name);
+
+	bool Has(std::string const& key) const;
+
+	template<class T>
+	void SetValue(std::string const& key, T const& value)
+	{
+		m_state.put(GetPath(key), value);
+	}
+
+	template<class T>
+	T GetValue(std::string const& key, T const& defaultValue) const
+	{
+		return m_state.get(GetPath(key), defaultValue);
+	}
+
+	template<class T>
+	void SetList(std::string const& key, std::vector<T> const& values)
+	{
+		boost::property_tree::ptree list;
+		for (typename std::vector<T>::const_iterator value = values.begin(); value != values.end(); ++value)
+		{
+			boost::property_tree::ptree entry;
+			entry.put_value(*value);
+			list.push_back(std::make_pair("", entry));
+		}
+		m_state.put_child(GetPath(key), list);
+	}
+
+	template<class T>
+	std::vector<T> GetList(std::string const& key) const
+	{
+		std::vector<T> values;
+		boost::optional<boost::property_tree::ptree const&> list = m_state.get_child_optional(GetPath(key));
+		if (list)
+		{
+			for (boost::property_tree::ptree::const_iterator entry = list->begin(); entry != list->end(); ++entry)
+			{
+				values.push_back(entry->second.get_value<T>());
+			}
+		}
+		return values;
+	}
+
+	// store bin contents and errors of a one dimensional histogram including under- and overflow
+	template<class THist>
+	void SetHistogram(std::string const& key, THist const& histogram)
+	{
+		std::vector<double> contents;
+		std::vector<double> errors;
+		for (int bin = 0; bin <= histogram.GetNbinsX() + 1; ++bin)
+		{
+			contents.push_back(histogram.GetBinContent(bin));
+			errors.push_back(histogram.GetBinError(bin));
+		}
+		SetList(key + "/contents", contents);
+		SetList(key + "/errors", errors);
+		SetValue(key + "/entries", histogram.GetEntries());
+	}
+
+	// returns false if no histogram has been stored with this key
+	template<class THist>
+	bool GetHistogram(std::string const& key, THist & histogram) const
+	{
+		std::vector<double> contents = GetList<double>(key + "/contents");
+		std::vector<double> errors = GetList<double>(key + "/errors");
+		if (contents.empty())
+		{
+			return false;
+		}
+		if ((static_cast<int>(contents.size()) != histogram.GetNbinsX() + 2) || (errors.size() != contents.size()))
+		{
+			LOG(FATAL) << "Binning of histogram \"" << key << "\" does not match the checkpoint!";
+		}
+		for (size_t bin = 0; bin < contents.size(); ++bin)
+		{
+			histogram.SetBinContent(static_cast<int>(bin), contents[bin]);
+			histogram.SetBinError(static_cast<int>(bin), errors[bin]);
+		}
+		histogram.SetEntries(GetValue(key + "/entries", 0.0));
+		return true;
+	}
+
+private:
+
+	static boost::property_tree::ptree::path_type GetPath(std::string const& key);
+
+	std::string m_fileName;
+	boost::property_tree::ptree m_state;
+};
@@ -12,6 +12,7 @@
 #include <boost/ptr_container/ptr_vector.hpp>
 
 #include "FilterBase.h"
+#include "Checkpoint.h"
 #include "ProductBase.h"
 #include "FilterResult.h"
 #include "EventBase.h"
@@ -43,6 +44,15 @@ public:
 	 */
 	virtual std::string GetConsumerId() const = 0;
 
+	/*
+	 * Must return true if SaveCheckpoint and RestoreCheckpoint cover the complete state of the
+	 * Consumer, or if the Consumer has no state. Level one pipelines with consumers without
+	 * checkpoint support cannot be initialised if checkpoints are enabled.
+	 */
+	virtual bool SupportsCheckpoints() const {
+		return false;
+	}
+
 protected:
 	// will be implemented by the ConsumerBase class
 	virtual void baseProcess( SettingsBase const& setting ) = 0;
@@ -53,6 +63,10 @@ protected:
 	                                      SettingsBase const& setting) = 0;
 	virtual void baseInit ( SettingsBase const& settings ) = 0;
 	virtual void baseFinish ( SettingsBase const& settings ) = 0;
+	virtual void baseSaveCheckpoint ( SettingsBase const& settings, Checkpoint & checkpoint ) = 0;
+	virtual void baseRestoreCheckpoint ( SettingsBase const& settings, Checkpoint const& checkpoint ) = 0;
+	virtual void baseSaveWorkerState ( SettingsBase const& settings, Checkpoint & workerState ) = 0;
+	virtual void baseMergeWorkerState ( SettingsBase const& settings, Checkpoint const& workerState ) = 0;
 };
 
 class ConsumerBaseAccess {
@@ -79,6 +93,22 @@ public:
 		m_cb.baseFinish( settings );
 	}
 
+	void SaveCheckpoint ( SettingsBase const& settings, Checkpoint & checkpoint ) {
+		m_cb.baseSaveCheckpoint( settings, checkpoint );
+	}
+
+	void RestoreCheckpoint ( SettingsBase const& settings, Checkpoint const& checkpoint ) {
+		m_cb.baseRestoreCheckpoint( settings, checkpoint );
+	}
+
+	void SaveWorkerState ( SettingsBase const& settings, Checkpoint & workerState ) {
+		m_cb.baseSaveWorkerState( settings, workerState );
+	}
+
+	void MergeWorkerState ( SettingsBase const& settings, Checkpoint const& workerState ) {
+		m_cb.baseMergeWorkerState( settings, workerState );
+	}
+
 private:
 	ConsumerBaseUntemplated & m_cb;
 };
@@ -131,6 +161,29 @@ public:
 	 */
 	virtual void Finish(setting_type const& setting) = 0;
 
+	/*
+	 * Called when the event loop writes a checkpoint. Overwrite this to add the state
+	 * accumulated so far, which is needed to resume the processing
+	 */
+	virtual void SaveCheckpoint(setting_type const& setting, Checkpoint & checkpoint) {}
+
+	/*
+	 * Called after Init when the event loop resumes from a checkpoint
+	 */
+	virtual void RestoreCheckpoint(setting_type const& setting, Checkpoint const& checkpoint) {}
+
+	/*
+	 * Called at the end of a forked worker process. Overwrite this to add the state which is
+	 * not stored as object in the output file, e.g. counters
+	 */
+	virtual void SaveWorkerState(setting_type const& setting, Checkpoint & workerState) {}
+
+	/*
+	 * Called in the parent process with the state saved by every forked worker, before Finish.
+	 * Overwrite this to add the state of the worker to the state of this consumer
+	 */
+	virtual void MergeWorkerState(setting_type const& setting, Checkpoint const& workerState) {}
+
 	/*
 	 * Return a reference to the settings used for this consumer
 	 */
@@ -184,4 +237,28 @@ protected:
 
 		this->Finish ( specSettings );
 	}
+
+	void baseSaveCheckpoint (SettingsBase const& settings, Checkpoint & checkpoint) override {
+		auto const& specSettings = static_cast < setting_type const&> ( settings );
+
+		this->SaveCheckpoint ( specSettings, checkpoint );
+	}
+
+	void baseRestoreCheckpoint (SettingsBase const& settings, Checkpoint const& checkpoint) override {
+		auto const& specSettings = static_cast < setting_type const&> ( settings );
+
+		this->RestoreCheckpoint ( specSettings, checkpoint );
+	}
+
+	void baseSaveWorkerState (SettingsBase const& settings, Checkpoint & workerState) override {
+		auto const& specSettings = static_cast < setting_type const&> ( settings );
+
+		this->SaveWorkerState ( specSettings, workerState );
+	}
+
+	void baseMergeWorkerState (SettingsBase const& settings, Checkpoint const& workerState) override {
+		auto const& specSettings = static_cast < setting_type const&> ( settings );
+
+		this->MergeWorkerState ( specSettings, workerState );
+	}
 };
@@ -38,6 +38,16 @@ public:
 		return m_overallEventCount;
 	}
 
+	// restore the counts, e.g. from a checkpoint
+	void SetCutCount(CutCount const& cutCount, long eventCount)
+	{
+		m_cutCount = cutCount;
+		m_overallEventCount = eventCount;
+	}
+
+	// add the counts of another cut flow, e.g. of a forked worker process
+	void AddCutCount(CutCount const& cutCount, long eventCount);
+
 	std::string ToString() const;
 
 private:
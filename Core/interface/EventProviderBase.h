@@ -6,8 +6,13 @@
 
 #pragma once
 
+#include <algorithm>
+#include <vector>
+
 #include <boost/noncopyable.hpp>
 
+#include "WorkUnitScheduler.h"
+
 template<class TTypes>
 class EventProviderBase: public boost::noncopyable {
 public:
@@ -21,4 +26,23 @@ public:
 	virtual bool GetEntry(long long lEventNumber) = 0;
 
 	virtual long long GetEntries() const = 0;
+
+	// split the entries into work units which are distributed to parallel workers
+	// providers reading from trees should align the units to the clusters of the input files
+	virtual std::vector<WorkUnit> GetWorkUnits(long long firstEntry, long long endEntry) const
+	{
+		return WorkUnitScheduler::GetWorkUnits(firstEntry, endEntry, std::max((endEntry - firstEntry) / 100, 1ll));
+	}
+
+	// called in forked worker processes before the first entry is read
+	// the files opened by the parent process have to be opened again, otherwise all workers share
+	// the same file offset and read from wrong positions
+	virtual void ReopenInput()
+	{
+	}
+
+	// called before the first entry of a work unit is read, e.g. to prefetch its entries
+	virtual void PrepareWorkUnit(WorkUnit const& workUnit)
+	{
+	}
 };
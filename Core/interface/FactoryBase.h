@@ -28,7 +28,8 @@ public:
 	virtual ~FactoryBase() {
 	}
 
-	// these virtual methods offer no default objects, so far
+	// these virtual methods offer no default objects, since the processors depend on the types
+	// of the analysis, which query the ProcessorRegistry for their types
 	virtual ProducerBaseUntemplated * createProducer ( std::string const& id ) {
 		return nullptr;
 	}
@@ -38,10 +39,7 @@ public:
 	}
 
 	virtual ConsumerBaseUntemplated * createConsumer ( std::string const& id ) {
-		/*if(id == CutFlowHistogramConsumer<TTypes>().GetConsumerId())
-			return new CutFlowHistogramConsumer<TTypes>();
-		else*/
-			return nullptr;
+		return nullptr;
 	}
 
 };
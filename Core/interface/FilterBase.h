@@ -8,9 +8,12 @@
 
 #include <boost/noncopyable.hpp>
 
+#include <algorithm>
 #include <map>
 #include <sstream>
+#include <vector>
 
+#include "Artus/Core/interface/FilterResult.h"
 #include "Artus/Core/interface/ProcessNodeBase.h"
 #include "Artus/Utility/interface/ArtusLogging.h"
 
@@ -34,11 +37,36 @@ public:
 	 */
 	virtual std::string GetFilterId() const = 0;
 
+	/*
+	 * Filters combining several cuts can report the single cuts to the cut flow. The cuts are
+	 * applied in the order of their names and the evaluation stops at the first failing cut.
+	 * Their decisions are added to the filter result as "<filter id>:<cut name>" right after
+	 * the decision of the filter itself. The names have to be known after Init.
+	 * Filters with cuts never share their decision with other pipelines.
+	 */
+	virtual std::vector<std::string> const& GetCutNames() const
+	{
+		static const std::vector<std::string> noCutNames;
+		return noCutNames;
+	}
+
+	// number of cuts passed in the last call of DoesEventPass
+	virtual size_t GetNPassedCuts() const
+	{
+		return 0;
+	}
+
+	static std::string GetCutDecisionName(std::string const& filterId, std::string const& cutName)
+	{
+		return filterId + ":" + cutName;
+	}
+
 protected:
 
 	virtual bool baseDoesEventPass(EventBase const& event,
 			ProductBase const& product, SettingsBase const& settings) const = 0;
 	virtual void baseInit ( SettingsBase const& settings ) = 0;
+	virtual std::string baseGetFingerprint ( SettingsBase const& settings ) const = 0;
 
 };
 
@@ -57,6 +85,53 @@ public:
 		m_cb.baseInit( settings );
 	}
 
+	std::string GetFingerprint ( SettingsBase const& settings ) const
+	{
+		// the decisions of the single cuts are only known to the filter evaluating them
+		if (! m_cb.GetCutNames().empty())
+			return "";
+
+		return m_cb.baseGetFingerprint( settings );
+	}
+
+	// insert the names of the cut decisions after the name of the filter,
+	// the cuts of tagging filters are tagging as well
+	void AddCutDecisionNames ( std::vector<std::string> & filterNames,
+	                           std::vector<std::string> & taggingFilters ) const
+	{
+		const std::string filterId = m_cb.GetFilterId();
+		std::vector<std::string> cutDecisionNames;
+		for (std::string const& cutName : m_cb.GetCutNames()) {
+			cutDecisionNames.push_back(FilterBaseUntemplated::GetCutDecisionName(filterId, cutName));
+		}
+		if (cutDecisionNames.empty())
+			return;
+
+		std::vector<std::string>::iterator filterName = std::find(filterNames.begin(), filterNames.end(), filterId);
+		if (filterName == filterNames.end())
+			filterName = filterNames.insert(filterNames.end(), filterId);
+		filterNames.insert(filterName + 1, cutDecisionNames.begin(), cutDecisionNames.end());
+
+		if (std::find(taggingFilters.begin(), taggingFilters.end(), filterId) != taggingFilters.end())
+			taggingFilters.insert(taggingFilters.end(), cutDecisionNames.begin(), cutDecisionNames.end());
+	}
+
+	// decisions of the cuts evaluated in the last call of DoesEventPass,
+	// the cuts after the first failing one stay undefined
+	void SetCutDecisions ( FilterResult & filterResult ) const
+	{
+		std::vector<std::string> const& cutNames = m_cb.GetCutNames();
+		if (cutNames.empty())
+			return;
+
+		const std::string filterId = m_cb.GetFilterId();
+		const size_t nPassedCuts = m_cb.GetNPassedCuts();
+		for (size_t cut = 0; (cut < cutNames.size()) && (cut <= nPassedCuts); ++cut) {
+			filterResult.SetFilterDecision(FilterBaseUntemplated::GetCutDecisionName(filterId, cutNames[cut]),
+			                               cut < nPassedCuts);
+		}
+	}
+
 private:
 	FilterBaseUntemplated & m_cb;
 };
@@ -86,6 +161,19 @@ public:
 		return false;
 	}
 
+	/*
+	 * Fingerprint of everything the decision depends on apart from the event and the product,
+	 * e.g. the filter id and the values of the settings used. Filters with the same non-empty
+	 * fingerprint must take the same decision on the same input, which allows pipelines to
+	 * share the decision as long as no local producer has modified the product before.
+	 * Filters reading product.PreviousPipelinesResult must not be shared.
+	 * An empty fingerprint (default) disables the sharing.
+	 */
+	virtual std::string GetFingerprint(setting_type const& settings) const
+	{
+		return "";
+	}
+
 	virtual std::string ToString(bool bVerbose = false) {
 		return GetFilterId();
 	}
@@ -112,4 +200,10 @@ protected:
 
 		this->Init ( specSettings );
 	}
+
+	std::string baseGetFingerprint (SettingsBase const& settings) const override {
+		auto const& specSettings = static_cast < setting_type const&> ( settings );
+
+		return this->GetFingerprint ( specSettings );
+	}
 };
@@ -0,0 +1,46 @@
+
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+/**
+   \brief Per-event storage of filter decisions which can be shared between pipelines.
+
+   Filters publish a fingerprint of the settings they depend on (see FilterBase::GetFingerprint).
+   Each distinct fingerprint is registered once and gets a slot in this cache. As long as the
+   filter runs before any local producer of a pipeline, its input is identical to the global
+   product and the decision stored in the slot can be reused by all other pipelines.
+
+   The PipelineRunner owns one instance and calls NewEvent before the pipelines are run.
+ */
+class FilterDecisionCache: public boost::noncopyable {
+public:
+
+	typedef size_t SlotIndex;
+
+	FilterDecisionCache();
+
+	// returns the slot for this fingerprint, registers a new slot if needed
+	SlotIndex RegisterFingerprint(std::string const& fingerprint);
+
+	size_t GetNumberOfSlots() const;
+
+	// invalidates all stored decisions
+	void NewEvent();
+
+	bool HasDecision(SlotIndex slot) const;
+	bool GetDecision(SlotIndex slot) const;
+	void SetDecision(SlotIndex slot, bool passed);
+
+private:
+	std::map<std::string, SlotIndex> m_slots;
+
+	// a decision is valid only if it has been stored in the current event
+	std::vector<unsigned long long> m_slotEvent;
+	std::vector<bool> m_decisions;
+	unsigned long long m_currentEvent;
+};
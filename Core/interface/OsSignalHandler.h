@@ -12,9 +12,19 @@ void osRegisterHandler();
 // unregister installed signals
 void osUnregisterHandler();
 
+// registering the handler for SIGTERM and SIGUSR1, only used if checkpoints are enabled
+void osRegisterCheckpointHandler();
+
+// unregister the handler for SIGTERM and SIGUSR1
+void osUnregisterCheckpointHandler();
+
 // call this to query whether the SIGINT signal was raised
 bool osHasSIGINT();
 
+// call this to query whether SIGTERM or SIGUSR1 was raised, which requests
+// to write a checkpoint (if enabled) and to stop the processing
+bool osHasCheckpointRequest();
+
 // signal handler called by the OS
 void osSignalHandler(int signum);
 
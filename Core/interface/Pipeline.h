@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <mutex>
 #include <vector>
 #include <sstream>
 #include <time.h>
@@ -14,9 +15,11 @@
 #include <boost/ptr_container/ptr_vector.hpp>
 
 #include "Artus/Utility/interface/Collections.h"
+#include "Artus/Utility/interface/RootFileHelper.h"
 
 #include "PipelineSettings.h"
 #include "FilterBase.h"
+#include "FilterDecisionCache.h"
 #include "ConsumerBase.h"
 #include "ProducerBase.h"
 
@@ -95,13 +98,16 @@ public:
 	typedef boost::ptr_vector< ProcessNodeBase > ProcessNodeVector;
 	typedef typename ProcessNodeVector::iterator ProcessNodeIterator;
 
+	Pipeline() : m_filterDecisionCache(nullptr), m_isInitialized(false) {
+	}
+
 	/// Virtual constructor.
 	virtual ~Pipeline() {
 	}
 
 	/// Initialize the pipeline using a custom PipelineInitilizer. This PipelineInitilizerBase 
 	/// can create specific Filters and Consumers
-	virtual void InitPipeline(setting_type pset,
+	virtual void InitPipeline(setting_type const& pset,
 			PipelineInitilizerBase<TTypes> const& initializer) {
 
 		LOG(DEBUG) << "";
@@ -125,13 +131,51 @@ public:
 		}
 
 		// init Consumers
-		for (auto & it : m_consumer) {
-			ConsumerBaseAccess(it).Init( pset );
+		// they create their output objects in the current ROOT directory, which is shared with
+		// pipelines initialised in parallel
+		{
+			std::lock_guard<std::recursive_mutex> lock(RootFileHelper::GetRootMutex());
+			for (auto & it : m_consumer) {
+				ConsumerBaseAccess(it).Init( pset );
+			}
+		}
+
+		// consumers without checkpoint support would silently lose their state when resuming
+		if ((pset.GetLevel() == 1) && (! pset.GetCheckpointFile().empty())) {
+			std::vector<std::string> consumerIds = GetConsumersWithoutCheckpoints();
+			if (! consumerIds.empty()) {
+				LOG(FATAL) << "Checkpoints are enabled, but the consumer \"" << consumerIds.front()
+				           << "\" of pipeline \"" << pset.GetName() << "\" does not support them!";
+			}
 		}
 
 		// store the filter names for later use in RunEvent
 		m_filterNames = pset.GetFilters();
 		m_taggingFilters = pset.GetTaggingFilters();
+		for (ProcessNodeIterator it = m_nodes.begin(); it != m_nodes.end(); ++it) {
+			if (it->GetProcessNodeType () == ProcessNodeType::Filter) {
+				FilterBaseAccess( static_cast< FilterForThisPipeline &> ( *it ) )
+						. AddCutDecisionNames ( m_filterNames, m_taggingFilters );
+			}
+		}
+
+		m_isInitialized = true;
+		RegisterSharedFilters();
+
+		// all settings needed in the event loop are read once here
+		m_pipelineSettings.Freeze();
+	}
+
+	/// Set the cache used to share filter decisions with other pipelines. The cache is owned by
+	/// the caller, usually the PipelineRunner. Pass nullptr to disable the sharing.
+	virtual void SetFilterDecisionCache(FilterDecisionCache * filterDecisionCache) {
+		m_filterDecisionCache = filterDecisionCache;
+		RegisterSharedFilters();
+	}
+
+	/// Redirect the output of all consumers to another file, e.g. in forked worker processes.
+	virtual void SetRootOutFile(TFile * rootOutFile) {
+		m_pipelineSettings.SetRootOutFile(rootOutFile);
 	}
 
 	/// Useful debug output of the Pipeline Content.
@@ -157,6 +201,45 @@ public:
 		}
 	}
 
+	/// Add the state of all consumers to the checkpoint.
+	virtual void SaveCheckpoint(Checkpoint & checkpoint) {
+		for (auto & it : m_consumer) {
+			ConsumerBaseAccess( it ).SaveCheckpoint( GetSettings(), checkpoint );
+		}
+	}
+
+	/// Ids of all consumers, which do not support checkpoints.
+	virtual std::vector<std::string> GetConsumersWithoutCheckpoints() const {
+		std::vector<std::string> consumerIds;
+		for (auto const& it : m_consumer) {
+			if (! it.SupportsCheckpoints()) {
+				consumerIds.push_back(it.GetConsumerId());
+			}
+		}
+		return consumerIds;
+	}
+
+	/// Restore the state of all consumers from the checkpoint.
+	virtual void RestoreCheckpoint(Checkpoint const& checkpoint) {
+		for (auto & it : m_consumer) {
+			ConsumerBaseAccess( it ).RestoreCheckpoint( GetSettings(), checkpoint );
+		}
+	}
+
+	/// Add the state of all consumers, which is not stored in the output file, at the end of a forked worker.
+	virtual void SaveWorkerState(Checkpoint & workerState) {
+		for (auto & it : m_consumer) {
+			ConsumerBaseAccess( it ).SaveWorkerState( GetSettings(), workerState );
+		}
+	}
+
+	/// Merge the state saved by a forked worker into all consumers.
+	virtual void MergeWorkerState(Checkpoint const& workerState) {
+		for (auto & it : m_consumer) {
+			ConsumerBaseAccess( it ).MergeWorkerState( GetSettings(), workerState );
+		}
+	}
+
 	/// Run the pipeline without specific event input. This is most useful for Pipelines which 
 	/// process output from Pipelines already run.
 	virtual void Run() {
@@ -178,7 +261,8 @@ public:
 		localFilterResult.AddFilterNames( m_filterNames, m_taggingFilters );
 
 		// run Filters & Producers
-		for (ProcessNodeIterator it = m_nodes.begin(); it != m_nodes.end(); ++it) {
+		size_t nodeIndex = 0;
+		for (ProcessNodeIterator it = m_nodes.begin(); it != m_nodes.end(); ++it, ++nodeIndex) {
 
 			// variables for runtime measurement
 			timeval tStart, tEnd;
@@ -204,8 +288,23 @@ public:
 				FilterForThisPipeline & flt = static_cast<FilterForThisPipeline&>(*it);
 				//LOG(DEBUG) << flt.GetFilterId() << "::DoesEventPass (pipeline: " << m_pipelineSettings.GetName() << ")";
 				gettimeofday(&tStart, nullptr);
-				const bool filterResult = FilterBaseAccess(flt).DoesEventPass(evt, localProduct, m_pipelineSettings);
+				bool filterResult = false;
+				if ((nodeIndex < m_sharedFilterSlots.size()) && m_sharedFilterSlots[nodeIndex].first) {
+					// decision can be shared with other pipelines
+					const FilterDecisionCache::SlotIndex slot = m_sharedFilterSlots[nodeIndex].second;
+					if (m_filterDecisionCache->HasDecision(slot)) {
+						filterResult = m_filterDecisionCache->GetDecision(slot);
+					}
+					else {
+						filterResult = FilterBaseAccess(flt).DoesEventPass(evt, localProduct, m_pipelineSettings);
+						m_filterDecisionCache->SetDecision(slot, filterResult);
+					}
+				}
+				else {
+					filterResult = FilterBaseAccess(flt).DoesEventPass(evt, localProduct, m_pipelineSettings);
+				}
 				localFilterResult.SetFilterDecision(flt.GetFilterId(), filterResult);
+				FilterBaseAccess(flt).SetCutDecisions(localFilterResult);
 				gettimeofday(&tEnd, nullptr);
 				runTime = static_cast<int>(tEnd.tv_sec * 1000000 + tEnd.tv_usec - tStart.tv_sec * 1000000 - tStart.tv_usec);  // a long int might be needed here but SafeMaps for long ints are not yet working
 				localProduct.processorRunTime[flt.GetFilterId()] = runTime;
@@ -277,10 +376,38 @@ public:
 	}*/
 
 private:
+
+	// Assign cache slots to all filters which run before the first local producer and
+	// therefore see an unmodified copy of the global product.
+	void RegisterSharedFilters() {
+		m_sharedFilterSlots.assign(m_nodes.size(), std::make_pair(false, FilterDecisionCache::SlotIndex(0)));
+		if ((m_filterDecisionCache == nullptr) || (! m_isInitialized))
+			return;
+
+		size_t nodeIndex = 0;
+		for (ProcessNodeIterator it = m_nodes.begin(); it != m_nodes.end(); ++it, ++nodeIndex) {
+			if (it->GetProcessNodeType() == ProcessNodeType::Producer)
+				break;
+
+			if (it->GetProcessNodeType() == ProcessNodeType::Filter) {
+				FilterForThisPipeline & flt = static_cast<FilterForThisPipeline&>(*it);
+				std::string fingerprint = FilterBaseAccess(flt).GetFingerprint(m_pipelineSettings);
+				if (! fingerprint.empty()) {
+					m_sharedFilterSlots[nodeIndex] = std::make_pair(true, m_filterDecisionCache->RegisterFingerprint(fingerprint));
+				}
+			}
+		}
+	}
+
 	ConsumerVector m_consumer;
 	ProcessNodeVector m_nodes;
 	setting_type m_pipelineSettings;
 	stringvector m_filterNames;
 	stringvector m_taggingFilters;
+
+	FilterDecisionCache * m_filterDecisionCache;
+	bool m_isInitialized;
+	// for each node: is the decision shared and which slot of the cache is used
+	std::vector<std::pair<bool, FilterDecisionCache::SlotIndex> > m_sharedFilterSlots;
 };
 
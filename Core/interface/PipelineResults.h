@@ -0,0 +1,114 @@
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <typeindex>
+#include <typeinfo>
+#include <utility>
+
+#include "Artus/Utility/interface/ArtusLogging.h"
+
+/**
+   \brief Keyed in-memory registry to hand over finished results between pipeline levels.
+
+   Consumers of level one pipelines register their finished objects (histograms, cut flows,
+   trees, ...) in their Finish method. Consumers of pipelines with a higher level can read them
+   in their Process method directly instead of re-reading them from the output file.
+
+   Objects are identified by the name of the registering pipeline and an object name.
+   Registered objects are either owned by the registry (std::shared_ptr) or only borrowed
+   (raw pointer), e.g. for histograms owned by the output file. The PipelineRunner clears the
+   registry at the end of RunPipelines, therefore borrowed objects have to stay alive until then.
+
+   All methods can be called concurrently from pipelines running in parallel.
+ */
+class PipelineResults {
+public:
+
+	// register an object owned by the registry, existing entries are replaced
+	template<class T>
+	static void Register(std::string const& pipelineName, std::string const& objectName,
+	                     std::shared_ptr<T> object)
+	{
+		std::lock_guard<std::mutex> lock(s_mutex);
+		s_entries[Key(pipelineName, objectName)] = Entry(std::shared_ptr<void>(object), std::type_index(typeid(T)));
+	}
+
+	// register an object which is not owned by the registry, existing entries are replaced
+	template<class T>
+	static void Register(std::string const& pipelineName, std::string const& objectName,
+	                     T * object)
+	{
+		Register(pipelineName, objectName, std::shared_ptr<T>(object, [](T*) {}));
+	}
+
+	static bool Has(std::string const& pipelineName, std::string const& objectName);
+
+	// get a registered object, fails if it is not available or of a different type
+	template<class T>
+	static std::shared_ptr<T> Get(std::string const& pipelineName, std::string const& objectName)
+	{
+		std::shared_ptr<T> object = GetWithDefault<T>(pipelineName, objectName);
+		if (! object)
+		{
+			LOG(FATAL) << "Result \"" << objectName << "\" of pipeline \"" << pipelineName << "\" has not been registered!";
+		}
+		return object;
+	}
+
+	// get a registered object, returns an empty pointer if it is not available
+	template<class T>
+	static std::shared_ptr<T> GetWithDefault(std::string const& pipelineName, std::string const& objectName)
+	{
+		std::lock_guard<std::mutex> lock(s_mutex);
+		std::map<Key, Entry>::const_iterator entry = s_entries.find(Key(pipelineName, objectName));
+		if (entry == s_entries.end())
+		{
+			return std::shared_ptr<T>();
+		}
+		if (entry->second.type != std::type_index(typeid(T)))
+		{
+			LOG(FATAL) << "Result \"" << objectName << "\" of pipeline \"" << pipelineName << "\" is requested with the wrong type!";
+		}
+		return std::static_pointer_cast<T>(entry->second.object);
+	}
+
+	// get the objects with the given name from all pipelines, key is the pipeline name
+	template<class T>
+	static std::map<std::string, std::shared_ptr<T> > GetAll(std::string const& objectName)
+	{
+		std::map<std::string, std::shared_ptr<T> > objects;
+		std::lock_guard<std::mutex> lock(s_mutex);
+		for (std::map<Key, Entry>::const_iterator entry = s_entries.begin();
+		     entry != s_entries.end(); ++entry)
+		{
+			if ((entry->first.second == objectName) &&
+			    (entry->second.type == std::type_index(typeid(T))))
+			{
+				objects[entry->first.first] = std::static_pointer_cast<T>(entry->second.object);
+			}
+		}
+		return objects;
+	}
+
+	static void Clear();
+
+private:
+
+	struct Entry
+	{
+		std::shared_ptr<void> object;
+		std::type_index type;
+		Entry() : type(typeid(void)) {}
+		Entry(std::shared_ptr<void> object, std::type_index type) : object(object), type(type) {}
+	};
+
+	// pipeline name and object name, both may contain arbitrary characters
+	typedef std::pair<std::string, std::string> Key;
+
+	static std::map<Key, Entry> s_entries;
+	static std::mutex s_mutex;
+};
@@ -6,22 +6,39 @@
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <sstream>
 #include <thread>
 #include <vector>
 #include <algorithm>
 #include <unistd.h>
+#include <sys/wait.h>
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <iostream>
 #include <map>
 #include <sys/time.h>
 
 #include <boost/noncopyable.hpp>
 #include <boost/ptr_container/ptr_list.hpp>
+#include <boost/property_tree/json_parser.hpp>
+
+#include <TROOT.h>
 
 #include "Pipeline.h"
 #include "EventProviderBase.h"
 #include "ProgressReport.h"
 #include "FilterResult.h"
+#include "Checkpoint.h"
+#include "FilterDecisionCache.h"
+#include "PipelineResults.h"
 #include "OsSignalHandler.h"
 
+#include "Artus/Utility/interface/RootFileHelper.h"
+
 /**
  \brief Class to manage all registered Pipelines and to connect them to the event.
 
@@ -80,6 +97,7 @@ public:
 	/// Add a pipeline. The object is destroyed in the destructor of the PipelineRunner.
 	void AddPipeline(TPipeline* pline)
 	{
+		pline->SetFilterDecisionCache(&m_filterDecisionCache);
 		m_pipelines.push_back(pline);
 	}
 
@@ -115,6 +133,9 @@ public:
 	void RunPipelines(TEventProvider & evtProvider,
 			setting_type const& settings)
 	{
+		// the global producers read their settings in the event loop
+		settings.Freeze();
+
 		long long firstEvent = settings.GetFirstEvent();
 		long long nEvents = evtProvider.GetEntries();
 		long long processNEvents = settings.GetProcessNEvents();
@@ -122,8 +143,15 @@ public:
 		{
 			nEvents = processNEvents;
 		}
-		const stringvector globlalFilterIds = settings.GetFilters();
-		const stringvector taggingFilters = settings.GetTaggingFilters();
+		stringvector globlalFilterIds = settings.GetFilters();
+		stringvector taggingFilters = settings.GetTaggingFilters();
+		for (ProcessNodesIterator it = m_globalNodes.begin(); it != m_globalNodes.end(); ++it)
+		{
+			if ( it->GetProcessNodeType () == ProcessNodeType::Filter )
+			{
+				FilterBaseAccess(static_cast<filter_base_type&>(*it)).AddCutDecisionNames(globlalFilterIds, taggingFilters);
+			}
+		}
 
 		// initialize pline filter decision
 		FilterResult::FilterNames pipelineResultNames(m_pipelines.size());
@@ -146,92 +174,131 @@ public:
 				LOG(FATAL)<< "Pipeline name '" << *itUnq << "' is not unique, but pipeline names must be unique";
 			}
 		}
-		// apparently evtProvider.GetEntries() is not reliable. Therefore, if 'ProcessNEvents' is not set (=-1), the loop condition
-		// always evaluates to true (processNEvents<0) = (-1<0) and is terminated via the 'if (!evtProvider.GetEntry(i)) break' statement
-		for (long long i = firstEvent; ( (processNEvents<0) || (i<(firstEvent + nEvents)) ); ++i)
+		// resume from a checkpoint of a previous job with the same configuration and input
+		Checkpoint checkpoint(settings.GetCheckpointFile());
+		const long long checkpointEveryNEvents = settings.GetCheckpointEveryNEvents();
+		const long long checkpointEveryNSeconds = settings.GetCheckpointEveryNSeconds();
+		const std::string checkpointFingerprint = GetCheckpointFingerprint(evtProvider, settings);
+		long long startEvent = firstEvent;
+		double previousRunTime = 0.0;
+		if (checkpoint.Exists())
 		{
-
-			// quit here according to OS
-			if (osHasSIGINT())
+			checkpoint.Read();
+			if (checkpoint.GetFingerprint() != checkpointFingerprint)
 			{
-				LOG(INFO)<< "Terminating processing due to received SIGTERM";
-				break;
+				LOG(FATAL)<< "Checkpoint \"" << checkpoint.GetFileName() << "\" has been written for a different configuration or input!";
 			}
-
-			if (!evtProvider.GetEntry(i))
-			break;
-			for (ProgressReportIterator it = m_progressReport.begin();
-					it != m_progressReport.end(); ++it)
+			startEvent = checkpoint.GetNextEvent();
+			previousRunTime = checkpoint.GetRunTime();
+			for (PipelinesIterator it = m_pipelines.begin(); it != m_pipelines.end(); ++it)
 			{
-				it->update(i-firstEvent, nEvents);
+				if (it->GetSettings().GetLevel() == 1)
+					it->RestoreCheckpoint(checkpoint);
 			}
+			LOG(INFO)<< "Resuming from checkpoint \"" << checkpoint.GetFileName() << "\" at event " << startEvent << ".";
+		}
+
+		// SIGTERM and SIGUSR1 only request a checkpoint, plain runs keep the default behaviour
+		if (m_registerSignalHandler && checkpoint.IsEnabled())
+		{
+			osRegisterCheckpointHandler();
+		}
 
-			product_type productGlobal;
-			// use the lit of filters to bootstrap the filter list names
-			FilterResult globalFilterResult ( globlalFilterIds, taggingFilters );
+		const std::chrono::steady_clock::time_point loopStart = std::chrono::steady_clock::now();
+		std::chrono::steady_clock::time_point lastCheckpointTime = loopStart;
+		long long lastCheckpointEvent = startEvent;
+		bool interrupted = false;
 
-			for (ProcessNodesIterator it = m_globalNodes.begin(); it != m_globalNodes.end(); ++it)
-			{
-				// variables for runtime measurement
-				timeval tStart, tEnd;
-				int runTime;
+		// objects of the forked workers which are not owned by any consumer of this process
+		RootFileHelper::AdoptedObjects adoptedObjects;
+		const size_t nForks = settings.GetForkWorkers();
 
-				// stop processing as soon as one filter fails
-				// but the consumers will still be processed
-				if (! globalFilterResult.HasPassed())
-				break;
+		if (nForks > 1)
+		{
+			if (checkpoint.IsEnabled())
+			{
+				LOG(FATAL)<< "Checkpoints are not supported in combination with forked workers!";
+			}
+			RunForkedEventLoop(evtProvider, settings, firstEvent, nEvents, nForks,
+			                   globlalFilterIds, taggingFilters, pipelineResultNames, adoptedObjects);
+		}
+		else
+		{
+			// apparently evtProvider.GetEntries() is not reliable. Therefore, if 'ProcessNEvents' is not set (=-1), the loop condition
+			// always evaluates to true (processNEvents<0) = (-1<0) and is terminated via the 'if (!evtProvider.GetEntry(i)) break' statement
+			for (long long i = startEvent; ( (processNEvents<0) || (i<(firstEvent + nEvents)) ); ++i)
+			{
+				const bool checkpointRequested = osHasCheckpointRequest();
+				interrupted = (checkpointRequested || osHasSIGINT());
 
-				if ( it->GetProcessNodeType () == ProcessNodeType::Producer )
+				// the output written after an interruption has to be consistent with the checkpoint
+				if (checkpoint.IsEnabled())
 				{
-					producer_base_type& prod = static_cast<producer_base_type&>(*it);
-					//LOG(DEBUG) << prod.GetProducerId() << "::Produce";
-					gettimeofday(&tStart, nullptr);
-					ProducerBaseAccess(prod).Produce(evtProvider.GetCurrentEvent(),
-							productGlobal, settings);
-					gettimeofday(&tEnd, nullptr);
-					runTime = static_cast<int>(tEnd.tv_sec * 1000000 + tEnd.tv_usec - tStart.tv_sec * 1000000 - tStart.tv_usec);
-					productGlobal.processorRunTime[prod.GetProducerId()] = runTime;
+					const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+					if (interrupted ||
+					    ((checkpointEveryNEvents > 0) && (i - lastCheckpointEvent >= checkpointEveryNEvents)) ||
+					    ((checkpointEveryNSeconds > 0) && (now - lastCheckpointTime >= std::chrono::seconds(checkpointEveryNSeconds))))
+					{
+						WriteCheckpoint(checkpoint, i, previousRunTime + std::chrono::duration<double>(now - loopStart).count(),
+						                checkpointFingerprint);
+						lastCheckpointTime = now;
+						lastCheckpointEvent = i;
+					}
 				}
-				else if ( it->GetProcessNodeType () == ProcessNodeType::Filter )
+
+				// quit here according to OS
+				if (checkpointRequested)
 				{
-					filter_base_type& flt = static_cast<filter_base_type&>(*it);
-					//LOG(DEBUG) << flt.GetFilterId() << "::DoesEventPass";
-					gettimeofday(&tStart, nullptr);
-					const bool filterResult = FilterBaseAccess(flt).DoesEventPass(evtProvider.GetCurrentEvent(),
-							productGlobal, settings);
-					globalFilterResult.SetFilterDecision(flt.GetFilterId(), filterResult);
-					gettimeofday(&tEnd, nullptr);
-					runTime = static_cast<int>(tEnd.tv_sec * 1000000 + tEnd.tv_usec - tStart.tv_sec * 1000000 - tStart.tv_usec);
-					productGlobal.processorRunTime[flt.GetFilterId()] = runTime;
+					if (checkpoint.IsEnabled())
+					{
+						LOG(INFO)<< "Terminating processing due to requested checkpoint";
+					}
+					else
+					{
+						LOG(INFO)<< "Terminating processing due to received signal";
+					}
+					break;
 				}
-				else
+				if (osHasSIGINT())
 				{
-					LOG(FATAL) << "ProcessNodeType not supported by the pipeline runner!";
+					LOG(INFO)<< "Terminating processing due to received SIGTERM";
+					break;
 				}
-			}
-
-			// run the pipelines
-			FilterResult pipelineFilterRes(pipelineResultNames, taggingFilters);
 
-			for (PipelinesIterator it = m_pipelines.begin(); it != m_pipelines.end(); ++it)
-			{
-				if (it->GetSettings().GetLevel() == 1)
+				if (!evtProvider.GetEntry(i))
+				break;
+				for (ProgressReportIterator it = m_progressReport.begin();
+						it != m_progressReport.end(); ++it)
 				{
-					productGlobal.PreviousPipelinesResult = pipelineFilterRes;
-					bool result = it->RunEvent(evtProvider.GetCurrentEvent(),
-							productGlobal, globalFilterResult);
-					pipelineFilterRes.SetFilterDecision(
-							it->GetSettings().GetName(), result);
+					it->update(i-firstEvent, nEvents);
 				}
+
+				ProcessEvent(evtProvider, settings, globlalFilterIds, taggingFilters, pipelineResultNames);
 			}
 		}
 
+		if (m_registerSignalHandler && checkpoint.IsEnabled())
+		{
+			osUnregisterCheckpointHandler();
+		}
+
 		for (ProgressReportIterator it = m_progressReport.begin();
 				it != m_progressReport.end(); ++it)
 		{
 			it->finish();
 		}
 
+		if (checkpoint.Exists() && (! interrupted))
+		{
+			// the job is complete and must not be resumed
+			checkpoint.Remove();
+		}
+		if (startEvent != firstEvent)
+		{
+			LOG(INFO)<< "Event loop resumed from checkpoint took " << (previousRunTime + std::chrono::duration<double>(
+			         std::chrono::steady_clock::now() - loopStart).count()) << " s in total.";
+		}
+
 		// first safe the results ( > plots ) from all level one pipelines
 		for (PipelinesIterator it = m_pipelines.begin();
 				!(it == m_pipelines.end()); ++it)
@@ -239,35 +306,39 @@ public:
 			if (it->GetSettings().GetLevel() == 1)
 				it->FinishPipeline();
 		}
+		// overwrite the objects written by consumers of this process, which did not process any event
+		RootFileHelper::WriteAdoptedObjects(adoptedObjects);
 
 		osSignalReset();
 
 		// run the pipelines greater level one
 		// even if the previous event loop was interrupted
-		bool noPipelineRun = false;
+		// the results of lower levels are handed over in memory via PipelineResults
+		size_t nThreads = std::max(settings.GetPostProcessingThreads(), size_t(1));
 		size_t curLevel = 2;
-		while (!noPipelineRun)
+		while (true)
 		{
-			noPipelineRun = true;
-			for (PipelinesIterator it = m_pipelines.begin();
-					it != m_pipelines.end(); ++it)
+			std::vector<pipeline_type*> levelPipelines;
+			for (PipelinesIterator it = m_pipelines.begin(); it != m_pipelines.end(); ++it)
 			{
-				if (osHasSIGINT())
-				{
-					LOG(INFO)<< "Terminating processing due to received SIGTERM";
-					break;
-				}
-
 				if (it->GetSettings().GetLevel() == curLevel)
-				{
-					noPipelineRun = false;
+					levelPipelines.push_back(&(*it));
+			}
+			if (levelPipelines.empty())
+				break;
 
-					it->Run();
-					it->FinishPipeline();
-				}
+			RunPipelinesParallel(levelPipelines, nThreads);
+
+			// writing the output is not thread-safe, therefore finish the pipelines
+			// sequentially in the order of the configuration
+			for (pipeline_type* pipeline : levelPipelines)
+			{
+				pipeline->FinishPipeline();
 			}
 			++curLevel;
 		}
+
+		PipelineResults::Clear();
 	}
 
 	void AddProgressReport(ProgressReportBase * p)
@@ -292,9 +363,344 @@ public:
 
 private:
 
+	// run the global producers and filters and all level one pipelines on the current event
+	template<class TEventProvider>
+	void ProcessEvent(TEventProvider & evtProvider, setting_type const& settings,
+	                  stringvector const& globalFilterIds, stringvector const& taggingFilters,
+	                  FilterResult::FilterNames const& pipelineResultNames)
+	{
+		product_type productGlobal;
+		// use the lit of filters to bootstrap the filter list names
+		FilterResult globalFilterResult ( globalFilterIds, taggingFilters );
+
+		for (ProcessNodesIterator it = m_globalNodes.begin(); it != m_globalNodes.end(); ++it)
+		{
+			// variables for runtime measurement
+			timeval tStart, tEnd;
+			int runTime;
+
+			// stop processing as soon as one filter fails
+			// but the consumers will still be processed
+			if (! globalFilterResult.HasPassed())
+			break;
+
+			if ( it->GetProcessNodeType () == ProcessNodeType::Producer )
+			{
+				producer_base_type& prod = static_cast<producer_base_type&>(*it);
+				//LOG(DEBUG) << prod.GetProducerId() << "::Produce";
+				gettimeofday(&tStart, nullptr);
+				ProducerBaseAccess(prod).Produce(evtProvider.GetCurrentEvent(),
+						productGlobal, settings);
+				gettimeofday(&tEnd, nullptr);
+				runTime = static_cast<int>(tEnd.tv_sec * 1000000 + tEnd.tv_usec - tStart.tv_sec * 1000000 - tStart.tv_usec);
+				productGlobal.processorRunTime[prod.GetProducerId()] = runTime;
+			}
+			else if ( it->GetProcessNodeType () == ProcessNodeType::Filter )
+			{
+				filter_base_type& flt = static_cast<filter_base_type&>(*it);
+				//LOG(DEBUG) << flt.GetFilterId() << "::DoesEventPass";
+				gettimeofday(&tStart, nullptr);
+				const bool filterResult = FilterBaseAccess(flt).DoesEventPass(evtProvider.GetCurrentEvent(),
+						productGlobal, settings);
+				globalFilterResult.SetFilterDecision(flt.GetFilterId(), filterResult);
+				FilterBaseAccess(flt).SetCutDecisions(globalFilterResult);
+				gettimeofday(&tEnd, nullptr);
+				runTime = static_cast<int>(tEnd.tv_sec * 1000000 + tEnd.tv_usec - tStart.tv_sec * 1000000 - tStart.tv_usec);
+				productGlobal.processorRunTime[flt.GetFilterId()] = runTime;
+			}
+			else
+			{
+				LOG(FATAL) << "ProcessNodeType not supported by the pipeline runner!";
+			}
+		}
+
+		// run the pipelines
+		FilterResult pipelineFilterRes(pipelineResultNames, taggingFilters);
+		m_filterDecisionCache.NewEvent();
+
+		for (PipelinesIterator it = m_pipelines.begin(); it != m_pipelines.end(); ++it)
+		{
+			if (it->GetSettings().GetLevel() == 1)
+			{
+				productGlobal.PreviousPipelinesResult = pipelineFilterRes;
+				bool result = it->RunEvent(evtProvider.GetCurrentEvent(),
+						productGlobal, globalFilterResult);
+				pipelineFilterRes.SetFilterDecision(
+						it->GetSettings().GetName(), result);
+			}
+		}
+	}
+
+	// distribute the events in work units to forked worker processes, workers which are done
+	// steal the remaining work units of the others, see WorkUnitScheduler
+	// the loaded producers and settings are shared copy-on-write, the results of the workers are
+	// merged into the objects of the consumers of this process via temporary output files
+	template<class TEventProvider>
+	void RunForkedEventLoop(TEventProvider & evtProvider, setting_type const& settings,
+	                        long long firstEvent, long long nEvents, size_t nWorkers,
+	                        stringvector const& globalFilterIds, stringvector const& taggingFilters,
+	                        FilterResult::FilterNames const& pipelineResultNames,
+	                        RootFileHelper::AdoptedObjects & adoptedObjects)
+	{
+		// all pipelines write into the same output file, which is not set e.g. in tests
+		TFile * rootOutFile = nullptr;
+		for (PipelinesIterator it = m_pipelines.begin(); it != m_pipelines.end(); ++it)
+		{
+			if (it->GetSettings().GetRootOutFile() != nullptr)
+				rootOutFile = it->GetSettings().GetRootOutFile();
+		}
+
+		// the state of the consumers, which is not stored in the output file, is handed over via files
+		std::string const workerStatePrefix = ((rootOutFile != nullptr) ? std::string(rootOutFile->GetName()) :
+		                                       ("artus." + std::to_string(getpid())));
+
+		// the state of the scheduler is shared with the worker processes
+		WorkUnitScheduler scheduler(evtProvider.GetWorkUnits(firstEvent, firstEvent + nEvents), true);
+
+		LOG(INFO)<< "Processing " << scheduler.GetTotalEntries() << " events in " << nWorkers << " forked worker processes.";
+		// avoid that buffered output is written by every worker
+		std::cout.flush();
+		std::cerr.flush();
+
+		std::vector<pid_t> workers;
+		for (size_t worker = 0; worker < nWorkers; ++worker)
+		{
+			pid_t pid = fork();
+			if (pid < 0)
+			{
+				LOG(FATAL)<< "Cannot fork worker process " << worker << "!";
+			}
+			else if (pid == 0)
+			{
+				RunForkedWorker(evtProvider, settings, worker, nWorkers, scheduler, rootOutFile, workerStatePrefix,
+				                globalFilterIds, taggingFilters, pipelineResultNames);
+			}
+			workers.push_back(pid);
+		}
+
+		// wait for the workers in the order in which they finish, as soon as one of them dies,
+		// the others are stopped since their results cannot be merged anyway
+		bool failed = false;
+		std::vector<bool> running(workers.size(), true);
+		size_t nRunningWorkers = workers.size();
+		while (nRunningWorkers > 0)
+		{
+			int status = 0;
+			pid_t pid = waitpid(-1, &status, 0);
+			if (pid < 0)
+			{
+				if (errno == EINTR)
+					continue;
+				LOG(FATAL)<< "Cannot wait for the forked worker processes!";
+			}
+			size_t worker = std::find(workers.begin(), workers.end(), pid) - workers.begin();
+			if ((worker >= workers.size()) || (! running[worker]))
+				continue;
+			running[worker] = false;
+			--nRunningWorkers;
+
+			if ((! WIFEXITED(status)) || (WEXITSTATUS(status) != 0))
+			{
+				LOG(ERROR)<< "Worker process " << worker << " failed!";
+				if (! failed)
+				{
+					failed = true;
+					for (size_t otherWorker = 0; otherWorker < workers.size(); ++otherWorker)
+					{
+						if (running[otherWorker])
+							kill(workers[otherWorker], SIGKILL);
+					}
+				}
+			}
+		}
+		if (failed)
+		{
+			LOG(FATAL)<< "Processing in forked worker processes failed!";
+		}
+
+		if (rootOutFile != nullptr)
+		{
+			for (size_t worker = 0; worker < workers.size(); ++worker)
+			{
+				std::string workerFileName = GetWorkerFileName(rootOutFile, worker);
+				TFile workerFile(workerFileName.c_str(), "READ");
+				RootFileHelper::MergeObjects(&workerFile, rootOutFile, adoptedObjects);
+				workerFile.Close();
+				std::remove(workerFileName.c_str());
+			}
+		}
+
+		for (size_t worker = 0; worker < workers.size(); ++worker)
+		{
+			Checkpoint workerState(GetWorkerStateFileName(workerStatePrefix, worker));
+			if (! workerState.Exists())
+			{
+				LOG(FATAL)<< "The state of worker process " << worker << " is missing!";
+			}
+			workerState.Read();
+			for (PipelinesIterator it = m_pipelines.begin(); it != m_pipelines.end(); ++it)
+			{
+				if (it->GetSettings().GetLevel() == 1)
+					it->MergeWorkerState(workerState);
+			}
+			workerState.Remove();
+		}
+	}
+
+	// event loop of a forked worker process, does not return
+	template<class TEventProvider>
+	void RunForkedWorker(TEventProvider & evtProvider, setting_type const& settings,
+	                     size_t worker, size_t nWorkers, WorkUnitScheduler & scheduler, TFile * rootOutFile,
+	                     std::string const& workerStatePrefix, stringvector const& globalFilterIds, stringvector const& taggingFilters,
+	                     FilterResult::FilterNames const& pipelineResultNames)
+	{
+		// the input files have been opened by the parent process before forking
+		evtProvider.ReopenInput();
+
+		TFile * workerFile = nullptr;
+		if (rootOutFile != nullptr)
+		{
+			// the output file of the parent process must not be touched by the worker
+			workerFile = new TFile(GetWorkerFileName(rootOutFile, worker).c_str(), "RECREATE");
+			RootFileHelper::MoveObjects(rootOutFile, workerFile);
+			for (PipelinesIterator it = m_pipelines.begin(); it != m_pipelines.end(); ++it)
+			{
+				it->SetRootOutFile(workerFile);
+			}
+		}
+
+		WorkUnitScheduler::WorkerState state = scheduler.GetInitialState(worker, nWorkers);
+		WorkUnit workUnit;
+		bool interrupted = false;
+		while ((! interrupted) && scheduler.GetNextWorkUnit(state, workUnit))
+		{
+			evtProvider.PrepareWorkUnit(workUnit);
+
+			for (long long i = workUnit.firstEntry; i < workUnit.endEntry; ++i)
+			{
+				if (osHasSIGINT() || osHasCheckpointRequest())
+				{
+					LOG(INFO)<< "Terminating worker process " << worker << " due to received signal";
+					interrupted = true;
+					break;
+				}
+
+				if (!evtProvider.GetEntry(i))
+					break;
+
+				// only the first worker reports the progress of all workers
+				if (worker == 0)
+				{
+					for (ProgressReportIterator it = m_progressReport.begin(); it != m_progressReport.end(); ++it)
+					{
+						it->update(scheduler.GetScheduledEntries(), scheduler.GetTotalEntries());
+					}
+				}
+
+				ProcessEvent(evtProvider, settings, globalFilterIds, taggingFilters, pipelineResultNames);
+			}
+		}
+
+		Checkpoint workerState(GetWorkerStateFileName(workerStatePrefix, worker));
+		for (PipelinesIterator it = m_pipelines.begin(); it != m_pipelines.end(); ++it)
+		{
+			if (it->GetSettings().GetLevel() == 1)
+			{
+				it->SaveWorkerState(workerState);
+				it->FinishPipeline();
+			}
+		}
+		workerState.Write();
+
+		if (workerFile != nullptr)
+		{
+			workerFile->Close();
+		}
+		std::cout.flush();
+		std::cerr.flush();
+
+		// skip all destructors and exit handlers, which would write to the output file of the parent process
+		_exit(0);
+	}
+
+	std::string GetWorkerFileName(TFile * rootOutFile, size_t worker) const
+	{
+		return std::string(rootOutFile->GetName()) + ".worker" + std::to_string(worker);
+	}
+
+	std::string GetWorkerStateFileName(std::string const& workerStatePrefix, size_t worker) const
+	{
+		return workerStatePrefix + ".worker" + std::to_string(worker) + ".json";
+	}
+
+	template<class TEventProvider>
+	std::string GetCheckpointFingerprint(TEventProvider & evtProvider, setting_type const& settings) const
+	{
+		std::stringstream fingerprint;
+		if (settings.GetPropTree() != nullptr)
+		{
+			boost::property_tree::json_parser::write_json(fingerprint, *(settings.GetPropTree()), false);
+		}
+		fingerprint << evtProvider.GetEntries();
+		return std::to_string(std::hash<std::string>()(fingerprint.str()));
+	}
+
+	void WriteCheckpoint(Checkpoint & checkpoint, long long nextEvent, double runTime,
+	                     std::string const& fingerprint)
+	{
+		checkpoint.SetNextEvent(nextEvent);
+		checkpoint.SetRunTime(runTime);
+		checkpoint.SetFingerprint(fingerprint);
+		for (PipelinesIterator it = m_pipelines.begin(); it != m_pipelines.end(); ++it)
+		{
+			if (it->GetSettings().GetLevel() == 1)
+				it->SaveCheckpoint(checkpoint);
+		}
+		checkpoint.Write();
+	}
+
+	// run pipelines of the same level concurrently, they only depend on results of lower levels
+	void RunPipelinesParallel(std::vector<pipeline_type*> const& pipelines, size_t nThreads)
+	{
+		std::atomic<size_t> nextPipeline(0);
+		auto runPipelines = [&pipelines, &nextPipeline] ()
+		{
+			for (size_t index = nextPipeline++; index < pipelines.size(); index = nextPipeline++)
+			{
+				if (osHasSIGINT())
+				{
+					LOG(INFO)<< "Terminating processing due to received SIGTERM";
+					break;
+				}
+				pipelines[index]->Run();
+			}
+		};
+
+		// the pipelines create and fill ROOT objects, ROOT has to be prepared for this before starting the threads
+		size_t const nUsedThreads = std::min(nThreads, pipelines.size());
+		if (nUsedThreads > 1)
+		{
+			ROOT::EnableThreadSafety();
+		}
+
+		std::vector<std::thread> threads;
+		for (size_t thread = 1; thread < nUsedThreads; ++thread)
+		{
+			threads.push_back(std::thread(runPipelines));
+		}
+		runPipelines();
+		for (std::thread & thread : threads)
+		{
+			thread.join();
+		}
+	}
+
 	Pipelines m_pipelines;
 	ProcessNodes m_globalNodes;
 	ProgressReportList m_progressReport;
 	bool m_registerSignalHandler;
+
+	// filter decisions shared between the pipelines
+	FilterDecisionCache m_filterDecisionCache;
 };
 
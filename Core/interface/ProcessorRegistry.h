@@ -0,0 +1,139 @@
+/* Copyright (c) 2013 - All Rights Reserved
+ *   Thomas Hauth  <Thomas.Hauth@cern.ch>
+ *   Joram Berger  <Joram.Berger@cern.ch>
+ *   Dominik Haitz <Dominik.Haitz@kit.edu>
+ */
+
+#pragma once
+
+#include <functional>
+#include <mutex>
+#include <ostream>
+#include <map>
+#include <string>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+#include "ProducerBase.h"
+#include "ConsumerBase.h"
+#include "FilterBase.h"
+
+/**
+   \brief Static registry of all producers, filters and consumers which can be created by id.
+
+   Processors register themselves at static initialisation time with the REGISTER_PRODUCER,
+   REGISTER_FILTER and REGISTER_CONSUMER macros, which have to be used in a source file of the
+   library providing them. The ids are only determined at the first lookup, when every
+   registered type is instantiated exactly once. Afterwards, all lookups are done in a hash map.
+
+   The processors are registered per TTypes they are derived from, e.g. ProducerBase<TTypes>,
+   and can only be created for these types. Factories query the registry for their types,
+   e.g. KappaFactory for KappaTypes, and factories of derived analyses chain to their base
+   class for all ids they do not handle themselves. If an id is registered more than once for
+   the same types, the last registration is used. Libraries are loaded after the libraries
+   they depend on, therefore registrations of derived analyses override those of their base.
+ */
+class ProcessorRegistry {
+public:
+
+	typedef std::function<ProducerBaseUntemplated*()> ProducerCreator;
+	typedef std::function<FilterBaseUntemplated*()> FilterCreator;
+	typedef std::function<ConsumerBaseUntemplated*()> ConsumerCreator;
+
+	// the return value is only used to trigger the registration at static initialisation time
+	template<class TTypes>
+	static bool AddProducer(ProducerCreator creator) {
+		return AddProducer(typeid(TTypes), creator);
+	}
+	template<class TTypes>
+	static bool AddFilter(FilterCreator creator) {
+		return AddFilter(typeid(TTypes), creator);
+	}
+	template<class TTypes>
+	static bool AddConsumer(ConsumerCreator creator) {
+		return AddConsumer(typeid(TTypes), creator);
+	}
+
+	// return nullptr for unknown ids and for ids registered only for other types
+	template<class TTypes>
+	static ProducerBaseUntemplated* CreateProducer(std::string const& id) {
+		return CreateProducer(typeid(TTypes), id);
+	}
+	template<class TTypes>
+	static FilterBaseUntemplated* CreateFilter(std::string const& id) {
+		return CreateFilter(typeid(TTypes), id);
+	}
+	template<class TTypes>
+	static ConsumerBaseUntemplated* CreateConsumer(std::string const& id) {
+		return CreateConsumer(typeid(TTypes), id);
+	}
+
+	// sorted ids of all registered processors of any types
+	static std::vector<std::string> GetProducerIds();
+	static std::vector<std::string> GetFilterIds();
+	static std::vector<std::string> GetConsumerIds();
+
+	// list of all registered processors, e.g. for --list-processors
+	static void Print(std::ostream & stream);
+
+	// types the processors are registered for, deduced from their base class
+	template<class TTypes>
+	static TTypes GetTypes(ProducerBase<TTypes> const*);
+	template<class TTypes>
+	static TTypes GetTypes(FilterBase<TTypes> const*);
+	template<class TTypes>
+	static TTypes GetTypes(ConsumerBase<TTypes> const*);
+
+private:
+
+	template<class TProcessor>
+	struct Table
+	{
+		std::vector<std::function<TProcessor*()> > creators;
+		// index of the creator per id
+		std::unordered_map<std::string, size_t> index;
+		// number of creators already in the index
+		size_t nIndexed = 0;
+	};
+
+	template<class TProcessor>
+	using Tables = std::map<std::type_index, Table<TProcessor> >;
+
+	static bool AddProducer(std::type_index types, ProducerCreator creator);
+	static bool AddFilter(std::type_index types, FilterCreator creator);
+	static bool AddConsumer(std::type_index types, ConsumerCreator creator);
+
+	static ProducerBaseUntemplated* CreateProducer(std::type_index types, std::string const& id);
+	static FilterBaseUntemplated* CreateFilter(std::type_index types, std::string const& id);
+	static ConsumerBaseUntemplated* CreateConsumer(std::type_index types, std::string const& id);
+
+	template<class TProcessor>
+	static void UpdateIndex(Table<TProcessor> & table, std::function<std::string(TProcessor const&)> getId);
+
+	template<class TProcessor>
+	static TProcessor* Create(Tables<TProcessor> & tables, std::function<std::string(TProcessor const&)> getId,
+	                          std::type_index types, std::string const& id);
+
+	template<class TProcessor>
+	static std::vector<std::string> GetIds(Tables<TProcessor> & tables, std::function<std::string(TProcessor const&)> getId);
+
+	// function-local statics to be independent of the static initialisation order
+	static Tables<ProducerBaseUntemplated> & GetProducers();
+	static Tables<FilterBaseUntemplated> & GetFilters();
+	static Tables<ConsumerBaseUntemplated> & GetConsumers();
+	static std::mutex & GetMutex();
+};
+
+#define ARTUS_REGISTRY_CONCAT_IMPL(A, B) A##B
+#define ARTUS_REGISTRY_CONCAT(A, B) ARTUS_REGISTRY_CONCAT_IMPL(A, B)
+
+#define ARTUS_REGISTER_PROCESSOR(ADD, BASE, TYPE) \
+static const bool ARTUS_REGISTRY_CONCAT(s_processorRegistration, __LINE__) = \
+		ProcessorRegistry::ADD<decltype(ProcessorRegistry::GetTypes(static_cast<TYPE const*>(nullptr)))>( \
+				[]() -> BASE* { return new TYPE(); });
+
+#define REGISTER_PRODUCER(TYPE) ARTUS_REGISTER_PROCESSOR(AddProducer, ProducerBaseUntemplated, TYPE)
+#define REGISTER_FILTER(TYPE) ARTUS_REGISTER_PROCESSOR(AddFilter, FilterBaseUntemplated, TYPE)
+#define REGISTER_CONSUMER(TYPE) ARTUS_REGISTER_PROCESSOR(AddConsumer, ConsumerBaseUntemplated, TYPE)
@@ -0,0 +1,90 @@
+
+#pragma once
+
+#include <atomic>
+#include <vector>
+
+#include <pthread.h>
+
+#include <boost/noncopyable.hpp>
+
+class TChain;
+
+/**
+   \brief Range of consecutive entries of one input file which is processed in one go.
+ */
+struct WorkUnit
+{
+	long long firstEntry;
+	// exclusive
+	long long endEntry;
+	// index of the file (tree) in the input chain
+	int file;
+};
+
+/**
+   \brief Dynamic distribution of work units to parallel workers.
+
+   Every worker starts with its own input file and processes the work units of this file in
+   order. As soon as this file is done, the worker steals work units from the end of the file
+   with the largest number of remaining entries. Therefore, all workers finish at about the
+   same time, even if the sizes of the input files are very different.
+
+   The state can be shared between threads or, if requested in the constructor, between
+   processes forked after the construction. It is protected by a robust mutex, therefore a
+   worker process dying while holding the lock does not block the others.
+ */
+class WorkUnitScheduler: public boost::noncopyable {
+public:
+
+	struct WorkerState
+	{
+		size_t file;
+		bool stealing;
+	};
+
+	explicit WorkUnitScheduler(std::vector<WorkUnit> const& workUnits, bool shareBetweenProcesses = false);
+	~WorkUnitScheduler();
+
+	WorkerState GetInitialState(size_t worker, size_t nWorkers) const;
+
+	// returns false as soon as all work units have been handed out
+	bool GetNextWorkUnit(WorkerState & state, WorkUnit & workUnit);
+
+	long long GetTotalEntries() const;
+	// number of entries in the work units handed out so far
+	long long GetScheduledEntries() const;
+
+	// splits the range into units of equal size, if nothing is known about the input
+	static std::vector<WorkUnit> GetWorkUnits(long long firstEntry, long long endEntry, long long nEntriesPerUnit);
+	// units aligned to the clusters of the trees in the chain
+	static std::vector<WorkUnit> GetClusterWorkUnits(TChain & chain, long long firstEntry, long long endEntry);
+
+private:
+
+	struct State
+	{
+		pthread_mutex_t mutex;
+		std::atomic<long long> scheduledEntries;
+	};
+
+	long long GetRemainingEntries(size_t file) const;
+	void Lock();
+	void Unlock();
+
+	// sorted by file
+	std::vector<WorkUnit> m_workUnits;
+	// number of entries in all previous units
+	std::vector<long long> m_entriesBefore;
+	// ranges of units per file
+	std::vector<size_t> m_fileBegin;
+	std::vector<size_t> m_fileEnd;
+
+	bool m_shareBetweenProcesses;
+	size_t m_stateSize;
+	char * m_stateMemory;
+	State * m_state;
+	// next unit taken from the front and end of the remaining units per file
+	size_t * m_front;
+	size_t * m_back;
+};
@@ -0,0 +1,83 @@
+
+#include <cstdio>
+#include <fstream>
+
+#include <boost/property_tree/json_parser.hpp>
+
+#include "Artus/Core/interface/Checkpoint.h"
+
+
+Checkpoint::Checkpoint(std::string const& fileName) :
+		m_fileName(fileName) {
+}
+
+std::string const& Checkpoint::GetFileName() const {
+	return m_fileName;
+}
+
+bool Checkpoint::IsEnabled() const {
+	return (! m_fileName.empty());
+}
+
+bool Checkpoint::Exists() const {
+	return (IsEnabled() && std::ifstream(m_fileName.c_str()).good());
+}
+
+void Checkpoint::Read() {
+	try {
+		boost::property_tree::json_parser::read_json(m_fileName, m_state);
+	}
+	catch (boost::property_tree::json_parser::json_parser_error const& error) {
+		LOG(FATAL) << "Checkpoint file \"" << m_fileName << "\" cannot be read: " << error.what();
+	}
+}
+
+void Checkpoint::Write() const {
+	std::string tmpFileName = m_fileName + ".tmp";
+	boost::property_tree::json_parser::write_json(tmpFileName, m_state);
+	if (std::rename(tmpFileName.c_str(), m_fileName.c_str()) != 0) {
+		LOG(FATAL) << "Checkpoint file \"" << m_fileName << "\" cannot be written!";
+	}
+	LOG(DEBUG) << "Checkpoint written to \"" << m_fileName << "\" before event " << GetNextEvent() << ".";
+}
+
+void Checkpoint::Remove() const {
+	std::remove(m_fileName.c_str());
+}
+
+long long Checkpoint::GetNextEvent() const {
+	return m_state.get<long long>("NextEvent", 0);
+}
+
+void Checkpoint::SetNextEvent(long long nextEvent) {
+	m_state.put("NextEvent", nextEvent);
+}
+
+double Checkpoint::GetRunTime() const {
+	return m_state.get<double>("RunTime", 0.0);
+}
+
+void Checkpoint::SetRunTime(double runTime) {
+	m_state.put("RunTime", runTime);
+}
+
+std::string Checkpoint::GetFingerprint() const {
+	return m_state.get<std::string>("Fingerprint", "");
+}
+
+void Checkpoint::SetFingerprint(std::string const& fingerprint) {
+	m_state.put("Fingerprint", fingerprint);
+}
+
+std::string Checkpoint::GetKey(std::string const& pipelineName, std::string const& consumerId,
+                               std::string const& name) {
+	return "Pipelines/" + pipelineName + "/" + consumerId + "/" + name;
+}
+
+bool Checkpoint::Has(std::string const& key) const {
+	return static_cast<bool>(m_state.get_child_optional(GetPath(key)));
+}
+
+boost::property_tree::ptree::path_type Checkpoint::GetPath(std::string const& key) {
+	return boost::property_tree::ptree::path_type(key, '/');
+}
@@ -33,6 +33,25 @@ void CutFlow::AddFilterResult(FilterResult const& fres)
 	}
 }
 
+void CutFlow::AddCutCount(CutCount const& cutCount, long eventCount)
+{
+	m_overallEventCount += eventCount;
+
+	for (CutFlow::CutCount::const_iterator it = cutCount.begin();
+	     it != cutCount.end(); ++it)
+	{
+		CutFlow::CutStat * stat = CutFlow::GetCutEntry(it->first);
+		if (stat == nullptr)
+		{
+			m_cutCount.push_back(*it);
+		}
+		else
+		{
+			stat->second += it->second;
+		}
+	}
+}
+
 CutFlow::CutStat * CutFlow::GetCutEntry(std::string const& filterName)
 {
 	for (CutFlow::CutCount::iterator it = m_cutCount.begin();
@@ -0,0 +1,44 @@
+
+#include "Artus/Core/interface/FilterDecisionCache.h"
+#include "Artus/Utility/interface/ArtusLogging.h"
+
+
+FilterDecisionCache::FilterDecisionCache() :
+		// slots are initialised with event 0, therefore start counting at 1
+		m_currentEvent(1) {
+}
+
+FilterDecisionCache::SlotIndex FilterDecisionCache::RegisterFingerprint(std::string const& fingerprint) {
+	std::map<std::string, SlotIndex>::const_iterator it = m_slots.find(fingerprint);
+	if (it != m_slots.end()) {
+		return it->second;
+	}
+
+	SlotIndex slot = m_decisions.size();
+	m_slots[fingerprint] = slot;
+	m_slotEvent.push_back(0);
+	m_decisions.push_back(false);
+	LOG(DEBUG) << "Decisions of filters with fingerprint \"" << fingerprint << "\" are shared between pipelines.";
+	return slot;
+}
+
+size_t FilterDecisionCache::GetNumberOfSlots() const {
+	return m_decisions.size();
+}
+
+void FilterDecisionCache::NewEvent() {
+	++m_currentEvent;
+}
+
+bool FilterDecisionCache::HasDecision(SlotIndex slot) const {
+	return (m_slotEvent[slot] == m_currentEvent);
+}
+
+bool FilterDecisionCache::GetDecision(SlotIndex slot) const {
+	return m_decisions[slot];
+}
+
+void FilterDecisionCache::SetDecision(SlotIndex slot, bool passed) {
+	m_decisions[slot] = passed;
+	m_slotEvent[slot] = m_currentEvent;
+}
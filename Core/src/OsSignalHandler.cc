@@ -11,6 +11,7 @@
 #include <atomic>
 
 std::atomic<bool> osSignal_hasSIGINT(false);
+std::atomic<bool> osSignal_hasCheckpointRequest(false);
 
 void osRegisterHandler()
 {
@@ -22,18 +23,45 @@ void osUnregisterHandler()
 	signal(SIGINT, SIG_DFL);
 }
 
+void osRegisterCheckpointHandler()
+{
+	// sent by batch systems before a job is killed
+	signal(SIGTERM, osSignalHandler);
+	signal(SIGUSR1, osSignalHandler);
+}
+
+void osUnregisterCheckpointHandler()
+{
+	signal(SIGTERM, SIG_DFL);
+	signal(SIGUSR1, SIG_DFL);
+}
+
 bool osHasSIGINT()
 {
 	return osSignal_hasSIGINT.load();
 }
 
+bool osHasCheckpointRequest()
+{
+	return osSignal_hasCheckpointRequest.load();
+}
+
 void osSignalHandler(int signum)
 {
-	LOG(INFO) << "Signal SIGINT received";
-	osSignal_hasSIGINT.store(true);
+	if (signum == SIGINT)
+	{
+		LOG(INFO) << "Signal SIGINT received";
+		osSignal_hasSIGINT.store(true);
+	}
+	else
+	{
+		LOG(INFO) << "Signal " << signum << " received";
+		osSignal_hasCheckpointRequest.store(true);
+	}
 }
 
 void osSignalReset()
 {
 	osSignal_hasSIGINT.store(false);
+	osSignal_hasCheckpointRequest.store(false);
 }
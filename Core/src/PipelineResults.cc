@@ -0,0 +1,16 @@
+
+#include "Artus/Core/interface/PipelineResults.h"
+
+
+std::map<PipelineResults::Key, PipelineResults::Entry> PipelineResults::s_entries;
+std::mutex PipelineResults::s_mutex;
+
+bool PipelineResults::Has(std::string const& pipelineName, std::string const& objectName) {
+	std::lock_guard<std::mutex> lock(s_mutex);
+	return (s_entries.find(Key(pipelineName, objectName)) != s_entries.end());
+}
+
+void PipelineResults::Clear() {
+	std::lock_guard<std::mutex> lock(s_mutex);
+	s_entries.clear();
+}
@@ -0,0 +1,141 @@
+
+#include <memory>
+#include <set>
+
+#include "Artus/Core/interface/ProcessorRegistry.h"
+
+
+bool ProcessorRegistry::AddProducer(std::type_index types, ProducerCreator creator) {
+	std::lock_guard<std::mutex> lock(GetMutex());
+	GetProducers()[types].creators.push_back(creator);
+	return true;
+}
+
+bool ProcessorRegistry::AddFilter(std::type_index types, FilterCreator creator) {
+	std::lock_guard<std::mutex> lock(GetMutex());
+	GetFilters()[types].creators.push_back(creator);
+	return true;
+}
+
+bool ProcessorRegistry::AddConsumer(std::type_index types, ConsumerCreator creator) {
+	std::lock_guard<std::mutex> lock(GetMutex());
+	GetConsumers()[types].creators.push_back(creator);
+	return true;
+}
+
+ProducerBaseUntemplated* ProcessorRegistry::CreateProducer(std::type_index types, std::string const& id) {
+	return Create<ProducerBaseUntemplated>(GetProducers(),
+	                                       [](ProducerBaseUntemplated const& producer) { return producer.GetProducerId(); },
+	                                       types, id);
+}
+
+FilterBaseUntemplated* ProcessorRegistry::CreateFilter(std::type_index types, std::string const& id) {
+	return Create<FilterBaseUntemplated>(GetFilters(),
+	                                     [](FilterBaseUntemplated const& filter) { return filter.GetFilterId(); },
+	                                     types, id);
+}
+
+ConsumerBaseUntemplated* ProcessorRegistry::CreateConsumer(std::type_index types, std::string const& id) {
+	return Create<ConsumerBaseUntemplated>(GetConsumers(),
+	                                       [](ConsumerBaseUntemplated const& consumer) { return consumer.GetConsumerId(); },
+	                                       types, id);
+}
+
+std::vector<std::string> ProcessorRegistry::GetProducerIds() {
+	return GetIds<ProducerBaseUntemplated>(GetProducers(),
+	                                       [](ProducerBaseUntemplated const& producer) { return producer.GetProducerId(); });
+}
+
+std::vector<std::string> ProcessorRegistry::GetFilterIds() {
+	return GetIds<FilterBaseUntemplated>(GetFilters(),
+	                                     [](FilterBaseUntemplated const& filter) { return filter.GetFilterId(); });
+}
+
+std::vector<std::string> ProcessorRegistry::GetConsumerIds() {
+	return GetIds<ConsumerBaseUntemplated>(GetConsumers(),
+	                                       [](ConsumerBaseUntemplated const& consumer) { return consumer.GetConsumerId(); });
+}
+
+void ProcessorRegistry::Print(std::ostream & stream) {
+	std::vector<std::pair<std::string, std::vector<std::string> > > processors = {
+		std::make_pair("Producers", GetProducerIds()),
+		std::make_pair("Filters", GetFilterIds()),
+		std::make_pair("Consumers", GetConsumerIds())
+	};
+	for (std::vector<std::pair<std::string, std::vector<std::string> > >::const_iterator type = processors.begin();
+	     type != processors.end(); ++type)
+	{
+		stream << type->first << " (" << type->second.size() << "):" << std::endl;
+		for (std::vector<std::string>::const_iterator id = type->second.begin(); id != type->second.end(); ++id)
+		{
+			stream << "\t" << *id << std::endl;
+		}
+	}
+}
+
+template<class TProcessor>
+void ProcessorRegistry::UpdateIndex(Table<TProcessor> & table, std::function<std::string(TProcessor const&)> getId) {
+	// the id is only available from an instance
+	for (; table.nIndexed < table.creators.size(); ++table.nIndexed)
+	{
+		std::unique_ptr<TProcessor> processor(table.creators[table.nIndexed]());
+		std::string id = getId(*processor);
+		std::pair<std::unordered_map<std::string, size_t>::iterator, bool> entry = table.index.insert(std::make_pair(id, table.nIndexed));
+		if (! entry.second)
+		{
+			// later registrations, e.g. of derived analyses, override earlier ones
+			LOG(WARNING) << "Processor id \"" << id << "\" has been registered more than once, the last registration is used.";
+			entry.first->second = table.nIndexed;
+		}
+	}
+}
+
+template<class TProcessor>
+TProcessor* ProcessorRegistry::Create(Tables<TProcessor> & tables, std::function<std::string(TProcessor const&)> getId,
+                                      std::type_index types, std::string const& id) {
+	std::lock_guard<std::mutex> lock(GetMutex());
+	typename Tables<TProcessor>::iterator table = tables.find(types);
+	if (table == tables.end())
+	{
+		return nullptr;
+	}
+	UpdateIndex(table->second, getId);
+	typename std::unordered_map<std::string, size_t>::const_iterator creator = table->second.index.find(id);
+	return ((creator == table->second.index.end()) ? nullptr : table->second.creators[creator->second]());
+}
+
+template<class TProcessor>
+std::vector<std::string> ProcessorRegistry::GetIds(Tables<TProcessor> & tables, std::function<std::string(TProcessor const&)> getId) {
+	std::lock_guard<std::mutex> lock(GetMutex());
+	std::set<std::string> ids;
+	for (typename Tables<TProcessor>::iterator table = tables.begin(); table != tables.end(); ++table)
+	{
+		UpdateIndex(table->second, getId);
+		for (typename std::unordered_map<std::string, size_t>::const_iterator creator = table->second.index.begin();
+		     creator != table->second.index.end(); ++creator)
+		{
+			ids.insert(creator->first);
+		}
+	}
+	return std::vector<std::string>(ids.begin(), ids.end());
+}
+
+ProcessorRegistry::Tables<ProducerBaseUntemplated> & ProcessorRegistry::GetProducers() {
+	static Tables<ProducerBaseUntemplated> producers;
+	return producers;
+}
+
+ProcessorRegistry::Tables<FilterBaseUntemplated> & ProcessorRegistry::GetFilters() {
+	static Tables<FilterBaseUntemplated> filters;
+	return filters;
+}
+
+ProcessorRegistry::Tables<ConsumerBaseUntemplated> & ProcessorRegistry::GetConsumers() {
+	static Tables<ConsumerBaseUntemplated> consumers;
+	return consumers;
+}
+
+std::mutex & ProcessorRegistry::GetMutex() {
+	static std::mutex mutex;
+	return mutex;
+}
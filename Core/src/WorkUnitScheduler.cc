@@ -0,0 +1,195 @@
+
+#include <algorithm>
+#include <cerrno>
+#include <new>
+
+#include <sys/mman.h>
+
+#include <TChain.h>
+
+#include "Artus/Core/interface/WorkUnitScheduler.h"
+#include "Artus/Utility/interface/ArtusLogging.h"
+
+
+WorkUnitScheduler::WorkUnitScheduler(std::vector<WorkUnit> const& workUnits, bool shareBetweenProcesses) :
+		m_workUnits(workUnits),
+		m_shareBetweenProcesses(shareBetweenProcesses),
+		m_stateSize(0),
+		m_stateMemory(nullptr),
+		m_state(nullptr),
+		m_front(nullptr),
+		m_back(nullptr) {
+
+	std::stable_sort(m_workUnits.begin(), m_workUnits.end(),
+	                 [](WorkUnit const& unit1, WorkUnit const& unit2) { return unit1.file < unit2.file; });
+
+	long long entries = 0;
+	for (size_t unit = 0; unit < m_workUnits.size(); ++unit) {
+		if ((unit == 0) || (m_workUnits[unit].file != m_workUnits[unit-1].file)) {
+			if (unit > 0) {
+				m_fileEnd.push_back(unit);
+			}
+			m_fileBegin.push_back(unit);
+		}
+		m_entriesBefore.push_back(entries);
+		entries += m_workUnits[unit].endEntry - m_workUnits[unit].firstEntry;
+	}
+	if (! m_workUnits.empty()) {
+		m_fileEnd.push_back(m_workUnits.size());
+	}
+	m_entriesBefore.push_back(entries);
+
+	// the state is modified by all workers
+	m_stateSize = sizeof(State) + 2 * m_fileBegin.size() * sizeof(size_t);
+	if (m_shareBetweenProcesses) {
+		void * memory = mmap(nullptr, m_stateSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+		if (memory == MAP_FAILED) {
+			LOG(FATAL) << "Cannot allocate shared memory for the work unit scheduler!";
+		}
+		m_stateMemory = static_cast<char*>(memory);
+	}
+	else {
+		m_stateMemory = new char[m_stateSize];
+	}
+
+	m_state = new (m_stateMemory) State();
+	pthread_mutexattr_t mutexAttributes;
+	pthread_mutexattr_init(&mutexAttributes);
+	if (m_shareBetweenProcesses) {
+		pthread_mutexattr_setpshared(&mutexAttributes, PTHREAD_PROCESS_SHARED);
+	}
+	pthread_mutexattr_setrobust(&mutexAttributes, PTHREAD_MUTEX_ROBUST);
+	if (pthread_mutex_init(&(m_state->mutex), &mutexAttributes) != 0) {
+		LOG(FATAL) << "Cannot initialise the mutex of the work unit scheduler!";
+	}
+	pthread_mutexattr_destroy(&mutexAttributes);
+	m_state->scheduledEntries.store(0);
+	m_front = reinterpret_cast<size_t*>(m_stateMemory + sizeof(State));
+	m_back = m_front + m_fileBegin.size();
+	std::copy(m_fileBegin.begin(), m_fileBegin.end(), m_front);
+	std::copy(m_fileEnd.begin(), m_fileEnd.end(), m_back);
+}
+
+WorkUnitScheduler::~WorkUnitScheduler() {
+	pthread_mutex_destroy(&(m_state->mutex));
+	m_state->~State();
+	if (m_shareBetweenProcesses) {
+		munmap(m_stateMemory, m_stateSize);
+	}
+	else {
+		delete[] m_stateMemory;
+	}
+}
+
+WorkUnitScheduler::WorkerState WorkUnitScheduler::GetInitialState(size_t worker, size_t nWorkers) const {
+	WorkerState state;
+	state.file = ((m_fileBegin.empty() || (nWorkers == 0)) ? 0 : (worker * m_fileBegin.size()) / nWorkers);
+	state.stealing = false;
+	return state;
+}
+
+bool WorkUnitScheduler::GetNextWorkUnit(WorkerState & state, WorkUnit & workUnit) {
+	Lock();
+
+	if ((state.file >= m_fileBegin.size()) || (m_front[state.file] >= m_back[state.file])) {
+		// steal from the file with the largest number of remaining entries
+		long long maxRemainingEntries = 0;
+		for (size_t file = 0; file < m_fileBegin.size(); ++file) {
+			long long remainingEntries = GetRemainingEntries(file);
+			if (remainingEntries > maxRemainingEntries) {
+				maxRemainingEntries = remainingEntries;
+				state.file = file;
+			}
+		}
+		if (maxRemainingEntries == 0) {
+			Unlock();
+			return false;
+		}
+		state.stealing = true;
+	}
+
+	// the owner of a file reads it from the front, all other workers from the back
+	size_t unit = (state.stealing ? --m_back[state.file] : m_front[state.file]++);
+	workUnit = m_workUnits[unit];
+	m_state->scheduledEntries += (workUnit.endEntry - workUnit.firstEntry);
+
+	Unlock();
+	return true;
+}
+
+long long WorkUnitScheduler::GetTotalEntries() const {
+	return m_entriesBefore.back();
+}
+
+long long WorkUnitScheduler::GetScheduledEntries() const {
+	return m_state->scheduledEntries.load();
+}
+
+std::vector<WorkUnit> WorkUnitScheduler::GetWorkUnits(long long firstEntry, long long endEntry, long long nEntriesPerUnit) {
+	std::vector<WorkUnit> workUnits;
+	nEntriesPerUnit = std::max(nEntriesPerUnit, 1ll);
+	for (long long entry = firstEntry; entry < endEntry; entry += nEntriesPerUnit) {
+		WorkUnit workUnit;
+		workUnit.firstEntry = entry;
+		workUnit.endEntry = std::min(entry + nEntriesPerUnit, endEntry);
+		workUnit.file = 0;
+		workUnits.push_back(workUnit);
+	}
+	return workUnits;
+}
+
+std::vector<WorkUnit> WorkUnitScheduler::GetClusterWorkUnits(TChain & chain, long long firstEntry, long long endEntry) {
+	std::vector<WorkUnit> workUnits;
+
+	// the offsets of the trees are only known after all files have been opened
+	chain.GetEntries();
+	Long64_t const* treeOffsets = chain.GetTreeOffset();
+
+	// the number of trees is never negative, != avoids assumptions about signed overflow
+	int const nFiles = chain.GetNtrees();
+	for (int file = 0; file != nFiles; ++file) {
+		long long fileFirstEntry = treeOffsets[file];
+		long long fileEndEntry = treeOffsets[file+1];
+		if ((fileEndEntry <= firstEntry) || (fileFirstEntry >= endEntry)) {
+			continue;
+		}
+
+		chain.LoadTree(fileFirstEntry);
+		TTree::TClusterIterator clusters = chain.GetTree()->GetClusterIterator(0);
+		long long clusterFirstEntry = 0;
+		while ((clusterFirstEntry = clusters()) < (fileEndEntry - fileFirstEntry)) {
+			WorkUnit workUnit;
+			workUnit.firstEntry = std::max(fileFirstEntry + clusterFirstEntry, firstEntry);
+			workUnit.endEntry = std::min(fileFirstEntry + clusters.GetNextEntry(), std::min(fileEndEntry, endEntry));
+			workUnit.file = file;
+			if (workUnit.firstEntry < workUnit.endEntry) {
+				workUnits.push_back(workUnit);
+			}
+		}
+	}
+
+	LOG(DEBUG) << "Split the input into " << workUnits.size() << " work units aligned to the tree clusters.";
+	return workUnits;
+}
+
+long long WorkUnitScheduler::GetRemainingEntries(size_t file) const {
+	return (m_entriesBefore[m_back[file]] - m_entriesBefore[m_front[file]]);
+}
+
+void WorkUnitScheduler::Lock() {
+	int result = pthread_mutex_lock(&(m_state->mutex));
+	if (result == EOWNERDEAD) {
+		// the owner died while holding the lock, the indices are only changed by single
+		// increments, the units handed out to the dead worker are lost and the parent
+		// process fails the processing for it
+		LOG(WARNING) << "A worker died while scheduling work units.";
+		pthread_mutex_consistent(&(m_state->mutex));
+	}
+	else if (result != 0) {
+		LOG(FATAL) << "Cannot lock the mutex of the work unit scheduler!";
+	}
+}
+
+void WorkUnitScheduler::Unlock() {
+	pthread_mutex_unlock(&(m_state->mutex));
+}
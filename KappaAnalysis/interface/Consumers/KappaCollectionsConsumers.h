@@ -165,7 +165,7 @@ public:
 		RootFileHelper::SafeCd(settings.GetRootOutFile(),
 		                       settings.GetRootFileFolder());
 		
-		m_tree->Write(m_tree->GetName());
+		m_tree->Write(m_tree->GetName(), TObject::kOverwrite);
 	}
 
 
@@ -49,14 +49,14 @@ public:
 		});
 
 		bool bInpData = settings.GetInputIsData();
-		LambdaNtupleConsumer<TTypes>::AddFloatQuantity("npuMean", [bInpData](event_type const& event, product_type const& product)
+		LambdaNtupleConsumer<TTypes>::AddFloatQuantity(settings, "npuMean", [bInpData](event_type const& event, product_type const& product)
 		{
 			if (bInpData)
 				return DefaultValues::UndefinedFloat;
 			return static_cast<KGenEventInfo*>(event.m_eventInfo)->nPUMean;
 		});
 
-		LambdaNtupleConsumer<TTypes>::AddIntQuantity("npu", [bInpData](event_type const& event, product_type const& product)
+		LambdaNtupleConsumer<TTypes>::AddIntQuantity(settings, "npu", [bInpData](event_type const& event, product_type const& product)
 		{
 			if (bInpData)
 				return DefaultValues::UndefinedInt;
@@ -80,8 +80,8 @@ public:
 		for (auto const & quantity : settings.GetQuantities())
 		{
 			if (boost::algorithm::icontains(quantity, "weight") &&
-			    (LambdaNtupleConsumer<TTypes>::GetFloatQuantities().count(quantity) == 0) &&
-			    (LambdaNtupleConsumer<TTypes>::GetDoubleQuantities().count(quantity) == 0))
+			    (! LambdaNtupleConsumer<TTypes>::HasQuantity(settings, quantity, LambdaNtupleQuantities::Type::Float)) &&
+			    (! LambdaNtupleConsumer<TTypes>::HasQuantity(settings, quantity, LambdaNtupleQuantities::Type::Double)))
 			{
 				LOG(DEBUG) << "\tQuantity \"" << quantity << "\" is tried to be taken from product.m_weights or product.m_optionalWeights.";
 				LambdaNtupleConsumer<TTypes>::AddFloatQuantity( quantity, [quantity](event_type const & event, product_type const & product)
@@ -90,7 +90,7 @@ public:
 				} );
 			}
 			if ((boost::algorithm::icontains(quantity, "filter") || boost::algorithm::icontains(quantity, "cut")) &&
-			   (LambdaNtupleConsumer<TTypes>::GetFloatQuantities().count(quantity) == 0))
+			   (! LambdaNtupleConsumer<TTypes>::HasQuantity(settings, quantity, LambdaNtupleQuantities::Type::Float)))
 			{
 				LOG(DEBUG) << "\tQuantity \"" << quantity << "\" is tried to be taken from prduct.fres (FilterResult).";
 				LambdaNtupleConsumer<TTypes>::AddIntQuantity( quantity, [quantity](event_type const & event, product_type const & product)
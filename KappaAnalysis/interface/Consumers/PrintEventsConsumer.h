@@ -17,6 +17,7 @@ public:
 	PrintEventsConsumer();
 
 	std::string GetConsumerId() const override;
+	bool SupportsCheckpoints() const override;
 
 	void ProcessEvent(event_type const& event, product_type const& product,
 	                          setting_type const& settings, FilterResult& result) override;
@@ -16,6 +16,7 @@ public:
 	PrintHltConsumer();
 
 	std::string GetConsumerId() const override;
+	bool SupportsCheckpoints() const override;
 
 	void ProcessFilteredEvent(event_type const& event, product_type const& product,
 	                          setting_type const& settings) override;
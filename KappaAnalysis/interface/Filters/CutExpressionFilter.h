@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Artus/KappaAnalysis/interface/KappaTypes.h"
+
+#include "Artus/Core/interface/FilterBase.h"
+#include "Artus/Utility/interface/Expression.h"
+
+/** Filter applying a boolean expression over LambdaNtuple quantities.
+ *
+ *  The expression (see Expression) is compiled once in Init, e.g.
+ *      "CutExpression" : "nMuons>=2 && leadingMuonPt>25 && abs(leadingMuonEta)<2.1"
+ *  replaces a chain of MinMuonsCountFilter, MuonLowerPtCutsFilter and MuonUpperAbsEtaCutsFilter.
+ *  The clauses of the outermost && are evaluated in order and each of them is reported as a
+ *  single cut to the cut flow. Every quantity is extracted at most once per event and only
+ *  if it is needed for the decision.
+ *
+ *  The producers registering the quantities have to be initialised before this filter.
+ *  Required config tag: CutExpression
+ */
+class CutExpressionFilter: public FilterBase<KappaTypes> {
+public:
+
+	typedef typename std::function<double(EventBase const&, ProductBase const&)> double_extractor_lambda;
+
+	std::string GetFilterId() const override;
+
+	void Init(KappaSettings const& settings) override;
+
+	bool DoesEventPass(KappaEvent const& event,
+	                   KappaProduct const& product,
+	                   KappaSettings const& settings) const override;
+
+	std::vector<std::string> const& GetCutNames() const override;
+	size_t GetNPassedCuts() const override;
+
+private:
+	double LoadVariable(size_t variableIndex) const;
+
+	std::vector<Expression> m_clauses;
+	std::vector<std::string> m_clauseNames;
+	std::vector<std::string> m_variableNames;
+	std::vector<double_extractor_lambda> m_variableExtractors;
+	Expression::VariableLoader m_variableLoader;
+
+	// state of the current event
+	mutable KappaEvent const* m_event = nullptr;
+	mutable KappaProduct const* m_product = nullptr;
+	mutable std::vector<double> m_variableValues;
+	mutable std::vector<unsigned char> m_variableLoaded;
+	mutable size_t m_nPassedClauses = 0;
+};
+
@@ -14,6 +14,7 @@ public:
 	typedef typename std::function<double(KappaEvent const&, KappaProduct const&)> double_extractor_lambda;
 	
 	std::string GetFilterId() const override;
+	std::string GetFingerprint(KappaSettings const& settings) const override;
 	void Init(KappaSettings const& settings) override;
 };
 
@@ -27,6 +28,7 @@ public:
 	typedef typename std::function<double(KappaEvent const&, KappaProduct const&)> double_extractor_lambda;
 	
 	std::string GetFilterId() const override;
+	std::string GetFingerprint(KappaSettings const& settings) const override;
 	void Init(KappaSettings const& settings) override;
 };
 
@@ -40,6 +42,7 @@ public:
 	typedef typename std::function<double(KappaEvent const&, KappaProduct const&)> double_extractor_lambda;
 	
 	std::string GetFilterId() const override;
+	std::string GetFingerprint(KappaSettings const& settings) const override;
 	void Init(KappaSettings const& settings) override;
 };
 
@@ -53,6 +56,7 @@ public:
 	typedef typename std::function<double(KappaEvent const&, KappaProduct const&)> double_extractor_lambda;
 
 	std::string GetFilterId() const override;
+	std::string GetFingerprint(KappaSettings const& settings) const override;
 	void Init(KappaSettings const& settings) override;
 };
 
@@ -66,6 +70,7 @@ public:
 	typedef typename std::function<double(KappaEvent const&, KappaProduct const&)> double_extractor_lambda;
 
 	std::string GetFilterId() const override;
+	std::string GetFingerprint(KappaSettings const& settings) const override;
 	void Init(KappaSettings const& settings) override;
 };
 
@@ -79,5 +84,6 @@ public:
 	typedef typename std::function<double(KappaEvent const&, KappaProduct const&)> double_extractor_lambda;
 
 	std::string GetFilterId() const override;
+	std::string GetFingerprint(KappaSettings const& settings) const override;
 	void Init(KappaSettings const& settings) override;
 };
@@ -77,8 +77,8 @@ protected:
 						this->m_cuts.push_back(std::pair<double_extractor_lambda, CutRange>(
 								[this, tmpHltName, pattern, tmpIndex](KappaEvent const& event, KappaProduct const& product) -> double {
 									bool hasMatch = false;
-									for (unsigned int iHlt = 0; iHlt < product.m_selectedHltNames.size(); ++iHlt)
-										hasMatch = hasMatch || boost::regex_search(product.m_selectedHltNames.at(iHlt), pattern);
+									for (unsigned int iHlt = 0; iHlt < product.m_selectedHltIndices.size(); ++iHlt)
+										hasMatch = hasMatch || boost::regex_search(product.GetSelectedHltName(iHlt), pattern);
 
 									return (((product.*m_validLeptonsMember).size() > tmpIndex && hasMatch) ?
 									        (product.*m_validLeptonsMember).at(tmpIndex)->p4.Pt() :
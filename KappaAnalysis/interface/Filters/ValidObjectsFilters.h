@@ -14,6 +14,7 @@ public:
 	typedef typename std::function<double(KappaEvent const&, KappaProduct const&)> double_extractor_lambda;
 	
 	std::string GetFilterId() const override;
+	std::string GetFingerprint(KappaSettings const& settings) const override;
 	void Init(KappaSettings const& settings) override;
 };
 
@@ -26,6 +27,7 @@ public:
 	typedef typename std::function<double(KappaEvent const&, KappaProduct const&)> double_extractor_lambda;
 	
 	std::string GetFilterId() const override;
+	std::string GetFingerprint(KappaSettings const& settings) const override;
 	void Init(KappaSettings const& settings) override;
 };
 
@@ -38,6 +40,7 @@ public:
 	typedef typename std::function<double(KappaEvent const&, KappaProduct const&)> double_extractor_lambda;
 	
 	std::string GetFilterId() const override;
+	std::string GetFingerprint(KappaSettings const& settings) const override;
 	void Init(KappaSettings const& settings) override;
 };
 
@@ -50,6 +53,7 @@ public:
 	typedef typename std::function<double(KappaEvent const&, KappaProduct const&)> double_extractor_lambda;
 	
 	std::string GetFilterId() const override;
+	std::string GetFingerprint(KappaSettings const& settings) const override;
 	void Init(KappaSettings const& settings) override;
 };
 
@@ -62,5 +66,6 @@ public:
 	typedef typename std::function<double(KappaEvent const&, KappaProduct const&)> double_extractor_lambda;
 	
 	std::string GetFilterId() const override;
+	std::string GetFingerprint(KappaSettings const& settings) const override;
 	void Init(KappaSettings const& settings) override;
 };
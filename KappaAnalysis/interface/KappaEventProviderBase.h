@@ -12,6 +12,7 @@
 #include "Kappa/DataFormats/interface/KDebug.h"
 
 #include "Artus/Core/interface/PipelineRunner.h"
+#include "Artus/Utility/interface/RootFileHelper.h"
 #include "KappaTools/RootTools/interface/FileInterface2.h"
 #include "KappaTools/Toolbox/interface/ProgressMonitor.h"
 
@@ -85,6 +86,24 @@ public:
 		return (m_batchMode ? m_fi.eventdata.GetEntriesFast() : m_fi.eventdata.GetEntries());
 	}
 
+	std::vector<WorkUnit> GetWorkUnits(long long firstEntry, long long endEntry) const override {
+		return WorkUnitScheduler::GetClusterWorkUnits(m_fi.eventdata, firstEntry, endEntry);
+	}
+
+	void ReopenInput() override {
+		RootFileHelper::CloseCurrentFile(m_fi.eventdata);
+		RootFileHelper::CloseCurrentFile(m_fi.lumidata);
+	}
+
+	void PrepareWorkUnit(WorkUnit const& workUnit) override {
+		// restrict the prefetching of the tree cache to the entries of this work unit
+		long long localEntry = m_fi.eventdata.LoadTree(workUnit.firstEntry);
+		if ((localEntry >= 0) && (m_fi.eventdata.GetTree() != nullptr))
+		{
+			m_fi.eventdata.GetTree()->SetCacheEntryRange(localEntry, localEntry + (workUnit.endEntry - workUnit.firstEntry));
+		}
+	}
+
 
 protected:
 
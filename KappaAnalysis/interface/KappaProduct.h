@@ -3,10 +3,15 @@
 #include "Kappa/DataFormats/interface/Kappa.h"
 
 #include "KappaTools/RootTools/interface/HLTTools.h"
-#include "MotherDaughterBundle.h"
 
 #include "Artus/Core/interface/ProductBase.h"
 #include "Artus/KappaAnalysis/interface/KappaEnumTypes.h"
+#include "Artus/KappaAnalysis/interface/MotherDaughterBundle.h"
+#include "Artus/KappaAnalysis/interface/Utility/EtaPhiIndex.h"
+#include "Artus/KappaAnalysis/interface/Utility/GenDecayGraph.h"
+#include "Artus/KappaAnalysis/interface/Utility/GenParticleIndex.h"
+#include "Artus/KappaAnalysis/interface/Utility/ResolvedHltPaths.h"
+#include "Artus/KappaAnalysis/interface/Utility/TriggerMatchResults.h"
 
 /**
    \brief Container class for everything that can be produced in pipeline.
@@ -43,6 +48,9 @@ public:
 	std::map<std::string, double> m_optionalWeights;
 
 	// filled by GenTauDecayProducer
+	// the graph is not changed afterwards and therefore shared by the copies of the product in all pipelines
+	std::shared_ptr<GenDecayGraph const> m_genBosonDecayGraph;
+	// copy of the graph in the old format, only filled if FillGenBosonMotherDaughterBundles is set
 	std::vector<MotherDaughterBundle> m_genBoson;
 
 	/// added by ElectronCorrectionProducer
@@ -89,6 +97,10 @@ public:
 	std::vector<KBasicJet*> m_validJets;
 	std::vector<KBasicJet*> m_invalidJets;
 
+	/// index of the gen particles, built by the first gen producer in the event which needs it
+	// the index is not changed afterwards and therefore shared by the copies of the product in all pipelines
+	std::shared_ptr<GenParticleIndex const> m_genParticleIndex;
+
 	/// added by GenParticleProducer
 	std::map<int, std::vector<KGenParticle*>> m_genParticlesMap;
 	std::vector<KGenParticle*> m_genElectrons;
@@ -107,9 +119,16 @@ public:
 	
 	mutable HLTTools m_hltInfo = HLTTools();
 	// selected means fired (and unprescaled if requested)
-	std::vector<std::string> m_selectedHltNames;
+	// the selected paths are indices into the paths resolved by the HltProducer
+	std::shared_ptr<ResolvedHltPaths const> m_resolvedHltPaths;
+	std::vector<size_t> m_selectedHltIndices;
 	std::vector<int> m_selectedHltPositions;
 	std::vector<int> m_selectedHltPrescales;
+	
+	std::string const& GetSelectedHltName(size_t selectedHltIndex) const
+	{
+		return m_resolvedHltPaths->paths[m_selectedHltIndices[selectedHltIndex]].name;
+	}
 
 	/// added by TriggerMatchingProducer
 	std::map<KElectron*, KLV*> m_triggerMatchedElectrons;
@@ -121,14 +140,20 @@ public:
 	std::map<KLepton*, KLV*> m_triggerMatchedLeptons;
 	
 	/// added by TriggerMatchingProducer
-	// m_detailedTriggerMatchedElectrons[reco lepton][HLT name][filter name] = {trigger objects}
-	std::map<KElectron*, std::map<std::string, std::map<std::string, std::vector<KLV*> > > > m_detailedTriggerMatchedElectrons;
-	std::map<KMuon*, std::map<std::string, std::map<std::string, std::vector<KLV*> > > > m_detailedTriggerMatchedMuons;
-	std::map<KTau*, std::map<std::string, std::map<std::string, std::vector<KLV*> > > > m_detailedTriggerMatchedTaus;
-	std::map<KBasicJet*, std::map<std::string, std::map<std::string, std::vector<KLV*> > > > m_detailedTriggerMatchedJets;
-	std::map<KJet*, std::map<std::string, std::map<std::string, std::vector<KLV*> > > > m_detailedTriggerMatchedTaggedJets;
-	
-	std::map<KLepton*, std::map<std::string, std::map<std::string, std::vector<KLV*> > >* > m_detailedTriggerMatchedLeptons;
+	// one entry per reco object, fired HLT path and fired filter with the indices of the matched trigger objects
+	TriggerMatchResults<KElectron> m_detailedTriggerMatchedElectrons;
+	TriggerMatchResults<KMuon> m_detailedTriggerMatchedMuons;
+	TriggerMatchResults<KTau> m_detailedTriggerMatchedTaus;
+	TriggerMatchResults<KBasicJet> m_detailedTriggerMatchedJets;
+	TriggerMatchResults<KJet> m_detailedTriggerMatchedTaggedJets;
+	
+	TriggerMatchResults<KLepton> m_detailedTriggerMatchedLeptons;
+
+	/// added by the gen matching producers, built by the first producer in the event which needs them
+	// the indices are not changed afterwards and therefore shared by the copies of the product in all pipelines
+	std::shared_ptr<EtaPhiIndex const> m_genParticlesEtaPhiIndex;
+	std::shared_ptr<EtaPhiIndex const> m_genTausEtaPhiIndex; // directions of the visible decay products
+	std::shared_ptr<EtaPhiIndex const> m_genTauJetsEtaPhiIndex;
 
 	/// added by GenMatchingProducer
 	std::map<KElectron*, KGenParticle*> m_genParticleMatchedElectrons;
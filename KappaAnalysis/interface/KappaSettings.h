@@ -259,6 +259,9 @@ public:
 	//settings for nPUFilter
 	IMPL_SETTING(int, MinNPU);
 	IMPL_SETTING(int, MaxNPU);
+
+	// settings for CutExpressionFilter
+	IMPL_SETTING_DEFAULT(std::string, CutExpression, "");
 	
 	IMPL_SETTING_DEFAULT(size_t, MinNMatchedElectrons, 0);
 	IMPL_SETTING_DEFAULT(size_t, MinNMatchedMuons, 0);
@@ -289,6 +292,8 @@ public:
 	//Reading Boson PdgId and Status code for GenTauDecayProducer studies.
 	IMPL_SETTING(int, BosonPdgId);
 	IMPL_SETTING_DEFAULT(int, BosonStatus, 3);  //keep pythia6 status as default for back-compatibility
+	// copy the decay graph into the old trees of KappaProduct::m_genBoson, needed only by analyses still reading them
+	IMPL_SETTING_DEFAULT(bool, FillGenBosonMotherDaughterBundles, false);
 
 	/// Needed by the GenPartonCounterProducer
 	IMPL_SETTING_DEFAULT(int, PartonStatus, 3);  //keep pythia6 status as default for back-compatibility
@@ -315,6 +320,8 @@ public:
 	IMPL_SETTING_STRINGLIST_DEFAULT(TmvaInputQuantities, {});
 	IMPL_SETTING_STRINGLIST_DEFAULT(TmvaMethods, {});
 	IMPL_SETTING_STRINGLIST_DEFAULT(TmvaWeights, {});
+	// evaluate BDT methods with the BdtEvaluator instead of TMVA
+	IMPL_SETTING_DEFAULT(bool, TmvaNativeBdt, false);
 
 	// KappaCollectionsConsumer settings
 	IMPL_SETTING_DEFAULT(bool, BranchGenMatchedElectrons, false);
@@ -5,15 +5,36 @@
 #include "KappaTools/RootTools/interface/HLTTools.h"
 
 #include "Artus/Utility/interface/DefaultValues.h"
+#include "Artus/Utility/interface/Utility.h"
+
+#include "Artus/KappaAnalysis/interface/Utility/GenDecayGraph.h"
 /**
    \brief Extended class for genParticles in HiggsAnalysis
    This class implements additional quantities: charge, final states in the decay 
    subtree of considered particles. The final states can be devided into one, three and five prongs.
-  
+
+   The trees are only kept for analyses, which still read KappaProduct::m_genBoson. They are
+   copied from the GenDecayGraph, which should be used instead.
 */
 class MotherDaughterBundle {
 public:
 	explicit MotherDaughterBundle(KGenParticle* newnode) : node(newnode) {}
+
+	/// copy of the subtree of a node of the decay graph including the decay modes
+	MotherDaughterBundle(GenDecayGraph const& genDecayGraph, GenDecayGraph::Node const& graphNode) :
+		finalState(graphNode.finalState),
+		node(graphNode.particle),
+		decayMode(static_cast<DecayMode>(Utility::ToUnderlyingValue(graphNode.decayMode)))
+	{
+		setCharge();
+		setDetectable();
+		Daughters.reserve(graphNode.nDaughters);
+		for (size_t daughter = 0; daughter < graphNode.nDaughters; ++daughter)
+		{
+			Daughters.push_back(MotherDaughterBundle(genDecayGraph, *genDecayGraph.GetDaughter(&graphNode, daughter)));
+		}
+	}
+
 	~MotherDaughterBundle() {};
 	bool finalState = false;
 	std::vector<MotherDaughterBundle*> finalStates;
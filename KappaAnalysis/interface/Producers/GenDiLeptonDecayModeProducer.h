@@ -32,8 +32,5 @@ public:
 
 	void Produce(KappaEvent const& event, KappaProduct& product,
 	                     KappaSettings const& settings) const override;
-
-private:
-	int NeutralParticles(std::vector<MotherDaughterBundle*> finalStateProngs) const;
 };
 
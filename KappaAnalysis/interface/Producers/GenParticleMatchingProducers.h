@@ -56,6 +56,8 @@ private:
 	float m_DeltaRMatchingRecoJetGenParticle;
 	bool m_InvalidateNonGenParticleMatchingRecoJets;
 	bool m_InvalidateGenParticleMatchingRecoJets;
+
+	mutable std::vector<size_t> m_genParticleCandidates;
 };
 
 
@@ -77,7 +79,7 @@ public:
 	RecoLeptonGenParticleMatchingProducerBase(std::map<TLepton*, KGenParticle*> product_type::*genParticleMatchedLeptons,
 	                                          std::vector<TLepton*> product_type::*validLeptons,
 	                                          std::vector<TLepton*> product_type::*invalidLeptons,
-	                                          std::vector<int>& (setting_type::*GetRecoLeptonMatchingGenParticlePdgIds)(void) const,
+	                                          std::vector<int> const& (setting_type::*GetRecoLeptonMatchingGenParticlePdgIds)(void) const,
 	                                          int (setting_type::*GetRecoLeptonMatchingGenParticleStatus)(void) const,
 	                                          float (setting_type::*GetDeltaRMatchingRecoLeptonsGenParticle)(void) const,
 	                                          bool (setting_type::*GetInvalidateNonGenParticleMatchingLeptons)(void) const,
@@ -115,6 +117,13 @@ public:
 
 		if ((settings.*GetDeltaRMatchingRecoLeptonsGenParticle)() > 0.0f)
 		{
+			if (! product.m_genParticlesEtaPhiIndex)
+			{
+				std::shared_ptr<EtaPhiIndex> genParticlesEtaPhiIndex(new EtaPhiIndex());
+				genParticlesEtaPhiIndex->Build(*event.m_genParticles);
+				product.m_genParticlesEtaPhiIndex = genParticlesEtaPhiIndex;
+			}
+
 			// loop over all valid leptons to check
 			for (typename std::vector<TLepton*>::iterator validLepton = (product.*m_validLeptons).begin();
 				 validLepton != (product.*m_validLeptons).end();)
@@ -123,10 +132,19 @@ public:
 				float deltaR = 0.0f;
 				float deltaRmin = std::numeric_limits<float>::max();
 
-				// loop over all genParticles
-				for (typename std::vector<KGenParticle>::iterator genParticle = event.m_genParticles->begin();
-					genParticle != event.m_genParticles->end(); ++genParticle)
+				// loop over the genParticles in the cone in the order of the collection, the first one with the smallest
+				// deltaR is matched. The deltaR of the event is only kept if the last genParticle of the collection has matched.
+				product.m_genParticlesEtaPhiIndex->GetCandidates((*validLepton)->p4.Eta(), (*validLepton)->p4.Phi(),
+				                                                 (settings.*GetDeltaRMatchingRecoLeptonsGenParticle)(),
+				                                                 m_genParticleCandidates);
+				if (! event.m_genParticles->empty())
 				{
+					product.m_genParticleMatchDeltaR = DefaultValues::UndefinedFloat;
+				}
+				for (std::vector<size_t>::const_iterator genParticleIndex = m_genParticleCandidates.begin();
+				     genParticleIndex != m_genParticleCandidates.end(); ++genParticleIndex)
+				{
+					typename std::vector<KGenParticle>::iterator genParticle = event.m_genParticles->begin() + *genParticleIndex;
 					// only use genParticles that will decay into comparable particles
 					if ((settings.*GetRecoLeptonMatchingGenParticlePdgIds)().empty() ||
 					    Utility::Contains((settings.*GetRecoLeptonMatchingGenParticlePdgIds)(), std::abs(genParticle->pdgId())))
@@ -140,16 +158,13 @@ public:
 							{
 								(product.*m_genParticleMatchedLeptons)[*validLepton] = &(*genParticle);
 								ratioGenParticleMatched += (1.0f / (product.*m_validLeptons).size());
-								product.m_genParticleMatchDeltaR = deltaR;
+								product.m_genParticleMatchDeltaR = (((*genParticleIndex + 1) == event.m_genParticles->size()) ? deltaR : DefaultValues::UndefinedFloat);
 								deltaRmin = deltaR;
 								leptonMatched = true;
 								//LOG(INFO) << this->GetProducerId() << " (event " << event.m_eventInfo->nEvent << "): " << (*validLepton)->p4 << " --> " << genParticle->p4 << ", pdg=" << genParticle->pdgId() << ", status=" << genParticle->status();
 							}
-							else product.m_genParticleMatchDeltaR = DefaultValues::UndefinedFloat;
 						}
-						else product.m_genParticleMatchDeltaR = DefaultValues::UndefinedFloat;
 					}
-					else product.m_genParticleMatchDeltaR = DefaultValues::UndefinedFloat;
 				}
 				// invalidate (non) matching lepton if requested
 				if (((! leptonMatched) && (settings.*GetInvalidateNonGenParticleMatchingLeptons)()) ||
@@ -184,7 +199,7 @@ private:
 	std::map<TLepton*, KGenParticle*> product_type::*m_genParticleMatchedLeptons; //changed to KGenParticle from const KDataLV
 	std::vector<TLepton*> product_type::*m_validLeptons;
 	std::vector<TLepton*> product_type::*m_invalidLeptons;
-	std::vector<int>& (setting_type::*GetRecoLeptonMatchingGenParticlePdgIds)(void) const;
+	std::vector<int> const& (setting_type::*GetRecoLeptonMatchingGenParticlePdgIds)(void) const;
 	int (setting_type::*GetRecoLeptonMatchingGenParticleStatus)(void) const;
 	float (setting_type::*GetDeltaRMatchingRecoLeptonsGenParticle)(void) const;
 	bool (setting_type::*GetInvalidateNonGenParticleMatchingLeptons)(void) const;
@@ -193,6 +208,8 @@ private:
 	std::map<size_t, std::vector<std::string> > m_leptonTriggerFiltersByIndex;
 	std::map<std::string, std::vector<std::string> > m_leptonTriggerFiltersByHltName;
 
+	mutable std::vector<size_t> m_genParticleCandidates;
+
 };
 
 
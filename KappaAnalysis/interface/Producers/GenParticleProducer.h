@@ -13,6 +13,7 @@
    Gen particles need to be wired with { "GenParticles" : "genParticles" } first.
    "GenParticleTypes" is a list which can contain genParticle for gen particles in general and/or genElectron, genMuon, genTau for the gen leptons.
    If "genParticle" is selected, the pdgIds from the list "GenParticlePdgIds" will be taken as input.
+   The gen particles are looked up in the gen particle index of the event, which is built on first use.
    Example for a valid configuration that writes out genTaus as well as Higgs and W with status 3:
    {
    "GenParticleTypes" : ["genParticle", "genTau"],
@@ -49,6 +50,7 @@ private:
 	static GenParticleType ToGenParticleType(std::string const& genParcticleName);
 	
 	std::vector<GenParticleType> genParticleTypes;
+	std::vector<int> genParticlePdgIds;
 
 };
 
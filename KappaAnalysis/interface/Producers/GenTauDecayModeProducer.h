@@ -42,8 +42,5 @@ public:
 		EM   = 5,
 		EE   = 6
 	};
-
-private:
-	int NeutralParticles(std::vector<MotherDaughterBundle*> finalStateProngs) const;
 };
 
@@ -16,6 +16,9 @@
    this collection :
 
    - tree with three generations of decay products : Boson, Bosondaughters, Bosongranddaughters  
+     (stored as GenDecayGraph together with the final states and decay modes of all subtrees)
+   - copies of these trees in KappaProduct::m_genBoson including the final states of the first two
+     taus, only if FillGenBosonMotherDaughterBundles is set
 
    If need arises to store other decay trees, this code can be made more general and
    configurable.
@@ -31,8 +34,13 @@ public:
 
 	void Produce(KappaEvent const& event, KappaProduct& product,
 	                     KappaSettings const& settings) const override;
-private:
-	void BuildDecayTree(MotherDaughterBundle & lastProductParentRef, unsigned int lastEventParentIndex, event_type const& event) const;
 
+private:
+	// node of the decay graph, nullptr if the node or the graph does not exist in this event
+	template<class... TIndices>
+	static GenDecayGraph::Node const* GetGenBosonNode(KappaProduct const& product, TIndices... indices)
+	{
+		return (product.m_genBosonDecayGraph ? product.m_genBosonDecayGraph->GetNode(indices...) : nullptr);
+	}
 };
 
@@ -60,6 +60,13 @@ public:
 		
 		if ((settings.*GetDeltaRMatchingRecoObjectGenTauJet)() > 0.0)
 		{
+			if (! product.m_genTauJetsEtaPhiIndex)
+			{
+				std::shared_ptr<EtaPhiIndex> genTauJetsEtaPhiIndex(new EtaPhiIndex());
+				genTauJetsEtaPhiIndex->Build(*event.m_genTauJets);
+				product.m_genTauJetsEtaPhiIndex = genTauJetsEtaPhiIndex;
+			}
+
 			// loop over all valid objects to check
 			for (typename std::vector<TValidObject*>::iterator validObject = (product.*m_validObjects).begin();
 				 validObject != (product.*m_validObjects).end();)
@@ -68,10 +75,14 @@ public:
 				float deltaR = 0;
 				float deltaRmin = std::numeric_limits<float>::max();
 				
-				// loop over all genTauJets
-				for (typename std::vector<KGenJet>::iterator genTauJet = event.m_genTauJets->begin();
-					genTauJet != event.m_genTauJets->end(); ++genTauJet) 
+				// loop over the genTauJets in the cone in the order of the collection, the first one with the smallest deltaR is matched
+				product.m_genTauJetsEtaPhiIndex->GetCandidates((*validObject)->p4.Eta(), (*validObject)->p4.Phi(),
+				                                               (settings.*GetDeltaRMatchingRecoObjectGenTauJet)(),
+				                                               m_genTauJetCandidates);
+				for (std::vector<size_t>::const_iterator genTauJetIndex = m_genTauJetCandidates.begin();
+				     genTauJetIndex != m_genTauJetCandidates.end(); ++genTauJetIndex)
 				{
+					typename std::vector<KGenJet>::iterator genTauJet = event.m_genTauJets->begin() + *genTauJetIndex;
 					// TODO: maybe need to match to visible component of genTauJet
 					// depends on setting for TauGenJetProducer.includeNeutrinos
 					// PhysicsTools/JetMCAlgos/python/TauGenJets_cfi.py
@@ -118,6 +129,8 @@ private:
 	std::map<size_t, std::vector<std::string> > m_objectTriggerFiltersByIndex;
 	std::map<std::string, std::vector<std::string> > m_objectTriggerFiltersByHltName;
 
+	mutable std::vector<size_t> m_genTauJetCandidates;
+
 };
 
 
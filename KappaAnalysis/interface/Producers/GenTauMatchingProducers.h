@@ -70,6 +70,18 @@ public:
 		
 		if ((settings.*GetDeltaRMatchingRecoObjectGenTau)() > 0.0f)
 		{
+			if (! product.m_genTausEtaPhiIndex)
+			{
+				std::shared_ptr<EtaPhiIndex> genTausEtaPhiIndex(new EtaPhiIndex());
+				for (size_t genTauIndex = 0; genTauIndex < event.m_genTaus->size(); ++genTauIndex)
+				{
+					genTausEtaPhiIndex->Add(genTauIndex, event.m_genTaus->at(genTauIndex).visible.p4.Eta(),
+					                        event.m_genTaus->at(genTauIndex).visible.p4.Phi());
+				}
+				genTausEtaPhiIndex->Finalise();
+				product.m_genTausEtaPhiIndex = genTausEtaPhiIndex;
+			}
+
 			// loop over all valid objects to check
 			for (typename std::vector<TValidObject*>::iterator validObject = (product.*m_validObjects).begin();
 				 validObject != (product.*m_validObjects).end();)
@@ -78,10 +90,19 @@ public:
 				float deltaR = 0;
 				float deltaRmin = std::numeric_limits<float>::max();
 				
-				// loop over all genTaus
-				for (typename std::vector<KGenTau>::iterator genTau = event.m_genTaus->begin(); 
-					genTau != event.m_genTaus->end(); ++genTau) 
+				// loop over the genTaus in the cone in the order of the collection, the first one with the smallest
+				// deltaR is matched. The deltaR of the event is only kept if the last genTau of the collection has matched.
+				product.m_genTausEtaPhiIndex->GetCandidates((*validObject)->p4.Eta(), (*validObject)->p4.Phi(),
+				                                            (settings.*GetDeltaRMatchingRecoObjectGenTau)(),
+				                                            m_genTauCandidates);
+				if (! event.m_genTaus->empty())
+				{
+					product.m_genTauMatchDeltaR = DefaultValues::UndefinedFloat;
+				}
+				for (std::vector<size_t>::const_iterator genTauIndex = m_genTauCandidates.begin();
+				     genTauIndex != m_genTauCandidates.end(); ++genTauIndex)
 				{
+					typename std::vector<KGenTau>::iterator genTau = event.m_genTaus->begin() + *genTauIndex;
 					// only use genTaus that will decay into comparable particles
 					if (MatchDecayMode(*genTau,tauDecayMode))
 					{
@@ -90,14 +111,12 @@ public:
 						{
 							(product.*m_genTauMatchedObjects)[*validObject] = &(*genTau);
 							ratioGenTauMatched += 1.0 / (product.*m_validObjects).size();
-							product.m_genTauMatchDeltaR = deltaR;
+							product.m_genTauMatchDeltaR = (((*genTauIndex + 1) == event.m_genTaus->size()) ? deltaR : DefaultValues::UndefinedFloat);
 							deltaRmin = deltaR;
 							objectMatched = true;
 							//LOG(INFO) << this->GetProducerId() << " (event " << event.m_eventInfo->nEvent << "): " << (*validObject)->p4 << " --> " << genTau->visible.p4;
 						}
-						else product.m_genTauMatchDeltaR = DefaultValues::UndefinedFloat;
 					}
-					else product.m_genTauMatchDeltaR = DefaultValues::UndefinedFloat;
 				}
 				// invalidate the object if it has not matched
 				if (((! objectMatched) && (settings.*GetInvalidateNonGenTauMatchingObjects)()) ||
@@ -146,6 +165,8 @@ private:
 	std::map<size_t, std::vector<std::string> > m_objectTriggerFiltersByIndex;
 	std::map<std::string, std::vector<std::string> > m_objectTriggerFiltersByHltName;
 
+	mutable std::vector<size_t> m_genTauCandidates;
+
 };
 
 
@@ -2,17 +2,24 @@
 #pragma once
 
 #include <limits>
+#include <memory>
 
 #include "Kappa/DataFormats/interface/Kappa.h"
+#include "KappaTools/RootTools/interface/HLTTools.h"
 #include "KappaTools/RootTools/interface/RunLumiReader.h"
 
 #include "Artus/KappaAnalysis/interface/KappaProducerBase.h"
+#include "Artus/KappaAnalysis/interface/Utility/ResolvedHltPaths.h"
 #include "Artus/Utility/interface/DefaultValues.h"
 
 
 /** 
+ *	Selects the fired HLT paths out of the configured ones (HltPaths).
  *
- *	
+ *	The names, positions and prescales of the configured paths only change with the lumi section.
+ *	They are resolved once per lumi section, such that only the trigger bits of the resolved
+ *	positions need to be tested for every event. The product refers to the selected paths by
+ *	their indices in the resolved paths.
  */
 class HltProducer: public KappaProducerBase
 {
@@ -24,5 +31,22 @@ public:
 	void Produce(KappaEvent const& event, KappaProduct& product,
 	                     KappaSettings const& settings) const override;
 
+private:
+	void ResolveHltPaths(KLumiInfo const* lumiInfo, stringvector const& hltPaths, stringvector const* hltPathsSettings) const;
+
+	// resolution of the configured paths for the current lumi section
+	mutable HLTTools m_hltTools;
+	mutable std::shared_ptr<ResolvedHltPaths const> m_resolvedHltPaths;
+	mutable KLumiInfo const* m_resolvedLumiInfo = nullptr;
+	mutable unsigned long long m_resolvedRun = 0;
+	mutable unsigned long long m_resolvedLumi = 0;
+	// the paths from the settings are identified by their address, only paths overwritten by
+	// previous producers (nullptr here) need to be compared with the resolved patterns
+	mutable stringvector const* m_resolvedHltPathsSettings = nullptr;
+	mutable stringvector m_resolvedHltPatterns;
+
+	// trigger with the lowest prescale out of all resolved paths
+	mutable int m_lowestPrescale = std::numeric_limits<int>::max();
+	mutable std::string m_lowestPrescaleHltName;
 };
 
@@ -7,16 +7,13 @@
 #include <boost/algorithm/string/trim.hpp>
 #include <boost/regex.hpp>
 
-#include "CondFormats/JetMETObjects/interface/FactorizedJetCorrector.h"
-#include "CondFormats/JetMETObjects/interface/JetCorrectionUncertainty.h"
 #include "CondFormats/JetMETObjects/interface/JetCorrectorParameters.h"
 
 #include "Kappa/DataFormats/interface/Kappa.h"
 
-#define USE_JEC
-#include "KappaTools/RootTools/interface/JECTools.h"
-
 #include "Artus/KappaAnalysis/interface/KappaProducerBase.h"
+#include "Artus/KappaAnalysis/interface/Utility/JetEnergyCorrection.h"
+#include "Artus/Utility/interface/SharedResourceCache.h"
 #include "Artus/Utility/interface/Utility.h"
 
 /**
@@ -33,6 +30,10 @@
    
    Documentation:
    https://twiki.cern.ch/twiki/bin/view/CMSPublic/WorkBookJetEnergyCorrections#JetEnCorFWLite
+   
+   The parameters are converted once into a JetEnergyCorrection (and JetEnergyCorrectionUncertainty)
+   shared by all pipelines. The corrections of all jets of an event are evaluated at once from
+   arrays of their kinematics.
 
    TODO: the code can be moved to a .cc file, if there are no external users using the TJet templated 
          version
@@ -53,50 +54,52 @@ public:
 	{
 	}
 	
-	~JetCorrectionsProducerBase()
-	{
-		delete factorizedJetCorrector;
-	}
-
 	void Init(KappaSettings const& settings) override
 	{
 		KappaProducerBase::Init(settings);
 		
+		// the correctors are shared by all pipelines using the same files
 		// load correction parameters
-		LOG(DEBUG) << "\tLoading JetCorrectorParameters from files...";
-		std::vector<JetCorrectorParameters> jecParameters;
-		for (std::vector<std::string>::const_iterator jecParametersFile = settings.GetJetEnergyCorrectionParameters().begin();
-		     jecParametersFile != settings.GetJetEnergyCorrectionParameters().end(); ++jecParametersFile)
+		std::vector<std::string> const& jecParametersFiles = settings.GetJetEnergyCorrectionParameters();
+		if (jecParametersFiles.size() > 0)
 		{
-			jecParameters.push_back(JetCorrectorParameters(*jecParametersFile));
-			LOG(DEBUG) << "\t\t" << *jecParametersFile;
-		}
-		if (jecParameters.size() > 0)
-		{
-			factorizedJetCorrector = new FactorizedJetCorrector(jecParameters);
+			jetEnergyCorrection = SharedResourceCache::Get<JetEnergyCorrection>(
+					boost::algorithm::join(jecParametersFiles, ","), "",
+					[&jecParametersFiles]()
+			{
+				LOG(DEBUG) << "\tLoading JetCorrectorParameters from files...";
+				std::vector<JetCorrectorParameters> jecParameters;
+				for (std::vector<std::string>::const_iterator jecParametersFile = jecParametersFiles.begin();
+				     jecParametersFile != jecParametersFiles.end(); ++jecParametersFile)
+				{
+					jecParameters.push_back(JetCorrectorParameters(*jecParametersFile));
+					LOG(DEBUG) << "\t\t" << *jecParametersFile;
+				}
+				return new JetEnergyCorrection(jecParameters);
+			});
 		}
 		
 		// initialise uncertainty calculation
-		LOG(DEBUG) << "\tLoading JetCorrectionUncertainty from files...";
 		if ((! settings.GetJetEnergyCorrectionUncertaintyParameters().empty()) &&
 		    (settings.GetJetEnergyCorrectionUncertaintyShift() != 0.0))
 		{
-			JetCorrectorParameters* jecUncertaintyParameters = nullptr;
-			if (!settings.GetJetEnergyCorrectionUncertaintySource().empty()) {
-				jecUncertaintyParameters = new JetCorrectorParameters(
-						settings.GetJetEnergyCorrectionUncertaintyParameters(),
-						settings.GetJetEnergyCorrectionUncertaintySource()
-				);
-			}
-			else {
-				jecUncertaintyParameters = new JetCorrectorParameters(settings.GetJetEnergyCorrectionUncertaintyParameters());
-			}
-			if ((!jecUncertaintyParameters->isValid()) || (jecUncertaintyParameters->size() == 0))
-				LOG(FATAL) << "Invalid definition " << settings.GetJetEnergyCorrectionUncertaintySource() 
-				           << " in file " << settings.GetJetEnergyCorrectionUncertaintyParameters();
-			jetCorrectionUncertainty = new JetCorrectionUncertainty(*jecUncertaintyParameters);
-			LOG(DEBUG) << "\t\t" << settings.GetJetEnergyCorrectionUncertaintySource();
-			LOG(DEBUG) << "\t\t" << settings.GetJetEnergyCorrectionUncertaintyParameters();
+			std::string const& jecUncertaintyFile = settings.GetJetEnergyCorrectionUncertaintyParameters();
+			std::string const& jecUncertaintySource = settings.GetJetEnergyCorrectionUncertaintySource();
+			jetEnergyCorrectionUncertainty = SharedResourceCache::Get<JetEnergyCorrectionUncertainty>(
+					jecUncertaintyFile, jecUncertaintySource,
+					[&jecUncertaintyFile, &jecUncertaintySource]()
+			{
+				LOG(DEBUG) << "\tLoading JetCorrectionUncertainty from files...";
+				JetCorrectorParameters jecUncertaintyParameters = (jecUncertaintySource.empty() ?
+				                                                   JetCorrectorParameters(jecUncertaintyFile) :
+				                                                   JetCorrectorParameters(jecUncertaintyFile, jecUncertaintySource));
+				if ((!jecUncertaintyParameters.isValid()) || (jecUncertaintyParameters.size() == 0))
+					LOG(FATAL) << "Invalid definition " << jecUncertaintySource
+					           << " in file " << jecUncertaintyFile;
+				LOG(DEBUG) << "\t\t" << jecUncertaintySource;
+				LOG(DEBUG) << "\t\t" << jecUncertaintyFile;
+				return new JetEnergyCorrectionUncertainty(jecUncertaintyParameters);
+			});
 		}
 	}
 
@@ -107,32 +110,70 @@ public:
 		assert(event.m_pileupDensity);
 		assert(event.m_vertexSummary);
 		
-		// create a copy of all jets in the event (first temporarily for the JEC)
-		(product.*m_correctedJetsMember).clear();
-		std::vector<TJet> correctJetsForJecTools((event.*m_basicJetsMember)->size());
-		size_t jetIndex = 0;
-		for (typename std::vector<TJet>::const_iterator jet = (event.*m_basicJetsMember)->begin();
-			 jet != (event.*m_basicJetsMember)->end(); ++jet)
+		// kinematics of all jets as arrays for the JEC
+		std::vector<TJet> const& jets = *(event.*m_basicJetsMember);
+		size_t const nJets = jets.size();
+		jetPt.resize(nJets);
+		jetEta.resize(nJets);
+		jetPhi.resize(nJets);
+		jetEnergy.resize(nJets);
+		jetArea.resize(nJets);
+		for (size_t jetIndex = 0; jetIndex < nJets; ++jetIndex)
 		{
-			correctJetsForJecTools[jetIndex] = *jet;
-			++jetIndex;
+			jetPt[jetIndex] = jets[jetIndex].p4.Pt();
+			jetEta[jetIndex] = jets[jetIndex].p4.Eta();
+			jetPhi[jetIndex] = jets[jetIndex].p4.Phi();
+			jetEnergy[jetIndex] = jets[jetIndex].p4.E();
+			jetArea[jetIndex] = jets[jetIndex].area;
 		}
+		JetCorrectionInputs jetCorrectionInputs;
+		jetCorrectionInputs.pt = jetPt.data();
+		jetCorrectionInputs.eta = jetEta.data();
+		jetCorrectionInputs.phi = jetPhi.data();
+		jetCorrectionInputs.energy = jetEnergy.data();
+		jetCorrectionInputs.area = jetArea.data();
+		jetCorrectionInputs.size = nJets;
+		jetCorrectionInputs.rho = event.m_pileupDensity->rho;
+		jetCorrectionInputs.nPrimaryVertices = event.m_vertexSummary->nVertices;
 		
-		// apply jet energy corrections and uncertainty shift
-		correctJets(&correctJetsForJecTools, factorizedJetCorrector, jetCorrectionUncertainty,
-		            event.m_pileupDensity->rho, event.m_vertexSummary->nVertices, -1,
-		            settings.GetJetEnergyCorrectionUncertaintyShift());
+		// apply jet energy corrections
+		correctionFactors.assign(nJets, 1.0f);
+		if (jetEnergyCorrection)
+		{
+			jetEnergyCorrection->GetCorrections(jetCorrectionInputs, correctionFactors.data());
+		}
+		
+		// apply uncertainty shift, evaluated for the corrected jets
+		float const uncertaintyShift = settings.GetJetEnergyCorrectionUncertaintyShift();
+		uncertaintyFactors.assign(nJets, 1.0f);
+		if (jetEnergyCorrectionUncertainty && (uncertaintyShift != 0.0))
+		{
+			for (size_t jetIndex = 0; jetIndex < nJets; ++jetIndex)
+			{
+				jetPt[jetIndex] *= correctionFactors[jetIndex];
+			}
+			size_t nJetsOutsideBins = jetEnergyCorrectionUncertainty->GetUncertainties(
+					jetCorrectionInputs, (uncertaintyShift > 0.0), uncertaintyFactors.data());
+			if ((nJetsOutsideBins > 0) && (! m_warnedJetsOutsideUncertaintyBins))
+			{
+				LOG(WARNING) << "Jets outside of the bins of the jet energy correction uncertainties are not shifted. "
+				             << "This warning is only given for the first event with such jets.";
+				m_warnedJetsOutsideUncertaintyBins = true;
+			}
+			for (size_t jetIndex = 0; jetIndex < nJets; ++jetIndex)
+			{
+				uncertaintyFactors[jetIndex] = 1.0f + (uncertaintyShift * uncertaintyFactors[jetIndex]);
+			}
+		}
 		
 		// create the shared pointers to store in the product
 		(product.*m_correctedJetsMember).clear();
-		(product.*m_correctedJetsMember).resize(correctJetsForJecTools.size());
-		jetIndex = 0;
-		for (typename std::vector<TJet>::const_iterator jet = correctJetsForJecTools.begin();
-			 jet != correctJetsForJecTools.end(); ++jet)
+		(product.*m_correctedJetsMember).resize(nJets);
+		for (size_t jetIndex = 0; jetIndex < nJets; ++jetIndex)
 		{
-			(product.*m_correctedJetsMember)[jetIndex] = std::shared_ptr<TJet>(new TJet(*jet));
-			product.m_originalJets[(product.*m_correctedJetsMember)[jetIndex].get()] = &(*jet);
-			++jetIndex;
+			(product.*m_correctedJetsMember)[jetIndex] = std::shared_ptr<TJet>(new TJet(jets[jetIndex]));
+			(product.*m_correctedJetsMember)[jetIndex]->p4 *= (correctionFactors[jetIndex] * uncertaintyFactors[jetIndex]);
+			product.m_originalJets[(product.*m_correctedJetsMember)[jetIndex].get()] = &(jets[jetIndex]);
 		}
 		
 		// perform corrections on copied jets
@@ -164,8 +205,19 @@ private:
 	std::vector<TJet>* KappaEvent::*m_basicJetsMember;
 	std::vector<std::shared_ptr<TJet> > KappaProduct::*m_correctedJetsMember;
 
-	FactorizedJetCorrector* factorizedJetCorrector = nullptr;
-	JetCorrectionUncertainty* jetCorrectionUncertainty = nullptr;
+	// shared with other pipelines, not changed after the initialisation
+	std::shared_ptr<JetEnergyCorrection const> jetEnergyCorrection;
+	std::shared_ptr<JetEnergyCorrectionUncertainty const> jetEnergyCorrectionUncertainty;
+	
+	// buffers reused for every event
+	mutable std::vector<float> jetPt;
+	mutable std::vector<float> jetEta;
+	mutable std::vector<float> jetPhi;
+	mutable std::vector<float> jetEnergy;
+	mutable std::vector<float> jetArea;
+	mutable std::vector<float> correctionFactors;
+	mutable std::vector<float> uncertaintyFactors;
+	mutable bool m_warnedJetsOutsideUncertaintyBins = false;
 };
 
 
@@ -1,6 +1,8 @@
 
 #pragma once
 
+#include <memory>
+
 #include "Artus/KappaAnalysis/interface/KappaProducerBase.h"
 
 
@@ -29,8 +31,13 @@ public:
 
 
 private:
-		std::vector<double> m_pileupWeights;
-		double m_bins;
+		struct PileupWeights
+		{
+			std::vector<double> weights;
+			double bins = 0.0;
+		};
+
+		std::shared_ptr<PileupWeights const> m_pileupWeights;
 
 };
 
@@ -1,6 +1,10 @@
 
 #pragma once
 
+#include <array>
+
+#include <boost/algorithm/string/join.hpp>
+#include <boost/algorithm/string/predicate.hpp>
 #include <boost/algorithm/string/split.hpp>
 #include <boost/algorithm/string/trim.hpp>
 
@@ -8,12 +12,18 @@
 
 #include "Artus/Core/interface/ProducerBase.h"
 #include "Artus/KappaAnalysis/interface/Consumers/KappaLambdaNtupleConsumer.h"
+#include "Artus/Utility/interface/BdtEvaluator.h"
 #include "Artus/Utility/interface/DefaultValues.h"
+#include "Artus/Utility/interface/RootFileHelper.h"
+#include "Artus/Utility/interface/SharedResourceCache.h"
 #include "Artus/KappaAnalysis/interface/KappaProducerBase.h"
 
 
 /**
    \brief Abstract producer base for reading/applying TMVA classifications.
+
+   With the setting TmvaNativeBdt, the methods starting with "BDT" are evaluated by the
+   BdtEvaluator from their weight files instead of the TMVA::Reader.
 */
 template<class TTypes>
 class TmvaClassificationReaderBase: public ProducerBase<TTypes>
@@ -32,9 +42,9 @@ public:
 		return (methodNameIndex == mvaOutputs.end() ? DefaultValues::UndefinedDouble : mvaOutputs[methodNameIndex - mvaOutputs.begin()]);
 	}
 	
-	TmvaClassificationReaderBase(std::vector<std::string>& (setting_type::*GetTmvaInputQuantities)(void) const,
-								 std::vector<std::string>& (setting_type::*GetTmvaMethods)(void) const,
-								 std::vector<std::string>& (setting_type::*GetTmvaWeights)(void) const,
+	TmvaClassificationReaderBase(std::vector<std::string> const& (setting_type::*GetTmvaInputQuantities)(void) const,
+								 std::vector<std::string> const& (setting_type::*GetTmvaMethods)(void) const,
+								 std::vector<std::string> const& (setting_type::*GetTmvaWeights)(void) const,
 								 std::vector<double> product_type::*mvaOutputs) :
 		ProducerBase<TTypes>(),
 		GetTmvaInputQuantities(GetTmvaInputQuantities),
@@ -50,6 +60,8 @@ public:
 		
 		// construct extractors vector
 		m_inputExtractors.clear();
+		// expressions of the input variables as declared to TMVA, "label := expression" or "expression"
+		std::vector<std::string> inputExpressions;
 		for (std::vector<std::string>::const_iterator quantity = (settings.*GetTmvaInputQuantities)().begin();
 			 quantity != (settings.*GetTmvaInputQuantities)().end(); ++quantity)
 		{
@@ -58,74 +70,150 @@ public:
 			transform(splitted.begin(), splitted.end(), splitted.begin(),
 					  [](std::string s) { return boost::algorithm::trim_copy(s); });
 			std::string lambdaQuantity = splitted.front();
+			size_t separator = quantity->find(":=");
+			inputExpressions.push_back(boost::algorithm::trim_copy((separator == std::string::npos) ? *quantity : quantity->substr(separator + 2)));
 			
-			if (LambdaNtupleConsumer<TTypes>::GetFloatQuantities().count(lambdaQuantity) > 0)
+			LambdaNtupleQuantities::Registration registration = LambdaNtupleQuantities::Find(
+					settings.GetName(),
+					LambdaNtupleQuantities::GetQuantityId(lambdaQuantity)
+			);
+			if (registration.type == LambdaNtupleQuantities::Type::Float)
 			{
-				m_inputExtractors.push_back(SafeMap::Get(LambdaNtupleConsumer<TTypes>::GetFloatQuantities(), lambdaQuantity));
+				m_inputExtractors.push_back(LambdaNtupleQuantities::GetExtractor<float>(registration.index));
 			}
-			else if(LambdaNtupleConsumer<TTypes>::GetIntQuantities().count(lambdaQuantity) > 0)
+			else if (registration.type == LambdaNtupleQuantities::Type::Int)
 			{
-				m_inputExtractors.push_back(SafeMap::Get(LambdaNtupleConsumer<TTypes>::GetIntQuantities(), lambdaQuantity));
+				m_inputExtractors.push_back(LambdaNtupleQuantities::GetExtractor<int>(registration.index));
 			}
 			else
 			{
 				LOG(FATAL) << "The TMVA interface currently only supports float-type and int-type input variables!";
 			}
 		}
+		assert((settings.*GetTmvaMethods)().size() == (settings.*GetTmvaWeights)().size());
+		m_tmvaMethodNames.clear();
+		m_bdtEvaluators.clear();
+		bool needsTmvaReader = false;
+		for (size_t mvaMethodIndex = 0; mvaMethodIndex < (settings.*GetTmvaMethods)().size(); ++mvaMethodIndex)
+		{
+			std::string const& tmvaMethod = (settings.*GetTmvaMethods)()[mvaMethodIndex];
+			std::string const& tmvaWeights = (settings.*GetTmvaWeights)()[mvaMethodIndex];
+			m_tmvaMethodNames.push_back(tmvaMethod + boost::lexical_cast<std::string>(mvaMethodIndex));
+			
+			if (settings.GetTmvaNativeBdt() && boost::algorithm::starts_with(tmvaMethod, "BDT"))
+			{
+				// the evaluator is immutable and shared by all pipelines using the same weight file
+				m_bdtEvaluators.push_back(SharedResourceCache::Get<BdtEvaluator>(
+						tmvaWeights, "",
+						[&tmvaWeights]() { return new BdtEvaluator(tmvaWeights); }
+				));
+				// the TMVA::Reader fails for input variables differing from the training as well
+				if (m_bdtEvaluators.back()->GetVariableNames() != inputExpressions)
+				{
+					LOG(FATAL) << "The BDT weight file \"" << tmvaWeights << "\" expects the input variables \""
+					           << boost::algorithm::join(m_bdtEvaluators.back()->GetVariableNames(), "\", \"")
+					           << "\", but \"" << boost::algorithm::join(inputExpressions, "\", \"") << "\" are configured!";
+				}
+			}
+			else
+			{
+				m_bdtEvaluators.push_back(std::shared_ptr<BdtEvaluator const>());
+				needsTmvaReader = true;
+			}
+		}
+		
+		// the reader stores the input variables and is therefore not shared with other pipelines
+		tmvaReader.reset();
+		m_tmvaInputValues.clear();
+		if (! needsTmvaReader)
+		{
+			if (m_inputExtractors.size() > s_maxNativeInputQuantities)
+			{
+				LOG(FATAL) << "The native BDT evaluation supports at most " << s_maxNativeInputQuantities
+				           << " input variables, but " << m_inputExtractors.size() << " are configured!";
+			}
+			return;
+		}
+		m_tmvaInputValues.resize(m_inputExtractors.size());
+		
+		// TMVA registers its objects in the global state of ROOT
+		std::lock_guard<std::recursive_mutex> lock(RootFileHelper::GetRootMutex());
+		tmvaReader.reset(new TMVA::Reader());
 		
 		// register TMVA input variables
 		for (std::vector<std::string>::const_iterator quantity = (settings.*GetTmvaInputQuantities)().begin();
 			 quantity != (settings.*GetTmvaInputQuantities)().end(); ++quantity)
 		{
-			tmvaReader.AddVariable(*quantity, static_cast<float*>(nullptr));
+			tmvaReader->AddVariable(*quantity, static_cast<float*>(nullptr));
 		}
 		
-		// loading TMVA weight files
-		assert((settings.*GetTmvaMethods)().size() == (settings.*GetTmvaWeights)().size());
+		// loading TMVA weight files of the methods not evaluated natively
 		LOG(DEBUG) << "\tLoading TMVA weight files...";
 		for (size_t mvaMethodIndex = 0; mvaMethodIndex < (settings.*GetTmvaMethods)().size(); ++mvaMethodIndex)
 		{
-			std::string tmvaMethod = (settings.*GetTmvaMethods)()[mvaMethodIndex]+ boost::lexical_cast<std::string>(mvaMethodIndex);
-			std::string tmvaWeights = (settings.*GetTmvaWeights)()[mvaMethodIndex];
-			LOG(DEBUG) << "\t\tmethod: " << tmvaMethod << ", weight file: " << tmvaWeights;
-			tmvaReader.BookMVA(tmvaMethod, tmvaWeights);
+			if (m_bdtEvaluators[mvaMethodIndex])
+			{
+				continue;
+			}
+			std::string const& tmvaWeights = (settings.*GetTmvaWeights)()[mvaMethodIndex];
+			LOG(DEBUG) << "\t\tmethod: " << m_tmvaMethodNames[mvaMethodIndex] << ", weight file: " << tmvaWeights;
+			tmvaReader->BookMVA(m_tmvaMethodNames[mvaMethodIndex], tmvaWeights);
 		}
 	}
 
 	void Produce(event_type const& event, product_type& product,
 						 setting_type const& settings) const override
 	{
-		// construct and fill input vector
-		std::vector<double> tmvaInputs(m_inputExtractors.size());
+		// fill input values, on the stack unless they are needed by the TMVA::Reader
+		std::array<float, s_maxNativeInputQuantities> nativeInputValues;
+		float* inputValues = (tmvaReader ? m_tmvaInputValues.data() : nativeInputValues.data());
 		size_t inputQuantityIndex = 0;
 		for(typename std::vector<float_extractor_lambda>::const_iterator inputExtractor = m_inputExtractors.begin();
 			inputExtractor != m_inputExtractors.end(); ++inputExtractor)
 		{
-			tmvaInputs[inputQuantityIndex] = (*inputExtractor)(event, product);
+			inputValues[inputQuantityIndex] = (*inputExtractor)(event, product);
 			++inputQuantityIndex;
 		}
 		
 		// retrieve MVA outputs
-		(product.*m_mvaOutputsMember) = std::vector<double>((settings.*GetTmvaMethods)().size());
-		for (size_t mvaMethodIndex = 0; mvaMethodIndex < (settings.*GetTmvaMethods)().size(); ++mvaMethodIndex)
+		(product.*m_mvaOutputsMember).resize(m_tmvaMethodNames.size());
+		for (size_t mvaMethodIndex = 0; mvaMethodIndex < m_tmvaMethodNames.size(); ++mvaMethodIndex)
 		{
-			std::string tmvaMethod = (settings.*GetTmvaMethods)()[mvaMethodIndex]+ boost::lexical_cast<std::string>(mvaMethodIndex);
-			(product.*m_mvaOutputsMember)[mvaMethodIndex] = tmvaReader.EvaluateMVA(tmvaInputs, tmvaMethod.c_str());
+			if (m_bdtEvaluators[mvaMethodIndex])
+			{
+				(product.*m_mvaOutputsMember)[mvaMethodIndex] = m_bdtEvaluators[mvaMethodIndex]->Evaluate(inputValues);
+			}
+			else
+			{
+				(product.*m_mvaOutputsMember)[mvaMethodIndex] = tmvaReader->EvaluateMVA(m_tmvaInputValues, m_tmvaMethodNames[mvaMethodIndex].c_str());
+			}
 		}
 	}
 
 
 private:
-	std::vector<std::string>& (setting_type::*GetTmvaInputQuantities)(void) const;
-	std::vector<std::string>& (setting_type::*GetTmvaMethods)(void) const;
-	std::vector<std::string>& (setting_type::*GetTmvaWeights)(void) const;
+	static const size_t s_maxNativeInputQuantities = 128;
+	
+	std::vector<std::string> const& (setting_type::*GetTmvaInputQuantities)(void) const;
+	std::vector<std::string> const& (setting_type::*GetTmvaMethods)(void) const;
+	std::vector<std::string> const& (setting_type::*GetTmvaWeights)(void) const;
 	std::vector<double> product_type::*m_mvaOutputsMember;
 	
 	std::vector<float_extractor_lambda> m_inputExtractors;
-	mutable TMVA::Reader tmvaReader;
+	// method names booked in the reader, the index makes them unique
+	std::vector<std::string> m_tmvaMethodNames;
+	// native evaluators of the BDT methods, nullptr for methods evaluated by the reader
+	std::vector<std::shared_ptr<BdtEvaluator const> > m_bdtEvaluators;
+	// not shared with other pipelines, since it stores the input variables
+	std::unique_ptr<TMVA::Reader> tmvaReader;
+	// input values of the current event for the reader, which is not re-entrant anyway
+	mutable std::vector<float> m_tmvaInputValues;
 
 };
 
+template<class TTypes>
+const size_t TmvaClassificationReaderBase<TTypes>::s_maxNativeInputQuantities;
+
 
 /**
    \brief Producer for general MVA discriminators
@@ -1,9 +1,34 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cmath>
+#include <map>
+
+#include <boost/regex.hpp>
+
 #include "Kappa/DataFormats/interface/Kappa.h"
 
 #include "Artus/KappaAnalysis/interface/KappaProducerBase.h"
+#include "Artus/KappaAnalysis/interface/Utility/TriggerMatchResults.h"
+
+
+/** Kernel of the trigger matching
+ *
+ *	The loop over the trigger objects is vectorised by the compiler already at -O2: it runs over full
+ *	blocks, has no branches, the arrays do not overlap and the result has the width of the inputs.
+ *	It is not defined in the header, since the loop is not vectorised any more after inlining.
+ */
+class TriggerObjectMatching
+{
+public:
+	enum { BlockSize = 4 };
+	
+	// matched[i] = 1.0 if the trigger object i is within the cone of the object, otherwise 0.0
+	// same convention for the azimuthal difference as in ROOT::Math::VectorUtil::DeltaR
+	static void MatchDeltaR(double eta, double phi, double const* triggerObjectsEta, double const* triggerObjectsPhi,
+	                        size_t nBlocks, double deltaR2Max, double* matched);
+};
 
 
 /** Abstract Producer class for trigger matching valid objects
@@ -18,37 +43,19 @@ public:
 
 	// reccommended access to product.m_detailedTriggerMatched.... by using only the HLT paths where all configured filters match with the valid object
 	static std::vector<std::string> GetHltNamesWhereAllFiltersMatched(
-			std::map<std::string, std::map<std::string, std::vector<KLV*> > > const& detailedTriggerMatchedObjects
+			TriggerMatchResults<TValidObject> const& detailedTriggerMatchedObjects,
+			TValidObject const* validObject
 	) {
-		std::vector<std::string> hltNames;
-		
-		for (std::pair<std::string, std::map<std::string, std::vector<KLV*> > > hltName : detailedTriggerMatchedObjects)
-		{
-			bool allFiltersMatched = true;
-			for (std::pair<std::string, std::vector<KLV*> > filterName : hltName.second)
-			{
-				if (filterName.second.size() == 0)
-				{
-					allFiltersMatched = false;
-				}
-			}
-			
-			if (allFiltersMatched)
-			{
-				hltNames.push_back(hltName.first);
-			}
-		}
-		
-		return hltNames;
+		return detailedTriggerMatchedObjects.GetHltNamesWhereAllFiltersMatched(validObject);
 	}
 	
 	TriggerMatchingProducerBase(std::map<TValidObject*, KLV*> KappaProduct::*triggerMatchedObjects,
-	                            std::map<TValidObject*, std::map<std::string, std::map<std::string, std::vector<KLV*> > > > KappaProduct::*detailedTriggerMatchedObjects,
+	                            TriggerMatchResults<TValidObject> KappaProduct::*detailedTriggerMatchedObjects,
 	                            std::vector<TValidObject*> KappaProduct::*validObjects,
 	                            std::vector<TValidObject*> KappaProduct::*invalidObjects,
 	                            std::map<size_t, std::vector<std::string> > KappaProduct::*settingsObjectTriggerFiltersByIndex,
 	                            std::map<std::string, std::vector<std::string> > KappaProduct::*settingsObjectTriggerFiltersByHltName,
-	                            std::vector<std::string>& (KappaSettings::*GetObjectTriggerFilterNames)(void) const,
+	                            std::vector<std::string> const& (KappaSettings::*GetObjectTriggerFilterNames)(void) const,
 	                            float (KappaSettings::*GetDeltaRTriggerMatchingObjects)(void) const,
 	                            bool (KappaSettings::*GetInvalidateNonMatchingObjects)(void) const) :
 		m_triggerMatchedObjects(triggerMatchedObjects),
@@ -86,78 +93,74 @@ public:
 			                                                          m_objectTriggerFiltersByHltNameFromSettings.end());
 		}
 		
+		TriggerMatchResults<TValidObject>& detailedTriggerMatchedObjects = (product.*m_detailedTriggerMatchedObjects);
 		(product.*m_triggerMatchedObjects).clear();
-		(product.*m_detailedTriggerMatchedObjects).clear();
-		if ((! product.m_selectedHltNames.empty()) && ((settings.*GetDeltaRTriggerMatchingObjects)() > 0.0))
+		detailedTriggerMatchedObjects.Clear();
+		if ((! product.m_selectedHltIndices.empty()) && ((settings.*GetDeltaRTriggerMatchingObjects)() > 0.0))
 		{
+			// the interned ids of the resolved HLT paths only change with their resolution
+			if (product.m_resolvedHltPaths->generation != m_resolvedHltGeneration)
+			{
+				m_resolvedHltIds.clear();
+				for (std::vector<ResolvedHltPaths::Path>::const_iterator hltPath = product.m_resolvedHltPaths->paths.begin();
+				     hltPath != product.m_resolvedHltPaths->paths.end(); ++hltPath)
+				{
+					m_resolvedHltIds.push_back(GetInternedId(hltPath->name, m_hltIds, m_hltRanks, &TriggerMatchNames::GetHltId));
+				}
+				m_resolvedHltGeneration = product.m_resolvedHltPaths->generation;
+			}
+			
 			bool hasAllHltMatches = true;
 			bool hasHltAndFilterMatch = false;
 			
+			// collect the fired filters of the fired HLT paths which match the configuration
+			m_checkedFilters.clear();
+			
 			// loop over the hlt names given in the config file
 			for (std::map<std::string, std::vector<std::string>>::const_iterator objectTriggerFilterByHltName = (product.*m_settingsObjectTriggerFiltersByHltName).begin();
 			     objectTriggerFilterByHltName != (product.*m_settingsObjectTriggerFiltersByHltName).end();
 			     ++objectTriggerFilterByHltName)
 			{
-				//LOG(DEBUG) << "objectTriggerFilterByHltName->first = " << objectTriggerFilterByHltName->first;
+				boost::regex const& hltRegex = GetRegex(objectTriggerFilterByHltName->first);
 				
 				// loop over all fired HLT paths
-				for (unsigned int firedHltIndex = 0; firedHltIndex < product.m_selectedHltNames.size(); ++firedHltIndex)
+				for (unsigned int firedHltIndex = 0; firedHltIndex < product.m_selectedHltIndices.size(); ++firedHltIndex)
 				{
-					std::string firedHltName = product.m_selectedHltNames.at(firedHltIndex);
+					std::string const& firedHltName = product.GetSelectedHltName(firedHltIndex);
 					int firedHltPosition = product.m_selectedHltPositions.at(firedHltIndex);
-					//LOG(DEBUG) << "\tfiredFilterIndex, firedHltName, firedHltPosition = " << firedHltIndex << ", " << firedHltName << ", " << firedHltPosition;
 					
 					// check that the hlt name given in the config matches the hlt which fired in the event
-					if (boost::regex_search(firedHltName, boost::regex(objectTriggerFilterByHltName->first, boost::regex::icase | boost::regex::extended)))
+					if (boost::regex_search(firedHltName, hltRegex))
 					{
-						//LOG(DEBUG) << "\t\thltMatched";
+						size_t hltId = m_resolvedHltIds[product.m_selectedHltIndices[firedHltIndex]];
 						
 						// loop over the filter regexp associated with the given hlt in the config
 						for (std::vector<std::string>::const_iterator filterName = objectTriggerFilterByHltName->second.begin();
 						     filterName != objectTriggerFilterByHltName->second.end();
 						     ++filterName)
 						{
-							//LOG(DEBUG) << "\t\t\tfilterName = " << *filterName;
+							boost::regex const& filterRegex = GetRegex(*filterName);
 							
 							// loop over all filters for the fired HLT
 							for (size_t firedFilterIndex = event.m_triggerObjectMetadata->getMinFilterIndex(firedHltPosition);
 							     firedFilterIndex < event.m_triggerObjectMetadata->getMaxFilterIndex(firedHltPosition);
 							     ++firedFilterIndex)
 							{
-								std::string firedFilterName = event.m_triggerObjectMetadata->toFilter[firedFilterIndex];
-								//LOG(DEBUG) << "\t\t\t\tfiredFilterIndex, firedFilterName = " << firedFilterIndex << ", " << firedFilterName;
+								std::string const& firedFilterName = event.m_triggerObjectMetadata->toFilter[firedFilterIndex];
 								
 								// check that the filter regexp given in the config matches the fired filter
-								if (boost::regex_search(firedFilterName, boost::regex(*filterName, boost::regex::icase | boost::regex::extended)))
+								if (boost::regex_search(firedFilterName, filterRegex))
 								{
 									hasHltAndFilterMatch = true;
-									//LOG(DEBUG) << "\t\t\t\t\tfilterMatched";
 									
-									// loop over all valid objects to check
-									for (typename std::vector<TValidObject*>::iterator validObject = (product.*m_validObjects).begin();
-									     validObject != (product.*m_validObjects).end(); ++validObject)
+									// every filter of an HLT path is only checked once, even if several regexps match
+									CheckedFilter checkedFilter;
+									checkedFilter.hltId = hltId;
+									checkedFilter.filterIndex = firedFilterIndex;
+									if (std::find(m_checkedFilters.begin(), m_checkedFilters.end(), checkedFilter) == m_checkedFilters.end())
 									{
-										std::vector<KLV*> matchedTriggerObjects;
-										//LOG(DEBUG) << "\t\t\t\t\t\tvalidObject = " << *validObject << ", (pt, eta, phi) = (" << (*validObject)->p4.Pt() << ", " << (*validObject)->p4.Phi() << ", " << (*validObject)->p4.Phi() << ")";
-										
-										// loop over all trigger objects for the fired filter
-										for (std::vector<int>::const_iterator triggerObjectIndex = event.m_triggerObjects->toIdxFilter[firedFilterIndex].begin();
-										     triggerObjectIndex != event.m_triggerObjects->toIdxFilter[firedFilterIndex].end();
-										     ++triggerObjectIndex)
-										{
-											KLV triggerObject = event.m_triggerObjects->trgObjects.at(*triggerObjectIndex);
-											//LOG(DEBUG) << "\t\t\t\t\t\t\ttriggerObjectIndex, triggerObject = " << *triggerObjectIndex << ", " << &triggerObject << ", (pt, eta, phi) = (" << triggerObject.p4.Pt() << ", " << triggerObject.p4.Phi() << ", " << triggerObject.p4.Phi() << ")";
-											
-											// check the matching
-											if (ROOT::Math::VectorUtil::DeltaR(triggerObject.p4, (*validObject)->p4) < (settings.*GetDeltaRTriggerMatchingObjects)() && triggerObject.p4.Pt() > settings.GetTriggerObjectLowerPtCut())
-											{
-												//LOG(DEBUG) << "\t\t\t\t\t\t\t\tobjectMatched";
-												
-												matchedTriggerObjects.push_back(&triggerObject);
-											}
-										}
-										
-										(product.*m_detailedTriggerMatchedObjects)[*validObject][firedHltName][firedFilterName] = matchedTriggerObjects;
+										checkedFilter.filterId = GetInternedId(firedFilterName, m_filterIds, m_filterRanks, &TriggerMatchNames::GetFilterId);
+										m_checkedFilters.push_back(checkedFilter);
 									}
 								}
 							}
@@ -170,20 +173,46 @@ public:
 				}
 			}
 			
-			for (typename std::pair<TValidObject*, std::map<std::string, std::map<std::string, std::vector<KLV*> > > > triggerMatchingResult : (product.*m_detailedTriggerMatchedObjects))
+			// the first match of an object is searched in the order of the HLT names and filter names
+			std::stable_sort(m_checkedFilters.begin(), m_checkedFilters.end(),
+			                 [this](CheckedFilter const& checkedFilter1, CheckedFilter const& checkedFilter2) -> bool
+			                 { return ((m_hltRanks[checkedFilter1.hltId] < m_hltRanks[checkedFilter2.hltId]) ||
+			                           ((checkedFilter1.hltId == checkedFilter2.hltId) &&
+			                            (m_filterRanks[checkedFilter1.filterId] < m_filterRanks[checkedFilter2.filterId]))); });
+			
+			// match the valid objects with the trigger objects of the collected filters
+			detailedTriggerMatchedObjects.Reserve(m_checkedFilters.size() * (product.*m_validObjects).size(),
+			                                      m_checkedFilters.size() * (product.*m_validObjects).size());
+			if (! m_checkedFilters.empty())
 			{
-				// check matching results for having passed all configured filters
-				std::vector<std::string> hltNamesWhereAllFiltersMatched = TriggerMatchingProducerBase::GetHltNamesWhereAllFiltersMatched(triggerMatchingResult.second);
-				if (hltNamesWhereAllFiltersMatched.size() > 0)
-				{
-					// store first trigger object of first filter of first HLT name
-					(product.*m_triggerMatchedObjects)[triggerMatchingResult.first] = ((triggerMatchingResult.second)[hltNamesWhereAllFiltersMatched.front()].begin()->second).front();
-				}
-				else if (hasAllHltMatches && hasHltAndFilterMatch && (settings.*GetInvalidateNonMatchingObjects)())
+				MatchTriggerObjects(event, product, settings);
+			}
+			
+			if (! detailedTriggerMatchedObjects.Empty())
+			{
+				// the objects are numbered as in the matching, before any of them is invalidated
+				size_t nMatchedObjects = (product.*m_validObjects).size();
+				size_t validObjectIndex = 0;
+				for (size_t matchedObjectIndex = 0; matchedObjectIndex < nMatchedObjects; ++matchedObjectIndex)
 				{
-					// invalidate the object if the trigger has not matched
-					(product.*m_invalidObjects).push_back(triggerMatchingResult.first);
-					(product.*m_validObjects).erase(std::find((product.*m_validObjects).begin(), (product.*m_validObjects).end(), &(*triggerMatchingResult.first)));
+					TValidObject* validObject = (product.*m_validObjects)[validObjectIndex];
+					
+					// check matching results for having passed all configured filters
+					typename TriggerMatchResults<TValidObject>::Entry const* firstMatch = GetFirstMatch(detailedTriggerMatchedObjects, matchedObjectIndex, nMatchedObjects);
+					if (firstMatch != nullptr)
+					{
+						// store first trigger object of first filter of first HLT name
+						int triggerObjectIndex = detailedTriggerMatchedObjects.GetTriggerObjectIndices()[firstMatch->firstTriggerObject];
+						(product.*m_triggerMatchedObjects)[validObject] = &(event.m_triggerObjects->trgObjects.at(triggerObjectIndex));
+					}
+					else if (hasAllHltMatches && hasHltAndFilterMatch && (settings.*GetInvalidateNonMatchingObjects)())
+					{
+						// invalidate the object if the trigger has not matched
+						(product.*m_invalidObjects).push_back(validObject);
+						(product.*m_validObjects).erase((product.*m_validObjects).begin() + validObjectIndex);
+						continue;
+					}
+					++validObjectIndex;
 				}
 			}
 			
@@ -195,20 +224,15 @@ public:
 			/*
 			// debug output
 			LOG(INFO) << "Result of trigger matching (Run: " << event.m_eventInfo->nRun << ", Lumi: " << event.m_eventInfo->nLumi << ", Event: " << event.m_eventInfo->nEvent << "):";
-			for (typename std::pair<TValidObject*, std::map<std::string, std::map<std::string, std::vector<KLV*> > > > validObject : (product.*m_detailedTriggerMatchedObjects))
+			for (typename TriggerMatchResults<TValidObject>::Entry const& entry : detailedTriggerMatchedObjects.GetEntries())
 			{
-				LOG(INFO) << "Reco object: (pt = " << validObject.first->p4.Pt() << ", eta = " << validObject.first->p4.Eta() << ", phi = " << validObject.first->p4.Phi() << ", mass = " << validObject.first->p4.mass() << ")";
-				for (std::pair<std::string, std::map<std::string, std::vector<KLV*> > > hltName : validObject.second)
+				LOG(INFO) << "Reco object: (pt = " << entry.object->p4.Pt() << ", eta = " << entry.object->p4.Eta() << ", phi = " << entry.object->p4.Phi() << ", mass = " << entry.object->p4.mass() << ")";
+				LOG(INFO) << "\tHLT name: " << TriggerMatchNames::GetHltName(entry.hltId);
+				LOG(INFO) << "\t\tFilter name: " << TriggerMatchNames::GetFilterName(entry.filterId);
+				for (size_t index = entry.firstTriggerObject; index < entry.endTriggerObject; ++index)
 				{
-					LOG(INFO) << "\tHLT name: " << hltName.first;
-					for (std::pair<std::string, std::vector<KLV*> > filterName : hltName.second)
-					{
-						LOG(INFO) << "\t\tFilter name: " << filterName.first;
-						for (KLV* triggerObject : filterName.second)
-						{
-							LOG(INFO) << "\t\t\tTrigger object: (pt = " << triggerObject->p4.Pt() << ", eta = " << triggerObject->p4.Eta() << ", phi = " << triggerObject->p4.Phi() << ", mass = " << triggerObject->p4.mass() << ")";
-						}
-					}
+					KLV const& triggerObject = event.m_triggerObjects->trgObjects.at(detailedTriggerMatchedObjects.GetTriggerObjectIndices()[index]);
+					LOG(INFO) << "\t\t\tTrigger object: (pt = " << triggerObject.p4.Pt() << ", eta = " << triggerObject.p4.Eta() << ", phi = " << triggerObject.p4.Phi() << ", mass = " << triggerObject.p4.mass() << ")";
 				}
 			}
 			LOG(INFO) << "==================================================";
@@ -219,17 +243,190 @@ public:
 
 private:
 	std::map<TValidObject*, KLV*> KappaProduct::*m_triggerMatchedObjects;
-	std::map<TValidObject*, std::map<std::string, std::map<std::string, std::vector<KLV*> > > > KappaProduct::*m_detailedTriggerMatchedObjects;
+	TriggerMatchResults<TValidObject> KappaProduct::*m_detailedTriggerMatchedObjects;
 	std::vector<TValidObject*> KappaProduct::*m_validObjects;
 	std::vector<TValidObject*> KappaProduct::*m_invalidObjects;
 	std::map<size_t, std::vector<std::string> > KappaProduct::*m_settingsObjectTriggerFiltersByIndex;
 	std::map<std::string, std::vector<std::string> > KappaProduct::*m_settingsObjectTriggerFiltersByHltName;
-	std::vector<std::string>& (KappaSettings::*GetObjectTriggerFilterNames)(void) const;
+	std::vector<std::string> const& (KappaSettings::*GetObjectTriggerFilterNames)(void) const;
 	float (KappaSettings::*GetDeltaRTriggerMatchingObjects)(void) const;
 	bool (KappaSettings::*GetInvalidateNonMatchingObjects)(void) const;
 	
 	std::map<size_t, std::vector<std::string> > m_objectTriggerFiltersByIndexFromSettings;
 	std::map<std::string, std::vector<std::string> > m_objectTriggerFiltersByHltNameFromSettings;
+	
+	struct CheckedFilter
+	{
+		size_t hltId;
+		// index in KTriggerObjectMetadata::toFilter
+		size_t filterIndex;
+		size_t filterId;
+		
+		bool operator==(CheckedFilter const& other) const
+		{
+			return ((hltId == other.hltId) && (filterIndex == other.filterIndex));
+		}
+	};
+	
+	// buffers and caches reused in every event
+	mutable std::vector<CheckedFilter> m_checkedFilters;
+	
+	// structure of arrays of the trigger objects and the valid objects of the current event
+	mutable std::vector<double> m_triggerObjectsEta;
+	mutable std::vector<double> m_triggerObjectsPhi;
+	mutable std::vector<bool> m_triggerObjectsPassPtCut;
+	mutable std::vector<double> m_validObjectsEta;
+	mutable std::vector<double> m_validObjectsPhi;
+	
+	// trigger objects of the current filter passing the pt cut
+	mutable std::vector<int> m_filterTriggerObjectIndices;
+	mutable std::vector<double> m_filterTriggerObjectsEta;
+	mutable std::vector<double> m_filterTriggerObjectsPhi;
+	mutable std::vector<double> m_filterTriggerObjectsMatched;
+	mutable std::map<std::string, boost::regex> m_regexes;
+	// local cache of the interned ids and the position of every name in the alphabetical order of
+	// the names known to this producer (indexed by the interned id)
+	mutable std::map<std::string, size_t> m_hltIds;
+	mutable std::map<std::string, size_t> m_filterIds;
+	mutable std::vector<size_t> m_hltRanks;
+	mutable std::vector<size_t> m_filterRanks;
+	// interned ids of the HLT paths of the resolution with this generation
+	mutable unsigned long long m_resolvedHltGeneration = 0;
+	mutable std::vector<size_t> m_resolvedHltIds;
+	
+	void MatchTriggerObjects(KappaEvent const& event, KappaProduct& product, KappaSettings const& settings) const
+	{
+		TriggerMatchResults<TValidObject>& detailedTriggerMatchedObjects = (product.*m_detailedTriggerMatchedObjects);
+		std::vector<TValidObject*> const& validObjects = (product.*m_validObjects);
+		std::vector<KLV> const& triggerObjects = event.m_triggerObjects->trgObjects;
+		
+		double deltaRMax = (settings.*GetDeltaRTriggerMatchingObjects)();
+		double deltaR2Max = deltaRMax * deltaRMax;
+		float triggerObjectLowerPtCut = settings.GetTriggerObjectLowerPtCut();
+		
+		// unpack the kinematics once per event
+		m_triggerObjectsEta.resize(triggerObjects.size());
+		m_triggerObjectsPhi.resize(triggerObjects.size());
+		m_triggerObjectsPassPtCut.resize(triggerObjects.size());
+		for (size_t triggerObjectIndex = 0; triggerObjectIndex < triggerObjects.size(); ++triggerObjectIndex)
+		{
+			m_triggerObjectsEta[triggerObjectIndex] = triggerObjects[triggerObjectIndex].p4.Eta();
+			m_triggerObjectsPhi[triggerObjectIndex] = triggerObjects[triggerObjectIndex].p4.Phi();
+			m_triggerObjectsPassPtCut[triggerObjectIndex] = (triggerObjects[triggerObjectIndex].p4.Pt() > triggerObjectLowerPtCut);
+		}
+		
+		m_validObjectsEta.resize(validObjects.size());
+		m_validObjectsPhi.resize(validObjects.size());
+		for (size_t validObjectIndex = 0; validObjectIndex < validObjects.size(); ++validObjectIndex)
+		{
+			m_validObjectsEta[validObjectIndex] = validObjects[validObjectIndex]->p4.Eta();
+			m_validObjectsPhi[validObjectIndex] = validObjects[validObjectIndex]->p4.Phi();
+		}
+		
+		for (typename std::vector<CheckedFilter>::const_iterator checkedFilter = m_checkedFilters.begin();
+		     checkedFilter != m_checkedFilters.end(); ++checkedFilter)
+		{
+			// gather the trigger objects of the fired filter into contiguous arrays
+			std::vector<int> const& triggerObjectIndices = event.m_triggerObjects->toIdxFilter[checkedFilter->filterIndex];
+			m_filterTriggerObjectIndices.clear();
+			m_filterTriggerObjectsEta.clear();
+			m_filterTriggerObjectsPhi.clear();
+			for (std::vector<int>::const_iterator triggerObjectIndex = triggerObjectIndices.begin();
+			     triggerObjectIndex != triggerObjectIndices.end(); ++triggerObjectIndex)
+			{
+				if (m_triggerObjectsPassPtCut.at(*triggerObjectIndex))
+				{
+					m_filterTriggerObjectIndices.push_back(*triggerObjectIndex);
+					m_filterTriggerObjectsEta.push_back(m_triggerObjectsEta[*triggerObjectIndex]);
+					m_filterTriggerObjectsPhi.push_back(m_triggerObjectsPhi[*triggerObjectIndex]);
+				}
+			}
+			
+			// pad the arrays to full blocks with trigger objects that never match
+			size_t nBlocks = (m_filterTriggerObjectIndices.size() + TriggerObjectMatching::BlockSize - 1) / TriggerObjectMatching::BlockSize;
+			m_filterTriggerObjectsEta.resize(nBlocks * TriggerObjectMatching::BlockSize, 1.0e10);
+			m_filterTriggerObjectsPhi.resize(nBlocks * TriggerObjectMatching::BlockSize, 0.0);
+			m_filterTriggerObjectsMatched.resize(nBlocks * TriggerObjectMatching::BlockSize);
+			
+			// loop over all valid objects to check
+			for (size_t validObjectIndex = 0; validObjectIndex < validObjects.size(); ++validObjectIndex)
+			{
+				detailedTriggerMatchedObjects.AddEntry(validObjects[validObjectIndex], checkedFilter->hltId, checkedFilter->filterId);
+				
+				TriggerObjectMatching::MatchDeltaR(m_validObjectsEta[validObjectIndex], m_validObjectsPhi[validObjectIndex],
+				                                   m_filterTriggerObjectsEta.data(), m_filterTriggerObjectsPhi.data(), nBlocks,
+				                                   deltaR2Max, m_filterTriggerObjectsMatched.data());
+				
+				for (size_t filterTriggerObjectIndex = 0; filterTriggerObjectIndex < m_filterTriggerObjectIndices.size(); ++filterTriggerObjectIndex)
+				{
+					if (m_filterTriggerObjectsMatched[filterTriggerObjectIndex] != 0.0)
+					{
+						detailedTriggerMatchedObjects.AddTriggerObject(m_filterTriggerObjectIndices[filterTriggerObjectIndex]);
+					}
+				}
+			}
+		}
+	}
+	
+	boost::regex const& GetRegex(std::string const& pattern) const
+	{
+		std::map<std::string, boost::regex>::iterator regex = m_regexes.find(pattern);
+		if (regex == m_regexes.end())
+		{
+			regex = m_regexes.insert(std::make_pair(pattern, boost::regex(pattern, boost::regex::icase | boost::regex::extended))).first;
+		}
+		return regex->second;
+	}
+	
+	// local cache of the interned ids, avoids locking the global names for every event
+	// the ranks are only renumbered when a new name is added, i.e. rarely after the first events
+	static size_t GetInternedId(std::string const& name, std::map<std::string, size_t>& ids, std::vector<size_t>& ranks,
+	                            size_t (*GetId)(std::string const&))
+	{
+		std::map<std::string, size_t>::const_iterator id = ids.find(name);
+		if (id == ids.end())
+		{
+			id = ids.insert(std::make_pair(name, GetId(name))).first;
+			ranks.resize(std::max(ranks.size(), id->second + 1), 0);
+			size_t rank = 0;
+			for (std::map<std::string, size_t>::const_iterator knownId = ids.begin(); knownId != ids.end(); ++knownId)
+			{
+				ranks[knownId->second] = rank++;
+			}
+		}
+		return id->second;
+	}
+	
+	// entry of the first filter (by name) of the first HLT path (by name) where all filters have matched
+	// MatchTriggerObjects adds one entry per checked filter and object, in the order of the checked filters,
+	// which are sorted by the names. The entries of an HLT path are therefore consecutive for every object.
+	typename TriggerMatchResults<TValidObject>::Entry const* GetFirstMatch(
+			TriggerMatchResults<TValidObject> const& detailedTriggerMatchedObjects,
+			size_t matchedObjectIndex, size_t nMatchedObjects) const
+	{
+		if (m_checkedFilters.empty())
+		{
+			return nullptr;
+		}
+		
+		std::vector<typename TriggerMatchResults<TValidObject>::Entry> const& entries = detailedTriggerMatchedObjects.GetEntries();
+		size_t firstFilterOfHlt = 0;
+		bool allFiltersMatched = true;
+		for (size_t checkedFilterIndex = 0; checkedFilterIndex < m_checkedFilters.size(); ++checkedFilterIndex)
+		{
+			if (m_checkedFilters[checkedFilterIndex].hltId != m_checkedFilters[firstFilterOfHlt].hltId)
+			{
+				if (allFiltersMatched)
+				{
+					break;
+				}
+				firstFilterOfHlt = checkedFilterIndex;
+				allFiltersMatched = true;
+			}
+			allFiltersMatched = (allFiltersMatched && entries[(checkedFilterIndex * nMatchedObjects) + matchedObjectIndex].HasMatch());
+		}
+		return (allFiltersMatched ? &(entries[(firstFilterOfHlt * nMatchedObjects) + matchedObjectIndex]) : nullptr);
+	}
 
 };
 
@@ -10,6 +10,7 @@
 #include "Artus/KappaAnalysis/interface/KappaProducerBase.h"
 #include "Artus/KappaAnalysis/interface/Consumers/KappaLambdaNtupleConsumer.h"
 #include "Artus/KappaAnalysis/interface/Utility/BtagSF.h"
+#include "Artus/KappaAnalysis/interface/Utility/MetadataNameBinding.h"
 
 
 /**
@@ -22,6 +23,8 @@ class ValidBTaggedJetsProducer: public KappaProducerBase
 
 public:
 
+	ValidBTaggedJetsProducer();
+
 	std::string GetProducerId() const override;
 
 	void Init(KappaSettings const& settings) override;
@@ -51,4 +54,8 @@ private:
 
 	BTagScaleFactorMethod bTagSFMethod;
 
+	// name of the b tagger, resolved once per input file
+	MetadataNameBinding<KJetMetadata> bTagger;
+	size_t bTaggerHandle;
+
 };
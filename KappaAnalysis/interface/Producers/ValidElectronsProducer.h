@@ -11,7 +11,9 @@
 #include "Kappa/DataFormats/interface/Kappa.h"
 
 #include "Artus/KappaAnalysis/interface/KappaProducerBase.h"
+#include "Artus/KappaAnalysis/interface/Utility/ObjectSelector.h"
 #include "Artus/KappaAnalysis/interface/Utility/ValidPhysicsObjectTools.h"
+#include "Artus/KappaAnalysis/interface/Utility/MetadataNameBinding.h"
 #include "Artus/Consumer/interface/LambdaNtupleConsumer.h"
 #include "Artus/Utility/interface/Utility.h"
 #include "Artus/Utility/interface/DefaultValues.h"
@@ -147,8 +149,8 @@ public:
 	                       std::string (setting_type::*GetElectronIsoType)(void) const=&setting_type::GetElectronIsoType,
 	                       std::string (setting_type::*GetElectronIso)(void) const=&setting_type::GetElectronIso,
 	                       std::string (setting_type::*GetElectronReco)(void) const=&setting_type::GetElectronReco,
-	                       std::vector<std::string>& (setting_type::*GetLowerPtCuts)(void) const=&setting_type::GetElectronLowerPtCuts,
-	                       std::vector<std::string>& (setting_type::*GetUpperAbsEtaCuts)(void) const=&setting_type::GetElectronUpperAbsEtaCuts) :
+	                       std::vector<std::string> const& (setting_type::*GetLowerPtCuts)(void) const=&setting_type::GetElectronLowerPtCuts,
+	                       std::vector<std::string> const& (setting_type::*GetUpperAbsEtaCuts)(void) const=&setting_type::GetElectronUpperAbsEtaCuts) :
 		ProducerBase<TTypes>(),
 		ValidPhysicsObjectTools<TTypes, KElectron>(GetLowerPtCuts, GetUpperAbsEtaCuts, validElectrons),
 		m_validElectronsMember(validElectrons),
@@ -156,7 +158,9 @@ public:
 		GetElectronID(GetElectronID),
 		GetElectronIsoType(GetElectronIsoType),
 		GetElectronIso(GetElectronIso),
-		GetElectronReco(GetElectronReco)
+		GetElectronReco(GetElectronReco),
+		electronIds(&KElectronMetadata::idNames, "Electron ID"),
+		mvaIdHandle(0)
 	{
 	}
 
@@ -176,6 +180,18 @@ public:
 			LOG(WARNING) << "ValidElectronsProducer: using cutbased vbft95 ID, but isolation is not set!";
 		}
 
+		// the name of the MVA ID is resolved to an index for every input file
+		if (electronID == ElectronID::MVANONTRIG)
+			mvaIdHandle = electronIds.Add("idMvaNonTrigV0");
+		else if (electronID == ElectronID::MVATRIG)
+			mvaIdHandle = electronIds.Add("idMvaTrigV0");
+
+		// the criteria are chosen once, such that no settings are needed per electron
+		electronSelector.Clear();
+		AddElectronIDCriteria();
+		AddElectronIsoCriteria(settings.GetDirectIso());
+		AddElectronRecoCriteria();
+
 		// add possible quantities for the lambda ntuples consumers
 		LambdaNtupleConsumer<TTypes>::AddIntQuantity("nElectrons", [](event_type const& event, product_type const& product) {
 			return product.m_validElectrons.size();
@@ -194,6 +210,8 @@ public:
 		assert(event.m_electrons);
 		assert(event.m_vertexSummary);
 		assert(event.m_electronMetadata);
+		electronIds.Bind(event.m_electronMetadata, event.m_input);
+
 		// select input source
 		std::vector<KElectron*> electrons;
 		if ((validElectronsInput == ValidElectronsInput::AUTO && (product.m_correctedElectrons.size() > 0)) || (validElectronsInput == ValidElectronsInput::CORRECTED))
@@ -218,72 +236,16 @@ public:
 			}
 		}
 
+		m_electronArrays.Build(electrons);
+		this->PrepareKinematicCuts(m_electronArrays, product);
+
 		for (std::vector<KElectron*>::iterator electron = electrons.begin(); electron != electrons.end(); ++electron)
 		{
-			bool valid = true;
-
-			// POG recommondations
-			// https://twiki.cern.ch/twiki/bin/viewauth/CMS/MultivariateElectronIdentification#Non_triggering_MVA
-			// https://twiki.cern.ch/twiki/bin/viewauth/CMS/MultivariateElectronIdentification#Triggering_MVA
-
-			// Electron IDs
-			if (electronID == ElectronID::MVANONTRIG)
-				valid = valid && IsMVANonTrigElectron(*electron, event.m_electronMetadata);
-			else if (electronID == ElectronID::MVATRIG)
-				valid = valid && IsMVATrigElectron(*electron, event.m_electronMetadata);
-			else if (electronID == ElectronID::VBTF95_VETO)
-				valid = valid && IsVetoVbtf95Electron(*electron, event, product);
-			else if (electronID == ElectronID::VBTF95_LOOSE)
-				valid = valid && IsLooseVbtf95Electron(*electron, event, product);
-			else if (electronID == ElectronID::VBTF95_MEDIUM)
-				valid = valid && IsMediumVbtf95Electron(*electron, event, product);
-			else if (electronID == ElectronID::VBTF95_TIGHT)
-				valid = valid && IsTightVbtf95Electron(*electron, event, product);
-			else if (electronID == ElectronID::FAKEABLE)
-				valid = valid && IsFakeableElectron(*electron, event, product);
-			else if (electronID == ElectronID::VETO)
-				valid = valid && (*electron)->idVeto();
-			else if (electronID == ElectronID::LOOSE)
-				valid = valid && (*electron)->idLoose();
-			else if (electronID == ElectronID::MEDIUM)
-				valid = valid && (*electron)->idMedium();
-			else if (electronID == ElectronID::TIGHT)
-				valid = valid && (*electron)->idTight();
-			else if (electronID != ElectronID::USER && electronID != ElectronID::NONE)
-				LOG(FATAL) << "Electron ID of type " << Utility::ToUnderlyingValue(electronID) << " not yet implemented!";
-
-			// Electron Isolation
-			if (electronIsoType == ElectronIsoType::PF) {
-				if (electronIso == ElectronIso::MVANONTRIG)
-					valid = valid && ((((*electron)->trackIso / (*electron)->p4.Pt()) < 0.4f) ? settings.GetDirectIso() : (!settings.GetDirectIso()));
-				else if (electronIso == ElectronIso::MVATRIG)
-					valid = valid && ((((*electron)->trackIso / (*electron)->p4.Pt()) < 0.15f) ? settings.GetDirectIso() : (!settings.GetDirectIso()));
-				else if (electronIso == ElectronIso::FAKEABLE)
-					valid = valid && IsFakeableElectronIso(*electron, event, product, settings);
-				else if (electronIso != ElectronIso::NONE)
-					LOG(FATAL) << "Electron isolation of type " << Utility::ToUnderlyingValue(electronIso) << " not yet implemented!";
-			}
-			else if (electronIsoType != ElectronIsoType::USER && electronIsoType != ElectronIsoType::NONE)
-			{
-				LOG(FATAL) << "Electron isolation type of type " << Utility::ToUnderlyingValue(electronIsoType) << " not yet implemented!";
-			}
-
-			// Electron reconstruction
-			if (electronReco == ElectronReco::MVANONTRIG)
-				valid = valid && ((*electron)->track.nInnerHits <= 1);
-				// && sip is the significance of impact parameter in 3D of the electron GSF track < 4 TODO
-			else if (electronReco == ElectronReco::MVATRIG)
-				valid = valid && ((*electron)->track.nInnerHits == 0);
-			else if (electronReco != ElectronReco::USER && electronReco != ElectronReco::NONE)
-			{
-				LOG(FATAL) << "Electron reconstruction of type " << Utility::ToUnderlyingValue(electronReco) << " not yet implemented!";
-			}
-
-			// conversion veto per default
-			valid = valid && (! ((*electron)->electronType & (1 << KElectronType::hasConversionMatch)));
+			// electron ID, isolation, reconstruction and conversion veto
+			bool valid = electronSelector.Pass(*electron, event);
 
 			// kinematic cuts
-			valid = valid && this->PassKinematicCuts(*electron, event, product);
+			valid = valid && this->PassKinematicCuts(m_electronArrays, electron - electrons.begin(), product);
 
 			// check possible analysis-specific criteria
 			valid = valid && AdditionalCriteria(*electron, event, product, settings);
@@ -295,7 +257,18 @@ public:
 		}
 	}
 
+	/// ID, isolation and reconstruction criteria as configured for this producer, e.g. for the use in filters
+	ObjectSelector<KElectron, event_type> const& GetElectronSelector() const
+	{
+		return electronSelector;
+	}
+
 	static bool IsMVANonTrigElectron(const KElectron* electron, const KElectronMetadata* electronMeta)
+	{
+		return IsMVANonTrigElectron(electron, electron->getId("idMvaNonTrigV0", electronMeta));
+	}
+
+	static bool IsMVANonTrigElectron(const KElectron* electron, float mvaNonTrig)
 	{
 		// Electron ID mva non trig (run 1)
 		// https://twiki.cern.ch/twiki/bin/viewauth/CMS/MultivariateElectronIdentification#Non_triggering_MVA
@@ -303,21 +276,26 @@ public:
 		if (electron->p4.Pt() < 10.0f)
 		{
 			return (
-				(std::abs(electron->p4.Eta()) < 0.8f && electron->getId("idMvaNonTrigV0", electronMeta) > 0.47f) ||
-				(std::abs(electron->p4.Eta()) > 0.8f && std::abs(electron->p4.Eta()) < DefaultValues::EtaBorderEB && electron->getId("idMvaNonTrigV0", electronMeta) > 0.004f) ||
-				(std::abs(electron->p4.Eta()) > DefaultValues::EtaBorderEB && std::abs(electron->p4.Eta()) < 2.5f && electron->getId("idMvaNonTrigV0", electronMeta) > 0.295f));
+				(std::abs(electron->p4.Eta()) < 0.8f && mvaNonTrig > 0.47f) ||
+				(std::abs(electron->p4.Eta()) > 0.8f && std::abs(electron->p4.Eta()) < DefaultValues::EtaBorderEB && mvaNonTrig > 0.004f) ||
+				(std::abs(electron->p4.Eta()) > DefaultValues::EtaBorderEB && std::abs(electron->p4.Eta()) < 2.5f && mvaNonTrig > 0.295f));
 		}
 		else if (electron->p4.Pt() >= 10.0f)
 		{
 			return (
-				(std::abs(electron->p4.Eta()) < 0.8f && electron->getId("idMvaNonTrigV0", electronMeta) > -0.34f) ||
-				(std::abs(electron->p4.Eta()) > 0.8f && std::abs(electron->p4.Eta()) < DefaultValues::EtaBorderEB && electron->getId("idMvaNonTrigV0", electronMeta) > -0.65f) ||
-				(std::abs(electron->p4.Eta()) > DefaultValues::EtaBorderEB && std::abs(electron->p4.Eta()) < 2.5f && electron->getId("idMvaNonTrigV0", electronMeta) > 0.6f));
+				(std::abs(electron->p4.Eta()) < 0.8f && mvaNonTrig > -0.34f) ||
+				(std::abs(electron->p4.Eta()) > 0.8f && std::abs(electron->p4.Eta()) < DefaultValues::EtaBorderEB && mvaNonTrig > -0.65f) ||
+				(std::abs(electron->p4.Eta()) > DefaultValues::EtaBorderEB && std::abs(electron->p4.Eta()) < 2.5f && mvaNonTrig > 0.6f));
 		}
 		return false;
 	}
 
 	static bool IsMVATrigElectron(const KElectron* electron, const KElectronMetadata* electronMeta)
+	{
+		return IsMVATrigElectron(electron, electron->getId("idMvaTrigV0", electronMeta));
+	}
+
+	static bool IsMVATrigElectron(const KElectron* electron, float mvaTrig)
 	{
 		// Electron ID mva trig (run 1)
 		// https://twiki.cern.ch/twiki/bin/viewauth/CMS/MultivariateElectronIdentification#Triggering_MVA
@@ -325,21 +303,21 @@ public:
 		if (electron->p4.Pt() >= 10.0f && electron->p4.Pt() < 20.0f)
 		{
 			return (
-				(std::abs(electron->p4.Eta()) <= 0.8f && electron->getId("idMvaTrigV0", electronMeta) > 0.0f) ||
-				(std::abs(electron->p4.Eta()) > 0.8f && std::abs(electron->p4.Eta()) <= DefaultValues::EtaBorderEB && electron->getId("idMvaTrigV0", electronMeta) > 0.1f) ||
-				(std::abs(electron->p4.Eta()) > DefaultValues::EtaBorderEB && std::abs(electron->p4.Eta()) <= 2.5f && electron->getId("idMvaTrigV0", electronMeta) > 0.62f));
+				(std::abs(electron->p4.Eta()) <= 0.8f && mvaTrig > 0.0f) ||
+				(std::abs(electron->p4.Eta()) > 0.8f && std::abs(electron->p4.Eta()) <= DefaultValues::EtaBorderEB && mvaTrig > 0.1f) ||
+				(std::abs(electron->p4.Eta()) > DefaultValues::EtaBorderEB && std::abs(electron->p4.Eta()) <= 2.5f && mvaTrig > 0.62f));
 		}
 		else if (electron->p4.Pt() >= 20.0f)
 		{
 			return (
-				(std::abs(electron->p4.Eta()) < 0.8f && electron->getId("idMvaTrigV0", electronMeta) > 0.94f) ||
-				(std::abs(electron->p4.Eta()) > 0.8f && std::abs(electron->p4.Eta()) < DefaultValues::EtaBorderEB && electron->getId("idMvaTrigV0", electronMeta) > 0.85f) ||
-				(std::abs(electron->p4.Eta()) > DefaultValues::EtaBorderEB && std::abs(electron->p4.Eta()) < 2.5f && electron->getId("idMvaTrigV0", electronMeta) > 0.92f));
+				(std::abs(electron->p4.Eta()) < 0.8f && mvaTrig > 0.94f) ||
+				(std::abs(electron->p4.Eta()) > 0.8f && std::abs(electron->p4.Eta()) < DefaultValues::EtaBorderEB && mvaTrig > 0.85f) ||
+				(std::abs(electron->p4.Eta()) > DefaultValues::EtaBorderEB && std::abs(electron->p4.Eta()) < 2.5f && mvaTrig > 0.92f));
 		}
 		return false;
 	}
 
-	static bool IsVetoVbtf95Electron(const KElectron* electron, event_type const& event, product_type const& product)
+	static bool IsVetoVbtf95Electron(const KElectron* electron, event_type const& event)
 	{
 		if (std::abs(electron->p4.Eta()) < DefaultValues::EtaBorderEB)
 		{
@@ -365,7 +343,7 @@ public:
 		return false;
 	}
 
-	static bool IsLooseVbtf95Electron(const KElectron* electron, event_type const& event, product_type const& product)
+	static bool IsLooseVbtf95Electron(const KElectron* electron, event_type const& event)
 	{
 		if (std::abs(electron->p4.Eta()) < DefaultValues::EtaBorderEB)
 		{
@@ -378,7 +356,7 @@ public:
 		return false;
 	}
 
-	static bool IsMediumVbtf95Electron(const KElectron* electron, event_type const& event, product_type const& product)
+	static bool IsMediumVbtf95Electron(const KElectron* electron, event_type const& event)
 	{
 		if (std::abs(electron->p4.Eta()) < DefaultValues::EtaBorderEB)
 		{
@@ -391,7 +369,7 @@ public:
 		return false;
 	}
 
-	static bool IsTightVbtf95Electron(const KElectron* electron, event_type const& event, product_type const& product)
+	static bool IsTightVbtf95Electron(const KElectron* electron, event_type const& event)
 	{
 		if (std::abs(electron->p4.Eta()) < DefaultValues::EtaBorderEB)
 		{
@@ -428,6 +406,7 @@ protected:
 	ElectronIsoType electronIsoType;
 	ElectronIso electronIso;
 	ElectronReco electronReco;
+	ObjectSelector<KElectron, event_type> electronSelector;
 
 	// Can be overwritten for analysis-specific use cases
 	virtual bool AdditionalCriteria(KElectron* electron, event_type const& event,
@@ -447,7 +426,92 @@ private:
 
 	ValidElectronsInput validElectronsInput;
 
-	bool IsFakeableElectron(KElectron* electron, event_type const& event, product_type& product) const
+	// kinematics of the input electrons of the current event
+	mutable PhysicsObjectArrays m_electronArrays;
+
+	// name of the MVA ID, resolved once per input file
+	MetadataNameBinding<KElectronMetadata> electronIds;
+	size_t mvaIdHandle;
+
+	// POG recommondations
+	// https://twiki.cern.ch/twiki/bin/viewauth/CMS/MultivariateElectronIdentification#Non_triggering_MVA
+	// https://twiki.cern.ch/twiki/bin/viewauth/CMS/MultivariateElectronIdentification#Triggering_MVA
+	void AddElectronIDCriteria()
+	{
+		if (electronID == ElectronID::MVANONTRIG)
+			electronSelector.Add([this](KElectron* electron, event_type const& event) {
+				return IsMVANonTrigElectron(electron, electron->electronIds[electronIds.GetIndex(mvaIdHandle)]);
+			});
+		else if (electronID == ElectronID::MVATRIG)
+			electronSelector.Add([this](KElectron* electron, event_type const& event) {
+				return IsMVATrigElectron(electron, electron->electronIds[electronIds.GetIndex(mvaIdHandle)]);
+			});
+		else if (electronID == ElectronID::VBTF95_VETO)
+			electronSelector.Add(&IsVetoVbtf95Electron);
+		else if (electronID == ElectronID::VBTF95_LOOSE)
+			electronSelector.Add(&IsLooseVbtf95Electron);
+		else if (electronID == ElectronID::VBTF95_MEDIUM)
+			electronSelector.Add(&IsMediumVbtf95Electron);
+		else if (electronID == ElectronID::VBTF95_TIGHT)
+			electronSelector.Add(&IsTightVbtf95Electron);
+		else if (electronID == ElectronID::FAKEABLE)
+			electronSelector.Add(&IsFakeableElectron);
+		else if (electronID == ElectronID::VETO)
+			electronSelector.Add([](KElectron* electron, event_type const& event) { return electron->idVeto(); });
+		else if (electronID == ElectronID::LOOSE)
+			electronSelector.Add([](KElectron* electron, event_type const& event) { return electron->idLoose(); });
+		else if (electronID == ElectronID::MEDIUM)
+			electronSelector.Add([](KElectron* electron, event_type const& event) { return electron->idMedium(); });
+		else if (electronID == ElectronID::TIGHT)
+			electronSelector.Add([](KElectron* electron, event_type const& event) { return electron->idTight(); });
+		else if (electronID != ElectronID::USER && electronID != ElectronID::NONE)
+			LOG(FATAL) << "Electron ID of type " << Utility::ToUnderlyingValue(electronID) << " not yet implemented!";
+	}
+
+	// the isolation criteria are inverted for directIso == false
+	void AddElectronIsoCriteria(bool directIso)
+	{
+		if (electronIsoType == ElectronIsoType::PF) {
+			if (electronIso == ElectronIso::MVANONTRIG)
+				electronSelector.Add([directIso](KElectron* electron, event_type const& event) {
+					return ((electron->trackIso / electron->p4.Pt()) < 0.4f) == directIso;
+				});
+			else if (electronIso == ElectronIso::MVATRIG)
+				electronSelector.Add([directIso](KElectron* electron, event_type const& event) {
+					return ((electron->trackIso / electron->p4.Pt()) < 0.15f) == directIso;
+				});
+			else if (electronIso == ElectronIso::FAKEABLE)
+				electronSelector.Add([directIso](KElectron* electron, event_type const& event) {
+					return IsFakeableElectronIso(electron, directIso);
+				});
+			else if (electronIso != ElectronIso::NONE)
+				LOG(FATAL) << "Electron isolation of type " << Utility::ToUnderlyingValue(electronIso) << " not yet implemented!";
+		}
+		else if (electronIsoType != ElectronIsoType::USER && electronIsoType != ElectronIsoType::NONE)
+		{
+			LOG(FATAL) << "Electron isolation type of type " << Utility::ToUnderlyingValue(electronIsoType) << " not yet implemented!";
+		}
+	}
+
+	void AddElectronRecoCriteria()
+	{
+		if (electronReco == ElectronReco::MVANONTRIG)
+			// && sip is the significance of impact parameter in 3D of the electron GSF track < 4 TODO
+			electronSelector.Add([](KElectron* electron, event_type const& event) { return (electron->track.nInnerHits <= 1); });
+		else if (electronReco == ElectronReco::MVATRIG)
+			electronSelector.Add([](KElectron* electron, event_type const& event) { return (electron->track.nInnerHits == 0); });
+		else if (electronReco != ElectronReco::USER && electronReco != ElectronReco::NONE)
+		{
+			LOG(FATAL) << "Electron reconstruction of type " << Utility::ToUnderlyingValue(electronReco) << " not yet implemented!";
+		}
+
+		// conversion veto per default
+		electronSelector.Add([](KElectron* electron, event_type const& event) {
+			return (! (electron->electronType & (1 << KElectronType::hasConversionMatch)));
+		});
+	}
+
+	static bool IsFakeableElectron(KElectron* electron, event_type const& event)
 	{
 		if (std::abs(electron->p4.Eta()) < DefaultValues::EtaBorderEB)
 		{
@@ -468,12 +532,12 @@ private:
 		return false;
 	}
 
-	bool IsFakeableElectronIso(KElectron* electron, event_type const& event, product_type& product,  setting_type const& settings) const
+	static bool IsFakeableElectronIso(KElectron* electron, bool directIso)
 	{
-		return (((electron->trackIso / electron->p4.Pt()) < 0.2f) ? settings.GetDirectIso() : (!settings.GetDirectIso()) &&
-				((electron->ecalIso / electron->p4.Pt()) < 0.2f) ? settings.GetDirectIso() : (!settings.GetDirectIso()) &&
-				((electron->hcal1Iso / electron->p4.Pt()) < 0.2f) ? settings.GetDirectIso() : (!settings.GetDirectIso()) &&
-				((electron->hcal2Iso / electron->p4.Pt()) < 0.2f) ? settings.GetDirectIso() : (!settings.GetDirectIso()));
+		return (((electron->trackIso / electron->p4.Pt()) < 0.2f) ? directIso : (!directIso) &&
+				((electron->ecalIso / electron->p4.Pt()) < 0.2f) ? directIso : (!directIso) &&
+				((electron->hcal1Iso / electron->p4.Pt()) < 0.2f) ? directIso : (!directIso) &&
+				((electron->hcal2Iso / electron->p4.Pt()) < 0.2f) ? directIso : (!directIso));
 	}
 };
 
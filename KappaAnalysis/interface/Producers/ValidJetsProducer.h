@@ -13,6 +13,7 @@
 
 #include "Artus/KappaAnalysis/interface/KappaProducerBase.h"
 #include "Artus/KappaAnalysis/interface/Utility/ValidPhysicsObjectTools.h"
+#include "Artus/KappaAnalysis/interface/Utility/MetadataNameBinding.h"
 #include "Artus/KappaAnalysis/interface/Consumers/KappaLambdaNtupleConsumer.h"
 #include "Artus/Utility/interface/Utility.h"
 #include "Artus/KappaAnalysis/interface/KappaProduct.h"
@@ -127,16 +128,16 @@ public:
 		LambdaNtupleConsumer<KappaTypes>::AddIntQuantity("nJets",[](KappaEvent const& event, KappaProduct const& product) {
 			return product.m_validJets.size();
 		} );
-		LambdaNtupleConsumer<KappaTypes>::AddIntQuantity("nJets20",[this](KappaEvent const& event, KappaProduct const& product) {
+		LambdaNtupleConsumer<KappaTypes>::AddIntQuantity("nJets20",[](KappaEvent const& event, KappaProduct const& product) {
 			return KappaProduct::GetNJetsAbovePtThreshold(product.m_validJets, 20.0);
 		} );
-		LambdaNtupleConsumer<KappaTypes>::AddIntQuantity("nJets30",[this](KappaEvent const& event, KappaProduct const& product) {
+		LambdaNtupleConsumer<KappaTypes>::AddIntQuantity("nJets30",[](KappaEvent const& event, KappaProduct const& product) {
 			return KappaProduct::GetNJetsAbovePtThreshold(product.m_validJets, 30.0);
 		} );
-		LambdaNtupleConsumer<KappaTypes>::AddIntQuantity("nJets50",[this](KappaEvent const& event, KappaProduct const& product) {
+		LambdaNtupleConsumer<KappaTypes>::AddIntQuantity("nJets50",[](KappaEvent const& event, KappaProduct const& product) {
 			return KappaProduct::GetNJetsAbovePtThreshold(product.m_validJets, 50.0);
 		} );
-		LambdaNtupleConsumer<KappaTypes>::AddIntQuantity("nJets80",[this](KappaEvent const& event, KappaProduct const& product) {
+		LambdaNtupleConsumer<KappaTypes>::AddIntQuantity("nJets80",[](KappaEvent const& event, KappaProduct const& product) {
 			return KappaProduct::GetNJetsAbovePtThreshold(product.m_validJets, 80.0);
 		} );
 
@@ -190,6 +191,9 @@ public:
 			}
 		}
 
+		m_jetArrays.Build(jets);
+		this->PrepareKinematicCuts(m_jetArrays, product);
+
 		for (typename std::vector<TJet*>::iterator jet = jets.begin(); jet != jets.end(); ++jet)
 		{
 			bool validJet = true;
@@ -237,7 +241,7 @@ public:
 			}
 
 			// kinematic cuts
-			validJet = validJet && this->PassKinematicCuts(*jet, event, product);
+			validJet = validJet && this->PassKinematicCuts(m_jetArrays, jet - jets.begin(), product);
 
 			// check possible analysis-specific criteria
 			validJet = validJet && AdditionalCriteria(*jet, event, product, settings);
@@ -265,6 +269,9 @@ private:
 
 	bool noID;
 	ValidJetsInput validJetsInput;
+
+	// kinematics of the input jets of the current event
+	mutable PhysicsObjectArrays m_jetArrays;
 	JetIDVersion jetIDVersion;
 	float maxFraction;
 	float maxMuFraction;
@@ -315,7 +322,15 @@ private:
 	std::map<std::string, std::vector<float> > jetTaggerLowerCutsByTaggerName;
 	std::map<std::string, std::vector<float> > jetTaggerUpperCutsByTaggerName;
 
-	bool PassPuJetIds(KJet* jet, std::vector<std::string> const& puJetIds, KJetMetadata* taggerMetadata) const;
+	// names of the taggers and IDs, resolved once per input file
+	MetadataNameBinding<KJetMetadata> jetTaggers;
+	MetadataNameBinding<KJetMetadata> jetIds;
+	std::map<size_t, std::vector<size_t> > puJetIdHandlesByIndex;
+	std::vector<size_t> defaultPuJetIdHandles;
+	std::vector<std::pair<size_t, float> > jetTaggerLowerCuts;
+	std::vector<std::pair<size_t, float> > jetTaggerUpperCuts;
+
+	bool PassPuJetIds(KJet* jet, std::vector<size_t> const& puJetIdHandles) const;
 };
 
 
@@ -12,6 +12,7 @@
 #include "Kappa/DataFormats/interface/Kappa.h"
 
 #include "Artus/KappaAnalysis/interface/KappaProducerBase.h"
+#include "Artus/KappaAnalysis/interface/Utility/ObjectSelector.h"
 #include "Artus/KappaAnalysis/interface/Utility/ValidPhysicsObjectTools.h"
 #include "Artus/Consumer/interface/LambdaNtupleConsumer.h"
 #include "Artus/Utility/interface/Utility.h"
@@ -118,8 +119,8 @@ public:
 	                   std::string (setting_type::*GetMuonID)(void) const=&setting_type::GetMuonID,
 	                   std::string (setting_type::*GetMuonIsoType)(void) const=&setting_type::GetMuonIsoType,
 	                   std::string (setting_type::*GetMuonIso)(void) const=&setting_type::GetMuonIso,
-	                   std::vector<std::string>& (setting_type::*GetLowerPtCuts)(void) const=&setting_type::GetMuonLowerPtCuts,
-	                   std::vector<std::string>& (setting_type::*GetUpperAbsEtaCuts)(void) const=&setting_type::GetMuonUpperAbsEtaCuts) :
+	                   std::vector<std::string> const& (setting_type::*GetLowerPtCuts)(void) const=&setting_type::GetMuonLowerPtCuts,
+	                   std::vector<std::string> const& (setting_type::*GetUpperAbsEtaCuts)(void) const=&setting_type::GetMuonUpperAbsEtaCuts) :
 		ProducerBase<TTypes>(),
 		ValidPhysicsObjectTools<TTypes, KMuon>(GetLowerPtCuts, GetUpperAbsEtaCuts, validMuons),
 		m_validMuonsMember(validMuons),
@@ -140,6 +141,11 @@ public:
 		muonIsoType = ToMuonIsoType(boost::algorithm::to_lower_copy(boost::algorithm::trim_copy((settings.*GetMuonIsoType)())));
 		muonIso = ToMuonIso(boost::algorithm::to_lower_copy(boost::algorithm::trim_copy((settings.*GetMuonIso)())));
 		
+		// the ID and isolation criteria are chosen once, such that no settings are needed per muon
+		muonSelector.Clear();
+		AddMuonIDCriteria(settings.GetYear());
+		AddMuonIsoCriteria(settings.GetDirectIso());
+		
 		// add possible quantities for the lambda ntuples consumers
 		LambdaNtupleConsumer<TTypes>::AddIntQuantity("nMuons", [](event_type const& event, product_type const& product) {
 			return product.m_validMuons.size();
@@ -227,79 +233,16 @@ public:
 			}
 		}
 		
-		// Apply muon isolation and MuonID
+		m_muonArrays.Build(muons);
+		this->PrepareKinematicCuts(m_muonArrays, product);
+		
 		for (std::vector<KMuon*>::iterator muon = muons.begin(); muon != muons.end(); ++muon)
 		{
-			bool validMuon = true;
-
-			// Muon ID according to Muon POG definitions
-			if (muonID == MuonID::TIGHT) {
-				if (settings.GetYear() == 2015)
-					validMuon = validMuon && IsTightMuon2015(*muon, event, product);
-				else if (settings.GetYear() == 2012)
-					validMuon = validMuon && IsTightMuon2012(*muon, event, product);
-				else if (settings.GetYear() == 2011)
-					validMuon = validMuon && IsTightMuon2011(*muon, event, product);
-				else
-					LOG(FATAL) << "Tight muon ID for year " << settings.GetYear() << " not yet implemented!";
-			}
-			else if (muonID == MuonID::MEDIUM) {
-				if (settings.GetYear() == 2015)
-					validMuon = validMuon && IsMediumMuon2015(*muon, event, product);
-				else
-					LOG(FATAL) << "Medium muon ID for year " << settings.GetYear() << " not yet implemented!";
-			}
-			else if (muonID == MuonID::LOOSE) {
-				if (settings.GetYear() == 2015)
-					validMuon = validMuon && IsLooseMuon2015(*muon, event, product);
-				else if (settings.GetYear() == 2012)
-					validMuon = validMuon && IsLooseMuon2012(*muon, event, product);
-				else
-					LOG(FATAL) << "Loose muon ID for year " << settings.GetYear() << " not yet implemented!";
-			}
-			else if (muonID == MuonID::VETO)
-			{
-				validMuon = validMuon && IsVetoMuon(*muon, event, product);
-			}
-			else if (muonID == MuonID::FAKEABLE)
-			{
-				validMuon = validMuon && IsFakeableMuon(*muon, event, product);
-			}
-			else if (muonID != MuonID::NONE)
-			{
-				LOG(FATAL) << "Muon ID of type " << Utility::ToUnderlyingValue(muonID) << " not yet implemented!";
-			}
-			
-			// Muon Isolation according to Muon POG definitions (independent of year)
-			// https://twiki.cern.ch/twiki/bin/view/CMSPublic/SWGuideMuonId#Muon_Isolation
-			// https://twiki.cern.ch/twiki/bin/view/CMSPublic/SWGuideMuonId#Muon_Isolation_AN1
-			if (muonIsoType == MuonIsoType::PF) {
-				if (muonIso == MuonIso::TIGHT)
-					validMuon = validMuon && ((((*muon)->pfIso() / (*muon)->p4.Pt()) < 0.12f) ? settings.GetDirectIso() : (!settings.GetDirectIso()));
-				else if (muonIso == MuonIso::LOOSE)
-					validMuon = validMuon && ((((*muon)->pfIso() / (*muon)->p4.Pt()) < 0.20f) ? settings.GetDirectIso() : (!settings.GetDirectIso()));
-				else if (muonIso == MuonIso::TIGHT_2015)
-					validMuon = validMuon && ((((*muon)->pfIso(0.5) / (*muon)->p4.Pt()) < 0.15f) ? settings.GetDirectIso() : (!settings.GetDirectIso()));
-				else if (muonIso == MuonIso::LOOSE_2015)
-					validMuon = validMuon && ((((*muon)->pfIso(0.5) / (*muon)->p4.Pt()) < 0.30f) ? settings.GetDirectIso() : (!settings.GetDirectIso()));
-				else if (muonIso == MuonIso::FAKEABLE)
-					validMuon = validMuon && IsFakeableMuonIso(*muon, event, product, settings);
-				else if (muonIso != MuonIso::NONE)
-					LOG(FATAL) << "Muon isolation of type " << Utility::ToUnderlyingValue(muonIso) << " not yet implemented!";
-			}
-			else if (muonIsoType == MuonIsoType::DETECTOR) {
-				if (muonIso == MuonIso::TIGHT)
-					validMuon = validMuon && ((((*muon)->trackIso / (*muon)->p4.Pt()) < 0.05f) ? settings.GetDirectIso() : (!settings.GetDirectIso()));
-				else if (muonIso == MuonIso::LOOSE)
-					validMuon = validMuon && ((((*muon)->trackIso / (*muon)->p4.Pt()) < 0.10f) ? settings.GetDirectIso() : (!settings.GetDirectIso()));
-				else if (muonIso != MuonIso::NONE)
-					LOG(FATAL) << "Muon isolation of type " << Utility::ToUnderlyingValue(muonIso) << " not yet implemented!";
-			}
-			else if (muonIsoType != MuonIsoType::USER && muonIsoType != MuonIsoType::NONE)
-				LOG(FATAL) << "Muon isolation type of type " << Utility::ToUnderlyingValue(muonIsoType) << " not yet implemented!";
+			// muon ID and isolation
+			bool validMuon = muonSelector.Pass(*muon, event);
 			
 			// kinematic cuts
-			validMuon = validMuon && this->PassKinematicCuts(*muon, event, product);
+			validMuon = validMuon && this->PassKinematicCuts(m_muonArrays, muon - muons.begin(), product);
 			
 			// check possible analysis-specific criteria
 			validMuon = validMuon && AdditionalCriteria(*muon, event, product, settings);
@@ -314,12 +257,19 @@ public:
 			}
 		}
 	}
+	
+	/// ID and isolation criteria as configured for this producer, e.g. for the use in filters
+	ObjectSelector<KMuon, event_type> const& GetMuonSelector() const
+	{
+		return muonSelector;
+	}
 
 
 protected:
 	MuonID muonID;
 	MuonIsoType muonIsoType;
 	MuonIso muonIso;
+	ObjectSelector<KMuon, event_type> muonSelector;
 	
 	// Can be overwritten for analysis-specific use cases
 	virtual bool AdditionalCriteria(KMuon* muon, event_type const& event,
@@ -338,9 +288,99 @@ private:
 	std::string (setting_type::*GetMuonIso)(void) const;
 
 	ValidMuonsInput validMuonsInput;
+
+	// kinematics of the input muons of the current event
+	mutable PhysicsObjectArrays m_muonArrays;
+	
+	void AddMuonIDCriteria(int year)
+	{
+		// Muon ID according to Muon POG definitions
+		if (muonID == MuonID::TIGHT) {
+			if (year == 2015)
+				muonSelector.Add(&IsTightMuon2015);
+			else if (year == 2012)
+				muonSelector.Add(&IsTightMuon2012);
+			else if (year == 2011)
+				muonSelector.Add(&IsTightMuon2011);
+			else
+				LOG(FATAL) << "Tight muon ID for year " << year << " not yet implemented!";
+		}
+		else if (muonID == MuonID::MEDIUM) {
+			if (year == 2015)
+				muonSelector.Add(&IsMediumMuon2015);
+			else
+				LOG(FATAL) << "Medium muon ID for year " << year << " not yet implemented!";
+		}
+		else if (muonID == MuonID::LOOSE) {
+			if (year == 2015)
+				muonSelector.Add(&IsLooseMuon2015);
+			else if (year == 2012)
+				muonSelector.Add(&IsLooseMuon2012);
+			else
+				LOG(FATAL) << "Loose muon ID for year " << year << " not yet implemented!";
+		}
+		else if (muonID == MuonID::VETO)
+		{
+			muonSelector.Add(&IsVetoMuon);
+		}
+		else if (muonID == MuonID::FAKEABLE)
+		{
+			muonSelector.Add(&IsFakeableMuon);
+		}
+		else if (muonID != MuonID::NONE)
+		{
+			LOG(FATAL) << "Muon ID of type " << Utility::ToUnderlyingValue(muonID) << " not yet implemented!";
+		}
+	}
+	
+	// Muon Isolation according to Muon POG definitions (independent of year)
+	// https://twiki.cern.ch/twiki/bin/view/CMSPublic/SWGuideMuonId#Muon_Isolation
+	// https://twiki.cern.ch/twiki/bin/view/CMSPublic/SWGuideMuonId#Muon_Isolation_AN1
+	// the isolation criteria are inverted for directIso == false
+	void AddMuonIsoCriteria(bool directIso)
+	{
+		if (muonIsoType == MuonIsoType::PF) {
+			if (muonIso == MuonIso::TIGHT)
+				muonSelector.Add([directIso](KMuon* muon, event_type const& event) {
+					return ((muon->pfIso() / muon->p4.Pt()) < 0.12f) == directIso;
+				});
+			else if (muonIso == MuonIso::LOOSE)
+				muonSelector.Add([directIso](KMuon* muon, event_type const& event) {
+					return ((muon->pfIso() / muon->p4.Pt()) < 0.20f) == directIso;
+				});
+			else if (muonIso == MuonIso::TIGHT_2015)
+				muonSelector.Add([directIso](KMuon* muon, event_type const& event) {
+					return ((muon->pfIso(0.5) / muon->p4.Pt()) < 0.15f) == directIso;
+				});
+			else if (muonIso == MuonIso::LOOSE_2015)
+				muonSelector.Add([directIso](KMuon* muon, event_type const& event) {
+					return ((muon->pfIso(0.5) / muon->p4.Pt()) < 0.30f) == directIso;
+				});
+			else if (muonIso == MuonIso::FAKEABLE)
+				muonSelector.Add([directIso](KMuon* muon, event_type const& event) {
+					return IsFakeableMuonIso(muon, directIso);
+				});
+			else if (muonIso != MuonIso::NONE)
+				LOG(FATAL) << "Muon isolation of type " << Utility::ToUnderlyingValue(muonIso) << " not yet implemented!";
+		}
+		else if (muonIsoType == MuonIsoType::DETECTOR) {
+			if (muonIso == MuonIso::TIGHT)
+				muonSelector.Add([directIso](KMuon* muon, event_type const& event) {
+					return ((muon->trackIso / muon->p4.Pt()) < 0.05f) == directIso;
+				});
+			else if (muonIso == MuonIso::LOOSE)
+				muonSelector.Add([directIso](KMuon* muon, event_type const& event) {
+					return ((muon->trackIso / muon->p4.Pt()) < 0.10f) == directIso;
+				});
+			else if (muonIso != MuonIso::NONE)
+				LOG(FATAL) << "Muon isolation of type " << Utility::ToUnderlyingValue(muonIso) << " not yet implemented!";
+		}
+		else if (muonIsoType != MuonIsoType::USER && muonIsoType != MuonIsoType::NONE)
+			LOG(FATAL) << "Muon isolation type of type " << Utility::ToUnderlyingValue(muonIsoType) << " not yet implemented!";
+	}
 	
 	// https://twiki.cern.ch/twiki/bin/view/CMSPublic/SWGuideMuonId#Tight_Muon_selection
-	bool IsTightMuon2011(KMuon* muon, event_type const& event, product_type& product) const
+	static bool IsTightMuon2011(KMuon* muon, event_type const& event)
 	{
 		return muon->isGlobalMuon()
 		       && muon->isPFMuon()
@@ -353,7 +393,7 @@ private:
 	}
 	
 	// https://twiki.cern.ch/twiki/bin/view/CMSPublic/SWGuideMuonId#Tight_Muon
-	bool IsTightMuon2012(KMuon* muon, event_type const& event, product_type& product) const
+	static bool IsTightMuon2012(KMuon* muon, event_type const& event)
 	{
 		return muon->isGlobalMuon()
 		       && muon->isPFMuon()
@@ -367,33 +407,33 @@ private:
 	}
 	
 	// https://twiki.cern.ch/twiki/bin/view/CMSPublic/SWGuideMuonId#Loose_Muon
-	bool IsLooseMuon2012(KMuon* muon, event_type const& event, product_type& product) const
+	static bool IsLooseMuon2012(KMuon* muon, event_type const& event)
 	{
 		return muon->isPFMuon()
 		       && (muon->isGlobalMuon() || muon->isTrackerMuon());
 	}
 
 	// https://twiki.cern.ch/twiki/bin/viewauth/CMS/SWGuideMuonIdRun2#Loose_Muon
-	bool IsLooseMuon2015(KMuon* muon, event_type const& event, product_type& product) const
+	static bool IsLooseMuon2015(KMuon* muon, event_type const& event)
 	{
 		return muon->idLoose();
 	}
 
 	// https://twiki.cern.ch/twiki/bin/viewauth/CMS/SWGuideMuonIdRun2#Medium_Muon
-	bool IsMediumMuon2015(KMuon* muon, event_type const& event, product_type& product) const
+	static bool IsMediumMuon2015(KMuon* muon, event_type const& event)
 	{
 		return muon->idMedium();
 	}
 
 	// https://twiki.cern.ch/twiki/bin/viewauth/CMS/SWGuideMuonIdRun2#Tight_Muon
-	bool IsTightMuon2015(KMuon* muon, event_type const& event, product_type& product) const
+	static bool IsTightMuon2015(KMuon* muon, event_type const& event)
 	{
 		return muon->idTight();
 	}
 
 	// https://twiki.cern.ch/twiki/bin/viewauth/CMS/HiggsToTauTauWorkingSummer2013#Muon_Tau_Final_state
 	// should be move to Higgs code
-	bool IsVetoMuon(KMuon* muon, event_type const& event, product_type& product) const
+	static bool IsVetoMuon(KMuon* muon, event_type const& event)
 	{
 		return muon->isPFMuon()
 		       && muon->isGlobalMuon()
@@ -401,27 +441,27 @@ private:
 		       && (std::abs(muon->dz) < 0.2f);
 	}
 
-	bool IsFakeableMuon(KMuon* muon, event_type const& event, product_type& product) const
+	static bool IsFakeableMuon(KMuon* muon, event_type const& event)
 	{
 		return muon->isGlobalMuon()
 		       && std::abs(muon->dxy) < 0.2f;
 	}
 
-	bool IsFakeableMuonIso(KMuon* muon, event_type const& event, product_type& product, setting_type const& settings) const
+	static bool IsFakeableMuonIso(KMuon* muon, bool directIso)
 	{
 		bool validMuon = true;
 
 		if (muon->p4.Pt() <= 20.0) {
 			validMuon = validMuon &&
-				   ((muon->trackIso < 8.0f) ? settings.GetDirectIso() : (!settings.GetDirectIso()) &&
-				   (muon->ecalIso  < 8.0f) ? settings.GetDirectIso() : (!settings.GetDirectIso()) &&
-				   (muon->hcalIso  < 8.0f) ? settings.GetDirectIso() : (!settings.GetDirectIso()));
+				   ((muon->trackIso < 8.0f) ? directIso : (!directIso) &&
+				   (muon->ecalIso  < 8.0f) ? directIso : (!directIso) &&
+				   (muon->hcalIso  < 8.0f) ? directIso : (!directIso));
 		}
 		else {
 			validMuon = validMuon &&
-				   (((muon->trackIso / muon->p4.Pt()) < 0.4f) ? settings.GetDirectIso() : (!settings.GetDirectIso()) &&
-				   ((muon->ecalIso / muon->p4.Pt()) < 0.4f) ? settings.GetDirectIso() : (!settings.GetDirectIso()) &&
-				   ((muon->hcalIso / muon->p4.Pt()) < 0.4f) ? settings.GetDirectIso() : (!settings.GetDirectIso()));
+				   (((muon->trackIso / muon->p4.Pt()) < 0.4f) ? directIso : (!directIso) &&
+				   ((muon->ecalIso / muon->p4.Pt()) < 0.4f) ? directIso : (!directIso) &&
+				   ((muon->hcalIso / muon->p4.Pt()) < 0.4f) ? directIso : (!directIso));
 		}
 
 		return validMuon;
@@ -10,7 +10,9 @@
 #include "Kappa/DataFormats/interface/Kappa.h"
 
 #include "Artus/KappaAnalysis/interface/KappaProducerBase.h"
+#include "Artus/KappaAnalysis/interface/Utility/ObjectSelector.h"
 #include "Artus/KappaAnalysis/interface/Utility/ValidPhysicsObjectTools.h"
+#include "Artus/KappaAnalysis/interface/Utility/MetadataNameBinding.h"
 #include "Artus/KappaAnalysis/interface/Consumers/KappaLambdaNtupleConsumer.h"
 #include "Artus/Utility/interface/SafeMap.h"
 #include "Artus/Utility/interface/Utility.h"
@@ -65,6 +67,8 @@ public:
 		ValidPhysicsObjectTools<KappaTypes, KTau>(&KappaSettings::GetTauLowerPtCuts,
 		                                    &KappaSettings::GetTauUpperAbsEtaCuts,
 		                                    &KappaProduct::m_validTaus),
+		binaryDiscriminators(&KTauMetadata::binaryDiscriminatorNames, "Tau discriminator"),
+		floatDiscriminators(&KTauMetadata::floatDiscriminatorNames, "Tau discriminator"),
 		tauID(TauID::NONE)
 	{
 	}
@@ -82,6 +86,33 @@ public:
 		tauID = ToTauID(settings.GetTauID());
 		oldTauDMs = settings.GetTauUseOldDMs();
 
+		// the discriminator names are resolved to indices for every input file
+		for (std::map<size_t, std::vector<std::string> >::const_iterator discriminatorByIndex = discriminatorsByIndex.begin();
+		     discriminatorByIndex != discriminatorsByIndex.end(); ++discriminatorByIndex)
+		{
+			discriminatorHandlesByIndex[discriminatorByIndex->first] = binaryDiscriminators.Add(discriminatorByIndex->second);
+		}
+		discriminatorHandlesForHlt.clear();
+		for (std::map<std::string, std::vector<std::string> >::const_iterator discriminatorByHltName = discriminatorsByHltName.begin();
+		     discriminatorByHltName != discriminatorsByHltName.end(); ++discriminatorByHltName)
+		{
+			DiscriminatorHandlesForHlt discriminatorHandles;
+			discriminatorHandles.isDefault = (discriminatorByHltName->first == "default");
+			discriminatorHandles.hltName = boost::regex(discriminatorByHltName->first, boost::regex::icase | boost::regex::extended);
+			discriminatorHandles.handles = binaryDiscriminators.Add(discriminatorByHltName->second);
+			discriminatorHandlesForHlt.push_back(discriminatorHandles);
+		}
+		
+		// the ID criteria are chosen once, such that no settings are needed per tau
+		tauSelector.Clear();
+		if (tauID == TauID::RECOMMENDATION13TEV)
+		{
+			decayModeDiscriminatorHandle = floatDiscriminators.Add(oldTauDMs ? "decayModeFinding" : "decayModeFindingNewDMs");
+			tauSelector.Add([this](KTau* tau, KappaEvent const& event) {
+				return IsTauIDRecommendation13TeV(tau, event);
+			});
+		}
+
 		// add possible quantities for the lambda ntuples consumers
 		LambdaNtupleConsumer<KappaTypes>::AddIntQuantity("nTaus", [](KappaEvent const& event, KappaProduct const& product) {
 			return product.m_validTaus.size();
@@ -105,6 +136,8 @@ public:
 	{
 		assert(event.m_taus);
 		assert(event.m_tauMetadata);
+		binaryDiscriminators.Bind(event.m_tauMetadata, event.m_input);
+		floatDiscriminators.Bind(event.m_tauMetadata, event.m_input);
 	
 		// select input source
 		std::vector<KTau*> taus;
@@ -130,37 +163,42 @@ public:
 			}
 		}
 		
+		m_tauArrays.Build(taus);
+		this->PrepareKinematicCuts(m_tauArrays, product);
+		
+		// the discriminators depending on the selected HLT paths are the same for all taus of the event
+		std::vector<std::vector<size_t> const*> discriminatorHandlesForEvent;
+		for (std::vector<DiscriminatorHandlesForHlt>::const_iterator discriminatorHandles = discriminatorHandlesForHlt.begin();
+		     discriminatorHandles != discriminatorHandlesForHlt.end(); ++discriminatorHandles)
+		{
+			if (discriminatorHandles->MatchesHlt(product))
+			{
+				discriminatorHandlesForEvent.push_back(&(discriminatorHandles->handles));
+			}
+		}
+		
 		for (std::vector<KTau*>::iterator tau = taus.begin(); tau != taus.end(); ++tau)
 		{
 			bool validTau = true;
 			
 			// check discriminators
-			for (std::map<size_t, std::vector<std::string> >::const_iterator discriminatorByIndex = discriminatorsByIndex.begin();
-				 validTau && (discriminatorByIndex != discriminatorsByIndex.end()); ++discriminatorByIndex)
+			std::map<size_t, std::vector<size_t> >::const_iterator discriminatorHandlesForIndex = discriminatorHandlesByIndex.find(product.m_validTaus.size());
+			if (discriminatorHandlesForIndex != discriminatorHandlesByIndex.end())
 			{
-				if (discriminatorByIndex->first == product.m_validTaus.size())
-				{
-					validTau = validTau && ApplyDiscriminators(*tau, discriminatorByIndex->second, event);
-				}
+				validTau = validTau && ApplyDiscriminators(*tau, discriminatorHandlesForIndex->second);
 			}
 			
-			for (std::map<std::string, std::vector<std::string> >::const_iterator discriminatorByHltName = discriminatorsByHltName.begin();
-				 validTau && (discriminatorByHltName != discriminatorsByHltName.end()); ++discriminatorByHltName)
+			for (std::vector<std::vector<size_t> const*>::const_iterator discriminatorHandles = discriminatorHandlesForEvent.begin();
+			     validTau && (discriminatorHandles != discriminatorHandlesForEvent.end()); ++discriminatorHandles)
 			{
-				bool hasMatch = false;
-				for (unsigned int iHlt = 0; iHlt < product.m_selectedHltNames.size(); ++iHlt)
-					hasMatch = hasMatch || boost::regex_search(product.m_selectedHltNames.at(iHlt), boost::regex(discriminatorByHltName->first, boost::regex::icase | boost::regex::extended));
-
-				if ((discriminatorByHltName->first == "default") || hasMatch)
-				{
-					validTau = validTau && ApplyDiscriminators(*tau, discriminatorByHltName->second, event);
-				}
+				validTau = validTau && ApplyDiscriminators(*tau, **discriminatorHandles);
 			}
 			
-			if(tauID == TauID::RECOMMENDATION13TEV)
-					validTau = validTau && IsTauIDRecommendation13TeV(*tau, event, oldTauDMs);
+			// tau ID
+			validTau = validTau && tauSelector.Pass(*tau, event);
+			
 			// kinematic cuts
-			validTau = validTau && this->PassKinematicCuts(*tau, event, product);
+			validTau = validTau && this->PassKinematicCuts(m_tauArrays, tau - taus.begin(), product);
 			
 			// check possible analysis-specific criteria
 			validTau = validTau && AdditionalCriteria(*tau, event, product, settings);
@@ -177,7 +215,15 @@ public:
 	}
 
 
+	/// ID criteria as configured for this producer, e.g. for the use in filters
+	ObjectSelector<KTau, KappaEvent> const& GetTauSelector() const
+	{
+		return tauSelector;
+	}
+
+
 protected:
+	ObjectSelector<KTau, KappaEvent> tauSelector;
 	
 	// Can be overwritten for analysis-specific use cases
 	virtual bool AdditionalCriteria(KTau* tau, KappaEvent const& event,
@@ -190,19 +236,46 @@ protected:
 
 private:
 	ValidTausInput validTausInput;
+
+	// kinematics of the input taus of the current event
+	mutable PhysicsObjectArrays m_tauArrays;
 	
 	std::map<size_t, std::vector<std::string> > discriminatorsByIndex;
 	std::map<std::string, std::vector<std::string> > discriminatorsByHltName;
 	
-	bool ApplyDiscriminators(KTau* tau, std::vector<std::string> const& discriminators,
-	                         KappaEvent const& event) const
+	// names of the discriminators, resolved once per input file
+	MetadataNameBinding<KTauMetadata> binaryDiscriminators;
+	MetadataNameBinding<KTauMetadata> floatDiscriminators;
+	std::map<size_t, std::vector<size_t> > discriminatorHandlesByIndex;
+	size_t decayModeDiscriminatorHandle = 0;
+	
+	// discriminators applied in events with at least one selected HLT path matching the regular expression
+	struct DiscriminatorHandlesForHlt
+	{
+		bool isDefault;
+		boost::regex hltName;
+		std::vector<size_t> handles;
+		
+		bool MatchesHlt(KappaProduct const& product) const
+		{
+			bool hasMatch = isDefault;
+			for (size_t selectedHltIndex = 0; (! hasMatch) && (selectedHltIndex < product.m_selectedHltIndices.size()); ++selectedHltIndex)
+			{
+				hasMatch = boost::regex_search(product.GetSelectedHltName(selectedHltIndex), hltName);
+			}
+			return hasMatch;
+		}
+	};
+	std::vector<DiscriminatorHandlesForHlt> discriminatorHandlesForHlt;
+	
+	bool ApplyDiscriminators(KTau* tau, std::vector<size_t> const& discriminatorHandles) const
 	{
 		bool validTau = true;
 		
-		for (std::vector<std::string>::const_iterator discriminator = discriminators.begin();
-		     validTau && (discriminator != discriminators.end()); ++discriminator)
+		for (std::vector<size_t>::const_iterator discriminatorHandle = discriminatorHandles.begin();
+		     validTau && (discriminatorHandle != discriminatorHandles.end()); ++discriminatorHandle)
 		{
-			validTau = validTau && tau->getId(*discriminator, event.m_tauMetadata);
+			validTau = validTau && MetadataNameBinding<KTauMetadata>::GetBit(tau->binaryDiscriminators, binaryDiscriminators.GetIndex(*discriminatorHandle));
 		}
 		
 		return validTau;
@@ -211,13 +284,12 @@ private:
 	TauID tauID;
 	bool oldTauDMs;
 
-	bool IsTauIDRecommendation13TeV(KTau* tau, KappaEvent const& event, bool const& oldTauDMs) const
+	bool IsTauIDRecommendation13TeV(KTau* tau, KappaEvent const& event) const
 	{
-		const KVertex* vertex = new KVertex(event.m_vertexSummary->pv);
-		float decayModeDiscriminator = (oldTauDMs ? tau->getDiscriminator("decayModeFinding", event.m_tauMetadata)
-							  : tau->getDiscriminator("decayModeFindingNewDMs", event.m_tauMetadata));
+		KVertex const& vertex = event.m_vertexSummary->pv;
+		float decayModeDiscriminator = tau->floatDiscriminators[floatDiscriminators.GetIndex(decayModeDiscriminatorHandle)];
 		return ( decayModeDiscriminator > 0.5
-			 && (std::abs(tau->track.ref.z() - vertex->position.z()) < 0.2)
+			 && (std::abs(tau->track.ref.z() - vertex.position.z()) < 0.2)
 			// tau dZ requirement for Phys14 sync
 			//&& (Utility::ApproxEqual(tau->track.ref.z(), vertex->position.z()))
 		);
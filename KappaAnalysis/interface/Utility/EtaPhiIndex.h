@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+
+/**
+   \brief Index of the directions of a collection of objects for the search of objects within a
+   cone in delta R.
+
+   The objects are sorted by eta, such that a query only has to look at the objects in the eta
+   band of the cone. The difference in phi is checked including the wrap-around. The index is
+   built once per event and collection and then shared by all matching producers.
+
+   The queries return a superset of the objects within the cone: the boundaries are widened by a
+   small margin and objects with undefined eta are always returned. Therefore, the exact delta R
+   has to be checked by the caller, which keeps the results identical to looping over the full
+   collection. The indices of the candidates are returned in the order of the collection.
+*/
+class EtaPhiIndex
+{
+public:
+
+	void Clear();
+
+	void Add(size_t index, float eta, float phi);
+
+	/// sorts the added objects, has to be called after adding them and before the queries
+	void Finalise();
+
+	bool IsBuilt() const
+	{
+		return m_built;
+	}
+
+	/// builds the index for a collection of objects with the member p4
+	template<class TObject>
+	void Build(std::vector<TObject> const& objects)
+	{
+		Clear();
+		for (size_t index = 0; index < objects.size(); ++index)
+		{
+			Add(index, objects[index].p4.Eta(), objects[index].p4.Phi());
+		}
+		Finalise();
+	}
+
+	/// indices of all objects which can be within deltaRMax around the given direction, sorted ascending
+	void GetCandidates(float eta, float phi, float deltaRMax, std::vector<size_t>& indices) const;
+
+	size_t GetSize() const
+	{
+		return m_entries.size() + m_unsortedIndices.size();
+	}
+
+private:
+
+	struct Entry
+	{
+		float eta;
+		float phi;
+		size_t index;
+	};
+
+	std::vector<Entry> m_entries;
+	std::vector<size_t> m_unsortedIndices;
+	bool m_built = false;
+};
+
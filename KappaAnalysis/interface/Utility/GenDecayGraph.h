@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include "Kappa/DataFormats/interface/Kappa.h"
+
+#include "Artus/KappaAnalysis/interface/Utility/GenParticleIndex.h"
+
+
+/**
+   \brief Decay trees of the generator bosons of an event.
+
+   All nodes are stored in one array and refer to each other by their positions. The daughters of
+   a node are consecutive in this array. The summaries of the subtrees (final states, number of
+   charged final states and decay mode) are computed once when the graph is built, such that the
+   graph is not changed afterwards and can be shared between the pipelines.
+
+   The trees start with the bosons of the requested |pdgId| and status. The intermediate
+   generation below the boson daughters (e.g. the status 2 copies of status 3 taus) is skipped,
+   such that the daughters of the boson daughters are their actual decay products.
+*/
+class GenDecayGraph
+{
+public:
+
+	static const size_t NoNode;
+
+	enum class DecayMode : int
+	{
+		NONE = -1,
+		E   = 1,
+		M   = 2,
+		//Greater 3 is hadronic
+		PI = 4,
+		KPLUS = 5,
+		KSTAR = 6,
+		RHO = 7,
+		AONE   = 8,
+		//These should appear for HiggsBoson
+		TAU = 10,
+		TAUTAU = 11
+	};
+
+	struct Node
+	{
+		// must be != null
+		KGenParticle* particle;
+		size_t parent;
+
+		// daughters are the nodes [firstDaughter, firstDaughter + nDaughters)
+		size_t firstDaughter;
+		size_t nDaughters;
+
+		int charge; // 5 if unknown
+		bool detectable;
+		bool finalState;
+
+		// summaries of the subtree of this node
+		size_t firstFinalState;
+		size_t nFinalStates;
+		size_t nChargedFinalStates;
+		DecayMode decayMode;
+	};
+
+	void Build(KGenParticles& genParticles, GenParticleIndex const& genParticleIndex, int bosonPdgId, int bosonStatus);
+
+	size_t GetNBosons() const
+	{
+		return m_bosons.size();
+	}
+
+	/// access to the nodes along a path of daughter positions, nullptr if one of them does not exist
+	Node const* GetNode(size_t bosonIndex) const;
+	Node const* GetNode(size_t bosonIndex, size_t daughterIndex) const;
+	Node const* GetNode(size_t bosonIndex, size_t daughterIndex, size_t granddaughterIndex) const;
+	Node const* GetNode(size_t bosonIndex, size_t daughterIndex, size_t granddaughterIndex, size_t grandGranddaughterIndex) const;
+
+	Node const* GetDaughter(Node const* node, size_t daughterIndex) const;
+
+	/// final states in the subtree of a node, in the order of a depth-first search
+	Node const& GetFinalState(Node const& node, size_t finalStateIndex) const
+	{
+		return m_nodes[m_finalStates[node.firstFinalState + finalStateIndex]];
+	}
+
+	/// 1, 3 or 5 for the corresponding number of charged final states, otherwise -1
+	static int GetProngSize(Node const& node);
+
+	static int GetCharge(int pdgId);
+	static bool IsDetectable(int pdgId);
+
+private:
+
+	size_t AddNode(KGenParticles& genParticles, size_t particleIndex, size_t parent);
+	void AddDaughters(KGenParticles& genParticles, size_t node, size_t particleIndex);
+
+	void CollectFinalStates(size_t node, std::vector<size_t>& finalStates) const;
+	void DetermineDecayMode(size_t node, DecayMode& decayMode) const;
+	static void UpdateDecayMode(int pdgId, DecayMode& decayMode);
+
+	std::vector<Node> m_nodes;
+	std::vector<size_t> m_bosons;
+	std::vector<size_t> m_finalStates;
+};
+
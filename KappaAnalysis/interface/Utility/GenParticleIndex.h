@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "Kappa/DataFormats/interface/Kappa.h"
+
+
+/**
+   \brief Index of the gen particles of an event by |pdgId| and by status together with the
+   mother/daughter relations.
+
+   The index is built with one pass over the gen particles on the first use in an event and is
+   then shared by all gen producers via the product. The lists of indices are stored in
+   compressed form (one offset per key or particle into one buffer). All lists are sorted in the
+   order of the gen particle collection, such that loops over them behave like loops over the full
+   collection with the corresponding condition.
+
+   The daughters are stored as given in the gen particles, including invalid indices. The
+   mothers are derived from the valid daughter indices.
+*/
+class GenParticleIndex
+{
+public:
+
+	typedef std::vector<size_t>::const_iterator const_iterator;
+
+	class IndexRange
+	{
+	public:
+		IndexRange(const_iterator begin, const_iterator end) : m_begin(begin), m_end(end) {}
+
+		const_iterator begin() const { return m_begin; }
+		const_iterator end() const { return m_end; }
+		size_t size() const { return (m_end - m_begin); }
+		bool empty() const { return (m_begin == m_end); }
+
+	private:
+		const_iterator m_begin;
+		const_iterator m_end;
+	};
+
+	void Clear();
+
+	void Build(KGenParticles const& genParticles);
+
+	bool IsBuilt() const
+	{
+		return m_built;
+	}
+
+	/// indices of all gen particles with the given |pdgId|
+	IndexRange GetByAbsPdgId(int absPdgId) const;
+
+	/// indices of all gen particles with the given status
+	IndexRange GetByStatus(int status) const;
+
+	IndexRange GetDaughters(size_t index) const;
+	IndexRange GetMothers(size_t index) const;
+
+private:
+
+	// keys sorted ascending, the indices for m_keys[i] are in m_indices[m_offsets[i]:m_offsets[i+1]]
+	struct KeyedIndices
+	{
+		std::vector<int> m_keys;
+		std::vector<size_t> m_offsets;
+		std::vector<size_t> m_indices;
+
+		void Clear();
+		void Build(std::vector<int> const& keyPerParticle);
+		IndexRange Get(int key) const;
+	};
+
+	KeyedIndices m_byAbsPdgId;
+	KeyedIndices m_byStatus;
+
+	std::vector<size_t> m_daughterOffsets;
+	std::vector<size_t> m_daughters;
+	std::vector<size_t> m_motherOffsets;
+	std::vector<size_t> m_mothers;
+
+	bool m_built = false;
+};
+
@@ -0,0 +1,182 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "CondFormats/JetMETObjects/interface/JetCorrectorParameters.h"
+
+#include "Artus/Utility/interface/Expression.h"
+
+
+/**
+   \brief Jets of an event as structure of arrays, the input of the jet energy corrections.
+*/
+struct JetCorrectionInputs
+{
+	enum class Variable : int
+	{
+		JetPt,
+		JetEta,
+		JetPhi,
+		JetE,
+		JetA,
+		Rho,
+		NPV
+	};
+
+	/// variable with the name used in the JetCorrectorParameters, unknown names are fatal
+	static Variable GetVariable(std::string const& name);
+
+	float GetValue(Variable variable, size_t jetIndex) const
+	{
+		switch (variable)
+		{
+		case Variable::JetPt:
+			return pt[jetIndex];
+		case Variable::JetEta:
+			return eta[jetIndex];
+		case Variable::JetPhi:
+			return phi[jetIndex];
+		case Variable::JetE:
+			return energy[jetIndex];
+		case Variable::JetA:
+			return area[jetIndex];
+		case Variable::Rho:
+			return rho;
+		case Variable::NPV:
+		default:
+			return nPrimaryVertices;
+		}
+	}
+
+	float const* pt = nullptr;
+	float const* eta = nullptr;
+	float const* phi = nullptr;
+	float const* energy = nullptr;
+	float const* area = nullptr;
+	size_t size = 0;
+
+	float rho = 0.0f;
+	float nPrimaryVertices = 0.0f;
+};
+
+
+/**
+   \brief Records of one set of JetCorrectorParameters as lookup table.
+
+   The bin boundaries of all records are stored contiguously. Tables with one bin variable and
+   ordered, non-overlapping bins are searched by bisection, others linearly. As in
+   JetCorrectorParameters::binIndex, a jet belongs to the first record with xMin <= x < xMax in
+   all bin variables. Every record needs at least the ranges of the parameter variables, i.e.
+   2 * nParVar parameters.
+*/
+class JetCorrectionTable
+{
+public:
+
+	explicit JetCorrectionTable(JetCorrectorParameters const& parameters);
+
+	size_t GetNRecords() const
+	{
+		return m_parameterOffsets.size() - 1;
+	}
+
+	std::vector<JetCorrectionInputs::Variable> const& GetParameterVariables() const
+	{
+		return m_parameterVariables;
+	}
+
+	/// index of the record of the jet, -1 if the jet is outside of all bins
+	int FindRecord(JetCorrectionInputs const& jets, size_t jetIndex) const;
+
+	float const* GetParameters(size_t recordIndex) const
+	{
+		return &(m_parameters[m_parameterOffsets[recordIndex]]);
+	}
+
+	size_t GetNParameters(size_t recordIndex) const
+	{
+		return m_parameterOffsets[recordIndex + 1] - m_parameterOffsets[recordIndex];
+	}
+
+private:
+	std::vector<JetCorrectionInputs::Variable> m_binVariables;
+	std::vector<JetCorrectionInputs::Variable> m_parameterVariables;
+
+	// [recordIndex * nBinVariables + binVariableIndex]
+	std::vector<float> m_xMin;
+	std::vector<float> m_xMax;
+	bool m_bisection = false;
+
+	// parameters of all records, starting at m_parameterOffsets[recordIndex]
+	std::vector<float> m_parameters;
+	std::vector<size_t> m_parameterOffsets;
+};
+
+
+/**
+   \brief Factorised jet energy corrections converted once from JetCorrectorParameters.
+
+   Replaces the FactorizedJetCorrector for the levels of the standard text files. For every level,
+   the records are converted into a JetCorrectionTable and the TFormula is translated and compiled
+   into an Expression. The first 2 * nParVar parameters of a record clamp the parameter variables,
+   the remaining ones are the parameters [0], [1], ... of the formula. As in the
+   FactorizedJetCorrector, every level is evaluated with the pt and energy corrected by the
+   previous levels and jets outside of the bins of a level are not corrected by this level.
+
+   GetCorrections evaluates each level for all jets of an event at once. It does not change the
+   object, such that one instance can be shared between pipelines and threads.
+   Response functions to be inverted (L5 flavour) are not supported.
+*/
+class JetEnergyCorrection
+{
+public:
+
+	explicit JetEnergyCorrection(std::vector<JetCorrectorParameters> const& levels);
+
+	/// factors[jetIndex] = product of the corrections of all levels
+	void GetCorrections(JetCorrectionInputs const& jets, float* factors) const;
+
+	/// translates a TFormula into the syntax of Expression, e.g. [0]*TMath::Log(x) into p0*log(x)
+	static std::string TranslateFormula(std::string const& formula);
+
+private:
+
+	struct Level
+	{
+		explicit Level(JetCorrectorParameters const& parameters);
+
+		JetCorrectionTable table;
+		Expression formula;
+		// for every variable of the formula: index of the parameter variable (x, y, z, t) or
+		// index in the parameters of the record for the parameters [0], [1], ...
+		std::vector<size_t> variableSources;
+		std::vector<bool> variableIsParameter;
+	};
+
+	std::vector<Level> m_levels;
+};
+
+
+/**
+   \brief Jet energy correction uncertainties converted once from JetCorrectorParameters.
+
+   Replaces the JetCorrectionUncertainty. The records contain triplets of (x, up, down) of the
+   first parameter variable (JetPt), between which the uncertainties are interpolated linearly as
+   in the SimpleJetCorrectionUncertainty. The object does not change after construction.
+*/
+class JetEnergyCorrectionUncertainty
+{
+public:
+
+	explicit JetEnergyCorrectionUncertainty(JetCorrectorParameters const& parameters);
+
+	/// relative uncertainties of the (corrected) jets for upward or downward shifts
+	/// jets outside of the bins get the uncertainty 0, such that they are not shifted
+	/// returns the number of jets outside of the bins
+	size_t GetUncertainties(JetCorrectionInputs const& jets, bool up, float* uncertainties) const;
+
+private:
+	JetCorrectionTable m_table;
+};
+
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "Artus/Utility/interface/ArtusLogging.h"
+
+#include <algorithm>
+#include <cassert>
+
+#include <boost/algorithm/string/join.hpp>
+
+#include "Kappa/DataFormats/interface/Kappa.h"
+
+
+/**
+   \brief Resolves names of jet taggers, tau discriminators or electron IDs to their positions in
+   the metadata of the current input file.
+
+   The names are added in the Init function of a processor. The metadata only changes on file
+   boundaries, therefore the names are looked up once per input file in Bind. Afterwards, the
+   values of the objects can be read by index instead of searching for the names for every object
+   in every event. Names which are not available in an input file are reported with the first
+   event of this file.
+*/
+template<class TMetadata>
+class MetadataNameBinding
+{
+public:
+
+	typedef std::vector<std::string> TMetadata::*NameList;
+
+	MetadataNameBinding(NameList nameList, std::string const& description) :
+		m_nameList(nameList),
+		m_description(description)
+	{
+	}
+
+	/// adds a name and returns the handle to its index, names are only added once
+	size_t Add(std::string const& name)
+	{
+		std::vector<std::string>::const_iterator known = std::find(m_names.begin(), m_names.end(), name);
+		if (known != m_names.end())
+		{
+			return (known - m_names.begin());
+		}
+		m_names.push_back(name);
+		m_indices.push_back(0);
+		return (m_names.size() - 1);
+	}
+
+	std::vector<size_t> Add(std::vector<std::string> const& names)
+	{
+		std::vector<size_t> handles;
+		for (std::vector<std::string>::const_iterator name = names.begin(); name != names.end(); ++name)
+		{
+			handles.push_back(Add(*name));
+		}
+		return handles;
+	}
+
+	/// resolves all names, if the metadata object or the input file has changed since the last call
+	void Bind(TMetadata const* metadata, long input) const
+	{
+		if ((metadata == m_boundMetadata) && (input == m_boundInput))
+		{
+			return;
+		}
+		assert(metadata);
+
+		std::vector<std::string> const& availableNames = metadata->*m_nameList;
+		for (size_t handle = 0; handle < m_names.size(); ++handle)
+		{
+			std::vector<std::string>::const_iterator availableName = std::find(availableNames.begin(), availableNames.end(), m_names[handle]);
+			if (availableName == availableNames.end())
+			{
+				LOG(FATAL) << m_description << " \"" << m_names[handle] << "\" is not available in input file " << input
+				           << "! Available names: " << boost::algorithm::join(availableNames, ", ");
+			}
+			m_indices[handle] = (availableName - availableNames.begin());
+		}
+
+		m_boundMetadata = metadata;
+		m_boundInput = input;
+	}
+
+	/// index in the metadata of the current input file, only valid after Bind
+	size_t GetIndex(size_t handle) const
+	{
+		return m_indices[handle];
+	}
+
+	size_t GetIndex(size_t handle, TMetadata const* metadata, long input) const
+	{
+		Bind(metadata, input);
+		return m_indices[handle];
+	}
+
+	/// binary IDs are stored either as bit masks or as vectors of bools, depending on the object
+	static bool GetBit(std::vector<bool> const& bits, size_t index)
+	{
+		return bits[index];
+	}
+
+	template<class TBits>
+	static bool GetBit(TBits bits, size_t index)
+	{
+		return ((bits & (TBits(1) << index)) != 0);
+	}
+
+private:
+	NameList m_nameList;
+	std::string m_description;
+	std::vector<std::string> m_names;
+
+	mutable std::vector<size_t> m_indices;
+	mutable TMetadata const* m_boundMetadata = nullptr;
+	mutable long m_boundInput = -1;
+};
+
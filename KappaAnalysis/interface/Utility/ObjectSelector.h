@@ -0,0 +1,59 @@
+#pragma once
+
+#include <functional>
+#include <vector>
+
+
+/**
+   \brief Chain of selection criteria for physics objects, compiled once from the settings.
+
+   The criteria are chosen in the Init function of a processor with all thresholds and flags from
+   the settings bound into them. The selection of an object is then a loop over the criteria
+   without any lookups of settings or switches over configuration enums. The criteria are
+   evaluated in the order in which they have been added and the evaluation stops at the first
+   failing one. An empty selector accepts all objects.
+
+       ObjectSelector<KMuon, KappaEvent> selector;
+       float maxRelativeIso = 0.15f;
+       selector.Add([maxRelativeIso](KMuon* muon, KappaEvent const& event) {
+               return (muon->pfIso() / muon->p4.Pt()) < maxRelativeIso;
+       });
+*/
+template<class TObject, class TEvent>
+class ObjectSelector
+{
+public:
+
+	typedef std::function<bool(TObject*, TEvent const&)> Criterion;
+
+	void Clear()
+	{
+		m_criteria.clear();
+	}
+
+	void Add(Criterion const& criterion)
+	{
+		m_criteria.push_back(criterion);
+	}
+
+	size_t GetNCriteria() const
+	{
+		return m_criteria.size();
+	}
+
+	bool Pass(TObject* object, TEvent const& event) const
+	{
+		for (typename std::vector<Criterion>::const_iterator criterion = m_criteria.begin(); criterion != m_criteria.end(); ++criterion)
+		{
+			if (! (*criterion)(object, event))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+private:
+	std::vector<Criterion> m_criteria;
+};
+
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "Kappa/DataFormats/interface/Kappa.h"
+
+#include "Artus/Utility/interface/Kinematics.h"
+
+
+/**
+   \brief Structure of arrays of the kinematics of a list of physics objects.
+
+   The coordinates of the objects are copied once per event into contiguous arrays, such that
+   selections can loop over them without touching the objects. Entry i belongs to the i-th object
+   of the list from which the arrays are built. The arrays can be passed to the kernels of
+   Kinematics via GetObjects.
+
+   The charge is zero for objects without a charge (e.g. jets).
+*/
+class PhysicsObjectArrays
+{
+public:
+
+	void Clear();
+
+	bool IsBuilt() const
+	{
+		return m_built;
+	}
+
+	template<class TObject>
+	void Build(std::vector<TObject*> const& objects)
+	{
+		Clear();
+		Reserve(objects.size());
+		for (typename std::vector<TObject*>::const_iterator object = objects.begin(); object != objects.end(); ++object)
+		{
+			Add((*object)->p4, GetCharge(**object));
+		}
+		m_built = true;
+	}
+
+	size_t GetSize() const
+	{
+		return m_pt.size();
+	}
+
+	std::vector<float> const& GetPt() const { return m_pt; }
+	std::vector<float> const& GetEta() const { return m_eta; }
+	std::vector<float> const& GetPhi() const { return m_phi; }
+	std::vector<float> const& GetMass() const { return m_mass; }
+	std::vector<float> const& GetEnergy() const { return m_energy; }
+	std::vector<int> const& GetCharge() const { return m_charge; }
+
+	Kinematics::Objects GetObjects() const;
+
+	/// passes[i] = 1 if pt[i] >= ptMin and |eta[i]| <= absEtaMax, otherwise 0
+	void PassKinematicCuts(float ptMin, float absEtaMax, std::vector<unsigned char>& passes) const;
+
+private:
+
+	void Reserve(size_t size);
+	void Add(RMFLV const& p4, int charge);
+
+	static int GetCharge(KLepton const& lepton)
+	{
+		return lepton.charge();
+	}
+	static int GetCharge(KLV const& physicsObject)
+	{
+		return 0;
+	}
+
+	std::vector<float> m_pt;
+	std::vector<float> m_eta;
+	std::vector<float> m_phi;
+	std::vector<float> m_mass;
+	std::vector<float> m_energy;
+	std::vector<int> m_charge;
+	bool m_built = false;
+};
+
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+
+/**
+   \brief Configured HLT paths resolved by the HltProducer for one lumi section.
+
+   The resolution is immutable and shared between the HltProducer and the products of the events
+   it has been used for. The selected paths of an event are indices into this table, such that no
+   names need to be copied per event. The generation is unique for every resolution in the process
+   and allows to cache results per resolved path, e.g. the interned ids of the names.
+*/
+class ResolvedHltPaths
+{
+public:
+	struct Path
+	{
+		std::string name;
+		size_t position;
+		int prescale;
+	};
+
+	std::vector<Path> paths;
+	// 0 for no resolution
+	unsigned long long generation = 0;
+};
@@ -0,0 +1,197 @@
+#pragma once
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+
+/**
+   \brief Ids of the HLT paths and trigger filters used in the trigger matching.
+
+   The names are interned once per process, such that the matching results can refer to them by
+   small integers. The ids are independent of the input file.
+*/
+class TriggerMatchNames
+{
+public:
+	static size_t GetHltId(std::string const& hltName);
+	static size_t GetFilterId(std::string const& filterName);
+
+	static std::string const& GetHltName(size_t hltId);
+	static std::string const& GetFilterName(size_t filterId);
+};
+
+
+/**
+   \brief Result of the trigger matching of the valid objects of one type in one event.
+
+   There is one entry for every combination of valid object, fired HLT path and fired filter which
+   has been checked. The indices of the trigger objects (in KTriggerObjects::trgObjects) matched
+   for an entry are a range in one buffer shared by all entries. Therefore, the results of an
+   event need only two allocations and are cheap to copy into the products of the pipelines.
+*/
+template<class TObject>
+class TriggerMatchResults
+{
+public:
+
+	struct Entry
+	{
+		TObject* object;
+		size_t hltId;
+		size_t filterId;
+		// range of the matched trigger objects in GetTriggerObjectIndices()
+		size_t firstTriggerObject;
+		size_t endTriggerObject;
+
+		bool HasMatch() const { return (endTriggerObject > firstTriggerObject); }
+	};
+
+	void Clear()
+	{
+		m_entries.clear();
+		m_triggerObjectIndices.clear();
+	}
+
+	void Reserve(size_t nEntries, size_t nTriggerObjects)
+	{
+		m_entries.reserve(nEntries);
+		m_triggerObjectIndices.reserve(nTriggerObjects);
+	}
+
+	bool Empty() const
+	{
+		return m_entries.empty();
+	}
+
+	/// starts a new entry, the matched trigger objects are added to this entry afterwards
+	void AddEntry(TObject* object, size_t hltId, size_t filterId)
+	{
+		Entry entry;
+		entry.object = object;
+		entry.hltId = hltId;
+		entry.filterId = filterId;
+		entry.firstTriggerObject = m_triggerObjectIndices.size();
+		entry.endTriggerObject = m_triggerObjectIndices.size();
+		m_entries.push_back(entry);
+	}
+
+	void AddTriggerObject(int triggerObjectIndex)
+	{
+		m_triggerObjectIndices.push_back(triggerObjectIndex);
+		m_entries.back().endTriggerObject = m_triggerObjectIndices.size();
+	}
+
+	/// adds all entries of another collection, e.g. of the electrons to the ones of the leptons
+	template<class TOtherObject>
+	void Append(TriggerMatchResults<TOtherObject> const& otherResults)
+	{
+		size_t offset = m_triggerObjectIndices.size();
+		for (typename std::vector<typename TriggerMatchResults<TOtherObject>::Entry>::const_iterator otherEntry = otherResults.GetEntries().begin();
+		     otherEntry != otherResults.GetEntries().end(); ++otherEntry)
+		{
+			Entry entry;
+			entry.object = otherEntry->object;
+			entry.hltId = otherEntry->hltId;
+			entry.filterId = otherEntry->filterId;
+			entry.firstTriggerObject = otherEntry->firstTriggerObject + offset;
+			entry.endTriggerObject = otherEntry->endTriggerObject + offset;
+			m_entries.push_back(entry);
+		}
+		m_triggerObjectIndices.insert(m_triggerObjectIndices.end(), otherResults.GetTriggerObjectIndices().begin(),
+		                              otherResults.GetTriggerObjectIndices().end());
+	}
+
+	std::vector<Entry> const& GetEntries() const
+	{
+		return m_entries;
+	}
+
+	std::vector<int> const& GetTriggerObjectIndices() const
+	{
+		return m_triggerObjectIndices;
+	}
+
+	bool HasObject(TObject const* object) const
+	{
+		for (typename std::vector<Entry>::const_iterator entry = m_entries.begin(); entry != m_entries.end(); ++entry)
+		{
+			if (entry->object == object)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/// true if at least one trigger object has been matched for every checked filter of this HLT path
+	bool AllFiltersMatched(TObject const* object, size_t hltId) const
+	{
+		bool checked = false;
+		for (typename std::vector<Entry>::const_iterator entry = m_entries.begin(); entry != m_entries.end(); ++entry)
+		{
+			if ((entry->object == object) && (entry->hltId == hltId))
+			{
+				if (! entry->HasMatch())
+				{
+					return false;
+				}
+				checked = true;
+			}
+		}
+		return checked;
+	}
+
+	/// recommended access to the results: only the HLT paths where all configured filters match
+	/// with the object, in the order in which they have been checked
+	void GetHltIdsWhereAllFiltersMatched(TObject const* object, std::vector<size_t>& hltIds) const
+	{
+		// single pass over the entries, collecting the HLT paths with a flag for unmatched filters
+		hltIds.clear();
+		std::vector<bool> allFiltersMatched;
+		for (typename std::vector<Entry>::const_iterator entry = m_entries.begin(); entry != m_entries.end(); ++entry)
+		{
+			if (entry->object == object)
+			{
+				size_t hltIndex = std::find(hltIds.begin(), hltIds.end(), entry->hltId) - hltIds.begin();
+				if (hltIndex == hltIds.size())
+				{
+					hltIds.push_back(entry->hltId);
+					allFiltersMatched.push_back(true);
+				}
+				if (! entry->HasMatch())
+				{
+					allFiltersMatched[hltIndex] = false;
+				}
+			}
+		}
+		
+		size_t nMatchedHlts = 0;
+		for (size_t hltIndex = 0; hltIndex < hltIds.size(); ++hltIndex)
+		{
+			if (allFiltersMatched[hltIndex])
+			{
+				hltIds[nMatchedHlts++] = hltIds[hltIndex];
+			}
+		}
+		hltIds.resize(nMatchedHlts);
+	}
+
+	std::vector<std::string> GetHltNamesWhereAllFiltersMatched(TObject const* object) const
+	{
+		std::vector<size_t> hltIds;
+		GetHltIdsWhereAllFiltersMatched(object, hltIds);
+
+		std::vector<std::string> hltNames;
+		for (std::vector<size_t>::const_iterator hltId = hltIds.begin(); hltId != hltIds.end(); ++hltId)
+		{
+			hltNames.push_back(TriggerMatchNames::GetHltName(*hltId));
+		}
+		return hltNames;
+	}
+
+private:
+	std::vector<Entry> m_entries;
+	std::vector<int> m_triggerObjectIndices;
+};
+
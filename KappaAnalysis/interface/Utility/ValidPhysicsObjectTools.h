@@ -4,16 +4,23 @@
 #include "Artus/Utility/interface/ArtusLogging.h"
 
 #include <algorithm>
+#include <limits>
 
 #include <boost/regex.hpp>
 
 #include "Kappa/DataFormats/interface/Kappa.h"
 
 #include "Artus/Utility/interface/Utility.h"
+#include "Artus/KappaAnalysis/interface/Utility/PhysicsObjectArrays.h"
 
 
 /**
    \brief Producer for cuts on valid physics objects
+
+   The cuts depending on the selected HLT paths are the same for all objects of an event. They are
+   therefore evaluated once per event on the arrays of the object kinematics in
+   PrepareKinematicCuts. The cuts depending on the number of already selected valid objects are
+   checked per object in PassKinematicCuts.
 */
 template<class TTypes, class TPhysicsObject>
 class ValidPhysicsObjectTools
@@ -24,8 +31,8 @@ public:
 	typedef typename TTypes::product_type product_type;
 	typedef typename TTypes::setting_type setting_type;
 	
-	ValidPhysicsObjectTools(std::vector<std::string>& (setting_type::*GetLowerPtCuts)(void) const,
-	                        std::vector<std::string>& (setting_type::*GetUpperAbsEtaCuts)(void) const,
+	ValidPhysicsObjectTools(std::vector<std::string> const& (setting_type::*GetLowerPtCuts)(void) const,
+	                        std::vector<std::string> const& (setting_type::*GetUpperAbsEtaCuts)(void) const,
 	                        std::vector<TPhysicsObject*> product_type::*validPhysicsObjects) :
 		GetLowerPtCuts(GetLowerPtCuts),
 		GetUpperAbsEtaCuts(GetUpperAbsEtaCuts),
@@ -38,81 +45,127 @@ public:
 		                                                           lowerPtCutsByHltName);
 		upperAbsEtaCutsByIndex = Utility::ParseMapTypes<size_t, float>(Utility::ParseVectorToMap((settings.*GetUpperAbsEtaCuts)()),
 		                                                               upperAbsEtaCutsByHltName);
+		
+		// the tightest cut of each entry is applied
+		lowerPtCutByIndex.clear();
+		for (std::map<size_t, std::vector<float> >::const_iterator lowerPtCuts = lowerPtCutsByIndex.begin();
+		     lowerPtCuts != lowerPtCutsByIndex.end(); ++lowerPtCuts)
+		{
+			lowerPtCutByIndex[lowerPtCuts->first] = *std::max_element(lowerPtCuts->second.begin(), lowerPtCuts->second.end());
+		}
+		upperAbsEtaCutByIndex.clear();
+		for (std::map<size_t, std::vector<float> >::const_iterator upperAbsEtaCuts = upperAbsEtaCutsByIndex.begin();
+		     upperAbsEtaCuts != upperAbsEtaCutsByIndex.end(); ++upperAbsEtaCuts)
+		{
+			upperAbsEtaCutByIndex[upperAbsEtaCuts->first] = *std::min_element(upperAbsEtaCuts->second.begin(), upperAbsEtaCuts->second.end());
+		}
+		lowerPtCutsForHlt = GetCutsForHlt(lowerPtCutsByHltName, true);
+		upperAbsEtaCutsForHlt = GetCutsForHlt(upperAbsEtaCutsByHltName, false);
 	}
 
 
 protected:
 	
-	bool PassKinematicCuts(TPhysicsObject* physicsObject, event_type const& event, product_type& product) const
+	/// evaluates the cuts, which do not depend on the number of valid objects, for all objects of the event
+	/// at once, has to be called before PassKinematicCuts
+	void PrepareKinematicCuts(PhysicsObjectArrays const& physicsObjects, product_type const& product) const
 	{
-		bool validObject = true;
-		
-		for (std::map<size_t, std::vector<float> >::const_iterator lowerPtCutByIndex = lowerPtCutsByIndex.begin();
-		     lowerPtCutByIndex != lowerPtCutsByIndex.end() && validObject; ++lowerPtCutByIndex)
+		float lowerPtCut = -std::numeric_limits<float>::infinity();
+		for (typename std::vector<CutForHlt>::const_iterator cut = lowerPtCutsForHlt.begin(); cut != lowerPtCutsForHlt.end(); ++cut)
 		{
-			if ((physicsObject->p4.Pt() < *std::max_element(lowerPtCutByIndex->second.begin(), lowerPtCutByIndex->second.end()))
-			    && (lowerPtCutByIndex->first == (product.*m_validPhysicsObjectsMember).size()))
+			if (cut->MatchesHlt(product))
 			{
-				validObject = false;
+				lowerPtCut = std::max(lowerPtCut, cut->cut);
 			}
 		}
 		
-		for (std::map<size_t, std::vector<float> >::const_iterator upperAbsEtaCutByIndex = upperAbsEtaCutsByIndex.begin();
-		     upperAbsEtaCutByIndex != upperAbsEtaCutsByIndex.end() && validObject; ++upperAbsEtaCutByIndex)
+		float upperAbsEtaCut = std::numeric_limits<float>::infinity();
+		for (typename std::vector<CutForHlt>::const_iterator cut = upperAbsEtaCutsForHlt.begin(); cut != upperAbsEtaCutsForHlt.end(); ++cut)
 		{
-			if (std::abs(physicsObject->p4.Eta()) > *std::min_element(upperAbsEtaCutByIndex->second.begin(), upperAbsEtaCutByIndex->second.end())
-			    && (upperAbsEtaCutByIndex->first == (product.*m_validPhysicsObjectsMember).size()))
+			if (cut->MatchesHlt(product))
 			{
-				validObject = false;
+				upperAbsEtaCut = std::min(upperAbsEtaCut, cut->cut);
 			}
 		}
-
-		for (std::map<std::string, std::vector<float> >::const_iterator lowerPtCutByHltName = lowerPtCutsByHltName.begin();
-		     lowerPtCutByHltName != lowerPtCutsByHltName.end() && validObject; ++lowerPtCutByHltName)
+		
+		physicsObjects.PassKinematicCuts(lowerPtCut, upperAbsEtaCut, m_passHltKinematicCuts);
+	}
+	
+	/// cuts for the object with the given index in the arrays passed to PrepareKinematicCuts
+	bool PassKinematicCuts(PhysicsObjectArrays const& physicsObjects, size_t physicsObjectIndex, product_type& product) const
+	{
+		if (! m_passHltKinematicCuts[physicsObjectIndex])
 		{
-			bool hasMatch = false;
-			for (unsigned int iHlt = 0; iHlt < product.m_selectedHltNames.size(); ++iHlt)
-				hasMatch = hasMatch || boost::regex_search(product.m_selectedHltNames.at(iHlt), boost::regex(lowerPtCutByHltName->first, boost::regex::icase | boost::regex::extended));
-
-			if ((physicsObject->p4.Pt() < *std::max_element(lowerPtCutByHltName->second.begin(), lowerPtCutByHltName->second.end()))
-			    && (lowerPtCutByHltName->first == "default" || hasMatch)
-			   )
-			{
-				validObject = false;
-			}
+			return false;
+		}
+		
+		// cuts on the object that would become the n-th valid object
+		size_t nValidPhysicsObjects = (product.*m_validPhysicsObjectsMember).size();
+		std::map<size_t, float>::const_iterator lowerPtCut = lowerPtCutByIndex.find(nValidPhysicsObjects);
+		if ((lowerPtCut != lowerPtCutByIndex.end()) && (physicsObjects.GetPt()[physicsObjectIndex] < lowerPtCut->second))
+		{
+			return false;
 		}
+		std::map<size_t, float>::const_iterator upperAbsEtaCut = upperAbsEtaCutByIndex.find(nValidPhysicsObjects);
+		if ((upperAbsEtaCut != upperAbsEtaCutByIndex.end()) && (std::abs(physicsObjects.GetEta()[physicsObjectIndex]) > upperAbsEtaCut->second))
+		{
+			return false;
+		}
+		
+		return true;
+	}
+
 
-		for (std::map<std::string, std::vector<float> >::const_iterator upperAbsEtaCutByHltName = upperAbsEtaCutsByHltName.begin();
-		     upperAbsEtaCutByHltName != upperAbsEtaCutsByHltName.end() && validObject; ++upperAbsEtaCutByHltName)
+private:
+
+	// cut applied in events with at least one selected HLT path matching the regular expression
+	struct CutForHlt
+	{
+		bool isDefault;
+		boost::regex hltName;
+		float cut;
+		
+		bool MatchesHlt(product_type const& product) const
 		{
-			bool hasMatch = false;
-			for (unsigned int iHlt = 0; iHlt < product.m_selectedHltNames.size(); ++iHlt)
-				hasMatch = hasMatch || boost::regex_search(product.m_selectedHltNames.at(iHlt), boost::regex(upperAbsEtaCutByHltName->first, boost::regex::icase | boost::regex::extended));
-
-			if ((std::abs(physicsObject->p4.Eta()) > *std::min_element(upperAbsEtaCutByHltName->second.begin(), upperAbsEtaCutByHltName->second.end()))
-			    &&
-			    (
-			    	(upperAbsEtaCutByHltName->first == "default") || hasMatch
-			    )
-			   )
+			bool hasMatch = isDefault;
+			for (size_t selectedHltIndex = 0; (! hasMatch) && (selectedHltIndex < product.m_selectedHltIndices.size()); ++selectedHltIndex)
 			{
-				validObject = false;
+				hasMatch = boost::regex_search(product.GetSelectedHltName(selectedHltIndex), hltName);
 			}
+			return hasMatch;
 		}
-
-		return validObject;
+	};
+	
+	static std::vector<CutForHlt> GetCutsForHlt(std::map<std::string, std::vector<float> > const& cutsByHltName, bool lowerCuts)
+	{
+		std::vector<CutForHlt> cutsForHlt;
+		for (std::map<std::string, std::vector<float> >::const_iterator cuts = cutsByHltName.begin(); cuts != cutsByHltName.end(); ++cuts)
+		{
+			CutForHlt cutForHlt;
+			cutForHlt.isDefault = (cuts->first == "default");
+			cutForHlt.hltName = boost::regex(cuts->first, boost::regex::icase | boost::regex::extended);
+			cutForHlt.cut = (lowerCuts ? *std::max_element(cuts->second.begin(), cuts->second.end()) :
+			                             *std::min_element(cuts->second.begin(), cuts->second.end()));
+			cutsForHlt.push_back(cutForHlt);
+		}
+		return cutsForHlt;
 	}
 
-
-private:
-	std::vector<std::string>& (setting_type::*GetLowerPtCuts)(void) const;
-	std::vector<std::string>& (setting_type::*GetUpperAbsEtaCuts)(void) const;
+	std::vector<std::string> const& (setting_type::*GetLowerPtCuts)(void) const;
+	std::vector<std::string> const& (setting_type::*GetUpperAbsEtaCuts)(void) const;
 	std::vector<TPhysicsObject*> product_type::*m_validPhysicsObjectsMember;
 
 	std::map<size_t, std::vector<float> > lowerPtCutsByIndex;
 	std::map<std::string, std::vector<float> > lowerPtCutsByHltName;
 	std::map<size_t, std::vector<float> > upperAbsEtaCutsByIndex;
 	std::map<std::string, std::vector<float> > upperAbsEtaCutsByHltName;
+	
+	std::map<size_t, float> lowerPtCutByIndex;
+	std::map<size_t, float> upperAbsEtaCutByIndex;
+	std::vector<CutForHlt> lowerPtCutsForHlt;
+	std::vector<CutForHlt> upperAbsEtaCutsForHlt;
+	
+	mutable std::vector<unsigned char> m_passHltKinematicCuts;
 
 };
 
@@ -10,6 +10,12 @@ std::string PrintEventsConsumer::GetConsumerId() const
 	return "PrintEventsConsumer";
 }
 
+// the consumer only prints the events and has no state
+bool PrintEventsConsumer::SupportsCheckpoints() const
+{
+	return true;
+}
+
 void PrintEventsConsumer::ProcessEvent(event_type const& event, product_type const& product,
                                        setting_type const& settings, FilterResult& result)
 {
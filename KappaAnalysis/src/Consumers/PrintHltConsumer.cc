@@ -10,6 +10,12 @@ std::string PrintHltConsumer::GetConsumerId() const
 	return "PrintHltConsumer";
 }
 
+// the consumer only prints the events and has no state
+bool PrintHltConsumer::SupportsCheckpoints() const
+{
+	return true;
+}
+
 void PrintHltConsumer::ProcessFilteredEvent(event_type const& event, product_type const& product,
                                             setting_type const& settings)
 {
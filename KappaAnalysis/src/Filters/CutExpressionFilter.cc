@@ -0,0 +1,85 @@
+
+#include "Artus/Consumer/interface/LambdaNtupleConsumer.h"
+
+#include "Artus/KappaAnalysis/interface/Filters/CutExpressionFilter.h"
+
+
+std::string CutExpressionFilter::GetFilterId() const
+{
+	return "CutExpressionFilter";
+}
+
+void CutExpressionFilter::Init(KappaSettings const& settings)
+{
+	FilterBase<KappaTypes>::Init(settings);
+
+	m_clauses.clear();
+	m_clauseNames.clear();
+	m_variableNames.clear();
+	std::vector<std::string> clauses = Expression::SplitConjunction(settings.GetCutExpression());
+	for (std::vector<std::string>::const_iterator clause = clauses.begin(); clause != clauses.end(); ++clause)
+	{
+		m_clauses.push_back(Expression(*clause, m_variableNames));
+		m_clauseNames.push_back(*clause);
+	}
+
+	m_variableExtractors.clear();
+	for (std::vector<std::string>::const_iterator variableName = m_variableNames.begin();
+	     variableName != m_variableNames.end(); ++variableName)
+	{
+		LambdaNtupleQuantities::Registration registration = LambdaNtupleQuantities::Find(
+				settings.GetName(),
+				LambdaNtupleQuantities::GetQuantityId(*variableName)
+		);
+		m_variableExtractors.push_back(LambdaNtupleQuantities::GetNumericExtractor(registration));
+		if (registration.type == LambdaNtupleQuantities::Type::None)
+		{
+			LOG(FATAL) << "Quantity \"" << *variableName << "\" used in the CutExpression is not registered! "
+			           << "The producer providing it has to run before the " << GetFilterId() << ".";
+		}
+		else if (! m_variableExtractors.back())
+		{
+			LOG(FATAL) << "Quantity \"" << *variableName << "\" used in the CutExpression is not a number!";
+		}
+	}
+	m_variableValues.assign(m_variableNames.size(), 0.0);
+	m_variableLoaded.assign(m_variableNames.size(), 0);
+	m_variableLoader = [this](size_t variableIndex) { return LoadVariable(variableIndex); };
+}
+
+bool CutExpressionFilter::DoesEventPass(KappaEvent const& event,
+                                        KappaProduct const& product,
+                                        KappaSettings const& settings) const
+{
+	m_event = &event;
+	m_product = &product;
+	m_variableLoaded.assign(m_variableLoaded.size(), 0);
+
+	m_nPassedClauses = 0;
+	while ((m_nPassedClauses < m_clauses.size()) && m_clauses[m_nPassedClauses].IsTrue(m_variableLoader))
+	{
+		++m_nPassedClauses;
+	}
+	return (m_nPassedClauses == m_clauses.size());
+}
+
+std::vector<std::string> const& CutExpressionFilter::GetCutNames() const
+{
+	return m_clauseNames;
+}
+
+size_t CutExpressionFilter::GetNPassedCuts() const
+{
+	return m_nPassedClauses;
+}
+
+double CutExpressionFilter::LoadVariable(size_t variableIndex) const
+{
+	if (! m_variableLoaded[variableIndex])
+	{
+		m_variableValues[variableIndex] = m_variableExtractors[variableIndex](*m_event, *m_product);
+		m_variableLoaded[variableIndex] = 1;
+	}
+	return m_variableValues[variableIndex];
+}
+
@@ -14,5 +14,5 @@
 	bool HltFilter::DoesEventPass(KappaEvent const& event, KappaProduct const& product,
 	                           KappaSettings const& settings) const
 	{
-		return (! product.m_selectedHltNames.empty());
+		return (! product.m_selectedHltIndices.empty());
 	}
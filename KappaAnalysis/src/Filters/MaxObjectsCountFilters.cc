@@ -8,6 +8,10 @@
 		return "MaxElectronsCountFilter";
 	}
 
+	std::string MaxElectronsCountFilter::GetFingerprint(KappaSettings const& settings) const {
+		return GetFilterId() + ":" + std::to_string(settings.GetMaxNElectrons());
+	}
+
 	void MaxElectronsCountFilter::Init(KappaSettings const& settings) {
 
 		FilterBase<KappaTypes>::Init(settings);
@@ -28,6 +32,10 @@
 		return "MaxMuonsCountFilter";
 	}
 
+	std::string MaxMuonsCountFilter::GetFingerprint(KappaSettings const& settings) const {
+		return GetFilterId() + ":" + std::to_string(settings.GetMaxNMuons());
+	}
+
 	void MaxMuonsCountFilter::Init(KappaSettings const& settings) {
 
 		FilterBase<KappaTypes>::Init(settings);
@@ -48,6 +56,10 @@
 		return "MaxTausCountFilter";
 	}
 
+	std::string MaxTausCountFilter::GetFingerprint(KappaSettings const& settings) const {
+		return GetFilterId() + ":" + std::to_string(settings.GetMaxNTaus());
+	}
+
 	void MaxTausCountFilter::Init(KappaSettings const& settings) {
 
 		FilterBase<KappaTypes>::Init(settings);
@@ -68,6 +80,10 @@
 		return "MaxJetsCountFilter";
 	}
 
+	std::string MaxJetsCountFilter::GetFingerprint(KappaSettings const& settings) const {
+		return GetFilterId() + ":" + std::to_string(settings.GetMaxNJets());
+	}
+
 	void MaxJetsCountFilter::Init(KappaSettings const& settings) {
 
 		FilterBase<KappaTypes>::Init(settings);
@@ -88,6 +104,10 @@
 		return "MaxBTaggedJetsCountFilter";
 	}
 
+	std::string MaxBTaggedJetsCountFilter::GetFingerprint(KappaSettings const& settings) const {
+		return GetFilterId() + ":" + std::to_string(settings.GetMaxNBTaggedJets());
+	}
+
 	void MaxBTaggedJetsCountFilter::Init(KappaSettings const& settings) {
 		this->m_cuts.push_back(std::pair<double_extractor_lambda, CutRange>(
 				[](KappaEvent const& event, KappaProduct const& product) {
@@ -106,6 +126,10 @@
 		return "MaxNonBTaggedJetsCountFilter";
 	}
 
+	std::string MaxNonBTaggedJetsCountFilter::GetFingerprint(KappaSettings const& settings) const {
+		return GetFilterId() + ":" + std::to_string(settings.GetMaxNNonBTaggedJets());
+	}
+
 	void MaxNonBTaggedJetsCountFilter::Init(KappaSettings const& settings) {
 		this->m_cuts.push_back(std::pair<double_extractor_lambda, CutRange>(
 				[](KappaEvent const& event, KappaProduct const& product) {
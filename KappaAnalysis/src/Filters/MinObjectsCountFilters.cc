@@ -8,6 +8,10 @@
 		return "MinElectronsCountFilter";
 	}
 
+	std::string MinElectronsCountFilter::GetFingerprint(KappaSettings const& settings) const {
+		return GetFilterId() + ":" + std::to_string(settings.GetMinNElectrons());
+	}
+
 	void MinElectronsCountFilter::Init(KappaSettings const& settings) {
 
 		FilterBase<KappaTypes>::Init(settings);
@@ -28,6 +32,10 @@
 		return "MinMuonsCountFilter";
 	}
 
+	std::string MinMuonsCountFilter::GetFingerprint(KappaSettings const& settings) const {
+		return GetFilterId() + ":" + std::to_string(settings.GetMinNMuons());
+	}
+
 	void MinMuonsCountFilter::Init(KappaSettings const& settings) {
 
 		FilterBase<KappaTypes>::Init(settings);
@@ -48,6 +56,10 @@
 		return "MinTausCountFilter";
 	}
 
+	std::string MinTausCountFilter::GetFingerprint(KappaSettings const& settings) const {
+		return GetFilterId() + ":" + std::to_string(settings.GetMinNTaus());
+	}
+
 	void MinTausCountFilter::Init(KappaSettings const& settings) {
 
 		FilterBase<KappaTypes>::Init(settings);
@@ -68,6 +80,10 @@
 		return "MinJetsCountFilter";
 	}
 
+	std::string MinJetsCountFilter::GetFingerprint(KappaSettings const& settings) const {
+		return GetFilterId() + ":" + std::to_string(settings.GetMinNJets());
+	}
+
 	void MinJetsCountFilter::Init(KappaSettings const& settings) {
 
 		FilterBase<KappaTypes>::Init(settings);
@@ -88,6 +104,10 @@
 		return "MinBTaggedJetsCountFilter";
 	}
 
+	std::string MinBTaggedJetsCountFilter::GetFingerprint(KappaSettings const& settings) const {
+		return GetFilterId() + ":" + std::to_string(settings.GetMinNBTaggedJets());
+	}
+
 	void MinBTaggedJetsCountFilter::Init(KappaSettings const& settings) {
 		this->m_cuts.push_back(std::pair<double_extractor_lambda, CutRange>(
 				[](KappaEvent const& event, KappaProduct const& product) {
@@ -105,6 +125,10 @@
 		return "MinNonBTaggedJetsCountFilter";
 	}
 
+	std::string MinNonBTaggedJetsCountFilter::GetFingerprint(KappaSettings const& settings) const {
+		return GetFilterId() + ":" + std::to_string(settings.GetMinNNonBTaggedJets());
+	}
+
 	void MinNonBTaggedJetsCountFilter::Init(KappaSettings const& settings) {
 		this->m_cuts.push_back(std::pair<double_extractor_lambda, CutRange>(
 				[](KappaEvent const& event, KappaProduct const& product) {
@@ -7,6 +7,10 @@
 		return "ElectronsCountFilter";
 	}
 
+	std::string ElectronsCountFilter::GetFingerprint(KappaSettings const& settings) const {
+		return GetFilterId() + ":" + std::to_string(settings.GetNElectrons());
+	}
+
 	void ElectronsCountFilter::Init(KappaSettings const& settings) {
 
 		FilterBase<KappaTypes>::Init(settings);
@@ -27,6 +31,10 @@
 		return "MuonsCountFilter";
 	}
 
+	std::string MuonsCountFilter::GetFingerprint(KappaSettings const& settings) const {
+		return GetFilterId() + ":" + std::to_string(settings.GetNMuons());
+	}
+
 	void MuonsCountFilter::Init(KappaSettings const& settings) {
 
 		FilterBase<KappaTypes>::Init(settings);
@@ -47,6 +55,10 @@
 		return "TausCountFilter";
 	}
 
+	std::string TausCountFilter::GetFingerprint(KappaSettings const& settings) const {
+		return GetFilterId() + ":" + std::to_string(settings.GetNTaus());
+	}
+
 	void TausCountFilter::Init(KappaSettings const& settings) {
 
 		FilterBase<KappaTypes>::Init(settings);
@@ -67,6 +79,10 @@
 		return "JetsCountFilter";
 	}
 
+	std::string JetsCountFilter::GetFingerprint(KappaSettings const& settings) const {
+		return GetFilterId() + ":" + std::to_string(settings.GetNJets());
+	}
+
 	void JetsCountFilter::Init(KappaSettings const& settings) {
 
 		FilterBase<KappaTypes>::Init(settings);
@@ -87,6 +103,10 @@
 		return "BTaggedJetsCountFilter";
 	}
 
+	std::string BTaggedJetsCountFilter::GetFingerprint(KappaSettings const& settings) const {
+		return GetFilterId() + ":" + std::to_string(settings.GetNBTaggedJets());
+	}
+
 	void BTaggedJetsCountFilter::Init(KappaSettings const& settings) {
 		this->m_cuts.push_back(std::pair<double_extractor_lambda, CutRange>(
 				[](KappaEvent const& event, KappaProduct const& product) {
@@ -104,6 +124,10 @@
 		return "NonBTaggedJetsCountFilter";
 	}
 
+	std::string NonBTaggedJetsCountFilter::GetFingerprint(KappaSettings const& settings) const {
+		return GetFilterId() + ":" + std::to_string(settings.GetNNonBTaggedJets());
+	}
+
 	void NonBTaggedJetsCountFilter::Init(KappaSettings const& settings) {
 		this->m_cuts.push_back(std::pair<double_extractor_lambda, CutRange>(
 				[](KappaEvent const& event, KappaProduct const& product) {
@@ -6,6 +6,10 @@ std::string ValidElectronsFilter::GetFilterId() const {
 	return "ValidElectronsFilter";
 }
 
+std::string ValidElectronsFilter::GetFingerprint(KappaSettings const& settings) const {
+	return GetFilterId();
+}
+
 void ValidElectronsFilter::Init(KappaSettings const& settings) {
 	CutRangeFilterBase::Init(settings);
 	this->m_cuts.push_back(std::pair<double_extractor_lambda, CutRange>(
@@ -20,6 +24,10 @@ std::string ValidMuonsFilter::GetFilterId() const {
 	return "ValidMuonsFilter";
 }
 
+std::string ValidMuonsFilter::GetFingerprint(KappaSettings const& settings) const {
+	return GetFilterId();
+}
+
 void ValidMuonsFilter::Init(KappaSettings const& settings) {
 	CutRangeFilterBase::Init(settings);
 	this->m_cuts.push_back(std::pair<double_extractor_lambda, CutRange>(
@@ -34,6 +42,10 @@ std::string ValidTausFilter::GetFilterId() const {
 	return "ValidTausFilter";
 }
 
+std::string ValidTausFilter::GetFingerprint(KappaSettings const& settings) const {
+	return GetFilterId();
+}
+
 void ValidTausFilter::Init(KappaSettings const& settings) {
 	CutRangeFilterBase::Init(settings);
 	this->m_cuts.push_back(std::pair<double_extractor_lambda, CutRange>(
@@ -49,6 +61,10 @@ std::string ValidJetsFilter::GetFilterId() const {
 	return "ValidJetsFilter";
 }
 
+std::string ValidJetsFilter::GetFingerprint(KappaSettings const& settings) const {
+	return GetFilterId();
+}
+
 void ValidJetsFilter::Init(KappaSettings const& settings) {
 	CutRangeFilterBase::Init(settings);
 	this->m_cuts.push_back(std::pair<double_extractor_lambda, CutRange>(
@@ -64,6 +80,10 @@ std::string ValidBTaggedJetsFilter::GetFilterId() const {
 	return "ValidBTaggedJetsFilter";
 }
 
+std::string ValidBTaggedJetsFilter::GetFingerprint(KappaSettings const& settings) const {
+	return GetFilterId();
+}
+
 void ValidBTaggedJetsFilter::Init(KappaSettings const& settings) {
 	CutRangeFilterBase::Init(settings);
 	this->m_cuts.push_back(std::pair<double_extractor_lambda, CutRange>(
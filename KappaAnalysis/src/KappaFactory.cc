@@ -1,5 +1,6 @@
 
 #include "Artus/KappaAnalysis/interface/KappaFactory.h"
+#include "Artus/Core/interface/ProcessorRegistry.h"
 
 // producer
 #include "Artus/KappaAnalysis/interface/Producers/HltProducer.h"
@@ -56,6 +57,8 @@
 #include "Artus/KappaAnalysis/interface/Filters/HCALNoiseFilter.h"
 #include "Artus/KappaAnalysis/interface/Filters/nPUFilter.h"
 #include "Artus/KappaAnalysis/interface/Filters/ZFilter.h"
+#include "Artus/KappaAnalysis/interface/Filters/CutExpressionFilter.h"
+#include "Artus/Consumer/interface/DerivedQuantitiesProducer.h"
 
 // consumer
 #include "Artus/KappaAnalysis/interface/Consumers/KappaCutFlowHistogramConsumer.h"
@@ -65,253 +68,145 @@
 #include "Artus/KappaAnalysis/interface/Consumers/PrintHltConsumer.h"
 #include "Artus/KappaAnalysis/interface/Consumers/PrintEventsConsumer.h"
 #include "Artus/Consumer/interface/RunTimeConsumer.h"
-#include "Artus/Consumer/interface/RunTimeConsumer.h"
+#include "Artus/Consumer/interface/CutFlowSummaryConsumer.h"
+
+
+// producer
+REGISTER_PRODUCER(GenTauDecayProducer)
+REGISTER_PRODUCER(GenTauDecayModeProducer)
+REGISTER_PRODUCER(GenParticleProducer)
+REGISTER_PRODUCER(GenTauJetProducer)
+REGISTER_PRODUCER(HltProducer)
+REGISTER_PRODUCER(ElectronCorrectionsProducer)
+REGISTER_PRODUCER(MuonCorrectionsProducer)
+REGISTER_PRODUCER(TauCorrectionsProducer)
+REGISTER_PRODUCER(JetCorrectionsProducer)
+REGISTER_PRODUCER(TaggedJetCorrectionsProducer)
+REGISTER_PRODUCER(ValidElectronsProducer<KappaTypes>)
+REGISTER_PRODUCER(ValidMuonsProducer<KappaTypes>)
+REGISTER_PRODUCER(ValidTausProducer)
+REGISTER_PRODUCER(ValidJetsProducer)
+REGISTER_PRODUCER(ValidTaggedJetsProducer)
+REGISTER_PRODUCER(ValidBTaggedJetsProducer)
+REGISTER_PRODUCER(ElectronTriggerMatchingProducer)
+REGISTER_PRODUCER(MuonTriggerMatchingProducer)
+REGISTER_PRODUCER(TauTriggerMatchingProducer)
+REGISTER_PRODUCER(JetTriggerMatchingProducer)
+REGISTER_PRODUCER(RecoElectronGenParticleMatchingProducer)
+REGISTER_PRODUCER(RecoMuonGenParticleMatchingProducer)
+REGISTER_PRODUCER(RecoTauGenParticleMatchingProducer)
+REGISTER_PRODUCER(RecoJetGenParticleMatchingProducer)
+REGISTER_PRODUCER(MatchedLeptonsProducer)
+REGISTER_PRODUCER(ValidLeptonsProducer)
+REGISTER_PRODUCER(PUWeightProducer)
+REGISTER_PRODUCER(DerivedQuantitiesProducer<KappaTypes>)
+REGISTER_PRODUCER(EventWeightProducer)
+REGISTER_PRODUCER(GeneratorWeightProducer)
+REGISTER_PRODUCER(LuminosityWeightProducer)
+REGISTER_PRODUCER(CrossSectionWeightProducer)
+REGISTER_PRODUCER(NumberGeneratedEventsWeightProducer)
+REGISTER_PRODUCER(GenMuonFSRProducer)
+// todo: uses setting not in KappaSettings
+REGISTER_PRODUCER(GeneralTmvaClassificationReader)
+REGISTER_PRODUCER(GenDiLeptonDecayModeProducer)
+REGISTER_PRODUCER(GenPartonCounterProducer)
+REGISTER_PRODUCER(EmbeddingWeightProducer)
+REGISTER_PRODUCER(NicknameProducer)
+REGISTER_PRODUCER(RecoElectronGenTauMatchingProducer)
+REGISTER_PRODUCER(RecoMuonGenTauMatchingProducer)
+REGISTER_PRODUCER(RecoTauGenTauMatchingProducer)
+REGISTER_PRODUCER(RecoElectronGenTauJetMatchingProducer)
+REGISTER_PRODUCER(RecoMuonGenTauJetMatchingProducer)
+REGISTER_PRODUCER(RecoTauGenTauJetMatchingProducer)
+REGISTER_PRODUCER(ZmmProducer)
+REGISTER_PRODUCER(ZeeProducer)
+REGISTER_PRODUCER(ZemProducer)
 
+// filter
+REGISTER_FILTER(RunLumiEventFilter)
+REGISTER_FILTER(JsonFilter)
+REGISTER_FILTER(HltFilter)
+REGISTER_FILTER(ValidElectronsFilter)
+REGISTER_FILTER(ValidMuonsFilter)
+REGISTER_FILTER(ValidTausFilter)
+REGISTER_FILTER(ValidJetsFilter)
+REGISTER_FILTER(ValidBTaggedJetsFilter)
+REGISTER_FILTER(ElectronsCountFilter)
+REGISTER_FILTER(MuonsCountFilter)
+REGISTER_FILTER(TausCountFilter)
+REGISTER_FILTER(JetsCountFilter)
+REGISTER_FILTER(BTaggedJetsCountFilter)
+REGISTER_FILTER(NonBTaggedJetsCountFilter)
+REGISTER_FILTER(MinElectronsCountFilter)
+REGISTER_FILTER(MinMuonsCountFilter)
+REGISTER_FILTER(MinTausCountFilter)
+REGISTER_FILTER(MinJetsCountFilter)
+REGISTER_FILTER(MinBTaggedJetsCountFilter)
+REGISTER_FILTER(MinNonBTaggedJetsCountFilter)
+REGISTER_FILTER(MaxElectronsCountFilter)
+REGISTER_FILTER(MaxMuonsCountFilter)
+REGISTER_FILTER(MaxTausCountFilter)
+REGISTER_FILTER(MaxJetsCountFilter)
+REGISTER_FILTER(MaxBTaggedJetsCountFilter)
+REGISTER_FILTER(MaxNonBTaggedJetsCountFilter)
+REGISTER_FILTER(ElectronLowerPtCutsFilter)
+REGISTER_FILTER(MuonLowerPtCutsFilter)
+REGISTER_FILTER(TauLowerPtCutsFilter)
+REGISTER_FILTER(JetLowerPtCutsFilter)
+REGISTER_FILTER(NonBTaggedJetLowerPtCutsFilter)
+REGISTER_FILTER(ElectronUpperAbsEtaCutsFilter)
+REGISTER_FILTER(MuonUpperAbsEtaCutsFilter)
+REGISTER_FILTER(TauUpperAbsEtaCutsFilter)
+REGISTER_FILTER(JetUpperAbsEtaCutsFilter)
+REGISTER_FILTER(ElectronTriggerMatchingFilter)
+REGISTER_FILTER(MuonTriggerMatchingFilter)
+REGISTER_FILTER(TauTriggerMatchingFilter)
+REGISTER_FILTER(JetTriggerMatchingFilter)
+REGISTER_FILTER(ElectronGenMatchingFilter)
+REGISTER_FILTER(MuonGenMatchingFilter)
+REGISTER_FILTER(TauGenMatchingFilter)
+REGISTER_FILTER(JetGenMatchingFilter)
+REGISTER_FILTER(GenTauMatchingRecoElectronMinDeltaRFilter)
+REGISTER_FILTER(GenTauMatchingRecoMuonMinDeltaRFilter)
+REGISTER_FILTER(GenTauMatchingRecoTauMinDeltaRFilter)
+REGISTER_FILTER(ValidElectronsMinDeltaRFilter)
+REGISTER_FILTER(ValidMuonsMinDeltaRFilter)
+REGISTER_FILTER(ValidTausMinDeltaRFilter)
+REGISTER_FILTER(ValidLeptonsMinDeltaRFilter)
+REGISTER_FILTER(GenDiLeptonDecayModeFilter)
+REGISTER_FILTER(GoodPrimaryVertexFilter)
+REGISTER_FILTER(HCALNoiseFilter)
+REGISTER_FILTER(BeamScrapingFilter)
+REGISTER_FILTER(nPUFilter)
+REGISTER_FILTER(ZFilter)
+REGISTER_FILTER(CutExpressionFilter)
+
+// consumer
+REGISTER_CONSUMER(KappaCutFlowHistogramConsumer)
+REGISTER_CONSUMER(KappaCutFlowTreeConsumer)
+REGISTER_CONSUMER(KappaLambdaNtupleConsumer<KappaTypes>)
+REGISTER_CONSUMER(KappaElectronsConsumer)
+REGISTER_CONSUMER(KappaMuonsConsumer)
+REGISTER_CONSUMER(KappaTausConsumer)
+REGISTER_CONSUMER(KappaJetsConsumer)
+REGISTER_CONSUMER(KappaTaggedJetsConsumer)
+REGISTER_CONSUMER(PrintHltConsumer)
+REGISTER_CONSUMER(PrintEventsConsumer)
+REGISTER_CONSUMER(RunTimeConsumer<KappaTypes>)
+REGISTER_CONSUMER(CutFlowSummaryConsumer<KappaTypes>)
 
 
 ProducerBaseUntemplated * KappaFactory::createProducer ( std::string const& id )
 {
-	if(id == GenTauDecayProducer().GetProducerId())
-  		return new GenTauDecayProducer();
-	else if(id == GenTauDecayModeProducer().GetProducerId())
-  		return new GenTauDecayModeProducer();
-	else if(id == GenParticleProducer().GetProducerId())
-  		return new GenParticleProducer();
-	else if(id == GenTauJetProducer().GetProducerId())
-  		return new GenTauJetProducer();
-	else if(id == HltProducer().GetProducerId())
-		return new HltProducer();
-	else if(id == ElectronCorrectionsProducer().GetProducerId())
-		return new ElectronCorrectionsProducer();
-	else if(id == MuonCorrectionsProducer().GetProducerId())
-		return new MuonCorrectionsProducer();
-	else if(id == TauCorrectionsProducer().GetProducerId())
-		return new TauCorrectionsProducer();
-	else if(id == JetCorrectionsProducer().GetProducerId())
-		return new JetCorrectionsProducer();
-	else if(id == TaggedJetCorrectionsProducer().GetProducerId())
-		return new TaggedJetCorrectionsProducer();
-	else if(id == ValidElectronsProducer<KappaTypes>().GetProducerId())
-		return new ValidElectronsProducer<KappaTypes>();
-	else if(id == ValidMuonsProducer<KappaTypes>().GetProducerId())
-		return new ValidMuonsProducer<KappaTypes>();
-	else if(id == ValidTausProducer().GetProducerId())
-		return new ValidTausProducer();
-	else if(id == ValidJetsProducer().GetProducerId())
-		return new ValidJetsProducer();
-	else if(id == ValidTaggedJetsProducer().GetProducerId())
-		return new ValidTaggedJetsProducer();
-	else if(id == ValidBTaggedJetsProducer().GetProducerId())
-		return new ValidBTaggedJetsProducer();
-	else if(id == ElectronTriggerMatchingProducer().GetProducerId())
-		return new ElectronTriggerMatchingProducer();
-	else if(id == MuonTriggerMatchingProducer().GetProducerId())
-		return new MuonTriggerMatchingProducer();
-	else if(id == TauTriggerMatchingProducer().GetProducerId())
-		return new TauTriggerMatchingProducer();
-	else if(id == JetTriggerMatchingProducer().GetProducerId())
-		return new JetTriggerMatchingProducer();
-	else if(id == RecoElectronGenParticleMatchingProducer().GetProducerId())
-		return new RecoElectronGenParticleMatchingProducer();
-	else if(id == RecoMuonGenParticleMatchingProducer().GetProducerId())
-		return new RecoMuonGenParticleMatchingProducer();
-	else if(id == RecoTauGenParticleMatchingProducer().GetProducerId())
-		return new RecoTauGenParticleMatchingProducer();
-	else if(id == RecoJetGenParticleMatchingProducer().GetProducerId())
-		return new RecoJetGenParticleMatchingProducer();
-	else if(id == MatchedLeptonsProducer().GetProducerId())
-		return new MatchedLeptonsProducer();
-	else if(id == ValidLeptonsProducer().GetProducerId())
-		return new ValidLeptonsProducer();
-	else if(id == PUWeightProducer().GetProducerId())
-		return new PUWeightProducer();
-	else if(id == EventWeightProducer().GetProducerId())
-		return new EventWeightProducer();
-	else if(id == GeneratorWeightProducer().GetProducerId())
-		return new GeneratorWeightProducer();
-	else if(id == LuminosityWeightProducer().GetProducerId())
-		return new LuminosityWeightProducer();
-	else if(id == CrossSectionWeightProducer().GetProducerId())
-		return new CrossSectionWeightProducer();
-	else if(id == NumberGeneratedEventsWeightProducer().GetProducerId())
-		return new NumberGeneratedEventsWeightProducer();
-	else if(id == GenMuonFSRProducer().GetProducerId())
-		return new GenMuonFSRProducer();
-	// todo: uses setting not in KappaSettings
-	else if(id == GeneralTmvaClassificationReader().GetProducerId())
-		return new GeneralTmvaClassificationReader();
-	else if(id == GenDiLeptonDecayModeProducer().GetProducerId())
-		return new GenDiLeptonDecayModeProducer();
-	else if(id == GenPartonCounterProducer().GetProducerId())
-		return new GenPartonCounterProducer();
-	else if(id == EmbeddingWeightProducer().GetProducerId())
-		return new EmbeddingWeightProducer();
-	else if(id == NicknameProducer().GetProducerId())
-		return new NicknameProducer();
-	else if(id == RecoElectronGenTauMatchingProducer().GetProducerId())
-		return new RecoElectronGenTauMatchingProducer();
-	else if(id == RecoMuonGenTauMatchingProducer().GetProducerId())
-		return new RecoMuonGenTauMatchingProducer();
-	else if(id == RecoTauGenTauMatchingProducer().GetProducerId())
-		return new RecoTauGenTauMatchingProducer();
-	else if(id == RecoElectronGenTauJetMatchingProducer().GetProducerId())
-		return new RecoElectronGenTauJetMatchingProducer();
-	else if(id == RecoMuonGenTauJetMatchingProducer().GetProducerId())
-		return new RecoMuonGenTauJetMatchingProducer();
-	else if(id == RecoTauGenTauJetMatchingProducer().GetProducerId())
-		return new RecoTauGenTauJetMatchingProducer();
-	else if(id == ZmmProducer().GetProducerId())
-		return new ZmmProducer();
-	else if(id == ZeeProducer().GetProducerId())
-		return new ZeeProducer();
-	else if(id == ZemProducer().GetProducerId())
-		return new ZemProducer();
-	else
-		return FactoryBase::createProducer( id );
+	return ProcessorRegistry::CreateProducer<KappaTypes>( id );
 }
 
 FilterBaseUntemplated * KappaFactory::createFilter ( std::string const& id )
 {
-	if(id == RunLumiEventFilter().GetFilterId())
-		return new RunLumiEventFilter();
-	else if(id == JsonFilter().GetFilterId())
-		return new JsonFilter();
-	else if(id == HltFilter().GetFilterId())
-		return new HltFilter();
-	else if(id == ValidElectronsFilter().GetFilterId())
-		return new ValidElectronsFilter();
-	else if(id == ValidMuonsFilter().GetFilterId())
-		return new ValidMuonsFilter();
-	else if(id == ValidTausFilter().GetFilterId())
-		return new ValidTausFilter();
-	else if(id == ValidJetsFilter().GetFilterId())
-		return new ValidJetsFilter();
-	else if(id == ValidBTaggedJetsFilter().GetFilterId())
-		return new ValidBTaggedJetsFilter();
-	else if(id == ElectronsCountFilter().GetFilterId())
-		return new ElectronsCountFilter();
-	else if(id == MuonsCountFilter().GetFilterId())
-		return new MuonsCountFilter();
-	else if(id == TausCountFilter().GetFilterId())
-		return new TausCountFilter();
-	else if(id == JetsCountFilter().GetFilterId())
-		return new JetsCountFilter();
-	else if(id == BTaggedJetsCountFilter().GetFilterId())
-		return new BTaggedJetsCountFilter();
-	else if(id == NonBTaggedJetsCountFilter().GetFilterId())
-		return new NonBTaggedJetsCountFilter();
-	else if(id == MinElectronsCountFilter().GetFilterId())
-		return new MinElectronsCountFilter();
-	else if(id == MinMuonsCountFilter().GetFilterId())
-		return new MinMuonsCountFilter();
-	else if(id == MinTausCountFilter().GetFilterId())
-		return new MinTausCountFilter();
-	else if(id == MinJetsCountFilter().GetFilterId())
-		return new MinJetsCountFilter();
-	else if(id == MinBTaggedJetsCountFilter().GetFilterId())
-		return new MinBTaggedJetsCountFilter();
-	else if(id == MinNonBTaggedJetsCountFilter().GetFilterId())
-		return new MinNonBTaggedJetsCountFilter();
-	else if(id == MaxElectronsCountFilter().GetFilterId())
-		return new MaxElectronsCountFilter();
-	else if(id == MaxMuonsCountFilter().GetFilterId())
-		return new MaxMuonsCountFilter();
-	else if(id == MaxTausCountFilter().GetFilterId())
-		return new MaxTausCountFilter();
-	else if(id == MaxJetsCountFilter().GetFilterId())
-		return new MaxJetsCountFilter();
-	else if(id == MaxBTaggedJetsCountFilter().GetFilterId())
-		return new MaxBTaggedJetsCountFilter();
-	else if(id == MaxNonBTaggedJetsCountFilter().GetFilterId())
-		return new MaxNonBTaggedJetsCountFilter();
-	else if(id == ElectronLowerPtCutsFilter().GetFilterId())
-		return new ElectronLowerPtCutsFilter();
-	else if(id == MuonLowerPtCutsFilter().GetFilterId())
-		return new MuonLowerPtCutsFilter();
-	else if(id == TauLowerPtCutsFilter().GetFilterId())
-		return new TauLowerPtCutsFilter();
-	else if(id == JetLowerPtCutsFilter().GetFilterId())
-		return new JetLowerPtCutsFilter();
-	else if(id == NonBTaggedJetLowerPtCutsFilter().GetFilterId())
-		return new NonBTaggedJetLowerPtCutsFilter();
-	else if(id == ElectronUpperAbsEtaCutsFilter().GetFilterId())
-		return new ElectronUpperAbsEtaCutsFilter();
-	else if(id == MuonUpperAbsEtaCutsFilter().GetFilterId())
-		return new MuonUpperAbsEtaCutsFilter();
-	else if(id == TauUpperAbsEtaCutsFilter().GetFilterId())
-		return new TauUpperAbsEtaCutsFilter();
-	else if(id == JetUpperAbsEtaCutsFilter().GetFilterId())
-		return new JetUpperAbsEtaCutsFilter();
-	else if(id == ElectronTriggerMatchingFilter().GetFilterId())
-		return new ElectronTriggerMatchingFilter();
-	else if(id == MuonTriggerMatchingFilter().GetFilterId())
-		return new MuonTriggerMatchingFilter();
-	else if(id == TauTriggerMatchingFilter().GetFilterId())
-		return new TauTriggerMatchingFilter();
-	else if(id == JetTriggerMatchingFilter().GetFilterId())
-		return new JetTriggerMatchingFilter();
-	else if(id == ElectronGenMatchingFilter().GetFilterId())
-		return new ElectronGenMatchingFilter();
-	else if(id == MuonGenMatchingFilter().GetFilterId())
-		return new MuonGenMatchingFilter();
-	else if(id == TauGenMatchingFilter().GetFilterId())
-		return new TauGenMatchingFilter();
-	else if(id == JetGenMatchingFilter().GetFilterId())
-		return new JetGenMatchingFilter();
-	else if(id == GenTauMatchingRecoElectronMinDeltaRFilter().GetFilterId())
-		return new GenTauMatchingRecoElectronMinDeltaRFilter();
-	else if(id == GenTauMatchingRecoMuonMinDeltaRFilter().GetFilterId())
-		return new GenTauMatchingRecoMuonMinDeltaRFilter();
-	else if(id == GenTauMatchingRecoTauMinDeltaRFilter().GetFilterId())
-		return new GenTauMatchingRecoTauMinDeltaRFilter();
-	else if(id == ValidElectronsMinDeltaRFilter().GetFilterId())
-		return new ValidElectronsMinDeltaRFilter();
-	else if(id == ValidMuonsMinDeltaRFilter().GetFilterId())
-		return new ValidMuonsMinDeltaRFilter();
-	else if(id == ValidTausMinDeltaRFilter().GetFilterId())
-		return new ValidTausMinDeltaRFilter();
-	else if(id == ValidLeptonsMinDeltaRFilter().GetFilterId())
-		return new ValidLeptonsMinDeltaRFilter();
-	else if(id == GenDiLeptonDecayModeFilter().GetFilterId())
-		return new GenDiLeptonDecayModeFilter();
-	else if(id == GoodPrimaryVertexFilter().GetFilterId())
-		return new GoodPrimaryVertexFilter();
-	else if(id == HCALNoiseFilter().GetFilterId())
-		return new HCALNoiseFilter();
-	else if(id == BeamScrapingFilter().GetFilterId())
-		return new BeamScrapingFilter();
-	else if(id == nPUFilter().GetFilterId())
-		return new nPUFilter();
-	else if(id == ZFilter().GetFilterId())
-		return new ZFilter();
-	else
-		return FactoryBase::createFilter( id );
+	return ProcessorRegistry::CreateFilter<KappaTypes>( id );
 }
 
 ConsumerBaseUntemplated * KappaFactory::createConsumer ( std::string const& id )
 {
-	if(id == KappaCutFlowHistogramConsumer().GetConsumerId())
-		return new KappaCutFlowHistogramConsumer();
-	if(id == KappaCutFlowTreeConsumer().GetConsumerId())
-		return new KappaCutFlowTreeConsumer();
-	else if(id == KappaLambdaNtupleConsumer<KappaTypes>().GetConsumerId())
-		return new KappaLambdaNtupleConsumer<KappaTypes>();
-	else if(id == KappaElectronsConsumer().GetConsumerId())
-		return new KappaElectronsConsumer();
-	else if(id == KappaMuonsConsumer().GetConsumerId())
-		return new KappaMuonsConsumer();
-	else if(id == KappaTausConsumer().GetConsumerId())
-		return new KappaTausConsumer();
-	else if(id == KappaJetsConsumer().GetConsumerId())
-		return new KappaJetsConsumer();
-	else if(id == KappaTaggedJetsConsumer().GetConsumerId())
-		return new KappaTaggedJetsConsumer();
-	else if(id == PrintHltConsumer().GetConsumerId())
-		return new PrintHltConsumer();
-	else if(id == PrintEventsConsumer().GetConsumerId())
-		return new PrintEventsConsumer();
-	else if(id == RunTimeConsumer<KappaTypes>().GetConsumerId())
-		return new RunTimeConsumer<KappaTypes>();
-	else
-		return FactoryBase::createConsumer( id );
+	return ProcessorRegistry::CreateConsumer<KappaTypes>( id );
 }
@@ -19,16 +19,23 @@ void GenDiLeptonDecayModeProducer::Produce(KappaEvent const& event, KappaProduct
                                            KappaSettings const& settings) const
 {
 	assert(event.m_genParticles);
+	if (! product.m_genParticleIndex)
+	{
+		std::shared_ptr<GenParticleIndex> genParticleIndex(new GenParticleIndex());
+		genParticleIndex->Build(*event.m_genParticles);
+		product.m_genParticleIndex = genParticleIndex;
+	}
 
-	for (KGenParticles::const_iterator genParticle = event.m_genParticles->begin();
-		 genParticle != event.m_genParticles->end(); ++genParticle)
+	GenParticleIndex::IndexRange bosonCandidates = product.m_genParticleIndex->GetByAbsPdgId(settings.GetBosonPdgId());
+	for (GenParticleIndex::const_iterator bosonIndex = bosonCandidates.begin(); bosonIndex != bosonCandidates.end(); ++bosonIndex)
 	{
-		if ((std::abs(genParticle->pdgId()) == settings.GetBosonPdgId()) && (genParticle->status() == settings.GetBosonStatus()))
+		if (event.m_genParticles->at(*bosonIndex).status() == settings.GetBosonStatus())
 		{
 			std::map<int, int> nDecayProductsPerType;
 
-			for (std::vector<unsigned int>::const_iterator decayParticleIndex = genParticle->daughterIndices.begin();
-			     decayParticleIndex != genParticle->daughterIndices.end(); ++decayParticleIndex)
+			GenParticleIndex::IndexRange decayParticles = product.m_genParticleIndex->GetDaughters(*bosonIndex);
+			for (GenParticleIndex::const_iterator decayParticleIndex = decayParticles.begin();
+			     decayParticleIndex != decayParticles.end(); ++decayParticleIndex)
 			{
 				int pdgId = std::abs(event.m_genParticles->at(*decayParticleIndex).pdgId());
 				nDecayProductsPerType[pdgId] = SafeMap::GetWithDefault(nDecayProductsPerType, pdgId, 0) + 1;
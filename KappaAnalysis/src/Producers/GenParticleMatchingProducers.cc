@@ -1,3 +1,5 @@
+#include <numeric>
+
 #include "Artus/KappaAnalysis/interface/Producers/GenParticleMatchingProducers.h"
 
 
@@ -22,6 +24,13 @@ void RecoJetGenParticleMatchingProducer::Produce(event_type const& event, produc
 
 	if (m_DeltaRMatchingRecoJetGenParticle > 0.0f)
 	{
+		if (! product.m_genParticlesEtaPhiIndex)
+		{
+			std::shared_ptr<EtaPhiIndex> genParticlesEtaPhiIndex(new EtaPhiIndex());
+			genParticlesEtaPhiIndex->Build(*event.m_genParticles);
+			product.m_genParticlesEtaPhiIndex = genParticlesEtaPhiIndex;
+		}
+
 		// loop over all valid objects (jets) to check
 		for (std::vector<KBasicJet*>::iterator validJet = product.m_validJets.begin();
 			 validJet != product.m_validJets.end();)
@@ -67,10 +76,22 @@ KGenParticle* RecoJetGenParticleMatchingProducer::Match(event_type const& event,
 	KGenParticle* hardestBQuark = nullptr;
 	KGenParticle* hardestCQuark = nullptr;
 
-	// loop over all genParticles 
-	for (std::vector<KGenParticle>::iterator genParticle = event.m_genParticles->begin();
-	     genParticle != event.m_genParticles->end(); ++genParticle)
+	// loop over the genParticles in the cone in the order of the collection, which defines the choice between equal candidates
+	if (product.m_genParticlesEtaPhiIndex)
+	{
+		product.m_genParticlesEtaPhiIndex->GetCandidates(recoJet->p4.Eta(), recoJet->p4.Phi(), m_DeltaRMatchingRecoJetGenParticle,
+		                                                 m_genParticleCandidates);
+	}
+	else
+	{
+		m_genParticleCandidates.resize(event.m_genParticles->size());
+		std::iota(m_genParticleCandidates.begin(), m_genParticleCandidates.end(), 0);
+	}
+
+	for (std::vector<size_t>::const_iterator genParticleIndex = m_genParticleCandidates.begin();
+	     genParticleIndex != m_genParticleCandidates.end(); ++genParticleIndex)
 	{
+		std::vector<KGenParticle>::iterator genParticle = event.m_genParticles->begin() + *genParticleIndex;
 		// only use genParticles with id 21, 1, -1, 2, -2, 3, -3, 4, -4, 5, -5
 		if ((std::abs(genParticle->pdgId()) == 1) ||
 		    (std::abs(genParticle->pdgId()) == 2) ||
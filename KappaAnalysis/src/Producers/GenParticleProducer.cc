@@ -15,26 +15,45 @@ void GenParticleProducer::Init(KappaSettings const& settings)
 	{
 		genParticleTypes.push_back(ToGenParticleType(*genParticleType));
 	}
+
+	genParticlePdgIds.clear();
+	for (std::vector<int>::const_iterator pdgId = settings.GetGenParticlePdgIds().begin();
+	     pdgId != settings.GetGenParticlePdgIds().end(); ++pdgId)
+	{
+		if (std::find(genParticlePdgIds.begin(), genParticlePdgIds.end(), *pdgId) == genParticlePdgIds.end())
+		{
+			genParticlePdgIds.push_back(*pdgId);
+		}
+	}
 }
 
 void GenParticleProducer::Produce(KappaEvent const& event, KappaProduct& product,
                      KappaSettings const& settings) const
 {
 	assert(event.m_genParticles);
+	if (! product.m_genParticleIndex)
+	{
+		std::shared_ptr<GenParticleIndex> genParticleIndex(new GenParticleIndex());
+		genParticleIndex->Build(*event.m_genParticles);
+		product.m_genParticleIndex = genParticleIndex;
+	}
 
 	// gen particles (can be used for quarks, W, Z, .., but also for leptons if needed)
 	if (std::find(genParticleTypes.begin(), genParticleTypes.end(), GenParticleType::GENPARTICLE)
 	    != genParticleTypes.end())
 	{
-		for (KGenParticles::iterator part = event.m_genParticles->begin();
-		     part != event.m_genParticles->end(); ++part)
+		for (std::vector<int>::const_iterator pdgId = genParticlePdgIds.begin(); pdgId != genParticlePdgIds.end(); ++pdgId)
 		{
-			if (std::find(settings.GetGenParticlePdgIds().begin(), settings.GetGenParticlePdgIds().end(), part->pdgId())
-			    != settings.GetGenParticlePdgIds().end())
+			GenParticleIndex::IndexRange candidates = product.m_genParticleIndex->GetByAbsPdgId(std::abs(*pdgId));
+			for (GenParticleIndex::const_iterator index = candidates.begin(); index != candidates.end(); ++index)
 			{
-				if ((settings.GetGenParticleStatus() == -1) || ( settings.GetGenParticleStatus() == part->status()))
+				KGenParticle* part = &(event.m_genParticles->at(*index));
+				if (part->pdgId() == *pdgId)
 				{
-					product.m_genParticlesMap[part->pdgId()].push_back(&(*part));
+					if ((settings.GetGenParticleStatus() == -1) || ( settings.GetGenParticleStatus() == part->status()))
+					{
+						product.m_genParticlesMap[part->pdgId()].push_back(part);
+					}
 				}
 			}
 		}
@@ -44,15 +63,13 @@ void GenParticleProducer::Produce(KappaEvent const& event, KappaProduct& product
 	if (std::find(genParticleTypes.begin(), genParticleTypes.end(), GenParticleType::GENELECTRON)
 	    != genParticleTypes.end())
 	{
-		for (KGenParticles::iterator part = event.m_genParticles->begin();
-		     part != event.m_genParticles->end(); ++part)
+		GenParticleIndex::IndexRange candidates = product.m_genParticleIndex->GetByAbsPdgId(11);
+		for (GenParticleIndex::const_iterator index = candidates.begin(); index != candidates.end(); ++index)
 		{
-			if (std::abs(part->pdgId()) == 11)
+			KGenParticle* part = &(event.m_genParticles->at(*index));
+			if ((settings.GetGenElectronStatus() == -1) || ( settings.GetGenElectronStatus() == part->status()))
 			{
-				if ((settings.GetGenElectronStatus() == -1) || ( settings.GetGenElectronStatus() == part->status()))
-				{
-					product.m_genElectrons.push_back(&(*part));
-				}
+				product.m_genElectrons.push_back(part);
 			}
 		}
 	}
@@ -61,15 +78,13 @@ void GenParticleProducer::Produce(KappaEvent const& event, KappaProduct& product
 	if (std::find(genParticleTypes.begin(), genParticleTypes.end(), GenParticleType::GENMUON)
 	    != genParticleTypes.end())
 	{
-		for (KGenParticles::iterator part = event.m_genParticles->begin();
-		     part != event.m_genParticles->end(); ++part)
+		GenParticleIndex::IndexRange candidates = product.m_genParticleIndex->GetByAbsPdgId(13);
+		for (GenParticleIndex::const_iterator index = candidates.begin(); index != candidates.end(); ++index)
 		{
-			if (std::abs(part->pdgId()) == 13)
+			KGenParticle* part = &(event.m_genParticles->at(*index));
+			if ((settings.GetGenMuonStatus() == -1) || ( settings.GetGenMuonStatus() == part->status()))
 			{
-				if ((settings.GetGenMuonStatus() == -1) || ( settings.GetGenMuonStatus() == part->status()))
-				{
-					product.m_genMuons.push_back(&(*part));
-				}
+				product.m_genMuons.push_back(part);
 			}
 		}
 	}
@@ -78,15 +93,13 @@ void GenParticleProducer::Produce(KappaEvent const& event, KappaProduct& product
 	if (std::find(genParticleTypes.begin(), genParticleTypes.end(), GenParticleType::GENTAU)
 	    != genParticleTypes.end())
 	{
-		for (KGenParticles::iterator part = event.m_genParticles->begin();
-		     part != event.m_genParticles->end(); ++part)
+		GenParticleIndex::IndexRange candidates = product.m_genParticleIndex->GetByAbsPdgId(15);
+		for (GenParticleIndex::const_iterator index = candidates.begin(); index != candidates.end(); ++index)
 		{
-			if (std::abs(part->pdgId()) == 15)
+			KGenParticle* part = &(event.m_genParticles->at(*index));
+			if ((settings.GetGenTauStatus() == -1) || ( settings.GetGenTauStatus() == part->status()))
 			{
-				if ((settings.GetGenTauStatus() == -1) || ( settings.GetGenTauStatus() == part->status()))
-				{
-					product.m_genTaus.push_back(&(*part));
-				}
+				product.m_genTaus.push_back(part);
 			}
 		}
 	}
@@ -15,15 +15,21 @@ void GenPartonCounterProducer::Produce(KappaEvent const& event, KappaProduct& pr
                                        KappaSettings const& settings) const
 {
 	assert(event.m_genParticles);
+	if (! product.m_genParticleIndex)
+	{
+		std::shared_ptr<GenParticleIndex> genParticleIndex(new GenParticleIndex());
+		genParticleIndex->Build(*event.m_genParticles);
+		product.m_genParticleIndex = genParticleIndex;
+	}
 
 	int nPartons = 0;
 	bool countPartons = false;
 
-	for (KGenParticles::const_iterator genParticle = event.m_genParticles->begin();
-		 genParticle != event.m_genParticles->end(); ++genParticle)
+	// only the particles with the parton status are considered
+	GenParticleIndex::IndexRange candidates = product.m_genParticleIndex->GetByStatus(settings.GetPartonStatus());
+	for (GenParticleIndex::const_iterator index = candidates.begin(); index != candidates.end(); ++index)
 	{
-		if (genParticle->status() != settings.GetPartonStatus())
-			continue;
+		KGenParticle const* genParticle = &(event.m_genParticles->at(*index));
 
 		if (countPartons) {
 			// quarks and gluons
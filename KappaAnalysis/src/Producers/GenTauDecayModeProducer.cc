@@ -36,8 +36,8 @@ void GenTauDecayModeProducer::Produce(KappaEvent const& event, KappaProduct& pro
 {
 	assert(event.m_genTaus);
 
-	MotherDaughterBundle* selectedTau1 = nullptr;
-	MotherDaughterBundle* selectedTau2 = nullptr;
+	GenDecayGraph::Node const* selectedTau1 = nullptr;
+	GenDecayGraph::Node const* selectedTau2 = nullptr;
 
 	int tau1ProngSize = -1;
 	int tau2ProngSize = -1;
@@ -45,31 +45,17 @@ void GenTauDecayModeProducer::Produce(KappaEvent const& event, KappaProduct& pro
 	int tau1DecayMode = -1;
 	int tau2DecayMode = -1;
 
-
-	if(product.m_genBoson.size()>0)
+	// decay modes and final states are already determined by the GenTauDecayProducer
+	if (product.m_genBosonDecayGraph && (product.m_genBosonDecayGraph->GetNode(0, 1) != nullptr))
 	{
-		if(product.m_genBoson[0].Daughters.size()>1)
-		{
-			selectedTau1 = &(product.m_genBoson[0].Daughters[0]);
-			selectedTau2 = &(product.m_genBoson[0].Daughters[1]);
-
-			selectedTau1->determineDecayMode(selectedTau1);
-			selectedTau2->determineDecayMode(selectedTau2);
+		selectedTau1 = product.m_genBosonDecayGraph->GetNode(0, 0);
+		selectedTau2 = product.m_genBosonDecayGraph->GetNode(0, 1);
 
-			tau1DecayMode = Utility::ToUnderlyingValue(selectedTau1->decayMode);
-			tau2DecayMode = Utility::ToUnderlyingValue(selectedTau2->decayMode);
+		tau1DecayMode = Utility::ToUnderlyingValue(selectedTau1->decayMode);
+		tau2DecayMode = Utility::ToUnderlyingValue(selectedTau2->decayMode);
 
-			selectedTau1->createFinalStateProngs(selectedTau1);
-			selectedTau2->createFinalStateProngs(selectedTau2);
-
-			if ((selectedTau1->finalStateOneProngs.size())>0) tau1ProngSize = 1;
-			else if ((selectedTau1->finalStateThreeProngs.size())>0) tau1ProngSize = 3;
-			else if ((selectedTau1->finalStateFiveProngs.size())>0) tau1ProngSize = 5;
-
-			if (selectedTau2->finalStateOneProngs.size()>0) tau2ProngSize = 1;
-			else if (selectedTau2->finalStateThreeProngs.size()>0) tau2ProngSize = 3;
-			else if (selectedTau2->finalStateFiveProngs.size()>0) tau2ProngSize = 5;
-		}
+		tau1ProngSize = GenDecayGraph::GetProngSize(*selectedTau1);
+		tau2ProngSize = GenDecayGraph::GetProngSize(*selectedTau2);
 	}
 
 	product.m_tau1DecayMode = tau1DecayMode;
@@ -81,12 +67,12 @@ void GenTauDecayModeProducer::Produce(KappaEvent const& event, KappaProduct& pro
 	for(typename std::vector<KGenTau>::const_iterator genTau = event.m_genTaus->begin();
 	    genTau != event.m_genTaus->end();++genTau)
 	{
-		if (selectedTau1->node->p4 == genTau->p4)
+		if (selectedTau1 && (selectedTau1->particle->p4 == genTau->p4))
 		{
 			product.m_genMatchedDecayMode[&(*genTau)] = tau1DecayMode;
 			product.m_genMatchedProngSize[&(*genTau)] = tau1ProngSize;
 		}
-		if (selectedTau2->node->p4 == genTau->p4)
+		if (selectedTau2 && (selectedTau2->particle->p4 == genTau->p4))
 		{
 			product.m_genMatchedDecayMode[&(*genTau)] = tau2DecayMode;
 			product.m_genMatchedProngSize[&(*genTau)] = tau2ProngSize;
@@ -102,9 +88,9 @@ void GenTauDecayModeProducer::Produce(KappaEvent const& event, KappaProduct& pro
 	std::map<int, int>::iterator tau1 = finalStateLeptons.begin();
 	if (tau1->second == 2)
 	{
-		if (tau1->first == static_cast<int>(MotherDaughterBundle::DecayMode::E))
+		if (tau1->first == static_cast<int>(GenDecayGraph::DecayMode::E))
 			product.m_genTauDecayMode = static_cast<int>(GenTauDecayMode::EE);
-		else if (tau1->first == static_cast<int>(MotherDaughterBundle::DecayMode::M))
+		else if (tau1->first == static_cast<int>(GenDecayGraph::DecayMode::M))
 			product.m_genTauDecayMode = static_cast<int>(GenTauDecayMode::MM);
 		else
 			product.m_genTauDecayMode = static_cast<int>(GenTauDecayMode::TT);
@@ -113,14 +99,14 @@ void GenTauDecayModeProducer::Produce(KappaEvent const& event, KappaProduct& pro
 	{
 		std::map<int, int>::iterator tau2 = finalStateLeptons.begin();
 		++tau2;
-		if (tau1->first == static_cast<int>(MotherDaughterBundle::DecayMode::E))
+		if (tau1->first == static_cast<int>(GenDecayGraph::DecayMode::E))
 		{
-			if (tau2->first == static_cast<int>(MotherDaughterBundle::DecayMode::M))
+			if (tau2->first == static_cast<int>(GenDecayGraph::DecayMode::M))
 				product.m_genTauDecayMode = static_cast<int>(GenTauDecayMode::EM);
 			else
 				product.m_genTauDecayMode = static_cast<int>(GenTauDecayMode::ET);
 		}
-		else if (tau1->first == static_cast<int>(MotherDaughterBundle::DecayMode::M))
+		else if (tau1->first == static_cast<int>(GenDecayGraph::DecayMode::M))
 				product.m_genTauDecayMode = static_cast<int>(GenTauDecayMode::MT);
 		else
 			product.m_genTauDecayMode = static_cast<int>(GenTauDecayMode::TT);
@@ -1,4 +1,6 @@
 
+#include <atomic>
+
 #include "Artus/KappaAnalysis/interface/Consumers/KappaLambdaNtupleConsumer.h"
 #include "Artus/KappaAnalysis/interface/Producers/HltProducer.h"
 
@@ -13,11 +15,17 @@ void HltProducer::Init(KappaSettings const& settings)
 	// add possible quantities for the lambda ntuples consumers
 	LambdaNtupleConsumer<KappaTypes>::AddIntQuantity("nSelectedHltPaths", [](KappaEvent const& event, KappaProduct const& product)
 	{
-		return static_cast<int>(product.m_selectedHltNames.size());
+		return static_cast<int>(product.m_selectedHltIndices.size());
 	});
 	LambdaNtupleConsumer<KappaTypes>::AddVStringQuantity("selectedHltPaths", [](KappaEvent const& event, KappaProduct const& product)
 	{
-		return product.m_selectedHltNames;
+		// the names are only copied, if they are requested
+		std::vector<std::string> selectedHltNames;
+		for (size_t selectedHltIndex = 0; selectedHltIndex < product.m_selectedHltIndices.size(); ++selectedHltIndex)
+		{
+			selectedHltNames.push_back(product.GetSelectedHltName(selectedHltIndex));
+		}
+		return selectedHltNames;
 	});
 }
 
@@ -27,7 +35,9 @@ void HltProducer::Produce(KappaEvent const& event, KappaProduct& product,
 	assert(event.m_lumiInfo);
 	assert(event.m_eventInfo);
 	
-	if (product.m_settingsHltPaths.empty())
+	// the list of paths can be overwritten by previous producers
+	bool overwrittenHltPaths = (! product.m_settingsHltPaths.empty());
+	if (! overwrittenHltPaths)
 	{
 		product.m_settingsHltPaths.insert(product.m_settingsHltPaths.begin(),
 		                                  settings.GetHltPaths().begin(),
@@ -40,58 +50,43 @@ void HltProducer::Produce(KappaEvent const& event, KappaProduct& product,
 	// set LumiMetadat, needs to be done here for the case running over multiple files
 	product.m_hltInfo.setLumiInfo(event.m_lumiInfo);
 
-	// search (independently) for trigger with lowest prescale and for fired triggers
-	std::string lowestPrescaleHltName;
-	int lowestPrescale = std::numeric_limits<int>::max();
-	
-	std::string lowestSelectedPrescaleHltName;
+	stringvector const* hltPathsSettings = (overwrittenHltPaths ? nullptr : &(settings.GetHltPaths()));
+	if ((event.m_lumiInfo != m_resolvedLumiInfo) ||
+	    (event.m_lumiInfo->nRun != m_resolvedRun) || (event.m_lumiInfo->nLumi != m_resolvedLumi) ||
+	    (hltPathsSettings != m_resolvedHltPathsSettings) ||
+	    (overwrittenHltPaths && (product.m_settingsHltPaths != m_resolvedHltPatterns)))
+	{
+		ResolveHltPaths(event.m_lumiInfo, product.m_settingsHltPaths, hltPathsSettings);
+	}
+
+	// search for (unprescaled if requested) fired triggers
 	int lowestSelectedPrescale = std::numeric_limits<int>::max();
 	
-	product.m_selectedHltNames.clear();
+	product.m_resolvedHltPaths = m_resolvedHltPaths;
+	product.m_selectedHltIndices.clear();
 	product.m_selectedHltPositions.clear();
 	product.m_selectedHltPrescales.clear();
-	for (stringvector::const_iterator hltPath = product.m_settingsHltPaths.begin(); hltPath != product.m_settingsHltPaths.end(); ++hltPath)
+	for (std::vector<ResolvedHltPaths::Path>::const_iterator hltPath = m_resolvedHltPaths->paths.begin();
+	     hltPath != m_resolvedHltPaths->paths.end(); ++hltPath)
 	{
-		std::string hltName = product.m_hltInfo.getHLTName(*hltPath);
-		if (! hltName.empty())
+		if (event.m_eventInfo->bitsHLT[hltPath->position] && (settings.GetAllowPrescaledTrigger() || (hltPath->prescale <= 1)))
 		{
-			// look for trigger with lowest prescale
-			// do not use hltName here as a parameter because *hltPath is already cached.
-			int prescale = product.m_hltInfo.getPrescale(*hltPath);
-			if ((prescale < lowestPrescale) && (prescale > 0))
-			{
-				lowestPrescale = prescale;
-				lowestPrescaleHltName = hltName;
-			}
-			
-			// look for (unprescaled if requested) fired trigger
-			if (event.m_eventInfo->hltFired(hltName, event.m_lumiInfo) && (settings.GetAllowPrescaledTrigger() || (prescale <= 1)))
+			product.m_selectedHltIndices.push_back(static_cast<size_t>(hltPath - m_resolvedHltPaths->paths.begin()));
+			product.m_selectedHltPositions.push_back(static_cast<int>(hltPath->position));
+			product.m_selectedHltPrescales.push_back(hltPath->prescale);
+			if ((hltPath->prescale < lowestSelectedPrescale) && (hltPath->prescale > 0))
 			{
-				product.m_selectedHltNames.push_back(hltName);
-				
-				// do not use hltName here as a parameter because *hltPath is already cached.
-				product.m_selectedHltPositions.push_back(static_cast<int>(product.m_hltInfo.getHLTPosition(*hltPath)));
-				
-				product.m_selectedHltPrescales.push_back(prescale);
-				if ((prescale < lowestSelectedPrescale) && (prescale > 0))
-				{
-					lowestSelectedPrescale = prescale;
-					lowestSelectedPrescaleHltName = hltName;
-				}
+				lowestSelectedPrescale = hltPath->prescale;
 			}
 		}
 	}
 	
-	if ((! settings.GetAllowPrescaledTrigger()) && (lowestPrescale > 1))
+	if ((! settings.GetAllowPrescaledTrigger()) && (m_lowestPrescale > 1))
 	{
 		LOG(WARNING) << "No unprescaled trigger found for event " << event.m_eventInfo->nEvent
-		             << "! Lowest prescale: " << lowestPrescale << " (\"" << lowestPrescaleHltName << "\").";
+		             << "! Lowest prescale: " << m_lowestPrescale << " (\"" << m_lowestPrescaleHltName << "\").";
 	}
 	
-	if (! (lowestPrescale > 0))
-	{
-		lowestPrescale = 1;
-	}
 	if (! (lowestSelectedPrescale > 0) || (lowestSelectedPrescale == std::numeric_limits<int>::max()))
 	{
 		lowestSelectedPrescale = 1;
@@ -100,3 +95,49 @@ void HltProducer::Produce(KappaEvent const& event, KappaProduct& product,
 	// TODO: how to define the HLT prescale eventweight when more than one HLT fires? The product of them? The min. or max. value? Maybe overwrite it later?
 	product.m_weights["hltPrescaleWeight"] = lowestSelectedPrescale;
 }
+
+void HltProducer::ResolveHltPaths(KLumiInfo const* lumiInfo, stringvector const& hltPaths, stringvector const* hltPathsSettings) const
+{
+	m_hltTools.setLumiInfo(lumiInfo);
+	
+	// the previous resolution stays valid for the products still referring to it
+	std::shared_ptr<ResolvedHltPaths> resolvedHltPaths = std::make_shared<ResolvedHltPaths>();
+	static std::atomic<unsigned long long> generation(0);
+	resolvedHltPaths->generation = ++generation;
+	m_lowestPrescale = std::numeric_limits<int>::max();
+	m_lowestPrescaleHltName.clear();
+	for (stringvector::const_iterator hltPath = hltPaths.begin(); hltPath != hltPaths.end(); ++hltPath)
+	{
+		std::string hltName = m_hltTools.getHLTName(*hltPath);
+		if (! hltName.empty())
+		{
+			// do not use hltName here as a parameter because *hltPath is already cached.
+			ResolvedHltPaths::Path resolvedHltPath;
+			resolvedHltPath.name = hltName;
+			resolvedHltPath.position = m_hltTools.getHLTPosition(*hltPath);
+			resolvedHltPath.prescale = m_hltTools.getPrescale(*hltPath);
+			
+			// look for trigger with lowest prescale
+			if ((resolvedHltPath.prescale < m_lowestPrescale) && (resolvedHltPath.prescale > 0))
+			{
+				m_lowestPrescale = resolvedHltPath.prescale;
+				m_lowestPrescaleHltName = hltName;
+			}
+			resolvedHltPaths->paths.push_back(resolvedHltPath);
+		}
+	}
+	m_resolvedHltPaths = resolvedHltPaths;
+	
+	m_resolvedHltPathsSettings = hltPathsSettings;
+	if (hltPathsSettings == nullptr)
+	{
+		m_resolvedHltPatterns = hltPaths;
+	}
+	else
+	{
+		m_resolvedHltPatterns.clear();
+	}
+	m_resolvedLumiInfo = lumiInfo;
+	m_resolvedRun = lumiInfo->nRun;
+	m_resolvedLumi = lumiInfo->nLumi;
+}
@@ -2,6 +2,8 @@
 #include "TH1.h"
 
 #include "Artus/KappaAnalysis/interface/Producers/PUWeightProducer.h"
+#include "Artus/Utility/interface/RootFileHelper.h"
+#include "Artus/Utility/interface/SharedResourceCache.h"
 
 
 std::string PUWeightProducer::GetProducerId() const {
@@ -11,20 +13,28 @@ std::string PUWeightProducer::GetProducerId() const {
 void PUWeightProducer::Init(KappaSettings const& settings) {
 	KappaProducerBase::Init(settings);
 
+	// the weights are shared by all pipelines using the same file
 	const std::string histogramName = "pileup";
-	LOG(DEBUG) << "\tLoading pile-up weights from files...";
-	LOG(DEBUG) << "\t\t" << settings.GetPileupWeightFile() << "/" << histogramName;
-	TFile file(settings.GetPileupWeightFile().c_str(), "READONLY");
-	TH1D* pileupHistogram = dynamic_cast<TH1D*>(file.Get(histogramName.c_str()));
-
-	m_pileupWeights.clear();
-	for (int i = 1; i <= pileupHistogram->GetNbinsX(); ++i)
+	std::string const& pileupWeightFile = settings.GetPileupWeightFile();
+	m_pileupWeights = SharedResourceCache::Get<PileupWeights>(pileupWeightFile, histogramName,
+			[&pileupWeightFile, &histogramName]()
 	{
-		m_pileupWeights.push_back(pileupHistogram->GetBinContent(i));
-	}
-	m_bins = 1.0 / pileupHistogram->GetBinWidth(1);
-	delete pileupHistogram;
-	file.Close();
+		LOG(DEBUG) << "\tLoading pile-up weights from files...";
+		LOG(DEBUG) << "\t\t" << pileupWeightFile << "/" << histogramName;
+		std::lock_guard<std::recursive_mutex> lock(RootFileHelper::GetRootMutex());
+		TFile file(pileupWeightFile.c_str(), "READONLY");
+		TH1D* pileupHistogram = dynamic_cast<TH1D*>(file.Get(histogramName.c_str()));
+
+		PileupWeights* pileupWeights = new PileupWeights();
+		for (int i = 1; i <= pileupHistogram->GetNbinsX(); ++i)
+		{
+			pileupWeights->weights.push_back(pileupHistogram->GetBinContent(i));
+		}
+		pileupWeights->bins = 1.0 / pileupHistogram->GetBinWidth(1);
+		delete pileupHistogram;
+		file.Close();
+		return pileupWeights;
+	});
 }
 
 void PUWeightProducer::Produce(KappaEvent const& event, KappaProduct& product,
@@ -32,9 +42,9 @@ void PUWeightProducer::Produce(KappaEvent const& event, KappaProduct& product,
 {
 	assert(event.m_genEventInfo != nullptr);
 
-	unsigned int puBin = static_cast<unsigned int>(static_cast<double>(event.m_genEventInfo->nPUMean) * m_bins);
-	if (puBin < m_pileupWeights.size())
-		product.m_weights["puWeight"] = m_pileupWeights.at(puBin);
+	unsigned int puBin = static_cast<unsigned int>(static_cast<double>(event.m_genEventInfo->nPUMean) * m_pileupWeights->bins);
+	if (puBin < m_pileupWeights->weights.size())
+		product.m_weights["puWeight"] = m_pileupWeights->weights.at(puBin);
 	else
 		product.m_weights["puWeight"] = 0.0;
 }
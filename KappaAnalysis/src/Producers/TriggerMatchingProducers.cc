@@ -2,6 +2,35 @@
 #include "Artus/KappaAnalysis/interface/Producers/TriggerMatchingProducers.h"
 
 
+void TriggerObjectMatching::MatchDeltaR(double eta, double phi, double const* triggerObjectsEta, double const* triggerObjectsPhi,
+                                        size_t nBlocks, double deltaR2Max, double* matched)
+{
+	size_t nTriggerObjects = nBlocks * BlockSize;
+#pragma GCC ivdep
+	for (size_t triggerObjectIndex = 0; triggerObjectIndex < nTriggerObjects; ++triggerObjectIndex)
+	{
+		double deltaEta = eta - triggerObjectsEta[triggerObjectIndex];
+		double deltaPhi = phi - triggerObjectsPhi[triggerObjectIndex];
+		deltaPhi += ((deltaPhi > M_PI) ? -2.0 * M_PI : ((deltaPhi <= -M_PI) ? 2.0 * M_PI : 0.0));
+		matched[triggerObjectIndex] = ((((deltaEta * deltaEta) + (deltaPhi * deltaPhi)) < deltaR2Max) ? 1.0 : 0.0);
+	}
+}
+
+
+namespace
+{
+	// the lepton results are rebuilt from the three lepton types, such that running a trigger
+	// matching producer again (e.g. in a local pipeline) replaces its previous results
+	void FillDetailedTriggerMatchedLeptons(KappaProduct& product)
+	{
+		product.m_detailedTriggerMatchedLeptons.Clear();
+		product.m_detailedTriggerMatchedLeptons.Append(product.m_detailedTriggerMatchedElectrons);
+		product.m_detailedTriggerMatchedLeptons.Append(product.m_detailedTriggerMatchedMuons);
+		product.m_detailedTriggerMatchedLeptons.Append(product.m_detailedTriggerMatchedTaus);
+	}
+}
+
+
 std::string ElectronTriggerMatchingProducer::GetProducerId() const
 {
 	return "ElectronTriggerMatchingProducer";
@@ -31,11 +60,7 @@ void ElectronTriggerMatchingProducer::Produce(KappaEvent const& event, KappaProd
 		product.m_triggerMatchedLeptons[&(*(it->first))] = &(*(it->second));
 	}
 	
-	for (std::map<KElectron*, std::map<std::string, std::map<std::string, std::vector<KLV*> > > >::iterator it = product.m_detailedTriggerMatchedElectrons.begin();
-	     it != product.m_detailedTriggerMatchedElectrons.end(); ++it)
-	{
-		product.m_detailedTriggerMatchedLeptons[&(*(it->first))] = &(it->second);
-	}
+	FillDetailedTriggerMatchedLeptons(product);
 }
 
 
@@ -68,11 +93,7 @@ void MuonTriggerMatchingProducer::Produce(KappaEvent const& event, KappaProduct&
 		product.m_triggerMatchedLeptons[&(*(it->first))] = &(*(it->second));
 	}
 	
-	for (std::map<KMuon*, std::map<std::string, std::map<std::string, std::vector<KLV*> > > >::iterator it = product.m_detailedTriggerMatchedMuons.begin();
-	     it != product.m_detailedTriggerMatchedMuons.end(); ++it)
-	{
-		product.m_detailedTriggerMatchedLeptons[&(*(it->first))] = &(it->second);
-	}
+	FillDetailedTriggerMatchedLeptons(product);
 }
 
 
@@ -105,11 +126,7 @@ void TauTriggerMatchingProducer::Produce(KappaEvent const& event, KappaProduct&
 		product.m_triggerMatchedLeptons[&(*(it->first))] = &(*(it->second));
 	}
 	
-	for (std::map<KTau*, std::map<std::string, std::map<std::string, std::vector<KLV*> > > >::iterator it = product.m_detailedTriggerMatchedTaus.begin();
-	     it != product.m_detailedTriggerMatchedTaus.end(); ++it)
-	{
-		product.m_detailedTriggerMatchedLeptons[&(*(it->first))] = &(it->second);
-	}
+	FillDetailedTriggerMatchedLeptons(product);
 }
 
 
@@ -2,6 +2,13 @@
 #include "Artus/KappaAnalysis/interface/Producers/ValidBTaggedJetsProducer.h"
 
 
+ValidBTaggedJetsProducer::ValidBTaggedJetsProducer() :
+	KappaProducerBase(),
+	bTagger(&KJetMetadata::tagNames, "Jet tagger"),
+	bTaggerHandle(0)
+{
+}
+
 std::string ValidBTaggedJetsProducer::GetProducerId() const {
 	return "ValidBTaggedJetsProducer";
 }
@@ -11,15 +18,16 @@ void ValidBTaggedJetsProducer::Init(KappaSettings const& settings)
 	KappaProducerBase::Init(settings);
 	
 	bTagSFMethod = ToBTagScaleFactorMethod(boost::algorithm::to_lower_copy(boost::algorithm::trim_copy(settings.GetBTagSFMethod())));
+	bTaggerHandle = bTagger.Add(settings.GetBTaggedJetCombinedSecondaryVertexName());
 	
 	// add possible quantities for the lambda ntuples consumers
 	LambdaNtupleConsumer<KappaTypes>::AddIntQuantity("nBJets", [](KappaEvent const& event, KappaProduct const& product) {
 		return product.m_bTaggedJets.size();
 	});
-	LambdaNtupleConsumer<KappaTypes>::AddIntQuantity("nBJets20", [this](KappaEvent const& event, KappaProduct const& product) {
+	LambdaNtupleConsumer<KappaTypes>::AddIntQuantity("nBJets20", [](KappaEvent const& event, KappaProduct const& product) {
 		return KappaProduct::GetNJetsAbovePtThreshold(product.m_bTaggedJets, 20.0);
 	});
-	LambdaNtupleConsumer<KappaTypes>::AddIntQuantity("nBJets30", [this](KappaEvent const& event, KappaProduct const& product) {
+	LambdaNtupleConsumer<KappaTypes>::AddIntQuantity("nBJets30", [](KappaEvent const& event, KappaProduct const& product) {
 		return KappaProduct::GetNJetsAbovePtThreshold(product.m_bTaggedJets, 30.0);
 	});		
 	LambdaNtupleConsumer<KappaTypes>::AddFloatQuantity("bJetPt", [](KappaEvent const& event, KappaProduct const& product) {
@@ -41,20 +49,23 @@ void ValidBTaggedJetsProducer::Init(KappaSettings const& settings)
 		return product.m_bTaggedJets.size() >= 2 ? product.m_bTaggedJets.at(1)->p4.Phi() : DefaultValues::UndefinedFloat;
 	});
 
-	std::string bTaggedJetCSVName = settings.GetBTaggedJetCombinedSecondaryVertexName();
-	std::string jetPuJetIDName = settings.GetPuJetIDFullDiscrName();
+	// every tagger has its own binding, such that only the taggers of requested quantities need to be available
+	std::shared_ptr<MetadataNameBinding<KJetMetadata> > bTaggedJetCSV(new MetadataNameBinding<KJetMetadata>(&KJetMetadata::tagNames, "Jet tagger"));
+	size_t bTaggedJetCSVHandle = bTaggedJetCSV->Add(settings.GetBTaggedJetCombinedSecondaryVertexName());
+	std::shared_ptr<MetadataNameBinding<KJetMetadata> > jetPuJetID(new MetadataNameBinding<KJetMetadata>(&KJetMetadata::tagNames, "Jet tagger"));
+	size_t jetPuJetIDHandle = jetPuJetID->Add(settings.GetPuJetIDFullDiscrName());
 
-	LambdaNtupleConsumer<KappaTypes>::AddFloatQuantity("leadingBJetCSV",[bTaggedJetCSVName](KappaEvent const& event, KappaProduct const& product) {
-		return product.m_bTaggedJets.size() >= 1 ? static_cast<KJet*>(product.m_bTaggedJets.at(0))->getTag(bTaggedJetCSVName, event.m_jetMetadata) : DefaultValues::UndefinedFloat;
+	LambdaNtupleConsumer<KappaTypes>::AddFloatQuantity(settings, "leadingBJetCSV", [bTaggedJetCSV, bTaggedJetCSVHandle](KappaEvent const& event, KappaProduct const& product) {
+		return product.m_bTaggedJets.size() >= 1 ? static_cast<KJet*>(product.m_bTaggedJets.at(0))->tags.at(bTaggedJetCSV->GetIndex(bTaggedJetCSVHandle, event.m_jetMetadata, event.m_input)) : DefaultValues::UndefinedFloat;
 	});
-	LambdaNtupleConsumer<KappaTypes>::AddFloatQuantity("leadingBJetPuID",[jetPuJetIDName](KappaEvent const& event, KappaProduct const& product) {
-		return product.m_bTaggedJets.size() >= 1 ? static_cast<KJet*>(product.m_bTaggedJets.at(0))->getTag(jetPuJetIDName, event.m_jetMetadata) : DefaultValues::UndefinedFloat;
+	LambdaNtupleConsumer<KappaTypes>::AddFloatQuantity(settings, "leadingBJetPuID", [jetPuJetID, jetPuJetIDHandle](KappaEvent const& event, KappaProduct const& product) {
+		return product.m_bTaggedJets.size() >= 1 ? static_cast<KJet*>(product.m_bTaggedJets.at(0))->tags.at(jetPuJetID->GetIndex(jetPuJetIDHandle, event.m_jetMetadata, event.m_input)) : DefaultValues::UndefinedFloat;
 	});
-	LambdaNtupleConsumer<KappaTypes>::AddFloatQuantity("trailingBJetCSV",[bTaggedJetCSVName](KappaEvent const& event, KappaProduct const& product) {
-		return product.m_bTaggedJets.size() >= 2 ? static_cast<KJet*>(product.m_bTaggedJets.at(1))->getTag(bTaggedJetCSVName, event.m_jetMetadata) : DefaultValues::UndefinedFloat;
+	LambdaNtupleConsumer<KappaTypes>::AddFloatQuantity(settings, "trailingBJetCSV", [bTaggedJetCSV, bTaggedJetCSVHandle](KappaEvent const& event, KappaProduct const& product) {
+		return product.m_bTaggedJets.size() >= 2 ? static_cast<KJet*>(product.m_bTaggedJets.at(1))->tags.at(bTaggedJetCSV->GetIndex(bTaggedJetCSVHandle, event.m_jetMetadata, event.m_input)) : DefaultValues::UndefinedFloat;
 	});
-	LambdaNtupleConsumer<KappaTypes>::AddFloatQuantity("trailingBJetPuID",[jetPuJetIDName](KappaEvent const& event, KappaProduct const& product) {
-		return product.m_bTaggedJets.size() >= 2 ? static_cast<KJet*>(product.m_bTaggedJets.at(1))->getTag(jetPuJetIDName, event.m_jetMetadata) : DefaultValues::UndefinedFloat;
+	LambdaNtupleConsumer<KappaTypes>::AddFloatQuantity(settings, "trailingBJetPuID", [jetPuJetID, jetPuJetIDHandle](KappaEvent const& event, KappaProduct const& product) {
+		return product.m_bTaggedJets.size() >= 2 ? static_cast<KJet*>(product.m_bTaggedJets.at(1))->tags.at(jetPuJetID->GetIndex(jetPuJetIDHandle, event.m_jetMetadata, event.m_input)) : DefaultValues::UndefinedFloat;
 	});
 }
 
@@ -62,6 +73,7 @@ void ValidBTaggedJetsProducer::Produce(KappaEvent const& event, KappaProduct& pr
                                        KappaSettings const& settings) const
 {
 	assert(event.m_jetMetadata);
+	bTagger.Bind(event.m_jetMetadata, event.m_input);
 
 	for (std::vector<KBasicJet*>::iterator jet = product.m_validJets.begin();
 	     jet != product.m_validJets.end(); ++jet)
@@ -69,7 +81,7 @@ void ValidBTaggedJetsProducer::Produce(KappaEvent const& event, KappaProduct& pr
 		bool validBJet = true;
 		KJet* tjet = static_cast<KJet*>(*jet);
 
-		float combinedSecondaryVertex = tjet->getTag(settings.GetBTaggedJetCombinedSecondaryVertexName(), event.m_jetMetadata);
+		float combinedSecondaryVertex = tjet->tags[bTagger.GetIndex(bTaggerHandle)];
 
 		if (combinedSecondaryVertex < settings.GetBTaggedJetCombinedSecondaryVertexMediumWP() ||
 			std::abs(tjet->p4.eta()) > settings.GetBTaggedJetAbsEtaCut()) {
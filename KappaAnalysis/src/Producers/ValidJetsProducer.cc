@@ -14,7 +14,9 @@ std::string ValidJetsProducer::GetProducerId() const {
 
 ValidTaggedJetsProducer::ValidTaggedJetsProducer() : ValidJetsProducerBase<KJet, KBasicJet>(&KappaEvent::m_tjets,
                                                                                         &KappaProduct::m_correctedTaggedJets,
-                                                                                        &KappaProduct::m_validJets)
+                                                                                        &KappaProduct::m_validJets),
+	jetTaggers(&KJetMetadata::tagNames, "Jet tagger"),
+	jetIds(&KJetMetadata::idNames, "Jet ID")
 {
 }
 
@@ -41,29 +43,68 @@ void ValidTaggedJetsProducer::Init(KappaSettings const& settings)
 			jetTaggerUpperCutsByTaggerName
 	);
 	
+	// the names are resolved to indices for every input file
+	for (std::map<size_t, std::vector<std::string> >::const_iterator puJetIdByIndex = puJetIdsByIndex.begin();
+	     puJetIdByIndex != puJetIdsByIndex.end(); ++puJetIdByIndex)
+	{
+		puJetIdHandlesByIndex[puJetIdByIndex->first] = jetIds.Add(puJetIdByIndex->second);
+	}
+	
+	for (std::map<std::string, std::vector<std::string> >::const_iterator puJetIdByHltName = puJetIdsByHltName.begin();
+	     puJetIdByHltName != puJetIdsByHltName.end(); ++puJetIdByHltName)
+	{
+		if (puJetIdByHltName->first == "default")
+		{
+			std::vector<size_t> handles = jetIds.Add(puJetIdByHltName->second);
+			defaultPuJetIdHandles.insert(defaultPuJetIdHandles.end(), handles.begin(), handles.end());
+		}
+		else
+		{
+			LOG(FATAL) << "HLT name dependent PU Jet is not yet implemented!";
+		}
+	}
+	
+	for (std::map<std::string, std::vector<float> >::const_iterator jetTaggerLowerCut = jetTaggerLowerCutsByTaggerName.begin();
+	     jetTaggerLowerCut != jetTaggerLowerCutsByTaggerName.end(); ++jetTaggerLowerCut)
+	{
+		float maxLowerCut = *std::max_element(jetTaggerLowerCut->second.begin(), jetTaggerLowerCut->second.end());
+		jetTaggerLowerCuts.push_back(std::make_pair(jetTaggers.Add(jetTaggerLowerCut->first), maxLowerCut));
+	}
+	
+	for (std::map<std::string, std::vector<float> >::const_iterator jetTaggerUpperCut = jetTaggerUpperCutsByTaggerName.begin();
+	     jetTaggerUpperCut != jetTaggerUpperCutsByTaggerName.end(); ++jetTaggerUpperCut)
+	{
+		float minUpperCut = *std::min_element(jetTaggerUpperCut->second.begin(), jetTaggerUpperCut->second.end());
+		jetTaggerUpperCuts.push_back(std::make_pair(jetTaggers.Add(jetTaggerUpperCut->first), minUpperCut));
+	}
+	
 	// add possible quantities for the lambda ntuples consumers
-	std::string bTaggedJetCSVName = settings.GetBTaggedJetCombinedSecondaryVertexName();
-	std::string bTaggedJetTCHEName = settings.GetBTaggedJetTrackCountingHighEffName();
-	std::string jetPuJetIDName = settings.GetPuJetIDFullDiscrName();
+	// every tagger has its own binding, such that only the taggers of requested quantities need to be available
+	std::shared_ptr<MetadataNameBinding<KJetMetadata> > bTaggedJetCSV(new MetadataNameBinding<KJetMetadata>(&KJetMetadata::tagNames, "Jet tagger"));
+	size_t bTaggedJetCSVHandle = bTaggedJetCSV->Add(settings.GetBTaggedJetCombinedSecondaryVertexName());
+	std::shared_ptr<MetadataNameBinding<KJetMetadata> > bTaggedJetTCHE(new MetadataNameBinding<KJetMetadata>(&KJetMetadata::tagNames, "Jet tagger"));
+	size_t bTaggedJetTCHEHandle = bTaggedJetTCHE->Add(settings.GetBTaggedJetTrackCountingHighEffName());
+	std::shared_ptr<MetadataNameBinding<KJetMetadata> > jetPuJetID(new MetadataNameBinding<KJetMetadata>(&KJetMetadata::tagNames, "Jet tagger"));
+	size_t jetPuJetIDHandle = jetPuJetID->Add(settings.GetPuJetIDFullDiscrName());
 
-	LambdaNtupleConsumer<KappaTypes>::AddFloatQuantity("leadingJetCSV",[bTaggedJetCSVName](KappaEvent const& event, KappaProduct const& product) {
-		return product.m_validJets.size() >= 1 ? static_cast<KJet*>(product.m_validJets.at(0))->getTag(bTaggedJetCSVName, event.m_jetMetadata) : DefaultValues::UndefinedFloat;
+	LambdaNtupleConsumer<KappaTypes>::AddFloatQuantity(settings, "leadingJetCSV", [bTaggedJetCSV, bTaggedJetCSVHandle](KappaEvent const& event, KappaProduct const& product) {
+		return product.m_validJets.size() >= 1 ? static_cast<KJet*>(product.m_validJets.at(0))->tags.at(bTaggedJetCSV->GetIndex(bTaggedJetCSVHandle, event.m_jetMetadata, event.m_input)) : DefaultValues::UndefinedFloat;
 	} );
-	LambdaNtupleConsumer<KappaTypes>::AddFloatQuantity("leadingJetTCHE",[bTaggedJetTCHEName](KappaEvent const& event, KappaProduct const& product) {
-		return product.m_validJets.size() >= 1 ? static_cast<KJet*>(product.m_validJets.at(0))->getTag(bTaggedJetTCHEName, event.m_jetMetadata) : DefaultValues::UndefinedFloat;
+	LambdaNtupleConsumer<KappaTypes>::AddFloatQuantity(settings, "leadingJetTCHE", [bTaggedJetTCHE, bTaggedJetTCHEHandle](KappaEvent const& event, KappaProduct const& product) {
+		return product.m_validJets.size() >= 1 ? static_cast<KJet*>(product.m_validJets.at(0))->tags.at(bTaggedJetTCHE->GetIndex(bTaggedJetTCHEHandle, event.m_jetMetadata, event.m_input)) : DefaultValues::UndefinedFloat;
 	} );
-	LambdaNtupleConsumer<KappaTypes>::AddFloatQuantity("leadingJetPuID",[jetPuJetIDName](KappaEvent const& event, KappaProduct const& product) {
-		return product.m_validJets.size() >= 1 ? static_cast<KJet*>(product.m_validJets.at(0))->getTag(jetPuJetIDName, event.m_jetMetadata) : DefaultValues::UndefinedFloat;
+	LambdaNtupleConsumer<KappaTypes>::AddFloatQuantity(settings, "leadingJetPuID", [jetPuJetID, jetPuJetIDHandle](KappaEvent const& event, KappaProduct const& product) {
+		return product.m_validJets.size() >= 1 ? static_cast<KJet*>(product.m_validJets.at(0))->tags.at(jetPuJetID->GetIndex(jetPuJetIDHandle, event.m_jetMetadata, event.m_input)) : DefaultValues::UndefinedFloat;
 	} );
 	
-	LambdaNtupleConsumer<KappaTypes>::AddFloatQuantity("trailingJetCSV",[bTaggedJetCSVName](KappaEvent const& event, KappaProduct const& product) {
-		return product.m_validJets.size() >= 2 ? static_cast<KJet*>(product.m_validJets.at(1))->getTag(bTaggedJetCSVName, event.m_jetMetadata) : DefaultValues::UndefinedFloat;
+	LambdaNtupleConsumer<KappaTypes>::AddFloatQuantity(settings, "trailingJetCSV", [bTaggedJetCSV, bTaggedJetCSVHandle](KappaEvent const& event, KappaProduct const& product) {
+		return product.m_validJets.size() >= 2 ? static_cast<KJet*>(product.m_validJets.at(1))->tags.at(bTaggedJetCSV->GetIndex(bTaggedJetCSVHandle, event.m_jetMetadata, event.m_input)) : DefaultValues::UndefinedFloat;
 	} );
-	LambdaNtupleConsumer<KappaTypes>::AddFloatQuantity("trailingJetTCHE",[bTaggedJetTCHEName](KappaEvent const& event, KappaProduct const& product) {
-		return product.m_validJets.size() >= 2 ? static_cast<KJet*>(product.m_validJets.at(1))->getTag(bTaggedJetTCHEName, event.m_jetMetadata) : DefaultValues::UndefinedFloat;
+	LambdaNtupleConsumer<KappaTypes>::AddFloatQuantity(settings, "trailingJetTCHE", [bTaggedJetTCHE, bTaggedJetTCHEHandle](KappaEvent const& event, KappaProduct const& product) {
+		return product.m_validJets.size() >= 2 ? static_cast<KJet*>(product.m_validJets.at(1))->tags.at(bTaggedJetTCHE->GetIndex(bTaggedJetTCHEHandle, event.m_jetMetadata, event.m_input)) : DefaultValues::UndefinedFloat;
 	} );
-	LambdaNtupleConsumer<KappaTypes>::AddFloatQuantity("trailingJetPuID",[jetPuJetIDName](KappaEvent const& event, KappaProduct const& product) {
-		return product.m_validJets.size() >= 2 ? static_cast<KJet*>(product.m_validJets.at(1))->getTag(jetPuJetIDName, event.m_jetMetadata) : DefaultValues::UndefinedFloat;
+	LambdaNtupleConsumer<KappaTypes>::AddFloatQuantity(settings, "trailingJetPuID", [jetPuJetID, jetPuJetIDHandle](KappaEvent const& event, KappaProduct const& product) {
+		return product.m_validJets.size() >= 2 ? static_cast<KJet*>(product.m_validJets.at(1))->tags.at(jetPuJetID->GetIndex(jetPuJetIDHandle, event.m_jetMetadata, event.m_input)) : DefaultValues::UndefinedFloat;
 	} );
 }
 
@@ -75,55 +116,41 @@ bool ValidTaggedJetsProducer::AdditionalCriteria(KJet* jet, KappaEvent const& ev
 	
 	bool validJet = ValidJetsProducerBase<KJet, KBasicJet>::AdditionalCriteria(jet, event, product, settings);
 	
-	// PU Jet ID
-	for (std::map<size_t, std::vector<std::string> >::const_iterator puJetIdByIndex = puJetIdsByIndex.begin();
-	     puJetIdByIndex != puJetIdsByIndex.end() && validJet; ++puJetIdByIndex)
-	{
-		if (puJetIdByIndex->first == product.m_validJets.size())
-		{
-			validJet = validJet && PassPuJetIds(jet, puJetIdByIndex->second, event.m_jetMetadata);
-		}
-	}
+	jetTaggers.Bind(event.m_jetMetadata, event.m_input);
+	jetIds.Bind(event.m_jetMetadata, event.m_input);
 	
-	for (std::map<std::string, std::vector<std::string> >::const_iterator puJetIdByHltName = puJetIdsByHltName.begin();
-	     puJetIdByHltName != puJetIdsByHltName.end() && validJet; ++puJetIdByHltName)
+	// PU Jet ID
+	std::map<size_t, std::vector<size_t> >::const_iterator puJetIdHandlesForIndex = puJetIdHandlesByIndex.find(product.m_validJets.size());
+	if (puJetIdHandlesForIndex != puJetIdHandlesByIndex.end())
 	{
-		if (puJetIdByHltName->first == "default")
-		{
-			validJet = validJet && PassPuJetIds(jet, puJetIdByHltName->second, event.m_jetMetadata);
-		}
-		else
-		{
-			LOG(FATAL) << "HLT name dependent PU Jet is not yet implemented!";
-		}
+		validJet = validJet && PassPuJetIds(jet, puJetIdHandlesForIndex->second);
 	}
+	validJet = validJet && PassPuJetIds(jet, defaultPuJetIdHandles);
 	
 	// Jet taggers
-	for (std::map<std::string, std::vector<float> >::const_iterator jetTaggerLowerCut = jetTaggerLowerCutsByTaggerName.begin();
-	     jetTaggerLowerCut != jetTaggerLowerCutsByTaggerName.end() && validJet; ++jetTaggerLowerCut)
+	for (std::vector<std::pair<size_t, float> >::const_iterator jetTaggerLowerCut = jetTaggerLowerCuts.begin();
+	     jetTaggerLowerCut != jetTaggerLowerCuts.end() && validJet; ++jetTaggerLowerCut)
 	{
-		float maxLowerCut = *std::max_element(jetTaggerLowerCut->second.begin(), jetTaggerLowerCut->second.end());
-		validJet = validJet && jet->getTag(jetTaggerLowerCut->first, event.m_jetMetadata) > maxLowerCut;
+		validJet = validJet && jet->tags[jetTaggers.GetIndex(jetTaggerLowerCut->first)] > jetTaggerLowerCut->second;
 	}
 	
-	for (std::map<std::string, std::vector<float> >::const_iterator jetTaggerUpperCut = jetTaggerUpperCutsByTaggerName.begin();
-	     jetTaggerUpperCut != jetTaggerUpperCutsByTaggerName.end() && validJet; ++jetTaggerUpperCut)
+	for (std::vector<std::pair<size_t, float> >::const_iterator jetTaggerUpperCut = jetTaggerUpperCuts.begin();
+	     jetTaggerUpperCut != jetTaggerUpperCuts.end() && validJet; ++jetTaggerUpperCut)
 	{
-		float minUpperCut = *std::min_element(jetTaggerUpperCut->second.begin(), jetTaggerUpperCut->second.end());
-		validJet = validJet && jet->getTag(jetTaggerUpperCut->first, event.m_jetMetadata) < minUpperCut;
+		validJet = validJet && jet->tags[jetTaggers.GetIndex(jetTaggerUpperCut->first)] < jetTaggerUpperCut->second;
 	}
 	
 	return validJet;
 }
 
-bool ValidTaggedJetsProducer::PassPuJetIds(KJet* jet, std::vector<std::string> const& puJetIds, KJetMetadata* taggerMetadata) const
+bool ValidTaggedJetsProducer::PassPuJetIds(KJet* jet, std::vector<size_t> const& puJetIdHandles) const
 {
 	bool validJet = true;
 	
-	for (std::vector<std::string>::const_iterator puJetId = puJetIds.begin();
-	     puJetId != puJetIds.end() && validJet; ++puJetId)
+	for (std::vector<size_t>::const_iterator puJetIdHandle = puJetIdHandles.begin();
+	     puJetIdHandle != puJetIdHandles.end() && validJet; ++puJetIdHandle)
 	{
-		validJet = validJet && jet->getId(*puJetId, taggerMetadata);
+		validJet = validJet && MetadataNameBinding<KJetMetadata>::GetBit(jet->ids, jetIds.GetIndex(*puJetIdHandle));
 	}
 	
 	return validJet;
@@ -1,4 +1,5 @@
 #include "Artus/KappaAnalysis/interface/Utility/BTagCalibrationStandalone.h"
+#include "Artus/Utility/interface/RootFileHelper.h"
 #include <iostream>
 #include <exception>
 #include <algorithm>
@@ -435,6 +436,9 @@ throw std::exception();
     te.discrMin = be.params.discrMin;
     te.discrMax = be.params.discrMax;
 
+    // the functions are registered in the global list of ROOT, which is shared with the
+    // pipelines initialised in parallel
+    std::lock_guard<std::recursive_mutex> lock(RootFileHelper::GetRootMutex());
     if (op_ == BTagEntry::OP_RESHAPING) {
       te.func = TF1("", be.formula.c_str(),
                     be.params.discrMin, be.params.discrMax);
@@ -0,0 +1,79 @@
+
+#include <algorithm>
+#include <cmath>
+
+#include "Artus/KappaAnalysis/interface/Utility/EtaPhiIndex.h"
+
+
+namespace
+{
+	// the exact delta R is checked by the caller, the margin only covers rounding differences
+	const double DeltaRMargin = 1.0e-4;
+}
+
+void EtaPhiIndex::Clear()
+{
+	m_entries.clear();
+	m_unsortedIndices.clear();
+	m_built = false;
+}
+
+void EtaPhiIndex::Add(size_t index, float eta, float phi)
+{
+	if (std::isfinite(eta) && std::isfinite(phi))
+	{
+		Entry entry;
+		entry.eta = eta;
+		entry.phi = phi;
+		entry.index = index;
+		m_entries.push_back(entry);
+	}
+	else
+	{
+		m_unsortedIndices.push_back(index);
+	}
+}
+
+void EtaPhiIndex::Finalise()
+{
+	std::sort(m_entries.begin(), m_entries.end(),
+	          [](Entry const& entry1, Entry const& entry2) -> bool
+	          { return ((entry1.eta < entry2.eta) || ((entry1.eta == entry2.eta) && (entry1.index < entry2.index))); });
+	m_built = true;
+}
+
+void EtaPhiIndex::GetCandidates(float eta, float phi, float deltaRMax, std::vector<size_t>& indices) const
+{
+	indices.clear();
+
+	if (std::isfinite(eta) && std::isfinite(phi))
+	{
+		double window = deltaRMax + DeltaRMargin;
+		std::vector<Entry>::const_iterator entry = std::lower_bound(
+				m_entries.begin(), m_entries.end(), eta - window,
+				[](Entry const& entry, double etaMin) -> bool { return (entry.eta < etaMin); }
+		);
+		for (; (entry != m_entries.end()) && (entry->eta <= eta + window); ++entry)
+		{
+			double deltaEta = double(eta) - entry->eta;
+			double deltaPhi = std::fabs(std::remainder(double(phi) - entry->phi, 2.0 * M_PI));
+			if (((deltaEta * deltaEta) + (deltaPhi * deltaPhi)) <= (window * window))
+			{
+				indices.push_back(entry->index);
+			}
+		}
+		indices.insert(indices.end(), m_unsortedIndices.begin(), m_unsortedIndices.end());
+	}
+	else
+	{
+		// no pruning possible, the caller decides with the full collection
+		for (std::vector<Entry>::const_iterator entry = m_entries.begin(); entry != m_entries.end(); ++entry)
+		{
+			indices.push_back(entry->index);
+		}
+		indices.insert(indices.end(), m_unsortedIndices.begin(), m_unsortedIndices.end());
+	}
+
+	std::sort(indices.begin(), indices.end());
+}
+
@@ -0,0 +1,244 @@
+
+#include <cstdlib>
+
+#include "Artus/Utility/interface/ArtusLogging.h"
+#include "Artus/Utility/interface/DefaultValues.h"
+
+#include "Artus/KappaAnalysis/interface/Utility/GenDecayGraph.h"
+
+
+const size_t GenDecayGraph::NoNode = std::numeric_limits<size_t>::max();
+
+void GenDecayGraph::Build(KGenParticles& genParticles, GenParticleIndex const& genParticleIndex, int bosonPdgId, int bosonStatus)
+{
+	m_nodes.clear();
+	m_bosons.clear();
+	m_finalStates.clear();
+
+	GenParticleIndex::IndexRange bosonCandidates = genParticleIndex.GetByAbsPdgId(bosonPdgId);
+	for (GenParticleIndex::const_iterator bosonIndex = bosonCandidates.begin(); bosonIndex != bosonCandidates.end(); ++bosonIndex)
+	{
+		if (genParticles[*bosonIndex].status() != bosonStatus)
+		{
+			continue;
+		}
+
+		size_t boson = AddNode(genParticles, *bosonIndex, NoNode);
+		m_bosons.push_back(boson);
+		m_nodes[boson].finalState = genParticles[*bosonIndex].daughterIndices.empty();
+
+		GenParticleIndex::IndexRange bosonDaughters = genParticleIndex.GetDaughters(*bosonIndex);
+		std::vector<size_t> daughterIndices;
+		m_nodes[boson].firstDaughter = m_nodes.size();
+		for (GenParticleIndex::const_iterator daughterIndex = bosonDaughters.begin(); daughterIndex != bosonDaughters.end(); ++daughterIndex)
+		{
+			if (*daughterIndex < genParticles.size())
+			{
+				AddNode(genParticles, *daughterIndex, boson);
+				daughterIndices.push_back(*daughterIndex);
+			}
+			else
+			{
+				LOG(ERROR) << "Index larger than size of gen particle vector:" << *daughterIndex << ">" << genParticles.size() << ".";
+			}
+		}
+		m_nodes[boson].nDaughters = daughterIndices.size();
+
+		// the decay products of the boson daughters are taken from their first daughter
+		for (size_t daughter = 0; daughter < daughterIndices.size(); ++daughter)
+		{
+			size_t daughterNode = m_nodes[boson].firstDaughter + daughter;
+			if (genParticles[daughterIndices[daughter]].daughterIndices.empty())
+			{
+				m_nodes[daughterNode].finalState = true;
+			}
+			else
+			{
+				AddDaughters(genParticles, daughterNode, genParticles[daughterIndices[daughter]].daughterIndex(0));
+			}
+		}
+	}
+
+	// summaries of all subtrees
+	std::vector<size_t> finalStates;
+	for (size_t node = 0; node < m_nodes.size(); ++node)
+	{
+		finalStates.clear();
+		CollectFinalStates(node, finalStates);
+		m_nodes[node].firstFinalState = m_finalStates.size();
+		m_nodes[node].nFinalStates = finalStates.size();
+		m_nodes[node].nChargedFinalStates = 0;
+		for (std::vector<size_t>::const_iterator finalState = finalStates.begin(); finalState != finalStates.end(); ++finalState)
+		{
+			if ((m_nodes[*finalState].charge == 1) || (m_nodes[*finalState].charge == -1))
+			{
+				++m_nodes[node].nChargedFinalStates;
+			}
+		}
+		m_finalStates.insert(m_finalStates.end(), finalStates.begin(), finalStates.end());
+
+		DecayMode decayMode = DecayMode::NONE;
+		DetermineDecayMode(node, decayMode);
+		m_nodes[node].decayMode = decayMode;
+	}
+}
+
+GenDecayGraph::Node const* GenDecayGraph::GetNode(size_t bosonIndex) const
+{
+	return ((bosonIndex < m_bosons.size()) ? &(m_nodes[m_bosons[bosonIndex]]) : nullptr);
+}
+
+GenDecayGraph::Node const* GenDecayGraph::GetNode(size_t bosonIndex, size_t daughterIndex) const
+{
+	return GetDaughter(GetNode(bosonIndex), daughterIndex);
+}
+
+GenDecayGraph::Node const* GenDecayGraph::GetNode(size_t bosonIndex, size_t daughterIndex, size_t granddaughterIndex) const
+{
+	return GetDaughter(GetNode(bosonIndex, daughterIndex), granddaughterIndex);
+}
+
+GenDecayGraph::Node const* GenDecayGraph::GetNode(size_t bosonIndex, size_t daughterIndex, size_t granddaughterIndex,
+                                                  size_t grandGranddaughterIndex) const
+{
+	return GetDaughter(GetNode(bosonIndex, daughterIndex, granddaughterIndex), grandGranddaughterIndex);
+}
+
+GenDecayGraph::Node const* GenDecayGraph::GetDaughter(Node const* node, size_t daughterIndex) const
+{
+	return (((node != nullptr) && (daughterIndex < node->nDaughters)) ? &(m_nodes[node->firstDaughter + daughterIndex]) : nullptr);
+}
+
+int GenDecayGraph::GetProngSize(Node const& node)
+{
+	return (((node.nChargedFinalStates == 1) || (node.nChargedFinalStates == 3) || (node.nChargedFinalStates == 5)) ?
+	        static_cast<int>(node.nChargedFinalStates) : -1);
+}
+
+int GenDecayGraph::GetCharge(int pdgId)
+{
+	int absPdgId = std::abs(pdgId);
+	if ((absPdgId == DefaultValues::pdgIdElectron) || (absPdgId == DefaultValues::pdgIdMuon) || (absPdgId == DefaultValues::pdgIdTau))
+	{
+		return ((pdgId > 0) ? -1 : 1);
+	}
+	else if ((absPdgId == DefaultValues::pdgIdW) || (absPdgId == DefaultValues::pdgIdPiPlus) ||
+	         (absPdgId == DefaultValues::pdgIdRhoPlus770) || (absPdgId == DefaultValues::pdgIdKPlus) ||
+	         (absPdgId == DefaultValues::pdgIdKStar) || (absPdgId == DefaultValues::pdgIdAOnePlus1260))
+	{
+		return ((pdgId > 0) ? 1 : -1);
+	}
+	else if ((absPdgId == DefaultValues::pdgIdNuE) || (absPdgId == DefaultValues::pdgIdNuMu) ||
+	         (absPdgId == DefaultValues::pdgIdNuTau) || (pdgId == DefaultValues::pdgIdGamma) ||
+	         (pdgId == DefaultValues::pdgIdPiZero) || (pdgId == DefaultValues::pdgIdKLong) ||
+	         (pdgId == DefaultValues::pdgIdEta) || (pdgId == DefaultValues::pdgIdKShort))
+	{
+		return 0;
+	}
+	return 5;
+}
+
+bool GenDecayGraph::IsDetectable(int pdgId)
+{
+	int absPdgId = std::abs(pdgId);
+	return ((pdgId == DefaultValues::pdgIdGamma) || (absPdgId == DefaultValues::pdgIdPiPlus) ||
+	        (absPdgId == DefaultValues::pdgIdElectron) || (absPdgId == DefaultValues::pdgIdMuon) ||
+	        (absPdgId == DefaultValues::pdgIdTau));
+}
+
+size_t GenDecayGraph::AddNode(KGenParticles& genParticles, size_t particleIndex, size_t parent)
+{
+	Node node;
+	node.particle = &(genParticles[particleIndex]);
+	node.parent = parent;
+	node.firstDaughter = 0;
+	node.nDaughters = 0;
+	node.charge = GetCharge(node.particle->pdgId());
+	node.detectable = IsDetectable(node.particle->pdgId());
+	node.finalState = false;
+	node.firstFinalState = 0;
+	node.nFinalStates = 0;
+	node.nChargedFinalStates = 0;
+	node.decayMode = DecayMode::NONE;
+	m_nodes.push_back(node);
+	return (m_nodes.size() - 1);
+}
+
+// adds all daughters of a gen particle as daughters of the node, recursively
+void GenDecayGraph::AddDaughters(KGenParticles& genParticles, size_t node, size_t particleIndex)
+{
+	KGenParticle const& particle = genParticles.at(particleIndex);
+
+	std::vector<size_t> daughterIndices;
+	m_nodes[node].firstDaughter = m_nodes.size();
+	for (std::vector<unsigned int>::const_iterator daughterIndex = particle.daughterIndices.begin();
+	     daughterIndex != particle.daughterIndices.end(); ++daughterIndex)
+	{
+		if (*daughterIndex < genParticles.size())
+		{
+			AddNode(genParticles, *daughterIndex, node);
+			daughterIndices.push_back(*daughterIndex);
+		}
+		else
+		{
+			LOG(ERROR) << "Index larger than size of gen particle vector:" << *daughterIndex << ">" << genParticles.size() << ".";
+		}
+	}
+	m_nodes[node].nDaughters = daughterIndices.size();
+
+	for (size_t daughter = 0; daughter < daughterIndices.size(); ++daughter)
+	{
+		size_t daughterNode = m_nodes[node].firstDaughter + daughter;
+		if (genParticles[daughterIndices[daughter]].daughterIndices.empty())
+		{
+			m_nodes[daughterNode].finalState = true;
+		}
+		else
+		{
+			AddDaughters(genParticles, daughterNode, daughterIndices[daughter]);
+		}
+	}
+}
+
+void GenDecayGraph::CollectFinalStates(size_t node, std::vector<size_t>& finalStates) const
+{
+	if (m_nodes[node].finalState)
+	{
+		finalStates.push_back(node);
+	}
+	else
+	{
+		for (size_t daughter = 0; daughter < m_nodes[node].nDaughters; ++daughter)
+		{
+			CollectFinalStates(m_nodes[node].firstDaughter + daughter, finalStates);
+		}
+	}
+}
+
+// the decay mode is given by the last known decay product in the first generation with known decay products
+void GenDecayGraph::DetermineDecayMode(size_t node, DecayMode& decayMode) const
+{
+	for (size_t daughter = 0; daughter < m_nodes[node].nDaughters; ++daughter)
+	{
+		size_t daughterNode = m_nodes[node].firstDaughter + daughter;
+		UpdateDecayMode(m_nodes[daughterNode].particle->pdgId(), decayMode);
+		if (decayMode == DecayMode::NONE)
+		{
+			DetermineDecayMode(daughterNode, decayMode);
+		}
+	}
+}
+
+void GenDecayGraph::UpdateDecayMode(int pdgId, DecayMode& decayMode)
+{
+	int absPdgId = std::abs(pdgId);
+	if (absPdgId == DefaultValues::pdgIdTau) decayMode = DecayMode::TAU;
+	else if (absPdgId == DefaultValues::pdgIdPiPlus) decayMode = DecayMode::PI;
+	else if (absPdgId == DefaultValues::pdgIdKPlus) decayMode = DecayMode::KPLUS;
+	else if (absPdgId == DefaultValues::pdgIdKStar) decayMode = DecayMode::KSTAR;
+	else if (absPdgId == DefaultValues::pdgIdRhoPlus770) decayMode = DecayMode::RHO;
+	else if (absPdgId == DefaultValues::pdgIdAOnePlus1260) decayMode = DecayMode::AONE;
+	else if (absPdgId == DefaultValues::pdgIdMuon) decayMode = DecayMode::M;
+	else if (absPdgId == DefaultValues::pdgIdElectron) decayMode = DecayMode::E;
+}
+
@@ -0,0 +1,134 @@
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "Artus/KappaAnalysis/interface/Utility/GenParticleIndex.h"
+
+
+void GenParticleIndex::KeyedIndices::Clear()
+{
+	m_keys.clear();
+	m_offsets.clear();
+	m_indices.clear();
+}
+
+void GenParticleIndex::KeyedIndices::Build(std::vector<int> const& keyPerParticle)
+{
+	m_keys = keyPerParticle;
+	std::sort(m_keys.begin(), m_keys.end());
+	m_keys.erase(std::unique(m_keys.begin(), m_keys.end()), m_keys.end());
+
+	// count the particles per key and fill them in the order of the collection
+	m_offsets.assign(m_keys.size() + 1, 0);
+	std::vector<size_t> keyIndexPerParticle(keyPerParticle.size());
+	for (size_t index = 0; index < keyPerParticle.size(); ++index)
+	{
+		keyIndexPerParticle[index] = (std::lower_bound(m_keys.begin(), m_keys.end(), keyPerParticle[index]) - m_keys.begin());
+		++m_offsets[keyIndexPerParticle[index] + 1];
+	}
+	for (size_t keyIndex = 0; keyIndex < m_keys.size(); ++keyIndex)
+	{
+		m_offsets[keyIndex + 1] += m_offsets[keyIndex];
+	}
+
+	m_indices.resize(keyPerParticle.size());
+	std::vector<size_t> nextPosition(m_offsets.begin(), m_offsets.end() - 1);
+	for (size_t index = 0; index < keyPerParticle.size(); ++index)
+	{
+		m_indices[nextPosition[keyIndexPerParticle[index]]++] = index;
+	}
+}
+
+GenParticleIndex::IndexRange GenParticleIndex::KeyedIndices::Get(int key) const
+{
+	std::vector<int>::const_iterator keyPosition = std::lower_bound(m_keys.begin(), m_keys.end(), key);
+	if ((keyPosition == m_keys.end()) || (*keyPosition != key))
+	{
+		return IndexRange(m_indices.end(), m_indices.end());
+	}
+	size_t keyIndex = (keyPosition - m_keys.begin());
+	return IndexRange(m_indices.begin() + m_offsets[keyIndex], m_indices.begin() + m_offsets[keyIndex + 1]);
+}
+
+void GenParticleIndex::Clear()
+{
+	m_byAbsPdgId.Clear();
+	m_byStatus.Clear();
+	m_daughterOffsets.clear();
+	m_daughters.clear();
+	m_motherOffsets.clear();
+	m_mothers.clear();
+	m_built = false;
+}
+
+void GenParticleIndex::Build(KGenParticles const& genParticles)
+{
+	Clear();
+	size_t nGenParticles = genParticles.size();
+
+	std::vector<int> absPdgIds(nGenParticles);
+	std::vector<int> statuses(nGenParticles);
+	m_daughterOffsets.assign(nGenParticles + 1, 0);
+	m_motherOffsets.assign(nGenParticles + 1, 0);
+	for (size_t index = 0; index < nGenParticles; ++index)
+	{
+		KGenParticle const& genParticle = genParticles[index];
+		absPdgIds[index] = std::abs(genParticle.pdgId());
+		statuses[index] = genParticle.status();
+
+		m_daughters.insert(m_daughters.end(), genParticle.daughterIndices.begin(), genParticle.daughterIndices.end());
+		m_daughterOffsets[index + 1] = m_daughters.size();
+		for (std::vector<unsigned int>::const_iterator daughterIndex = genParticle.daughterIndices.begin();
+		     daughterIndex != genParticle.daughterIndices.end(); ++daughterIndex)
+		{
+			if (*daughterIndex < nGenParticles)
+			{
+				++m_motherOffsets[*daughterIndex + 1];
+			}
+		}
+	}
+
+	m_byAbsPdgId.Build(absPdgIds);
+	m_byStatus.Build(statuses);
+
+	// mothers in the order of the collection
+	for (size_t index = 0; index < nGenParticles; ++index)
+	{
+		m_motherOffsets[index + 1] += m_motherOffsets[index];
+	}
+	m_mothers.resize(m_motherOffsets.back());
+	std::vector<size_t> nextPosition(m_motherOffsets.begin(), m_motherOffsets.end() - 1);
+	for (size_t index = 0; index < nGenParticles; ++index)
+	{
+		for (size_t daughterPosition = m_daughterOffsets[index]; daughterPosition < m_daughterOffsets[index + 1]; ++daughterPosition)
+		{
+			if (m_daughters[daughterPosition] < nGenParticles)
+			{
+				m_mothers[nextPosition[m_daughters[daughterPosition]]++] = index;
+			}
+		}
+	}
+
+	m_built = true;
+}
+
+GenParticleIndex::IndexRange GenParticleIndex::GetByAbsPdgId(int absPdgId) const
+{
+	return m_byAbsPdgId.Get(absPdgId);
+}
+
+GenParticleIndex::IndexRange GenParticleIndex::GetByStatus(int status) const
+{
+	return m_byStatus.Get(status);
+}
+
+GenParticleIndex::IndexRange GenParticleIndex::GetDaughters(size_t index) const
+{
+	return IndexRange(m_daughters.begin() + m_daughterOffsets.at(index), m_daughters.begin() + m_daughterOffsets.at(index + 1));
+}
+
+GenParticleIndex::IndexRange GenParticleIndex::GetMothers(size_t index) const
+{
+	return IndexRange(m_mothers.begin() + m_motherOffsets.at(index), m_mothers.begin() + m_motherOffsets.at(index + 1));
+}
+
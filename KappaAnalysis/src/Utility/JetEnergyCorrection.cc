@@ -0,0 +1,310 @@
+
+#include <algorithm>
+
+#include <boost/regex.hpp>
+
+#include "Artus/Utility/interface/ArtusLogging.h"
+
+#include "Artus/KappaAnalysis/interface/Utility/JetEnergyCorrection.h"
+
+
+JetCorrectionInputs::Variable JetCorrectionInputs::GetVariable(std::string const& name)
+{
+	if (name == "JetPt")
+	{
+		return Variable::JetPt;
+	}
+	else if (name == "JetEta")
+	{
+		return Variable::JetEta;
+	}
+	else if (name == "JetPhi")
+	{
+		return Variable::JetPhi;
+	}
+	else if (name == "JetE")
+	{
+		return Variable::JetE;
+	}
+	else if (name == "JetA")
+	{
+		return Variable::JetA;
+	}
+	else if (name == "Rho")
+	{
+		return Variable::Rho;
+	}
+	else if (name == "NPV")
+	{
+		return Variable::NPV;
+	}
+	LOG(FATAL) << "The jet correction variable \"" << name << "\" is not supported!";
+	return Variable::JetPt;
+}
+
+
+JetCorrectionTable::JetCorrectionTable(JetCorrectorParameters const& parameters)
+{
+	JetCorrectorParameters::Definitions const& definitions = parameters.definitions();
+	for (unsigned int binVariableIndex = 0; binVariableIndex < definitions.nBinVar(); ++binVariableIndex)
+	{
+		m_binVariables.push_back(JetCorrectionInputs::GetVariable(definitions.binVar(binVariableIndex)));
+	}
+	for (unsigned int parameterVariableIndex = 0; parameterVariableIndex < definitions.nParVar(); ++parameterVariableIndex)
+	{
+		m_parameterVariables.push_back(JetCorrectionInputs::GetVariable(definitions.parVar(parameterVariableIndex)));
+	}
+
+	m_parameterOffsets.push_back(0);
+	for (unsigned int recordIndex = 0; recordIndex < parameters.size(); ++recordIndex)
+	{
+		JetCorrectorParameters::Record const& record = parameters.record(recordIndex);
+		for (unsigned int binVariableIndex = 0; binVariableIndex < m_binVariables.size(); ++binVariableIndex)
+		{
+			m_xMin.push_back(record.xMin(binVariableIndex));
+			m_xMax.push_back(record.xMax(binVariableIndex));
+		}
+		if (record.nParameters() < (2 * m_parameterVariables.size()))
+		{
+			LOG(FATAL) << "Record " << recordIndex << " of the jet corrections of level " << definitions.level()
+			           << " has " << record.nParameters() << " parameters, but the ranges of the "
+			           << m_parameterVariables.size() << " parameter variables need " << (2 * m_parameterVariables.size()) << "!";
+		}
+		for (unsigned int parameterIndex = 0; parameterIndex < record.nParameters(); ++parameterIndex)
+		{
+			m_parameters.push_back(record.parameter(parameterIndex));
+		}
+		m_parameterOffsets.push_back(m_parameters.size());
+	}
+
+	// bisection finds the same record as the linear search only for ordered bins without overlaps
+	m_bisection = (m_binVariables.size() == 1);
+	for (size_t recordIndex = 1; m_bisection && (recordIndex < m_xMin.size()); ++recordIndex)
+	{
+		m_bisection = (m_xMax[recordIndex - 1] <= m_xMin[recordIndex]);
+	}
+}
+
+int JetCorrectionTable::FindRecord(JetCorrectionInputs const& jets, size_t jetIndex) const
+{
+	if (m_bisection)
+	{
+		float const x = jets.GetValue(m_binVariables[0], jetIndex);
+		size_t const recordIndex = static_cast<size_t>(std::upper_bound(m_xMin.begin(), m_xMin.end(), x) - m_xMin.begin());
+		return (((recordIndex > 0) && (x < m_xMax[recordIndex - 1])) ? static_cast<int>(recordIndex - 1) : -1);
+	}
+
+	size_t const nBinVariables = m_binVariables.size();
+	for (size_t recordIndex = 0; recordIndex < GetNRecords(); ++recordIndex)
+	{
+		bool inside = true;
+		for (size_t binVariableIndex = 0; inside && (binVariableIndex < nBinVariables); ++binVariableIndex)
+		{
+			float const x = jets.GetValue(m_binVariables[binVariableIndex], jetIndex);
+			inside = ((x >= m_xMin[(recordIndex * nBinVariables) + binVariableIndex]) &&
+			          (x < m_xMax[(recordIndex * nBinVariables) + binVariableIndex]));
+		}
+		if (inside)
+		{
+			return static_cast<int>(recordIndex);
+		}
+	}
+	return -1;
+}
+
+
+JetEnergyCorrection::Level::Level(JetCorrectorParameters const& parameters) :
+	table(parameters)
+{
+	JetCorrectorParameters::Definitions const& definitions = parameters.definitions();
+	if (definitions.isResponse())
+	{
+		LOG(FATAL) << "Jet corrections of level " << definitions.level() << " defined as response are not supported!";
+	}
+
+	std::vector<std::string> variableNames;
+	formula = Expression(JetEnergyCorrection::TranslateFormula(definitions.formula()), variableNames);
+
+	static const std::string parameterVariableNames = "xyzt";
+	size_t const nParameterVariables = table.GetParameterVariables().size();
+	for (std::vector<std::string>::const_iterator variableName = variableNames.begin();
+	     variableName != variableNames.end(); ++variableName)
+	{
+		if ((variableName->size() == 1) && (parameterVariableNames.find(*variableName) < nParameterVariables))
+		{
+			variableSources.push_back(parameterVariableNames.find(*variableName));
+			variableIsParameter.push_back(false);
+		}
+		else if ((variableName->size() > 1) && ((*variableName)[0] == 'p') &&
+		         (variableName->find_first_not_of("0123456789", 1) == std::string::npos))
+		{
+			// the first parameters of each record are the ranges of the parameter variables
+			variableSources.push_back((2 * nParameterVariables) + std::stoul(variableName->substr(1)));
+			variableIsParameter.push_back(true);
+		}
+		else
+		{
+			LOG(FATAL) << "Unknown variable \"" << *variableName << "\" in the jet correction formula \""
+			           << definitions.formula() << "\" of level " << definitions.level() << "!";
+		}
+	}
+}
+
+JetEnergyCorrection::JetEnergyCorrection(std::vector<JetCorrectorParameters> const& levels)
+{
+	for (std::vector<JetCorrectorParameters>::const_iterator level = levels.begin(); level != levels.end(); ++level)
+	{
+		m_levels.push_back(Level(*level));
+	}
+}
+
+void JetEnergyCorrection::GetCorrections(JetCorrectionInputs const& jets, float* factors) const
+{
+	size_t const nJets = jets.size;
+	std::fill(factors, factors + nJets, 1.0f);
+	if (nJets == 0)
+	{
+		return;
+	}
+
+	// pt and energy corrected by the previous levels
+	std::vector<float> pt(jets.pt, jets.pt + nJets);
+	std::vector<float> energy(jets.energy, jets.energy + nJets);
+	JetCorrectionInputs correctedJets = jets;
+	correctedJets.pt = pt.data();
+	correctedJets.energy = energy.data();
+
+	std::vector<int> records(nJets, -1);
+	std::vector<double> columns;
+	std::vector<double const*> variableValues;
+	std::vector<double> scales(nJets, 1.0);
+
+	for (std::vector<Level>::const_iterator level = m_levels.begin(); level != m_levels.end(); ++level)
+	{
+		JetCorrectionTable const& table = level->table;
+		for (size_t jetIndex = 0; jetIndex < nJets; ++jetIndex)
+		{
+			records[jetIndex] = table.FindRecord(correctedJets, jetIndex);
+		}
+
+		// one column per variable of the formula with the clamped variables or the parameters of the jets
+		size_t const nVariables = level->variableSources.size();
+		columns.assign(std::max(nVariables, size_t(1)) * nJets, 0.0);
+		variableValues.assign(nVariables, nullptr);
+		for (size_t variableIndex = 0; variableIndex < nVariables; ++variableIndex)
+		{
+			double* column = &(columns[variableIndex * nJets]);
+			variableValues[variableIndex] = column;
+			size_t const source = level->variableSources[variableIndex];
+			for (size_t jetIndex = 0; jetIndex < nJets; ++jetIndex)
+			{
+				if (records[jetIndex] < 0)
+				{
+					continue;
+				}
+				size_t const recordIndex = static_cast<size_t>(records[jetIndex]);
+				float const* parameters = table.GetParameters(recordIndex);
+				if (level->variableIsParameter[variableIndex])
+				{
+					column[jetIndex] = ((source < table.GetNParameters(recordIndex)) ? parameters[source] : 0.0f);
+				}
+				else
+				{
+					float const x = correctedJets.GetValue(table.GetParameterVariables()[source], jetIndex);
+					column[jetIndex] = std::max(std::min(x, parameters[(2 * source) + 1]), parameters[2 * source]);
+				}
+			}
+		}
+		level->formula.EvaluateBatch(variableValues, nJets, scales.data());
+
+		for (size_t jetIndex = 0; jetIndex < nJets; ++jetIndex)
+		{
+			float const scale = ((records[jetIndex] < 0) ? 1.0f : static_cast<float>(scales[jetIndex]));
+			factors[jetIndex] *= scale;
+			pt[jetIndex] *= scale;
+			energy[jetIndex] *= scale;
+		}
+	}
+}
+
+std::string JetEnergyCorrection::TranslateFormula(std::string const& formula)
+{
+	static const std::vector<std::pair<std::string, std::string> > functions = {
+		{ "TMath::Log10", "log10" }, { "TMath::Log", "log" }, { "TMath::Exp", "exp" }, { "TMath::Power", "pow" },
+		{ "TMath::Max", "max" }, { "TMath::Min", "min" }, { "TMath::Abs", "abs" }, { "TMath::Sqrt", "sqrt" }
+	};
+
+	std::string translation = formula;
+	for (std::vector<std::pair<std::string, std::string> >::const_iterator function = functions.begin();
+	     function != functions.end(); ++function)
+	{
+		translation = boost::regex_replace(translation, boost::regex("\\b" + function->first + "\\s*\\("), function->second + "(");
+	}
+	translation = boost::regex_replace(translation, boost::regex("\\bfabs\\s*\\("), "abs(");
+	translation = boost::regex_replace(translation, boost::regex("\\[(\\d+)\\]"), "p$1");
+	return translation;
+}
+
+
+JetEnergyCorrectionUncertainty::JetEnergyCorrectionUncertainty(JetCorrectorParameters const& parameters) :
+	m_table(parameters)
+{
+	if (m_table.GetParameterVariables().empty())
+	{
+		LOG(FATAL) << "Jet energy correction uncertainties need a parameter variable!";
+	}
+	for (size_t recordIndex = 0; recordIndex < m_table.GetNRecords(); ++recordIndex)
+	{
+		if ((m_table.GetNParameters(recordIndex) % 3 != 0) || (m_table.GetNParameters(recordIndex) < 6))
+		{
+			LOG(FATAL) << "Jet energy correction uncertainties need at least two triplets of parameters per bin!";
+		}
+	}
+}
+
+size_t JetEnergyCorrectionUncertainty::GetUncertainties(JetCorrectionInputs const& jets, bool up, float* uncertainties) const
+{
+	size_t const valueOffset = (up ? 1 : 2);
+	size_t nJetsOutsideBins = 0;
+	for (size_t jetIndex = 0; jetIndex < jets.size; ++jetIndex)
+	{
+		int const record = m_table.FindRecord(jets, jetIndex);
+		if (record < 0)
+		{
+			uncertainties[jetIndex] = 0.0f;
+			++nJetsOutsideBins;
+			continue;
+		}
+		size_t const recordIndex = static_cast<size_t>(record);
+		float const* parameters = m_table.GetParameters(recordIndex);
+		size_t const nPoints = m_table.GetNParameters(recordIndex) / 3;
+		float const x = jets.GetValue(m_table.GetParameterVariables()[0], jetIndex);
+
+		if (x <= parameters[0])
+		{
+			uncertainties[jetIndex] = parameters[valueOffset];
+		}
+		else if (x >= parameters[3 * (nPoints - 1)])
+		{
+			uncertainties[jetIndex] = parameters[(3 * (nPoints - 1)) + valueOffset];
+		}
+		else
+		{
+			// linear interpolation between the points below and above
+			size_t point = 0;
+			while (parameters[3 * (point + 1)] <= x)
+			{
+				++point;
+			}
+			float const x0 = parameters[3 * point];
+			float const x1 = parameters[3 * (point + 1)];
+			float const y0 = parameters[(3 * point) + valueOffset];
+			float const y1 = parameters[(3 * (point + 1)) + valueOffset];
+			float const slope = (y1 - y0) / (x1 - x0);
+			float const offset = ((y0 * x1) - (y1 * x0)) / (x1 - x0);
+			uncertainties[jetIndex] = (slope * x) + offset;
+		}
+	}
+	return nJetsOutsideBins;
+}
+
@@ -0,0 +1,57 @@
+
+#include <cmath>
+
+#include "Artus/KappaAnalysis/interface/Utility/PhysicsObjectArrays.h"
+
+
+void PhysicsObjectArrays::Clear()
+{
+	m_pt.clear();
+	m_eta.clear();
+	m_phi.clear();
+	m_mass.clear();
+	m_energy.clear();
+	m_charge.clear();
+	m_built = false;
+}
+
+Kinematics::Objects PhysicsObjectArrays::GetObjects() const
+{
+	return Kinematics::Objects(m_pt.data(), m_eta.data(), m_phi.data(), m_mass.data(), m_pt.size());
+}
+
+void PhysicsObjectArrays::PassKinematicCuts(float ptMin, float absEtaMax, std::vector<unsigned char>& passes) const
+{
+	passes.resize(m_pt.size());
+	float const* pt = m_pt.data();
+	float const* eta = m_eta.data();
+	unsigned char* pass = passes.data();
+
+	// same comparisons as the checks for failing objects in ValidPhysicsObjectTools, such that NaN passes
+#pragma GCC ivdep
+	for (size_t index = 0; index < m_pt.size(); ++index)
+	{
+		pass[index] = static_cast<unsigned char>((! (pt[index] < ptMin)) & (! (std::abs(eta[index]) > absEtaMax)));
+	}
+}
+
+void PhysicsObjectArrays::Reserve(size_t size)
+{
+	m_pt.reserve(size);
+	m_eta.reserve(size);
+	m_phi.reserve(size);
+	m_mass.reserve(size);
+	m_energy.reserve(size);
+	m_charge.reserve(size);
+}
+
+void PhysicsObjectArrays::Add(RMFLV const& p4, int charge)
+{
+	m_pt.push_back(p4.Pt());
+	m_eta.push_back(p4.Eta());
+	m_phi.push_back(p4.Phi());
+	m_mass.push_back(p4.M());
+	m_energy.push_back(p4.E());
+	m_charge.push_back(charge);
+}
+
@@ -0,0 +1,72 @@
+
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+#include "Artus/KappaAnalysis/interface/Utility/TriggerMatchResults.h"
+
+
+namespace
+{
+	// the names are stored in a deque, such that references to them stay valid
+	struct InternedNames
+	{
+		std::unordered_map<std::string, size_t> ids;
+		std::deque<std::string> names;
+
+		size_t GetId(std::string const& name)
+		{
+			std::unordered_map<std::string, size_t>::const_iterator id = ids.find(name);
+			if (id != ids.end())
+			{
+				return id->second;
+			}
+			names.push_back(name);
+			ids[name] = names.size() - 1;
+			return names.size() - 1;
+		}
+	};
+
+	std::mutex & GetMutex()
+	{
+		static std::mutex mutex;
+		return mutex;
+	}
+
+	InternedNames & GetHltNames()
+	{
+		static InternedNames hltNames;
+		return hltNames;
+	}
+
+	InternedNames & GetFilterNames()
+	{
+		static InternedNames filterNames;
+		return filterNames;
+	}
+}
+
+size_t TriggerMatchNames::GetHltId(std::string const& hltName)
+{
+	std::lock_guard<std::mutex> lock(GetMutex());
+	return GetHltNames().GetId(hltName);
+}
+
+size_t TriggerMatchNames::GetFilterId(std::string const& filterName)
+{
+	std::lock_guard<std::mutex> lock(GetMutex());
+	return GetFilterNames().GetId(filterName);
+}
+
+std::string const& TriggerMatchNames::GetHltName(size_t hltId)
+{
+	std::lock_guard<std::mutex> lock(GetMutex());
+	return GetHltNames().names.at(hltId);
+}
+
+std::string const& TriggerMatchNames::GetFilterName(size_t filterId)
+{
+	std::lock_guard<std::mutex> lock(GetMutex());
+	return GetFilterNames().names.at(filterId);
+}
+
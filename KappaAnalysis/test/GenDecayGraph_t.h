@@ -0,0 +1,287 @@
+/* Copyright (c) 2013 - All Rights Reserved
+ *   Thomas Hauth  <Thomas.Hauth@cern.ch>
+ *   Joram Berger  <Joram.Berger@cern.ch>
+ *   Dominik Haitz <Dominik.Haitz@kit.edu>
+ */
+
+#pragma once
+
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include <boost/test/included/unit_test.hpp>
+
+#include "Artus/Utility/interface/DefaultValues.h"
+#include "Artus/Utility/interface/Utility.h"
+
+#include "Artus/KappaAnalysis/interface/MotherDaughterBundle.h"
+#include "Artus/KappaAnalysis/interface/Utility/GenDecayGraph.h"
+#include "Artus/KappaAnalysis/interface/Utility/GenParticleIndex.h"
+
+/**
+   Random decay records of bosons into taus with their decay products, including bosons without
+   or with a single daughter, boson daughters decaying directly without an intermediate copy and
+   unrelated particles.
+*/
+class GenDecayTestRecord
+{
+public:
+	GenDecayTestRecord(std::mt19937& generator) : m_generator(generator)
+	{
+		size_t nQuarks = Uniform(0, 3);
+		for (size_t quark = 0; quark < nQuarks; ++quark)
+		{
+			AddParticle((Uniform(0, 1) == 0 ? 1 : -1) * static_cast<int>(Uniform(1, 5)), 3);
+		}
+
+		size_t nBosons = Uniform(0, 2);
+		for (size_t boson = 0; boson < nBosons; ++boson)
+		{
+			size_t bosonIndex = AddParticle(DefaultValues::pdgIdH, (Uniform(0, 4) == 0) ? 2 : 3);
+			size_t nDaughters = Uniform(0, 4);
+			for (size_t daughter = 0; daughter < nDaughters; ++daughter)
+			{
+				// the status 2 copy of a boson is also stored as its daughter
+				size_t daughterIndex = ((daughter == 2) ?
+				                        AddParticle(DefaultValues::pdgIdH, 2) :
+				                        AddParticle(((daughter % 2) == 0 ? 1 : -1) * DefaultValues::pdgIdTau, 3));
+				AddDaughter(bosonIndex, daughterIndex);
+				if (std::abs(Particle(daughterIndex).pdgId()) != DefaultValues::pdgIdTau)
+				{
+					continue;
+				}
+
+				if (Uniform(0, 5) > 0)
+				{
+					size_t copyIndex = AddParticle(Particle(daughterIndex).pdgId(), 2);
+					AddDaughter(daughterIndex, copyIndex);
+					Decay(copyIndex);
+				}
+				else
+				{
+					Decay(daughterIndex);
+				}
+			}
+		}
+	}
+
+	KGenParticles& GetParticles()
+	{
+		return m_particles;
+	}
+
+private:
+	std::mt19937& m_generator;
+	KGenParticles m_particles;
+
+	size_t Uniform(size_t min, size_t max)
+	{
+		return std::uniform_int_distribution<size_t>(min, max)(m_generator);
+	}
+
+	KGenParticle const& Particle(size_t index) const
+	{
+		return m_particles[index];
+	}
+
+	// Kappa stores |pdgId| in the bits 0-23, the status in the bits 24-30 and the sign of the pdgId in bit 31
+	size_t AddParticle(int pdgId, int status)
+	{
+		KGenParticle particle;
+		particle.particleinfo = (static_cast<unsigned int>(std::abs(pdgId)) | (static_cast<unsigned int>(status) << 24) |
+		                         ((pdgId < 0) ? (1u << 31) : 0u));
+		BOOST_REQUIRE_EQUAL(particle.pdgId(), pdgId);
+		BOOST_REQUIRE_EQUAL(particle.status(), status);
+		m_particles.push_back(particle);
+		return (m_particles.size() - 1);
+	}
+
+	void AddDaughter(size_t mother, size_t daughter)
+	{
+		m_particles[mother].daughterIndices.push_back(static_cast<unsigned int>(daughter));
+	}
+
+	void AddDaughters(size_t mother, std::vector<int> const& pdgIds, int sign)
+	{
+		for (std::vector<int>::const_iterator pdgId = pdgIds.begin(); pdgId != pdgIds.end(); ++pdgId)
+		{
+			bool neutral = ((*pdgId == DefaultValues::pdgIdGamma) || (*pdgId == DefaultValues::pdgIdPiZero));
+			size_t daughter = AddParticle((neutral ? 1 : sign) * (*pdgId), 1);
+			AddDaughter(mother, daughter);
+			Decay(daughter);
+		}
+	}
+
+	// decays of a tau (with the sign of a tau-) and of the intermediate hadrons
+	void Decay(size_t index)
+	{
+		int pdgId = Particle(index).pdgId();
+		int sign = ((pdgId > 0) ? 1 : -1);
+		int absPdgId = std::abs(pdgId);
+		if (absPdgId == DefaultValues::pdgIdTau)
+		{
+			static const std::vector<std::vector<int> > decays = {
+				{ DefaultValues::pdgIdElectron, -DefaultValues::pdgIdNuE, DefaultValues::pdgIdNuTau },
+				{ DefaultValues::pdgIdMuon, -DefaultValues::pdgIdNuMu, DefaultValues::pdgIdNuTau },
+				{ -DefaultValues::pdgIdPiPlus, DefaultValues::pdgIdNuTau },
+				{ -DefaultValues::pdgIdPiPlus, DefaultValues::pdgIdPiZero, DefaultValues::pdgIdNuTau },
+				{ -DefaultValues::pdgIdRhoPlus770, DefaultValues::pdgIdNuTau },
+				{ -DefaultValues::pdgIdAOnePlus1260, DefaultValues::pdgIdNuTau },
+				{ -DefaultValues::pdgIdPiPlus, -DefaultValues::pdgIdPiPlus, DefaultValues::pdgIdPiPlus, DefaultValues::pdgIdNuTau },
+				{ -DefaultValues::pdgIdKPlus, DefaultValues::pdgIdNuTau },
+				{ -DefaultValues::pdgIdKStar, DefaultValues::pdgIdNuTau },
+				{ DefaultValues::pdgIdGamma, DefaultValues::pdgIdNuTau, -DefaultValues::pdgIdPiPlus },
+				{ DefaultValues::pdgIdKShort, DefaultValues::pdgIdNuTau, DefaultValues::pdgIdEta },
+				{ }
+			};
+			AddDaughters(index, decays[Uniform(0, decays.size() - 1)], sign);
+		}
+		else if (absPdgId == DefaultValues::pdgIdPiZero)
+		{
+			AddDaughters(index, { DefaultValues::pdgIdGamma, DefaultValues::pdgIdGamma }, sign);
+		}
+		else if (absPdgId == DefaultValues::pdgIdRhoPlus770)
+		{
+			AddDaughters(index, { DefaultValues::pdgIdPiPlus, DefaultValues::pdgIdPiZero }, sign);
+		}
+		else if (absPdgId == DefaultValues::pdgIdAOnePlus1260)
+		{
+			AddDaughters(index, { DefaultValues::pdgIdRhoPlus770, DefaultValues::pdgIdPiZero }, sign);
+		}
+		else if (absPdgId == DefaultValues::pdgIdKStar)
+		{
+			AddDaughters(index, { DefaultValues::pdgIdKPlus, DefaultValues::pdgIdPiZero }, sign);
+		}
+	}
+};
+
+// decay trees as built by the GenTauDecayProducer before the GenDecayGraph was introduced
+inline void BuildMotherDaughterBundleTree(MotherDaughterBundle& parent, unsigned int parentIndex, KGenParticles& genParticles)
+{
+	for (unsigned int j = 0; j < genParticles.at(parentIndex).daughterIndices.size(); ++j)
+	{
+		unsigned int daughterIndex = genParticles.at(parentIndex).daughterIndex(j);
+		if (daughterIndex < genParticles.size())
+		{
+			parent.Daughters.push_back(MotherDaughterBundle(&(genParticles.at(daughterIndex))));
+			MotherDaughterBundle& daughter = parent.Daughters.back();
+			daughter.setCharge();
+			daughter.setDetectable();
+			if (genParticles.at(daughterIndex).daughterIndices.size() == 0) daughter.finalState = true;
+			else BuildMotherDaughterBundleTree(daughter, daughterIndex, genParticles);
+		}
+	}
+}
+
+inline std::vector<MotherDaughterBundle> BuildMotherDaughterBundles(KGenParticles& genParticles, int bosonPdgId, int bosonStatus)
+{
+	std::vector<MotherDaughterBundle> bosons;
+	for (KGenParticles::iterator part = genParticles.begin(); part != genParticles.end(); ++part)
+	{
+		if ((std::abs(part->pdgId()) == bosonPdgId) && (part->status() == bosonStatus))
+		{
+			bosons.push_back(MotherDaughterBundle(&(*part)));
+			MotherDaughterBundle& boson = bosons.back();
+			boson.setCharge();
+			boson.setDetectable();
+			if (part->daughterIndices.size() == 0) boson.finalState = true;
+			for (unsigned int i = 0; i < part->daughterIndices.size(); ++i)
+			{
+				unsigned int daughterIndex = part->daughterIndex(i);
+				if (daughterIndex < genParticles.size())
+				{
+					boson.Daughters.push_back(MotherDaughterBundle(&(genParticles.at(daughterIndex))));
+					MotherDaughterBundle& daughter = boson.Daughters.back();
+					daughter.setCharge();
+					daughter.setDetectable();
+					if (genParticles.at(daughterIndex).daughterIndices.size() != 0)
+					{
+						BuildMotherDaughterBundleTree(daughter, genParticles.at(daughterIndex).daughterIndex(0), genParticles);
+					}
+					else daughter.finalState = true;
+				}
+			}
+		}
+	}
+	return bosons;
+}
+
+inline void CheckSameTree(MotherDaughterBundle const& bundle, GenDecayGraph const& graph, GenDecayGraph::Node const& node)
+{
+	BOOST_CHECK(bundle.node == node.particle);
+	BOOST_CHECK_EQUAL(bundle.finalState, node.finalState);
+	BOOST_CHECK_EQUAL(bundle.getCharge(), node.charge);
+	BOOST_CHECK_EQUAL(bundle.isDetectable(), node.detectable);
+	BOOST_REQUIRE_EQUAL(bundle.Daughters.size(), node.nDaughters);
+	for (size_t daughter = 0; daughter < node.nDaughters; ++daughter)
+	{
+		CheckSameTree(bundle.Daughters[daughter], graph, *graph.GetDaughter(&node, daughter));
+	}
+}
+
+inline void CheckSameTree(MotherDaughterBundle const& expected, MotherDaughterBundle const& bundle)
+{
+	BOOST_CHECK(bundle.node == expected.node);
+	BOOST_CHECK_EQUAL(bundle.finalState, expected.finalState);
+	BOOST_CHECK_EQUAL(bundle.getCharge(), expected.getCharge());
+	BOOST_CHECK_EQUAL(bundle.isDetectable(), expected.isDetectable());
+	BOOST_REQUIRE_EQUAL(bundle.Daughters.size(), expected.Daughters.size());
+	for (size_t daughter = 0; daughter < expected.Daughters.size(); ++daughter)
+	{
+		CheckSameTree(expected.Daughters[daughter], bundle.Daughters[daughter]);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(test_gen_decay_graph_against_mother_daughter_bundles)
+{
+	std::mt19937 generator(42);
+	size_t nTaus = 0;
+	for (size_t event = 0; event < 2000; ++event)
+	{
+		GenDecayTestRecord record(generator);
+		KGenParticles& genParticles = record.GetParticles();
+
+		GenParticleIndex genParticleIndex;
+		genParticleIndex.Build(genParticles);
+		GenDecayGraph graph;
+		graph.Build(genParticles, genParticleIndex, DefaultValues::pdgIdH, 3);
+
+		std::vector<MotherDaughterBundle> bosons = BuildMotherDaughterBundles(genParticles, DefaultValues::pdgIdH, 3);
+		BOOST_REQUIRE_EQUAL(graph.GetNBosons(), bosons.size());
+		for (size_t boson = 0; boson < bosons.size(); ++boson)
+		{
+			CheckSameTree(bosons[boson], graph, *graph.GetNode(boson));
+
+			// the copies for the KappaProduct::m_genBoson have the same structure
+			MotherDaughterBundle copy(graph, *graph.GetNode(boson));
+			CheckSameTree(bosons[boson], copy);
+
+			// decay modes and final states as determined by the GenTauDecayModeProducer before
+			for (size_t daughter = 0; daughter < bosons[boson].Daughters.size(); ++daughter)
+			{
+				MotherDaughterBundle& tau = bosons[boson].Daughters[daughter];
+				GenDecayGraph::Node const* node = graph.GetNode(boson, daughter);
+				++nTaus;
+
+				tau.determineDecayMode(&tau);
+				BOOST_CHECK_EQUAL(Utility::ToUnderlyingValue(tau.decayMode), Utility::ToUnderlyingValue(node->decayMode));
+				BOOST_CHECK_EQUAL(Utility::ToUnderlyingValue(copy.Daughters[daughter].decayMode), Utility::ToUnderlyingValue(node->decayMode));
+
+				tau.createFinalStateProngs(&tau);
+				int prongSize = -1;
+				if (tau.finalStateOneProngs.size() > 0) prongSize = 1;
+				else if (tau.finalStateThreeProngs.size() > 0) prongSize = 3;
+				else if (tau.finalStateFiveProngs.size() > 0) prongSize = 5;
+				BOOST_CHECK_EQUAL(prongSize, GenDecayGraph::GetProngSize(*node));
+
+				BOOST_REQUIRE_EQUAL(tau.finalStates.size(), node->nFinalStates);
+				for (size_t finalState = 0; finalState < node->nFinalStates; ++finalState)
+				{
+					BOOST_CHECK(tau.finalStates[finalState]->node == graph.GetFinalState(*node, finalState).particle);
+				}
+			}
+		}
+	}
+	BOOST_CHECK_GT(nTaus, 1000);
+}
@@ -0,0 +1,218 @@
+/* Copyright (c) 2013 - All Rights Reserved
+ *   Thomas Hauth  <Thomas.Hauth@cern.ch>
+ *   Joram Berger  <Joram.Berger@cern.ch>
+ *   Dominik Haitz <Dominik.Haitz@kit.edu>
+ */
+
+#pragma once
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <boost/test/included/unit_test.hpp>
+
+#include "Artus/KappaAnalysis/interface/Utility/JetEnergyCorrection.h"
+
+/// bins and parameters of one record of the JetCorrectorParameters
+struct JetCorrectionTestRecord
+{
+	std::vector<float> xMin;
+	std::vector<float> xMax;
+	std::vector<float> parameters;
+};
+
+inline JetCorrectorParameters GetTestJetCorrectorParameters(std::vector<std::string> const& binVariables,
+                                                            std::vector<std::string> const& parameterVariables,
+                                                            std::string const& formula,
+                                                            std::vector<JetCorrectionTestRecord> const& records)
+{
+	std::vector<JetCorrectorParameters::Record> parameterRecords;
+	for (std::vector<JetCorrectionTestRecord>::const_iterator record = records.begin(); record != records.end(); ++record)
+	{
+		parameterRecords.push_back(JetCorrectorParameters::Record(binVariables.size(), record->xMin, record->xMax, record->parameters));
+	}
+	return JetCorrectorParameters(JetCorrectorParameters::Definitions(binVariables, parameterVariables, formula, false),
+	                              parameterRecords);
+}
+
+/// jets as structure of arrays for the JetCorrectionInputs
+struct JetCorrectionTestJets
+{
+	void Add(float jetPt, float jetEta, float jetArea = 0.5f)
+	{
+		pt.push_back(jetPt);
+		eta.push_back(jetEta);
+		phi.push_back(0.0f);
+		energy.push_back(jetPt * std::cosh(jetEta));
+		area.push_back(jetArea);
+	}
+
+	JetCorrectionInputs GetInputs(float rho = 0.0f, float nPrimaryVertices = 0.0f) const
+	{
+		JetCorrectionInputs inputs;
+		inputs.pt = pt.data();
+		inputs.eta = eta.data();
+		inputs.phi = phi.data();
+		inputs.energy = energy.data();
+		inputs.area = area.data();
+		inputs.size = pt.size();
+		inputs.rho = rho;
+		inputs.nPrimaryVertices = nPrimaryVertices;
+		return inputs;
+	}
+
+	std::vector<float> pt;
+	std::vector<float> eta;
+	std::vector<float> phi;
+	std::vector<float> energy;
+	std::vector<float> area;
+};
+
+BOOST_AUTO_TEST_CASE(test_jet_energy_correction_formula)
+{
+	BOOST_CHECK_EQUAL(JetEnergyCorrection::TranslateFormula("[0]+[1]*TMath::Log10(x)+TMath::Power(x,[12])"),
+	                  "p0+p1*log10(x)+pow(x,p12)");
+	BOOST_CHECK_EQUAL(JetEnergyCorrection::TranslateFormula("TMath::Max(0.0001,1-y*([0]+([1]*(z))*(1+[2]*TMath::Log(x)))/x)"),
+	                  "max(0.0001,1-y*(p0+(p1*(z))*(1+p2*log(x)))/x)");
+	BOOST_CHECK_EQUAL(JetEnergyCorrection::TranslateFormula("fabs (x)*TMath::Exp(-[0])+TMath::Sqrt(TMath::Abs(y))"),
+	                  "abs(x)*exp(-p0)+sqrt(abs(y))");
+}
+
+BOOST_AUTO_TEST_CASE(test_jet_correction_table)
+{
+	// ordered bins of one variable are searched by bisection, with a gap between 3 and 4
+	JetCorrectionTable orderedTable(GetTestJetCorrectorParameters({ "JetEta" }, { "JetPt" }, "[0]", {
+		{ { -5.0f }, { -1.0f }, { 0.0f, 1000.0f, 1.0f } },
+		{ { -1.0f }, { 1.0f }, { 0.0f, 1000.0f, 2.0f } },
+		{ { 1.0f }, { 3.0f }, { 0.0f, 1000.0f, 3.0f } },
+		{ { 4.0f }, { 5.0f }, { 0.0f, 1000.0f, 4.0f, 5.0f } }
+	}));
+	BOOST_REQUIRE_EQUAL(orderedTable.GetNRecords(), 4u);
+	BOOST_CHECK_EQUAL(orderedTable.GetNParameters(3), 4u);
+	BOOST_CHECK_EQUAL(orderedTable.GetParameters(2)[2], 3.0f);
+
+	// the same bins in another order are searched linearly, overlapping bins go to the first record
+	JetCorrectionTable unorderedTable(GetTestJetCorrectorParameters({ "JetEta" }, { "JetPt" }, "[0]", {
+		{ { 4.0f }, { 5.0f }, { 0.0f, 1000.0f, 4.0f } },
+		{ { -1.0f }, { 1.0f }, { 0.0f, 1000.0f, 2.0f } },
+		{ { -5.0f }, { -1.0f }, { 0.0f, 1000.0f, 1.0f } },
+		{ { 1.0f }, { 3.0f }, { 0.0f, 1000.0f, 3.0f } },
+		{ { 0.0f }, { 5.0f }, { 0.0f, 1000.0f, 6.0f } }
+	}));
+
+	JetCorrectionTestJets jets;
+	for (float eta : { -6.0f, -5.0f, -1.0f, -0.5f, 0.0f, 1.0f, 2.999f, 3.0f, 3.5f, 4.0f, 4.999f, 5.0f, 6.0f })
+	{
+		jets.Add(30.0f, eta);
+	}
+	std::vector<int> expectedOrdered = { -1, 0, 1, 1, 1, 2, 2, -1, -1, 3, 3, -1, -1 };
+	std::vector<int> expectedUnordered = { -1, 2, 1, 1, 1, 3, 3, 4, 4, 0, 0, -1, -1 };
+	JetCorrectionInputs inputs = jets.GetInputs();
+	for (size_t jetIndex = 0; jetIndex < inputs.size; ++jetIndex)
+	{
+		BOOST_CHECK_EQUAL(orderedTable.FindRecord(inputs, jetIndex), expectedOrdered[jetIndex]);
+		BOOST_CHECK_EQUAL(unorderedTable.FindRecord(inputs, jetIndex), expectedUnordered[jetIndex]);
+	}
+
+	// bisection agrees with the linear search over the same records in two bin variables
+	std::vector<JetCorrectionTestRecord> records;
+	std::vector<JetCorrectionTestRecord> records2d;
+	for (int bin = -50; bin < 50; ++bin)
+	{
+		records.push_back({ { 0.1f * float(bin) }, { 0.1f * float(bin + 1) }, { 0.0f, 1000.0f, float(bin) } });
+		records2d.push_back({ { 0.1f * float(bin), 0.0f }, { 0.1f * float(bin + 1), 1000.0f }, { 0.0f, 1000.0f, float(bin) } });
+	}
+	JetCorrectionTable bisectionTable(GetTestJetCorrectorParameters({ "JetEta" }, { "JetPt" }, "[0]", records));
+	JetCorrectionTable linearTable(GetTestJetCorrectorParameters({ "JetEta", "JetPt" }, { "JetPt" }, "[0]", records2d));
+	std::mt19937 generator(7);
+	std::uniform_real_distribution<float> etaDistribution(-5.5f, 5.5f);
+	JetCorrectionTestJets randomJets;
+	for (size_t jetIndex = 0; jetIndex < 1000; ++jetIndex)
+	{
+		randomJets.Add(30.0f, etaDistribution(generator));
+	}
+	inputs = randomJets.GetInputs();
+	for (size_t jetIndex = 0; jetIndex < inputs.size; ++jetIndex)
+	{
+		BOOST_CHECK_EQUAL(bisectionTable.FindRecord(inputs, jetIndex), linearTable.FindRecord(inputs, jetIndex));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(test_jet_energy_correction)
+{
+	std::vector<JetCorrectorParameters> levels;
+	// offset correction with the parameter variables area, rho and number of vertices
+	levels.push_back(GetTestJetCorrectorParameters({ "JetEta" }, { "JetA", "Rho", "NPV" }, "1+[0]*x*y+[1]*z", {
+		{ { -5.0f }, { 5.0f }, { 0.0f, 10.0f, 0.0f, 100.0f, 0.0f, 100.0f, 0.01f, 0.002f } }
+	}));
+	// pt dependent correction with the pt clamped to [10, 100], only defined for positive eta
+	levels.push_back(GetTestJetCorrectorParameters({ "JetEta" }, { "JetPt" }, "[0]+[1]*TMath::Log10(x)", {
+		{ { 0.0f }, { 5.0f }, { 10.0f, 100.0f, 0.9f, 0.1f } }
+	}));
+	JetEnergyCorrection jetEnergyCorrection(levels);
+
+	JetCorrectionTestJets jets;
+	jets.Add(5.0f, 1.0f, 0.5f);
+	jets.Add(30.0f, 2.0f, 0.4f);
+	jets.Add(500.0f, 0.5f, 0.5f);
+	jets.Add(30.0f, -1.0f, 0.5f);
+	jets.Add(30.0f, 6.0f, 0.5f);
+	float const rho = 20.0f;
+	float const nPrimaryVertices = 15.0f;
+	JetCorrectionInputs inputs = jets.GetInputs(rho, nPrimaryVertices);
+
+	std::vector<float> factors(inputs.size, 0.0f);
+	jetEnergyCorrection.GetCorrections(inputs, factors.data());
+
+	for (size_t jetIndex = 0; jetIndex < inputs.size; ++jetIndex)
+	{
+		float expectedFactor = 1.0f;
+		if (std::abs(jets.eta[jetIndex]) < 5.0f)
+		{
+			expectedFactor = 1.0f + (0.01f * jets.area[jetIndex] * rho) + (0.002f * nPrimaryVertices);
+		}
+		// the second level uses the pt corrected by the first level
+		if ((jets.eta[jetIndex] >= 0.0f) && (jets.eta[jetIndex] < 5.0f))
+		{
+			float const correctedPt = std::max(std::min(jets.pt[jetIndex] * expectedFactor, 100.0f), 10.0f);
+			expectedFactor *= (0.9f + (0.1f * std::log10(correctedPt)));
+		}
+		BOOST_CHECK_CLOSE(factors[jetIndex], expectedFactor, 1e-4);
+	}
+	// first jet: clamped to the minimum of 10, third jet: clamped to the maximum of 100
+	BOOST_CHECK_CLOSE(factors[0], 1.13f * 1.0f, 1e-4);
+	BOOST_CHECK_CLOSE(factors[2], 1.13f * 1.1f, 1e-4);
+	// last jet is outside of the bins of all levels
+	BOOST_CHECK_EQUAL(factors[4], 1.0f);
+}
+
+BOOST_AUTO_TEST_CASE(test_jet_energy_correction_uncertainty)
+{
+	JetEnergyCorrectionUncertainty uncertainty(GetTestJetCorrectorParameters({ "JetEta" }, { "JetPt" }, "", {
+		{ { -5.0f }, { 5.0f }, { 10.0f, 0.05f, 0.06f, 100.0f, 0.01f, 0.02f } }
+	}));
+
+	JetCorrectionTestJets jets;
+	jets.Add(5.0f, 0.0f);
+	jets.Add(55.0f, 0.0f);
+	jets.Add(200.0f, 0.0f);
+	jets.Add(55.0f, 6.0f);
+	JetCorrectionInputs inputs = jets.GetInputs();
+
+	std::vector<float> up(inputs.size, -1.0f);
+	std::vector<float> down(inputs.size, -1.0f);
+	BOOST_CHECK_EQUAL(uncertainty.GetUncertainties(inputs, true, up.data()), 1u);
+	BOOST_CHECK_EQUAL(uncertainty.GetUncertainties(inputs, false, down.data()), 1u);
+
+	BOOST_CHECK_CLOSE(up[0], 0.05f, 1e-4);
+	BOOST_CHECK_CLOSE(down[0], 0.06f, 1e-4);
+	BOOST_CHECK_CLOSE(up[1], 0.03f, 1e-3);
+	BOOST_CHECK_CLOSE(down[1], 0.04f, 1e-3);
+	BOOST_CHECK_CLOSE(up[2], 0.01f, 1e-4);
+	BOOST_CHECK_CLOSE(down[2], 0.02f, 1e-4);
+
+	// jets outside of the bins are not shifted
+	BOOST_CHECK_EQUAL(up[3], 0.0f);
+	BOOST_CHECK_EQUAL(down[3], 0.0f);
+}
@@ -0,0 +1,18 @@
+/* Copyright (c) 2013 - All Rights Reserved
+ *   Thomas Hauth  <Thomas.Hauth@cern.ch>
+ *   Joram Berger  <Joram.Berger@cern.ch>
+ *   Dominik Haitz <Dominik.Haitz@kit.edu>
+ */
+/*
+ *
+ * use "scram b runtests" to run this code
+ *
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+
+#define BOOST_TEST_MODULE ArtusKappaAnalysis
+
+#include "GenDecayGraph_t.h"
+#include "JetEnergyCorrection_t.h"
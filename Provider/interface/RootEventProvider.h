@@ -10,6 +10,7 @@
 #include <TChain.h>
 
 #include "Artus/Core/interface/EventProviderBase.h"
+#include "Artus/Utility/interface/RootFileHelper.h"
 
 template<class TTypes>
 class RootEventProvider: public EventProviderBase<TTypes> {
@@ -37,6 +38,14 @@ public:
 		return m_rootChain->GetEntries();
 	}
 
+	std::vector<WorkUnit> GetWorkUnits(long long firstEntry, long long endEntry) const override {
+		return WorkUnitScheduler::GetClusterWorkUnits(*m_rootChain, firstEntry, endEntry);
+	}
+
+	void ReopenInput() override {
+		RootFileHelper::CloseCurrentFile(*m_rootChain);
+	}
+
 	virtual void WireEvent(TraxSettings const&) = 0;
 
 protected:
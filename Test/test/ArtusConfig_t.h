@@ -75,3 +75,143 @@ BOOST_AUTO_TEST_CASE( test_parse_config )
 	BOOST_CHECK( nodesOne.begin()->GetProcessNodeType() == ProcessNodeType::Producer );
 }
 
+
+BOOST_AUTO_TEST_CASE( test_parallel_pipeline_init )
+{
+	std::stringstream configStream;
+
+	configStream
+	<<	"{"
+	<<	    "\"PipelineInitThreads\": 3,"
+	<<	    "\"Processors\": [],"
+	<<	    "\"InputFiles\": [ \"sample_ntuple.root\" ],"
+	<<	    "\"Pipelines\": {";
+	for (int pipeline = 0; pipeline < 8; ++pipeline)
+	{
+		configStream
+		<<	"    \"pipeline" << pipeline << "\": {"
+		<<	"        \"Consumers\": [ \"test_consumer\" ],"
+		<<	"        \"Processors\": [ \"producer:test_local_producer\", \"filter:testfilter\" ]"
+		<<	"    }" << ((pipeline < 7) ? "," : "");
+	}
+	configStream
+	<<	    "}"
+	<<	"}";
+
+	ArtusConfig cfg ( configStream );
+
+	TestPipelineInitializer pInit;
+	TestFactory factory;
+	TestPipelineRunner runner(false);
+	cfg.LoadConfiguration( pInit, runner, factory, nullptr);
+
+	// the pipelines keep the order of the configuration
+	auto & pLine = runner.GetPipelines();
+	BOOST_CHECK_EQUAL( pLine.size() , size_t(8) );
+	int pipeline = 0;
+	for (auto it = pLine.begin(); it != pLine.end(); ++it, ++pipeline)
+	{
+		BOOST_CHECK_EQUAL( it->GetSettings().GetName(), "pipeline" + std::to_string(pipeline) );
+		BOOST_CHECK_EQUAL( it->GetNodes().size() , size_t(2) );
+	}
+}
+
+BOOST_AUTO_TEST_CASE( test_settings_freeze )
+{
+	boost::property_tree::ptree propTree;
+	propTree.put("Pipelines.pline.Level", 2);
+	propTree.put("ProcessNEvents", 10);
+
+	SettingsBase settings;
+	settings.SetName("pline");
+	settings.SetPropTreePath("Pipelines.pline");
+	settings.SetPropTree(&propTree);
+
+	// copies of the settings object resolve their own values
+	SettingsBase frozenSettings = settings;
+	frozenSettings.Freeze();
+
+	BOOST_CHECK( frozenSettings.CacheLevel.IsCached() );
+	BOOST_CHECK( frozenSettings.CacheFirstEvent.IsCached() );
+	BOOST_CHECK( ! settings.CacheLevel.IsCached() );
+	// required settings, which are not configured, fail only when they are accessed
+	BOOST_CHECK( ! frozenSettings.CacheInputIsData.IsCached() );
+
+	// the configuration is not read anymore after freezing and the values are shared with the copies
+	propTree.put("ProcessNEvents", 20);
+	BOOST_CHECK_EQUAL( frozenSettings.GetLevel(), 2 );
+	BOOST_CHECK_EQUAL( frozenSettings.GetProcessNEvents(), 10 );
+	BOOST_CHECK_EQUAL( settings.GetProcessNEvents(), 10 );
+	BOOST_CHECK_EQUAL( &settings.GetProcessNEvents(), &frozenSettings.GetProcessNEvents() );
+	BOOST_CHECK( frozenSettings.GetTaggingFilters().empty() );
+}
+
+BOOST_AUTO_TEST_CASE( test_settings_table )
+{
+	boost::property_tree::ptree propTree;
+	propTree.put("ProcessNEvents", 10);
+	propTree.put("FirstEvent", 3);
+	propTree.put("Pipelines.pline1.ProcessNEvents", 20);
+	propTree.put("Pipelines.pline2.Level", 2);
+
+	SettingsTable settingsTable(propTree);
+	BOOST_CHECK_EQUAL( settingsTable.GetNumberOfOverrides(), 2 );
+
+	size_t pline1 = settingsTable.GetPipelineIndex("pline1");
+	size_t pline2 = settingsTable.GetPipelineIndex("pline2");
+	BOOST_CHECK_EQUAL( settingsTable.GetPipelineIndex("missing"), SettingsTable::GlobalSettings );
+
+	SettingsTable::KeyId processNEvents = SettingsTable::GetKeyId("ProcessNEvents");
+	BOOST_CHECK_EQUAL( SettingsTable::GetKeyId("ProcessNEvents"), processNEvents );
+	BOOST_CHECK_EQUAL( settingsTable.Find(pline1, processNEvents)->get_value<int>(), 20 );
+	BOOST_CHECK_EQUAL( settingsTable.Find(pline2, processNEvents)->get_value<int>(), 10 );
+	BOOST_CHECK( settingsTable.Find(SettingsTable::GlobalSettings, SettingsTable::GetKeyId("Level")) == nullptr );
+
+	// settings of pipelines read via the table
+	SettingsBase settings;
+	settings.SetName("pline1");
+	settings.SetPropTreePath("Pipelines.pline1");
+	settings.SetPropTree(&propTree);
+	settings.SetSettingsTable(&settingsTable);
+	BOOST_CHECK_EQUAL( settings.GetProcessNEvents(), 20 );
+	BOOST_CHECK_EQUAL( settings.GetFirstEvent(), 3 );
+	BOOST_CHECK_EQUAL( settings.GetLevel(), 1 );
+
+	// pipelines share the values, which they do not override, and the default values
+	SettingsBase settings2;
+	settings2.SetName("pline2");
+	settings2.SetPropTreePath("Pipelines.pline2");
+	settings2.SetPropTree(&propTree);
+	settings2.SetSettingsTable(&settingsTable);
+	settings2.Freeze();
+	settings.Freeze();
+	BOOST_CHECK_EQUAL( settings2.GetProcessNEvents(), 10 );
+	BOOST_CHECK_EQUAL( settings2.GetLevel(), 2 );
+	BOOST_CHECK_EQUAL( &settings2.GetFirstEvent(), &settings.GetFirstEvent() );
+	BOOST_CHECK_EQUAL( &settings2.GetPostProcessingThreads(), &settings.GetPostProcessingThreads() );
+	BOOST_CHECK( &settings2.GetProcessNEvents() != &settings.GetProcessNEvents() );
+	// FirstEvent, ProcessNEvents of both pipelines and Level of pipeline 2
+	BOOST_CHECK_EQUAL( settingsTable.GetValues()->GetNumberOfValues(), size_t(4) );
+}
+
+BOOST_AUTO_TEST_CASE( test_settings_fallback_on_type_mismatch )
+{
+	boost::property_tree::ptree propTree;
+	propTree.put("ProcessNEvents", 10);
+	propTree.put("Pipelines.pline1.ProcessNEvents", "many");
+
+	// pipeline settings of incompatible type fall back to the global value
+	SettingsBase settings;
+	settings.SetName("pline1");
+	settings.SetPropTreePath("Pipelines.pline1");
+	settings.SetPropTree(&propTree);
+	BOOST_CHECK_EQUAL( settings.GetProcessNEvents(), 10 );
+
+	SettingsTable settingsTable(propTree);
+	SettingsBase tableSettings;
+	tableSettings.SetName("pline1");
+	tableSettings.SetPropTreePath("Pipelines.pline1");
+	tableSettings.SetPropTree(&propTree);
+	tableSettings.SetSettingsTable(&settingsTable);
+	BOOST_CHECK_EQUAL( tableSettings.GetProcessNEvents(), 10 );
+}
@@ -18,6 +18,16 @@
 #include "FilterBase_t.h"
 #include "Pipeline_t.h"
 #include "PipelineRunner_t.h"
+#include "PipelineResults_t.h"
+#include "Checkpoint_t.h"
+#include "WorkUnitScheduler_t.h"
+#include "ProcessorRegistry_t.h"
 #include "ArtusConfig_t.h"
 #include "SafeMap_t.h"
+#include "SharedResourceCache_t.h"
+#include "LogBuffer_t.h"
+#include "Kinematics_t.h"
+#include "Expression_t.h"
+#include "BdtEvaluator_t.h"
+#include "LambdaNtupleConsumer_t.h"
 
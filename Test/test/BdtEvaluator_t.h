@@ -0,0 +1,102 @@
+/* Copyright (c) 2013 - All Rights Reserved
+ *   Thomas Hauth  <Thomas.Hauth@cern.ch>
+ *   Joram Berger  <Joram.Berger@cern.ch>
+ *   Dominik Haitz <Dominik.Haitz@kit.edu>
+ */
+
+#pragma once
+
+#include <cmath>
+#include <sstream>
+
+#include <boost/test/included/unit_test.hpp>
+
+#include "Artus/Utility/interface/BdtEvaluator.h"
+
+// two trees in the format of TMVA: the inner node of the first tree goes right for x < 0.5 (cType 0)
+// TMVA writes the analysis type of the trees, which are regression trees for Grad, also per tree
+inline std::string GetTestBdtWeights(std::string const& boostType, std::string const& useYesNoLeaf)
+{
+	std::string const analysisType = ((boostType == "Grad") ? "1" : "0");
+	return "<?xml version=\"1.0\"?>\n"
+	       "<MethodSetup Method=\"BDT::BDT\">\n"
+	       "  <GeneralInfo>\n"
+	       "    <Info name=\"TMVA Release\" value=\"4.2.0 [262656]\"/>\n"
+	       "    <Info name=\"AnalysisType\" value=\"Classification\"/>\n"
+	       "  </GeneralInfo>\n"
+	       "  <Options>\n"
+	       "    <Option name=\"BoostType\" modified=\"Yes\">" + boostType + "</Option>\n"
+	       "    <Option name=\"UseYesNoLeaf\" modified=\"No\">" + useYesNoLeaf + "</Option>\n"
+	       "  </Options>\n"
+	       "  <Variables NVar=\"2\">\n"
+	       "    <Variable VarIndex=\"1\" Expression=\"x\" Label=\"x\" Type=\"F\"/>\n"
+	       "    <Variable VarIndex=\"0\" Expression=\"pt\" Label=\"pt\" Type=\"F\"/>\n"
+	       "  </Variables>\n"
+	       "  <Transformations NTransformations=\"0\"/>\n"
+	       "  <Weights NTrees=\"2\" AnalysisType=\"" + analysisType + "\">\n"
+	       "    <BinaryTree type=\"DecisionTree\" AnalysisType=\"" + analysisType + "\" boostWeight=\"5.0000000000000000e-01\" itree=\"0\">\n"
+	       "      <Node pos=\"s\" depth=\"0\" NCoef=\"0\" IVar=\"0\" Cut=\"1.0000000e+00\" cType=\"1\" res=\"0\" rms=\"0\" purity=\"0.5\" nType=\"0\">\n"
+	       "        <Node pos=\"l\" depth=\"1\" NCoef=\"0\" IVar=\"-1\" Cut=\"0\" cType=\"1\" res=\"-3.0000001e-01\" rms=\"0\" purity=\"2.0000000e-01\" nType=\"-1\"/>\n"
+	       "        <Node pos=\"r\" depth=\"1\" NCoef=\"0\" IVar=\"1\" Cut=\"5.0000000e-01\" cType=\"0\" res=\"0\" rms=\"0\" purity=\"0.6\" nType=\"0\">\n"
+	       "          <Node pos=\"l\" depth=\"2\" NCoef=\"0\" IVar=\"-1\" Cut=\"0\" cType=\"1\" res=\"4.0000001e-01\" rms=\"0\" purity=\"9.0000000e-01\" nType=\"1\"/>\n"
+	       "          <Node pos=\"r\" depth=\"2\" NCoef=\"0\" IVar=\"-1\" Cut=\"0\" cType=\"1\" res=\"-1.0000000e-01\" rms=\"0\" purity=\"4.0000001e-01\" nType=\"-1\"/>\n"
+	       "        </Node>\n"
+	       "      </Node>\n"
+	       "    </BinaryTree>\n"
+	       "    <BinaryTree type=\"DecisionTree\" AnalysisType=\"" + analysisType + "\" boostWeight=\"2.5000000000000000e-01\" itree=\"1\">\n"
+	       "      <Node pos=\"s\" depth=\"0\" NCoef=\"0\" IVar=\"-1\" Cut=\"0\" cType=\"1\" res=\"2.0000000e-01\" rms=\"0\" purity=\"6.9999999e-01\" nType=\"1\"/>\n"
+	       "    </BinaryTree>\n"
+	       "  </Weights>\n"
+	       "</MethodSetup>\n";
+}
+
+BOOST_AUTO_TEST_CASE( test_bdt_evaluator )
+{
+	std::istringstream weights(GetTestBdtWeights("AdaBoost", "True"));
+	BdtEvaluator bdt(weights, "test");
+
+	BOOST_REQUIRE_EQUAL( bdt.GetNVariables(), 2u );
+	BOOST_CHECK_EQUAL( bdt.GetVariableNames()[0], "pt" );
+	BOOST_CHECK_EQUAL( bdt.GetVariableNames()[1], "x" );
+	BOOST_CHECK_EQUAL( bdt.GetNTrees(), 2u );
+
+	// one entry for every leaf of the first tree: left, right-left (x >= 0.5) and right-right (x < 0.5)
+	std::vector<float> inputs = { 0.5f, 0.7f, 1.0f, 0.7f, 2.0f, 0.1f };
+
+	// AdaBoost with YesNoLeaf: weighted mean of the node types
+	BOOST_CHECK_CLOSE( bdt.Evaluate(&(inputs[0])), (-0.5 + 0.25) / 0.75, 1e-9 );
+	BOOST_CHECK_CLOSE( bdt.Evaluate(&(inputs[2])), 1.0, 1e-9 );
+	BOOST_CHECK_CLOSE( bdt.Evaluate(&(inputs[4])), (-0.5 + 0.25) / 0.75, 1e-9 );
+
+	// AdaBoost without YesNoLeaf: weighted mean of the purities
+	weights.str(GetTestBdtWeights("AdaBoost", "False"));
+	weights.clear();
+	BdtEvaluator purityBdt(weights, "test");
+	BOOST_CHECK_CLOSE( purityBdt.Evaluate(&(inputs[0])), (0.5 * double(0.2f) + 0.25 * double(0.7f)) / 0.75, 1e-9 );
+	BOOST_CHECK_CLOSE( purityBdt.Evaluate(&(inputs[2])), (0.5 * double(0.9f) + 0.25 * double(0.7f)) / 0.75, 1e-9 );
+	BOOST_CHECK_CLOSE( purityBdt.Evaluate(&(inputs[4])), (0.5 * double(0.4f) + 0.25 * double(0.7f)) / 0.75, 1e-9 );
+
+	// gradient boost: sum of the responses mapped to [-1, 1]
+	weights.str(GetTestBdtWeights("Grad", "False"));
+	weights.clear();
+	BdtEvaluator gradBdt(weights, "test");
+	BOOST_CHECK_CLOSE( gradBdt.Evaluate(&(inputs[0])), std::tanh(double(-0.3f) + double(0.2f)), 1e-9 );
+	BOOST_CHECK_CLOSE( gradBdt.Evaluate(&(inputs[2])), std::tanh(double(0.4f) + double(0.2f)), 1e-9 );
+	BOOST_CHECK_CLOSE( gradBdt.Evaluate(&(inputs[4])), std::tanh(double(-0.1f) + double(0.2f)), 1e-9 );
+
+	// the batch evaluation gives the same results over several blocks
+	size_t nEntries = 200;
+	std::vector<float> batchInputs;
+	for (size_t entry = 0; entry < nEntries; ++entry)
+	{
+		batchInputs.push_back(inputs[2 * (entry % 3)]);
+		batchInputs.push_back(inputs[(2 * (entry % 3)) + 1]);
+	}
+	std::vector<double> results(nEntries, 0.0);
+	gradBdt.EvaluateBatch(batchInputs.data(), nEntries, results.data());
+	for (size_t entry = 0; entry < nEntries; ++entry)
+	{
+		BOOST_CHECK_EQUAL( results[entry], gradBdt.Evaluate(&(inputs[2 * (entry % 3)])) );
+	}
+}
+
@@ -0,0 +1,74 @@
+/* Copyright (c) 2013 - All Rights Reserved
+ *   Thomas Hauth  <Thomas.Hauth@cern.ch>
+ *   Joram Berger  <Joram.Berger@cern.ch>
+ *   Dominik Haitz <Dominik.Haitz@kit.edu>
+ */
+
+#pragma once
+
+#include <boost/test/included/unit_test.hpp>
+
+#include "Artus/Core/interface/Checkpoint.h"
+
+// minimal one dimensional histogram interface used by Checkpoint
+class TestCheckpointHistogram {
+public:
+	explicit TestCheckpointHistogram(int nBins) : m_contents(nBins + 2, 0.0), m_errors(nBins + 2, 0.0), m_entries(0.0) {}
+
+	int GetNbinsX() const { return static_cast<int>(m_contents.size()) - 2; }
+	double GetBinContent(int bin) const { return m_contents[bin]; }
+	double GetBinError(int bin) const { return m_errors[bin]; }
+	double GetEntries() const { return m_entries; }
+	void SetBinContent(int bin, double content) { m_contents[bin] = content; }
+	void SetBinError(int bin, double error) { m_errors[bin] = error; }
+	void SetEntries(double entries) { m_entries = entries; }
+
+	std::vector<double> m_contents;
+	std::vector<double> m_errors;
+	double m_entries;
+};
+
+BOOST_AUTO_TEST_CASE( test_checkpoint )
+{
+	const std::string fileName = "test_checkpoint.json";
+
+	TestCheckpointHistogram histogram(3);
+	histogram.SetBinContent(2, 4.0);
+	histogram.SetBinError(2, 2.0);
+	histogram.SetBinContent(4, 1.5);
+	histogram.SetEntries(5.0);
+
+	{
+		Checkpoint checkpoint(fileName);
+		BOOST_CHECK( checkpoint.IsEnabled() );
+		checkpoint.SetNextEvent(42);
+		checkpoint.SetRunTime(1.5);
+		checkpoint.SetFingerprint("abc");
+		checkpoint.SetValue(Checkpoint::GetKey("pline1", "consumer", "value"), 23);
+		checkpoint.SetList(Checkpoint::GetKey("pline1", "consumer", "names"), std::vector<std::string>({"a", "b"}));
+		checkpoint.SetHistogram(Checkpoint::GetKey("pline1", "consumer", "hist"), histogram);
+		checkpoint.Write();
+	}
+
+	Checkpoint checkpoint(fileName);
+	BOOST_CHECK( checkpoint.Exists() );
+	checkpoint.Read();
+	BOOST_CHECK_EQUAL( checkpoint.GetNextEvent(), 42 );
+	BOOST_CHECK_EQUAL( checkpoint.GetRunTime(), 1.5 );
+	BOOST_CHECK_EQUAL( checkpoint.GetFingerprint(), "abc" );
+	BOOST_CHECK_EQUAL( checkpoint.GetValue(Checkpoint::GetKey("pline1", "consumer", "value"), 0), 23 );
+	BOOST_CHECK_EQUAL( checkpoint.GetValue(Checkpoint::GetKey("pline2", "consumer", "value"), 0), 0 );
+	BOOST_CHECK( checkpoint.GetList<std::string>(Checkpoint::GetKey("pline1", "consumer", "names"))
+	             == std::vector<std::string>({"a", "b"}) );
+
+	TestCheckpointHistogram restoredHistogram(3);
+	BOOST_CHECK( checkpoint.GetHistogram(Checkpoint::GetKey("pline1", "consumer", "hist"), restoredHistogram) );
+	BOOST_CHECK( restoredHistogram.m_contents == histogram.m_contents );
+	BOOST_CHECK( restoredHistogram.m_errors == histogram.m_errors );
+	BOOST_CHECK_EQUAL( restoredHistogram.GetEntries(), 5.0 );
+	BOOST_CHECK( ! checkpoint.GetHistogram(Checkpoint::GetKey("pline2", "consumer", "hist"), restoredHistogram) );
+
+	checkpoint.Remove();
+	BOOST_CHECK( ! checkpoint.Exists() );
+	BOOST_CHECK( ! Checkpoint("").IsEnabled() );
+}
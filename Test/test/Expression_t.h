@@ -0,0 +1,153 @@
+/* Copyright (c) 2013 - All Rights Reserved
+ *   Thomas Hauth  <Thomas.Hauth@cern.ch>
+ *   Joram Berger  <Joram.Berger@cern.ch>
+ *   Dominik Haitz <Dominik.Haitz@kit.edu>
+ */
+
+#pragma once
+
+#include <boost/test/included/unit_test.hpp>
+
+#include "Artus/Utility/interface/Expression.h"
+
+BOOST_AUTO_TEST_CASE( test_expression_arithmetics )
+{
+	std::vector<std::string> variableNames;
+	Expression::VariableLoader noVariables = [](size_t variableIndex) { return 0.0; };
+
+	BOOST_CHECK_EQUAL( Expression("1 + 2 * 3", variableNames).Evaluate(noVariables), 7.0 );
+	BOOST_CHECK_EQUAL( Expression("(1 + 2) * 3", variableNames).Evaluate(noVariables), 9.0 );
+	BOOST_CHECK_EQUAL( Expression("8 / 2 / 2 - -1", variableNames).Evaluate(noVariables), 3.0 );
+	BOOST_CHECK_EQUAL( Expression("abs(-2.5) + sqrt(16) + min(1, 2) + max(1, 2e1)", variableNames).Evaluate(noVariables), 27.5 );
+	BOOST_CHECK_EQUAL( Expression("1 < 2 && 2 <= 2 && 3 > 2 && 3 >= 3 && 1 == 1 && 1 != 2", variableNames).Evaluate(noVariables), 1.0 );
+	BOOST_CHECK_EQUAL( Expression("!(1 < 2) || 0", variableNames).Evaluate(noVariables), 0.0 );
+	BOOST_CHECK_EQUAL( Expression("2 || 0", variableNames).Evaluate(noVariables), 1.0 );
+	BOOST_CHECK_EQUAL( Expression("pow(2, 10) + log10(100) + log(exp(0))", variableNames).Evaluate(noVariables), 1026.0 );
+
+	// constant expressions are folded into one instruction
+	BOOST_CHECK_EQUAL( Expression("abs(-1) + 2 * 3 > 6", variableNames).GetNInstructions(), 1u );
+	BOOST_CHECK( variableNames.empty() );
+}
+
+BOOST_AUTO_TEST_CASE( test_expression_variables )
+{
+	std::vector<std::string> variableNames;
+	Expression cut("nMuons>=2 && leadingMuonPt>25 && abs(leadingMuonEta)<2.1", variableNames);
+	Expression sum("leadingMuonPt + nMuons", variableNames);
+
+	// the variables are shared between the expressions
+	BOOST_REQUIRE_EQUAL( variableNames.size(), 3u );
+	BOOST_CHECK_EQUAL( variableNames[0], "nMuons" );
+	BOOST_CHECK_EQUAL( variableNames[1], "leadingMuonPt" );
+	BOOST_CHECK_EQUAL( variableNames[2], "leadingMuonEta" );
+
+	std::vector<double> values = { 2.0, 30.0, -1.5 };
+	std::vector<size_t> nLoads(values.size(), 0);
+	Expression::VariableLoader loader = [&values, &nLoads](size_t variableIndex) {
+		++nLoads[variableIndex];
+		return values[variableIndex];
+	};
+
+	BOOST_CHECK( cut.IsTrue(loader) );
+	BOOST_CHECK_EQUAL( sum.Evaluate(loader), 32.0 );
+
+	values[2] = -2.5;
+	BOOST_CHECK( ! cut.IsTrue(loader) );
+
+	// short-circuit evaluation: the other variables are not loaded if the first cut fails
+	values[0] = 1.0;
+	nLoads.assign(values.size(), 0);
+	BOOST_CHECK( ! cut.IsTrue(loader) );
+	BOOST_CHECK_EQUAL( nLoads[0], 1u );
+	BOOST_CHECK_EQUAL( nLoads[1], 0u );
+	BOOST_CHECK_EQUAL( nLoads[2], 0u );
+
+	nLoads.assign(values.size(), 0);
+	BOOST_CHECK( Expression("nMuons > 0 || leadingMuonPt > 0", variableNames).IsTrue(loader) );
+	BOOST_CHECK_EQUAL( nLoads[1], 0u );
+}
+
+BOOST_AUTO_TEST_CASE( test_expression_split_conjunction )
+{
+	std::vector<std::string> clauses = Expression::SplitConjunction(" nMuons>=2 && (a>1 && b>1) && abs(eta)<2.1 ");
+	BOOST_REQUIRE_EQUAL( clauses.size(), 3u );
+	BOOST_CHECK_EQUAL( clauses[0], "nMuons>=2" );
+	BOOST_CHECK_EQUAL( clauses[1], "(a>1 && b>1)" );
+	BOOST_CHECK_EQUAL( clauses[2], "abs(eta)<2.1" );
+
+	// a disjunction cannot be split
+	clauses = Expression::SplitConjunction("a && b || c");
+	BOOST_REQUIRE_EQUAL( clauses.size(), 1u );
+	BOOST_CHECK_EQUAL( clauses[0], "a && b || c" );
+}
+
+BOOST_AUTO_TEST_CASE( test_expression_conditional )
+{
+	std::vector<std::string> variableNames;
+	Expression::VariableLoader noVariables = [](size_t variableIndex) { return 0.0; };
+
+	BOOST_CHECK_EQUAL( Expression("1 < 2 ? 3 : 4", variableNames).Evaluate(noVariables), 3.0 );
+	BOOST_CHECK_EQUAL( Expression("0 ? 1 : 0 ? 2 : 3", variableNames).Evaluate(noVariables), 3.0 );
+	BOOST_CHECK_EQUAL( Expression("0 ? 1 : 0 ? 2 : 3", variableNames).GetNInstructions(), 1u );
+
+	Expression deltaEta("(nJets >= 2) ? abs(leadingJetEta - trailingJetEta) : -1", variableNames);
+	BOOST_REQUIRE_EQUAL( variableNames.size(), 3u );
+
+	std::vector<double> values = { 1.0, 1.5, -0.5 };
+	std::vector<size_t> nLoads(values.size(), 0);
+	Expression::VariableLoader loader = [&values, &nLoads](size_t variableIndex) {
+		++nLoads[variableIndex];
+		return values[variableIndex];
+	};
+
+	// only the selected branch is evaluated
+	BOOST_CHECK_EQUAL( deltaEta.Evaluate(loader), -1.0 );
+	BOOST_CHECK_EQUAL( nLoads[1], 0u );
+	BOOST_CHECK_EQUAL( nLoads[2], 0u );
+
+	values[0] = 2.0;
+	BOOST_CHECK_EQUAL( deltaEta.Evaluate(loader), 2.0 );
+
+	std::vector<std::string> clauses = Expression::SplitConjunction("a && b ? c : d");
+	BOOST_CHECK_EQUAL( clauses.size(), 1u );
+}
+
+BOOST_AUTO_TEST_CASE( test_expression_batch )
+{
+	std::vector<std::string> variableNames;
+	std::vector<Expression> expressions = {
+		Expression("(a > 0.5 && b < 0.5) ? max(a, b) * 2 : -abs(c - a)", variableNames),
+		Expression("a < 0.2 || !(b > 0.7) && sqrt(c) > 0.5", variableNames),
+		Expression("1 + 2", variableNames)
+	};
+
+	// more entries than one block and a remainder
+	size_t nEntries = 300;
+	std::vector<std::vector<double> > columns(variableNames.size(), std::vector<double>(nEntries));
+	for (size_t entry = 0; entry < nEntries; ++entry)
+	{
+		for (size_t variableIndex = 0; variableIndex < variableNames.size(); ++variableIndex)
+		{
+			columns[variableIndex][entry] = std::fmod(0.618034 * double((entry + 1) * (variableIndex + 3)), 1.0);
+		}
+	}
+	std::vector<double const*> variableValues;
+	for (size_t variableIndex = 0; variableIndex < variableNames.size(); ++variableIndex)
+	{
+		variableValues.push_back(columns[variableIndex].data());
+	}
+
+	for (std::vector<Expression>::const_iterator expression = expressions.begin(); expression != expressions.end(); ++expression)
+	{
+		std::vector<double> results(nEntries, 0.0);
+		expression->EvaluateBatch(variableValues, nEntries, results.data());
+		for (size_t entry = 0; entry < nEntries; ++entry)
+		{
+			Expression::VariableLoader loader = [&columns, entry](size_t variableIndex) {
+				return columns[variableIndex][entry];
+			};
+			BOOST_CHECK_EQUAL( results[entry], expression->Evaluate(loader) );
+		}
+	}
+}
+
@@ -11,6 +11,7 @@
 #include "Artus/Core/interface/FilterBase.h"
 #include "Artus/Core/interface/FilterResult.h"
 #include "Artus/Core/interface/CutFlow.h"
+#include "Artus/Core/interface/FilterDecisionCache.h"
 
 BOOST_AUTO_TEST_CASE( test_cut_flow )
 {
@@ -132,3 +133,27 @@ BOOST_AUTO_TEST_CASE( test_filter_result_copy_constr )
 	BOOST_CHECK( fres_local.GetFilterDecision("local1") == FilterResult::Decision::Passed );
 }
 
+
+BOOST_AUTO_TEST_CASE( test_filter_decision_cache )
+{
+	FilterDecisionCache cache;
+
+	FilterDecisionCache::SlotIndex slot1 = cache.RegisterFingerprint("filter1:1");
+	FilterDecisionCache::SlotIndex slot2 = cache.RegisterFingerprint("filter1:2");
+
+	BOOST_CHECK( slot1 != slot2 );
+	BOOST_CHECK_EQUAL( cache.RegisterFingerprint("filter1:1"), slot1 );
+	BOOST_CHECK_EQUAL( cache.GetNumberOfSlots(), size_t(2) );
+
+	cache.NewEvent();
+	BOOST_CHECK( cache.HasDecision(slot1) == false );
+
+	cache.SetDecision(slot1, true);
+	BOOST_CHECK( cache.HasDecision(slot1) == true );
+	BOOST_CHECK( cache.GetDecision(slot1) == true );
+	BOOST_CHECK( cache.HasDecision(slot2) == false );
+
+	// decisions must not survive the event
+	cache.NewEvent();
+	BOOST_CHECK( cache.HasDecision(slot1) == false );
+}
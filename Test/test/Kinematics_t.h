@@ -0,0 +1,242 @@
+/* Copyright (c) 2013 - All Rights Reserved
+ *   Thomas Hauth  <Thomas.Hauth@cern.ch>
+ *   Joram Berger  <Joram.Berger@cern.ch>
+ *   Dominik Haitz <Dominik.Haitz@kit.edu>
+ */
+
+#pragma once
+
+#include <chrono>
+#include <random>
+
+#include <boost/test/included/unit_test.hpp>
+
+#include <Math/LorentzVector.h>
+#include <Math/PtEtaPhiM4D.h>
+#include <Math/VectorUtil.h>
+
+#include "Artus/Utility/interface/Kinematics.h"
+
+typedef ROOT::Math::LorentzVector<ROOT::Math::PtEtaPhiM4D<double> > KinematicsTestVector;
+
+class KinematicsTestObjects
+{
+public:
+	KinematicsTestObjects(size_t size, unsigned int seed)
+	{
+		std::mt19937 generator(seed);
+		std::uniform_real_distribution<float> ptDistribution(1.0f, 200.0f);
+		std::uniform_real_distribution<float> etaDistribution(-5.0f, 5.0f);
+		std::uniform_real_distribution<float> phiDistribution(float(-M_PI), float(M_PI));
+		std::uniform_real_distribution<float> massDistribution(0.0f, 10.0f);
+		for (size_t index = 0; index < size; ++index)
+		{
+			pt.push_back(ptDistribution(generator));
+			eta.push_back(etaDistribution(generator));
+			phi.push_back(phiDistribution(generator));
+			mass.push_back(massDistribution(generator));
+		}
+	}
+
+	Kinematics::Objects GetObjects() const
+	{
+		return Kinematics::Objects(pt.data(), eta.data(), phi.data(), mass.data(), pt.size());
+	}
+
+	KinematicsTestVector GetVector(size_t index) const
+	{
+		return KinematicsTestVector(pt[index], eta[index], phi[index], mass[index]);
+	}
+
+	std::vector<float> pt;
+	std::vector<float> eta;
+	std::vector<float> phi;
+	std::vector<float> mass;
+};
+
+// all instruction sets supported by the machine running the tests
+inline std::vector<Kinematics::InstructionSet> GetKinematicsTestInstructionSets()
+{
+	std::vector<Kinematics::InstructionSet> instructionSets;
+	for (int instructionSet = static_cast<int>(Kinematics::InstructionSet::BASELINE);
+	     instructionSet <= static_cast<int>(Kinematics::GetBestSupportedInstructionSet()); ++instructionSet)
+	{
+		instructionSets.push_back(static_cast<Kinematics::InstructionSet>(instructionSet));
+	}
+	return instructionSets;
+}
+
+BOOST_AUTO_TEST_CASE(test_kinematics_instruction_set)
+{
+	BOOST_CHECK(Kinematics::GetInstructionSet() == Kinematics::GetBestSupportedInstructionSet());
+
+	Kinematics::SetInstructionSet(Kinematics::InstructionSet::BASELINE);
+	BOOST_CHECK(Kinematics::GetInstructionSet() == Kinematics::InstructionSet::BASELINE);
+	BOOST_CHECK_EQUAL(Kinematics::ToString(Kinematics::GetInstructionSet()), "baseline");
+
+	// unsupported instruction sets are not selected
+	Kinematics::SetInstructionSet(Kinematics::InstructionSet::AVX512);
+	BOOST_CHECK(Kinematics::GetInstructionSet() == Kinematics::GetBestSupportedInstructionSet());
+}
+
+BOOST_AUTO_TEST_CASE(test_kinematics_delta_r)
+{
+	// sizes below, at and above the block size of the kernels
+	std::vector<size_t> sizes = { 0, 1, 7, 16, 37 };
+	for (Kinematics::InstructionSet instructionSet : GetKinematicsTestInstructionSets())
+	{
+		Kinematics::SetInstructionSet(instructionSet);
+		BOOST_TEST_MESSAGE("Instruction set " << Kinematics::ToString(instructionSet));
+
+		for (size_t size1 : sizes)
+		{
+			for (size_t size2 : sizes)
+			{
+				KinematicsTestObjects objects1(size1, 1 + size1);
+				KinematicsTestObjects objects2(size2, 100 + size2);
+
+				std::vector<float> deltaR2(size1 * size2);
+				Kinematics::DeltaR2Matrix(objects1.GetObjects(), objects2.GetObjects(), deltaR2.data());
+				for (size_t index1 = 0; index1 < size1; ++index1)
+				{
+					for (size_t index2 = 0; index2 < size2; ++index2)
+					{
+						double deltaR = ROOT::Math::VectorUtil::DeltaR(objects1.GetVector(index1), objects2.GetVector(index2));
+						BOOST_CHECK_SMALL(std::sqrt(deltaR2[(index1 * size2) + index2]) - deltaR, 1e-4);
+					}
+				}
+
+				if (size1 == size2)
+				{
+					std::vector<float> deltaPhi(size1);
+					Kinematics::DeltaPhi(objects1.phi.data(), objects2.phi.data(), size1, deltaPhi.data());
+					for (size_t index = 0; index < size1; ++index)
+					{
+						// VectorUtil::DeltaPhi(v1, v2) is phi2 - phi1, the wrapping at +-pi may differ due to rounding
+						double reference = ROOT::Math::VectorUtil::DeltaPhi(objects2.GetVector(index), objects1.GetVector(index));
+						BOOST_CHECK_SMALL(std::remainder(deltaPhi[index] - reference, 2.0 * M_PI), 1e-5);
+						BOOST_CHECK(std::fabs(deltaPhi[index]) <= float(M_PI));
+					}
+				}
+
+				// the closest objects are those with the smallest entries in the delta R matrix
+				float deltaRMax = 1.0f;
+				std::vector<int> matchedIndices(size1);
+				Kinematics::MatchDeltaR(objects1.GetObjects(), objects2.GetObjects(), deltaRMax, matchedIndices.data());
+				for (size_t index1 = 0; index1 < size1; ++index1)
+				{
+					int expectedIndex = -1;
+					float deltaR2Min = deltaRMax * deltaRMax;
+					for (size_t index2 = 0; index2 < size2; ++index2)
+					{
+						if (deltaR2[(index1 * size2) + index2] < deltaR2Min)
+						{
+							deltaR2Min = deltaR2[(index1 * size2) + index2];
+							expectedIndex = static_cast<int>(index2);
+						}
+					}
+					BOOST_CHECK_EQUAL(matchedIndices[index1], expectedIndex);
+				}
+			}
+		}
+	}
+	Kinematics::SetInstructionSet(Kinematics::GetBestSupportedInstructionSet());
+}
+
+BOOST_AUTO_TEST_CASE(test_kinematics_match_delta_r)
+{
+	std::vector<float> pt = { 10.0f, 20.0f, 30.0f };
+	std::vector<float> eta1 = { 0.0f, 1.0f, -2.0f };
+	std::vector<float> phi1 = { 0.0f, 3.1f, 1.0f };
+	std::vector<float> eta2 = { 1.05f, 0.2f, -0.2f, 5.0f };
+	std::vector<float> phi2 = { -3.1f, 0.0f, 0.0f, 1.0f };
+	Kinematics::Objects objects1(pt.data(), eta1.data(), phi1.data(), nullptr, eta1.size());
+	Kinematics::Objects objects2(pt.data(), eta2.data(), phi2.data(), nullptr, eta2.size());
+
+	// equal distances lead to the first object, matching across phi = pi
+	std::vector<int> matchedIndices(objects1.size);
+	Kinematics::MatchDeltaR(objects1, objects2, 0.3f, matchedIndices.data());
+	BOOST_CHECK_EQUAL(matchedIndices[0], 1);
+	BOOST_CHECK_EQUAL(matchedIndices[1], 0);
+	BOOST_CHECK_EQUAL(matchedIndices[2], -1);
+}
+
+BOOST_AUTO_TEST_CASE(test_kinematics_select_and_mass)
+{
+	for (Kinematics::InstructionSet instructionSet : GetKinematicsTestInstructionSets())
+	{
+		Kinematics::SetInstructionSet(instructionSet);
+		BOOST_TEST_MESSAGE("Instruction set " << Kinematics::ToString(instructionSet));
+
+		for (size_t size : { 0, 5, 16, 41 })
+		{
+			KinematicsTestObjects objects1(size, 7 + size);
+			KinematicsTestObjects objects2(size + 3, 70 + size);
+
+			std::vector<unsigned char> selected(size);
+			size_t nSelected = Kinematics::SelectPtAbsEta(objects1.GetObjects(), 50.0f, 2.4f, selected.data());
+			size_t nExpected = 0;
+			for (size_t index = 0; index < size; ++index)
+			{
+				bool expected = ((objects1.pt[index] > 50.0f) && (std::fabs(objects1.eta[index]) < 2.4f));
+				BOOST_CHECK_EQUAL(selected[index], (expected ? 1 : 0));
+				nExpected += (expected ? 1 : 0);
+			}
+			BOOST_CHECK_EQUAL(nSelected, nExpected);
+
+			std::vector<float> mass(objects1.pt.size() * objects2.pt.size());
+			Kinematics::PairMassMatrix(objects1.GetObjects(), objects2.GetObjects(), mass.data());
+			for (size_t index1 = 0; index1 < objects1.pt.size(); ++index1)
+			{
+				for (size_t index2 = 0; index2 < objects2.pt.size(); ++index2)
+				{
+					double reference = (objects1.GetVector(index1) + objects2.GetVector(index2)).M();
+					BOOST_CHECK_SMALL(mass[(index1 * objects2.pt.size()) + index2] - reference, 1e-5 * std::max(reference, 1.0));
+				}
+			}
+		}
+	}
+	Kinematics::SetInstructionSet(Kinematics::GetBestSupportedInstructionSet());
+}
+
+// reports the timings of the kernels for all instruction sets, run with --log_level=message
+BOOST_AUTO_TEST_CASE(test_kinematics_benchmark)
+{
+	KinematicsTestObjects objects1(64, 11);
+	KinematicsTestObjects objects2(64, 12);
+	std::vector<float> deltaR2(objects1.pt.size() * objects2.pt.size());
+	std::vector<float> mass(objects1.pt.size() * objects2.pt.size());
+	std::vector<int> matchedIndices(objects1.pt.size());
+	const size_t nRepetitions = 1000;
+
+	for (Kinematics::InstructionSet instructionSet : GetKinematicsTestInstructionSets())
+	{
+		Kinematics::SetInstructionSet(instructionSet);
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for (size_t repetition = 0; repetition < nRepetitions; ++repetition)
+		{
+			Kinematics::DeltaR2Matrix(objects1.GetObjects(), objects2.GetObjects(), deltaR2.data());
+		}
+		std::chrono::steady_clock::time_point deltaR2End = std::chrono::steady_clock::now();
+		for (size_t repetition = 0; repetition < nRepetitions; ++repetition)
+		{
+			Kinematics::PairMassMatrix(objects1.GetObjects(), objects2.GetObjects(), mass.data());
+		}
+		std::chrono::steady_clock::time_point massEnd = std::chrono::steady_clock::now();
+		for (size_t repetition = 0; repetition < nRepetitions; ++repetition)
+		{
+			Kinematics::MatchDeltaR(objects1.GetObjects(), objects2.GetObjects(), 0.5f, matchedIndices.data());
+		}
+		std::chrono::steady_clock::time_point matchEnd = std::chrono::steady_clock::now();
+
+		typedef std::chrono::duration<double, std::micro> Microseconds;
+		BOOST_TEST_MESSAGE("Kinematics (" << Kinematics::ToString(instructionSet) << ", 64 x 64 objects, " << nRepetitions << " calls): "
+		                   << "DeltaR2Matrix " << Microseconds(deltaR2End - start).count() << " us, "
+		                   << "PairMassMatrix " << Microseconds(massEnd - deltaR2End).count() << " us, "
+		                   << "MatchDeltaR " << Microseconds(matchEnd - massEnd).count() << " us");
+		BOOST_CHECK(deltaR2.size() == mass.size());
+	}
+	Kinematics::SetInstructionSet(Kinematics::GetBestSupportedInstructionSet());
+}
+
@@ -0,0 +1,153 @@
+/* Copyright (c) 2013 - All Rights Reserved
+ *   Thomas Hauth  <Thomas.Hauth@cern.ch>
+ *   Joram Berger  <Joram.Berger@cern.ch>
+ *   Dominik Haitz <Dominik.Haitz@kit.edu>
+ */
+
+#pragma once
+
+#include <boost/test/included/unit_test.hpp>
+
+#include "Artus/Consumer/interface/LambdaNtupleConsumer.h"
+
+#include "TestTypes.h"
+
+// the same lambda expression registered with the settings of different pipelines
+static void RegisterOffsetQuantity(int offset)
+{
+	LambdaNtupleConsumer<TestTypes>::AddIntQuantity("testOffsetValue", [offset](TestEvent const& event, TestProduct const&)
+	{
+		return event.iVal + offset;
+	});
+}
+
+static int EvaluateIntQuantity(std::string const& pipelineName, std::string const& name,
+                               TestEvent const& event, TestProduct const& product)
+{
+	LambdaNtupleQuantities::Registration registration = LambdaNtupleQuantities::Find(
+			pipelineName, LambdaNtupleQuantities::GetQuantityId(name));
+	BOOST_REQUIRE(registration.type == LambdaNtupleQuantities::Type::Int);
+	return LambdaNtupleQuantities::GetExtractor<int>(registration.index)(event, product);
+}
+
+BOOST_AUTO_TEST_CASE(test_lambda_ntuple_quantities_registration)
+{
+	TestEvent event;
+	event.iVal = 10;
+	TestProduct product;
+
+	// lambda expressions with captures replace the registered extractor
+	RegisterOffsetQuantity(1);
+	BOOST_CHECK_EQUAL(EvaluateIntQuantity("pipeline1", "testOffsetValue", event, product), 11);
+	RegisterOffsetQuantity(2);
+	BOOST_CHECK_EQUAL(EvaluateIntQuantity("pipeline1", "testOffsetValue", event, product), 12);
+
+	// repeated registrations of lambda expressions without captures are ignored
+	for (int registration = 0; registration < 2; ++registration)
+	{
+		LambdaNtupleConsumer<TestTypes>::AddIntQuantity("testValue", [](TestEvent const& event, TestProduct const&)
+		{
+			return event.iVal;
+		});
+	}
+	size_t index = LambdaNtupleQuantities::Find("pipeline1", LambdaNtupleQuantities::GetQuantityId("testValue")).index;
+	LambdaNtupleConsumer<TestTypes>::AddIntQuantity("testValue", [](TestEvent const& event, TestProduct const&)
+	{
+		return 2 * event.iVal;
+	});
+	BOOST_CHECK_EQUAL(LambdaNtupleQuantities::Find("pipeline1", LambdaNtupleQuantities::GetQuantityId("testValue")).index, index);
+	BOOST_CHECK_EQUAL(EvaluateIntQuantity("pipeline1", "testValue", event, product), 20);
+
+	// extractors of a pipeline take precedence over the common ones
+	TestSettings settings("pipeline2");
+	LambdaNtupleConsumer<TestTypes>::AddIntQuantity(settings, "testValue", [](TestEvent const& event, TestProduct const&)
+	{
+		return 3 * event.iVal;
+	});
+	BOOST_CHECK_EQUAL(EvaluateIntQuantity("pipeline1", "testValue", event, product), 20);
+	BOOST_CHECK_EQUAL(EvaluateIntQuantity("pipeline2", "testValue", event, product), 30);
+	BOOST_CHECK(LambdaNtupleConsumer<TestTypes>::HasQuantity(settings, "testValue", LambdaNtupleQuantities::Type::Int));
+	BOOST_CHECK(! LambdaNtupleConsumer<TestTypes>::HasQuantity(settings, "testValue", LambdaNtupleQuantities::Type::Float));
+}
+
+BOOST_AUTO_TEST_CASE(test_lambda_ntuple_quantities_compatibility)
+{
+	TestEvent event;
+	event.iVal = 4;
+	TestProduct product;
+
+	BOOST_CHECK_EQUAL(LambdaNtupleConsumer<TestTypes>::GetFloatQuantities().count("testCompatibilityValue"), 0);
+	BOOST_CHECK_THROW(LambdaNtupleConsumer<TestTypes>::GetFloatQuantities().at("testCompatibilityValue"), std::out_of_range);
+
+	LambdaNtupleConsumer<TestTypes>::GetFloatQuantities()["testCompatibilityValue"] = [](EventBase const& event, ProductBase const&)
+	{
+		return 0.5f * static_cast<float>(static_cast<TestEvent const&>(event).iVal);
+	};
+	BOOST_CHECK_EQUAL(LambdaNtupleConsumer<TestTypes>::GetFloatQuantities().count("testCompatibilityValue"), 1);
+	BOOST_CHECK_EQUAL(LambdaNtupleConsumer<TestTypes>::GetIntQuantities().count("testCompatibilityValue"), 0);
+	BOOST_CHECK_EQUAL(LambdaNtupleConsumer<TestTypes>::GetFloatQuantities().at("testCompatibilityValue")(event, product), 2.0f);
+
+	// the entries are registered as common quantities
+	BOOST_CHECK(LambdaNtupleQuantities::HasQuantity("pipeline1", "testCompatibilityValue", LambdaNtupleQuantities::Type::Float));
+
+	// copying an entry copies the extractor
+	LambdaNtupleConsumer<TestTypes>::GetFloatQuantities()["testCompatibilityCopy"] =
+			LambdaNtupleConsumer<TestTypes>::GetFloatQuantities()["testCompatibilityValue"];
+	BOOST_CHECK_EQUAL(LambdaNtupleQuantities::CommonFloatQuantities.at("testCompatibilityCopy")(event, product), 2.0f);
+}
+
+BOOST_AUTO_TEST_CASE(test_derived_quantities)
+{
+	LambdaNtupleConsumer<TestTypes>::AddIntQuantity("testDerivedInput", [](TestEvent const& event, TestProduct const&)
+	{
+		return event.iVal;
+	});
+
+	std::shared_ptr<DerivedQuantities const> derivedQuantities = std::make_shared<DerivedQuantities const>(
+			"pipelineDerived", std::vector<std::string>{
+					"testDerivedDouble := 2 * testDerivedInput",
+					"testDerivedSelect := (testDerivedDouble > 5) ? testDerivedDouble : -1"
+			});
+	BOOST_CHECK_EQUAL(derivedQuantities->GetNQuantities(), 2);
+	BOOST_CHECK_EQUAL(derivedQuantities->GetIndex("testDerivedSelect"), 1);
+	BOOST_CHECK_EQUAL(derivedQuantities->GetIndex("testDerivedInput"), 2);
+
+	BOOST_CHECK(! DerivedQuantities::Get("pipelineDerived"));
+	DerivedQuantities::Register("pipelineDerived", derivedQuantities);
+	BOOST_CHECK_EQUAL(DerivedQuantities::Get("pipelineDerived").get(), derivedQuantities.get());
+
+	// the derived quantities are only registered for their pipeline
+	BOOST_CHECK(LambdaNtupleQuantities::HasQuantity("pipelineDerived", "testDerivedSelect", LambdaNtupleQuantities::Type::Double));
+	BOOST_CHECK(! LambdaNtupleQuantities::HasQuantity("pipeline1", "testDerivedSelect", LambdaNtupleQuantities::Type::Double));
+
+	LambdaNtupleQuantities::Registration registration = LambdaNtupleQuantities::Find(
+			"pipelineDerived", LambdaNtupleQuantities::GetQuantityId("testDerivedSelect"));
+	LambdaNtupleQuantities::Extractor<double>::type extractor = LambdaNtupleQuantities::GetExtractor<double>(registration.index);
+
+	// the evaluation of buffered events agrees with the evaluation of single events
+	DerivedQuantitiesBuffer buffer;
+	buffer.Init(derivedQuantities);
+	TestProduct product;
+	std::vector<double> expectedValues;
+	for (int value = 0; value < 300; ++value)
+	{
+		TestEvent event;
+		event.iVal = value % 7;
+		buffer.BufferInputs(event, product);
+		expectedValues.push_back(extractor(event, product));
+		BOOST_CHECK_EQUAL(expectedValues.back(), ((event.iVal > 2) ? 2.0 * event.iVal : -1.0));
+	}
+	BOOST_REQUIRE_EQUAL(buffer.GetNBufferedEntries(), expectedValues.size());
+	BOOST_REQUIRE_EQUAL(buffer.EvaluateBuffer(), expectedValues.size());
+	BOOST_CHECK_EQUAL(buffer.GetNBufferedEntries(), 0);
+	for (size_t entry = 0; entry < expectedValues.size(); ++entry)
+	{
+		BOOST_CHECK_EQUAL(buffer.GetValue(1, entry), expectedValues[entry]);
+	}
+
+	// buffers without derived quantities
+	DerivedQuantitiesBuffer emptyBuffer;
+	emptyBuffer.Init(nullptr);
+	BOOST_CHECK_EQUAL(emptyBuffer.GetNQuantities(), 0);
+	BOOST_CHECK_EQUAL(emptyBuffer.GetIndex("testDerivedSelect"), emptyBuffer.GetNQuantities());
+}
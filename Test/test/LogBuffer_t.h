@@ -0,0 +1,49 @@
+/* Copyright (c) 2013 - All Rights Reserved
+ *   Thomas Hauth  <Thomas.Hauth@cern.ch>
+ *   Joram Berger  <Joram.Berger@cern.ch>
+ *   Dominik Haitz <Dominik.Haitz@kit.edu>
+ */
+
+#pragma once
+
+#include <thread>
+
+#include <boost/test/included/unit_test.hpp>
+
+#include "Artus/Utility/interface/LogBuffer.h"
+
+BOOST_AUTO_TEST_CASE(test_log_buffer)
+{
+	LogBuffer::Install();
+
+	LogBuffer buffer1;
+	LogBuffer buffer2;
+	std::thread thread([&buffer2]() {
+		buffer2.Activate();
+		LOG(WARNING) << "buffered message of the second thread";
+		buffer2.Deactivate();
+	});
+	buffer1.Activate();
+	LOG(WARNING) << "buffered message of the first thread";
+	LOG(WARNING) << "buffered message of the first thread";
+	buffer1.Deactivate();
+	thread.join();
+
+	// only the messages of the thread are kept in a buffer
+	BOOST_CHECK_EQUAL(buffer1.GetNumberOfMessages(), 2);
+	BOOST_CHECK_EQUAL(buffer2.GetNumberOfMessages(), 1);
+
+	// flushed messages end up in the buffer active in the flushing thread, if any
+	LogBuffer buffer3;
+	buffer3.Activate();
+	buffer1.Flush();
+	buffer3.Deactivate();
+	BOOST_CHECK_EQUAL(buffer1.GetNumberOfMessages(), 0);
+	BOOST_CHECK_EQUAL(buffer3.GetNumberOfMessages(), 2);
+
+	LogBuffer::Uninstall();
+	buffer2.Flush();
+	buffer3.Flush();
+	BOOST_CHECK_EQUAL(buffer2.GetNumberOfMessages(), 0);
+	BOOST_CHECK_EQUAL(buffer3.GetNumberOfMessages(), 0);
+}
@@ -0,0 +1,83 @@
+/* Copyright (c) 2013 - All Rights Reserved
+ *   Thomas Hauth  <Thomas.Hauth@cern.ch>
+ *   Joram Berger  <Joram.Berger@cern.ch>
+ *   Dominik Haitz <Dominik.Haitz@kit.edu>
+ */
+
+#pragma once
+
+#include <boost/test/included/unit_test.hpp>
+
+#include "Artus/Core/interface/PipelineResults.h"
+#include "Artus/Consumer/interface/CutFlowConsumerBase.h"
+#include "Artus/Consumer/interface/CutFlowSummaryConsumer.h"
+
+#include "TestPipeline.h"
+#include "TestPipelineRunner.h"
+#include "TestEventProvider.h"
+#include "TestFilter.h"
+
+BOOST_AUTO_TEST_CASE( test_pipeline_results )
+{
+	int borrowed = 5;
+	PipelineResults::Register("pline1", "borrowed", &borrowed);
+	PipelineResults::Register("pline1", "owned", std::shared_ptr<double>(new double(2.5)));
+	PipelineResults::Register("pline2", "owned", std::shared_ptr<double>(new double(3.5)));
+
+	BOOST_CHECK( PipelineResults::Has("pline1", "borrowed") );
+	BOOST_CHECK( ! PipelineResults::Has("pline2", "borrowed") );
+
+	// borrowed objects are not copied
+	BOOST_CHECK_EQUAL( PipelineResults::Get<int>("pline1", "borrowed").get(), &borrowed );
+	BOOST_CHECK_EQUAL( *PipelineResults::Get<double>("pline2", "owned"), 3.5 );
+	BOOST_CHECK( ! PipelineResults::GetWithDefault<double>("pline2", "missing") );
+
+	// the object name may contain the characters used in cut expressions
+	PipelineResults::Register("pline1", "a/b>1", std::shared_ptr<double>(new double(4.5)));
+	BOOST_CHECK_EQUAL( *PipelineResults::Get<double>("pline1", "a/b>1"), 4.5 );
+	BOOST_CHECK_EQUAL( PipelineResults::GetAll<double>("b>1").size(), 0 );
+
+	std::map<std::string, std::shared_ptr<double> > all = PipelineResults::GetAll<double>("owned");
+	BOOST_CHECK_EQUAL( all.size(), 2 );
+	BOOST_CHECK_EQUAL( *all["pline1"], 2.5 );
+	BOOST_CHECK_EQUAL( *all["pline2"], 3.5 );
+
+	PipelineResults::Clear();
+	BOOST_CHECK( ! PipelineResults::Has("pline1", "owned") );
+}
+
+BOOST_AUTO_TEST_CASE( test_pipeline_results_cut_flow_hand_over )
+{
+	TestPipeline * tline1 = new TestPipeline;
+	tline1->AddFilter( new TestFilter );
+	tline1->AddConsumer( new CutFlowConsumerBase<TestTypes> );
+
+	TestPipeline * tline2 = new TestPipeline;
+	CutFlowSummaryConsumer<TestTypes> * pSummary = new CutFlowSummaryConsumer<TestTypes>;
+	tline2->AddConsumer( pSummary );
+
+	tline1->InitPipeline( TestSettings( "lvl1" ), TestPipelineInitializer() );
+	TestSettings tset_lvl2( "lvl2" );
+	tset_lvl2.SetLevel(2);
+	tline2->InitPipeline( tset_lvl2, TestPipelineInitializer() );
+
+	std::map<std::string, std::shared_ptr<CutFlow> > cutFlows;
+	{
+		TestPipelineRunner prunner(false);
+		prunner.ClearProgressReports();
+		prunner.AddPipeline( tline1 );
+		prunner.AddPipeline( tline2 );
+
+		TestEventProvider evtProvider;
+		prunner.RunPipelines( evtProvider, TestSettings() );
+
+		cutFlows = pSummary->GetCutFlows();
+	}
+
+	// the handed over cut flow is a copy, which outlives the level one consumer
+	BOOST_REQUIRE_EQUAL( cutFlows.size(), 1 );
+	BOOST_REQUIRE( cutFlows["lvl1"] );
+	BOOST_CHECK_EQUAL( cutFlows["lvl1"]->GetEventCount(), 10 );
+	BOOST_CHECK_EQUAL( cutFlows["lvl1"]->GetCutCount().size(), 1 );
+	BOOST_CHECK_EQUAL( cutFlows["lvl1"]->GetCutCount().front().first, "testfilter" );
+}
@@ -18,6 +18,10 @@
 
 #include <boost/test/included/unit_test.hpp>
 
+#include <cstdio>
+#include <fstream>
+#include <numeric>
+
 BOOST_AUTO_TEST_CASE( test_event_prunner_global_product )
 {
 	TestPipelineInstr * tline1 = new TestPipelineInstr;
@@ -235,3 +239,202 @@ BOOST_AUTO_TEST_CASE( test_event_prunner_multi_level )
 	// could be changed at a later stage
 	tline3->CheckCalls(0,1);
 }
+
+BOOST_AUTO_TEST_CASE( test_event_prunner_multi_level_parallel )
+{
+	TestPipeline * tline1 = new TestPipeline;
+	TestResultProducingConsumer * pCons1 = new TestResultProducingConsumer;
+	tline1->AddConsumer( pCons1 );
+
+	std::vector<TestPipeline*> lvl2Pipelines;
+	std::vector<TestResultReadingConsumer*> lvl2Consumers;
+	for (int i = 0; i < 4; ++i)
+	{
+		lvl2Pipelines.push_back( new TestPipeline );
+		lvl2Consumers.push_back( new TestResultReadingConsumer( "lvl1" ) );
+		lvl2Pipelines.back()->AddConsumer( lvl2Consumers.back() );
+	}
+
+	TestSettings tset_lvl1( "lvl1" );
+	tline1->InitPipeline( tset_lvl1, TestPipelineInitializer() );
+	for (size_t i = 0; i < lvl2Pipelines.size(); ++i)
+	{
+		TestSettings tset_lvl2( "lvl2_" + std::to_string(i) );
+		tset_lvl2.SetLevel(2);
+		lvl2Pipelines[i]->InitPipeline( tset_lvl2, TestPipelineInitializer() );
+	}
+
+	TestSettings global_tset;
+	global_tset.SetPostProcessingThreads(2);
+
+	TestPipelineRunner prunner(false);
+	// don't show progress report in this test cases
+	prunner.ClearProgressReports();
+	prunner.AddPipeline( tline1 );
+	prunner.AddPipelines( lvl2Pipelines );
+
+	TestEventProvider evtProvider;
+	prunner.RunPipelines ( evtProvider, global_tset );
+
+	// the level two pipelines read the result of level one from memory
+	for (TestResultReadingConsumer * pCons : lvl2Consumers)
+	{
+		BOOST_CHECK_EQUAL( pCons->m_nEvents, 10 );
+	}
+	// the registry is cleared after the pipelines have been run
+	BOOST_CHECK( ! PipelineResults::Has( "lvl1", "nEvents" ) );
+}
+
+BOOST_AUTO_TEST_CASE( test_event_prunner_shared_filter )
+{
+	int sharedFilterCalls = 0;
+
+	// both pipelines run the same filter directly on the global product
+	TestPipeline * tline1 = new TestPipeline;
+	TestPipeline * tline2 = new TestPipeline;
+	// the local producer runs before the filter in this pipeline
+	TestPipeline * tline3 = new TestPipeline;
+
+	TestConsumer * pCons1 = new TestConsumer(false);
+	TestConsumer * pCons2 = new TestConsumer(false);
+	TestConsumer * pCons3 = new TestConsumer(false);
+
+	tline1->AddFilter( new TestSharedFilter( &sharedFilterCalls ) );
+	tline1->AddConsumer( pCons1 );
+	tline2->AddFilter( new TestSharedFilter( &sharedFilterCalls ) );
+	tline2->AddConsumer( pCons2 );
+	tline3->AddProducer( new TestLocalProducer() );
+	tline3->AddFilter( new TestSharedFilter( &sharedFilterCalls ) );
+	tline3->AddConsumer( pCons3 );
+
+	TestSettings global_tset;
+	tline1->InitPipeline( TestSettings("1"), TestPipelineInitializer() );
+	tline2->InitPipeline( TestSettings("2"), TestPipelineInitializer() );
+	tline3->InitPipeline( TestSettings("3"), TestPipelineInitializer() );
+
+	TestPipelineRunner prunner(false);
+	// don't show progress report in this test cases
+	prunner.ClearProgressReports();
+	prunner.AddPipelines( { tline1, tline2, tline3 } );
+
+	TestEventProvider evtProvider;
+	prunner.RunPipelines ( evtProvider, global_tset );
+
+	// one evaluation per event for the first two pipelines
+	// and one for the third pipeline
+	BOOST_CHECK_EQUAL( sharedFilterCalls, 20 );
+	pCons1->CheckCalls(10, 10);
+	pCons2->CheckCalls(10, 10);
+	pCons3->CheckCalls(10, 10);
+	BOOST_CHECK( pCons2->fres.GetFilterDecision("testsharedfilter") == FilterResult::Decision::Passed );
+}
+
+BOOST_AUTO_TEST_CASE( test_event_prunner_checkpoint )
+{
+	TestSettings global_tset;
+	global_tset.SetCheckpointFile("test_prunner_checkpoint.json");
+	global_tset.SetCheckpointEveryNEvents(4);
+
+	// first job is interrupted by the batch system after six events
+	{
+		TestPipeline * tline = new TestPipeline;
+		TestCheckpointConsumer * pCons = new TestCheckpointConsumer(6);
+		tline->AddConsumer( pCons );
+		tline->InitPipeline( TestSettings("1"), TestPipelineInitializer() );
+
+		TestPipelineRunner prunner(false);
+		// don't show progress report in this test cases
+		prunner.ClearProgressReports();
+		prunner.AddPipeline( tline );
+
+		TestEventProvider evtProvider;
+		prunner.RunPipelines ( evtProvider, global_tset );
+
+		BOOST_CHECK_EQUAL( pCons->m_nEvents, 6 );
+		BOOST_CHECK( Checkpoint(global_tset.GetCheckpointFile()).Exists() );
+	}
+
+	// second job resumes and processes the remaining events
+	{
+		TestPipeline * tline = new TestPipeline;
+		TestCheckpointConsumer * pCons = new TestCheckpointConsumer;
+		tline->AddConsumer( pCons );
+		tline->InitPipeline( TestSettings("1"), TestPipelineInitializer() );
+
+		TestPipelineRunner prunner(false);
+		// don't show progress report in this test cases
+		prunner.ClearProgressReports();
+		prunner.AddPipeline( tline );
+
+		TestEventProvider evtProvider;
+		prunner.RunPipelines ( evtProvider, global_tset );
+
+		BOOST_CHECK_EQUAL( pCons->m_nEvents, 10 );
+		// the job is complete, therefore the checkpoint is removed
+		BOOST_CHECK( ! Checkpoint(global_tset.GetCheckpointFile()).Exists() );
+	}
+}
+
+BOOST_AUTO_TEST_CASE( test_event_prunner_fork )
+{
+	const std::string fileName = "test_prunner_fork.txt";
+	std::remove(fileName.c_str());
+
+	TestPipeline * tline = new TestPipeline;
+	TestForkConsumer * pCons = new TestForkConsumer(fileName);
+	tline->AddConsumer( pCons );
+	tline->InitPipeline( TestSettings("1"), TestPipelineInitializer() );
+
+	TestSettings global_tset;
+	global_tset.SetForkWorkers(3);
+
+	TestPipelineRunner prunner(false);
+	// don't show progress report in this test cases
+	prunner.ClearProgressReports();
+	prunner.AddPipeline( tline );
+
+	TestEventProvider evtProvider;
+	prunner.RunPipelines ( evtProvider, global_tset );
+
+	// the events are processed by the workers only
+	BOOST_CHECK_EQUAL( pCons->m_nEvents, 0 );
+
+	// one line per worker and one for this process
+	std::ifstream file(fileName.c_str());
+	std::vector<int> nEvents;
+	int nWorkerEvents = 0;
+	while (file >> nWorkerEvents)
+	{
+		nEvents.push_back(nWorkerEvents);
+	}
+	BOOST_CHECK_EQUAL( nEvents.size(), 4 );
+	BOOST_CHECK_EQUAL( std::accumulate(nEvents.begin(), nEvents.end(), 0), 10 );
+	std::remove(fileName.c_str());
+}
+
+BOOST_AUTO_TEST_CASE( test_event_prunner_fork_cut_flow )
+{
+	TestPipeline * tline = new TestPipeline;
+	TestCutFlowConsumer * pCons = new TestCutFlowConsumer;
+	tline->AddFilter( new TestFilter );
+	tline->AddConsumer( pCons );
+	tline->InitPipeline( TestSettings("1"), TestPipelineInitializer() );
+
+	TestSettings global_tset;
+	global_tset.SetForkWorkers(3);
+
+	TestPipelineRunner prunner(false);
+	// don't show progress report in this test cases
+	prunner.ClearProgressReports();
+	prunner.AddPipeline( tline );
+
+	TestEventProvider evtProvider;
+	prunner.RunPipelines ( evtProvider, global_tset );
+
+	// the counts of all workers are merged into the consumer of this process
+	BOOST_CHECK_EQUAL( pCons->GetCutFlow().GetEventCount(), 10 );
+	BOOST_REQUIRE_EQUAL( pCons->GetCutFlow().GetCutCount().size(), 1 );
+	BOOST_CHECK_EQUAL( pCons->GetCutFlow().GetCutCount().front().first, "testfilter" );
+	BOOST_CHECK_EQUAL( pCons->GetCutFlow().GetCutCount().front().second, 10 );
+}
+
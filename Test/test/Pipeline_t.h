@@ -12,6 +12,7 @@
 #include <boost/noncopyable.hpp>
 #include <boost/ptr_container/ptr_vector.hpp>
 
+#include "Artus/Core/interface/CutFlow.h"
 #include "Artus/Core/interface/Pipeline.h"
 
 #include "TestGlobalProducer.h"
@@ -212,6 +213,58 @@ BOOST_AUTO_TEST_CASE( test_multiplefilter_producer_stop_exec )
 	BOOST_CHECK( pCons1->fres.HasPassed() == false);
 }
 
+BOOST_AUTO_TEST_CASE( test_filter_cut_decisions )
+{
+	TestConsumer * pCons1 = new TestConsumer( false );
+
+	Pipeline<TestTypes> pline;
+	pline.AddConsumer( pCons1 );
+	pline.AddFilter( new TestCutsFilter() );
+
+	TestPipelineInitializer init;
+	TestSettings settings;
+	pline.InitPipeline( settings, init );
+
+	CutFlow cutFlow;
+	TestProduct product;
+	FilterResult globalFilterResult;
+	TestEvent td;
+
+	// all cuts passed
+	td.iVal = 0;
+	pline.RunEvent(td, product, globalFilterResult);
+	cutFlow.AddFilterResult(pCons1->fres);
+	BOOST_CHECK( pCons1->fres.GetFilterDecisions().size() == 4 );
+	BOOST_CHECK( pCons1->fres.GetFilterDecision("testcutsfilter") == FilterResult::Decision::Passed );
+	BOOST_CHECK( pCons1->fres.GetFilterDecision("testcutsfilter:zero") == FilterResult::Decision::Passed );
+
+	// the last cut fails
+	td.iVal = 1;
+	pline.RunEvent(td, product, globalFilterResult);
+	cutFlow.AddFilterResult(pCons1->fres);
+	BOOST_CHECK( pCons1->fres.GetFilterDecision("testcutsfilter") == FilterResult::Decision::NotPassed );
+	BOOST_CHECK( pCons1->fres.GetFilterDecision("testcutsfilter:small") == FilterResult::Decision::Passed );
+	BOOST_CHECK( pCons1->fres.GetFilterDecision("testcutsfilter:zero") == FilterResult::Decision::NotPassed );
+
+	// the cuts after the first failing one are not evaluated
+	td.iVal = 5;
+	pline.RunEvent(td, product, globalFilterResult);
+	cutFlow.AddFilterResult(pCons1->fres);
+	BOOST_CHECK( pCons1->fres.GetFilterDecision("testcutsfilter:positive") == FilterResult::Decision::Passed );
+	BOOST_CHECK( pCons1->fres.GetFilterDecision("testcutsfilter:small") == FilterResult::Decision::NotPassed );
+	BOOST_CHECK( pCons1->fres.GetFilterDecision("testcutsfilter:zero") == FilterResult::Decision::Undefined );
+
+	pline.FinishPipeline();
+
+	// the cut flow is in the order of the cuts
+	CutFlow::CutCount expectedCutFlow;
+	expectedCutFlow.push_back(std::make_pair("testcutsfilter", 1));
+	expectedCutFlow.push_back(std::make_pair("testcutsfilter:positive", 3));
+	expectedCutFlow.push_back(std::make_pair("testcutsfilter:small", 2));
+	expectedCutFlow.push_back(std::make_pair("testcutsfilter:zero", 1));
+	BOOST_CHECK( cutFlow.GetCutCount() == expectedCutFlow );
+}
+
 BOOST_AUTO_TEST_CASE( test_event_pipeline_level2 )
 {
 	TestConsumer * pCons1 = new TestConsumer();
@@ -237,3 +290,16 @@ BOOST_AUTO_TEST_CASE( test_event_pipeline_level2 )
 	pCons2->CheckCalls(0,0,2);
 }
 
+
+BOOST_AUTO_TEST_CASE( test_pipeline_checkpoint_support )
+{
+	Pipeline<TestTypes> pline;
+
+	pline.AddConsumer( new TestConsumer() );
+	pline.AddConsumer( new TestCheckpointConsumer() );
+
+	// only consumers saving and restoring their state can be used with checkpoints
+	std::vector<std::string> consumerIds = pline.GetConsumersWithoutCheckpoints();
+	BOOST_REQUIRE_EQUAL( consumerIds.size(), 1 );
+	BOOST_CHECK_EQUAL( consumerIds[0], TestConsumer().GetConsumerId() );
+}
@@ -0,0 +1,60 @@
+/* Copyright (c) 2013 - All Rights Reserved
+ *   Thomas Hauth  <Thomas.Hauth@cern.ch>
+ *   Joram Berger  <Joram.Berger@cern.ch>
+ *   Dominik Haitz <Dominik.Haitz@kit.edu>
+ */
+
+#pragma once
+
+#include <memory>
+#include <sstream>
+
+#include <boost/test/included/unit_test.hpp>
+
+#include "Artus/Core/interface/ProcessorRegistry.h"
+
+#include "TestGlobalProducer.h"
+#include "TestFilter.h"
+#include "TestConsumer.h"
+
+// same id as TestFilter, overrides its registration
+class TestFilterOverride: public TestFilter {
+};
+
+// types without any registered processors
+struct TestRegistryOtherTypes {
+};
+
+REGISTER_PRODUCER(TestGlobalProducer)
+REGISTER_PRODUCER(TestGlobalProducer2)
+REGISTER_FILTER(TestFilter)
+REGISTER_FILTER(TestFilterOverride)
+REGISTER_CONSUMER(TestConsumer)
+
+BOOST_AUTO_TEST_CASE( test_processor_registry )
+{
+	std::unique_ptr<ProducerBaseUntemplated> producer(ProcessorRegistry::CreateProducer<TestTypes>("test_global_producer2"));
+	BOOST_REQUIRE( producer );
+	BOOST_CHECK_EQUAL( producer->GetProducerId(), "test_global_producer2" );
+
+	std::unique_ptr<FilterBaseUntemplated> filter(ProcessorRegistry::CreateFilter<TestTypes>("testfilter"));
+	BOOST_REQUIRE( filter );
+	BOOST_CHECK_EQUAL( filter->GetFilterId(), "testfilter" );
+	BOOST_CHECK( dynamic_cast<TestFilterOverride*>(filter.get()) != nullptr );
+
+	std::unique_ptr<ConsumerBaseUntemplated> consumer(ProcessorRegistry::CreateConsumer<TestTypes>(TestConsumer().GetConsumerId()));
+	BOOST_CHECK( consumer );
+
+	// unknown ids and ids of other processor types
+	BOOST_CHECK( ProcessorRegistry::CreateProducer<TestTypes>("testfilter") == nullptr );
+	BOOST_CHECK( ProcessorRegistry::CreateFilter<TestTypes>("unknown") == nullptr );
+	BOOST_CHECK( ProcessorRegistry::CreateProducer<TestRegistryOtherTypes>("test_global_producer2") == nullptr );
+
+	std::vector<std::string> producerIds = ProcessorRegistry::GetProducerIds();
+	BOOST_CHECK_EQUAL( producerIds.size(), 2 );
+	BOOST_CHECK_EQUAL( producerIds[0], "test_global_producer" );
+
+	std::stringstream list;
+	ProcessorRegistry::Print(list);
+	BOOST_CHECK( list.str().find("Filters (1):\n\ttestfilter\n") != std::string::npos );
+}
@@ -0,0 +1,43 @@
+/* Copyright (c) 2013 - All Rights Reserved
+ *   Thomas Hauth  <Thomas.Hauth@cern.ch>
+ *   Joram Berger  <Joram.Berger@cern.ch>
+ *   Dominik Haitz <Dominik.Haitz@kit.edu>
+ */
+
+#pragma once
+
+#include <boost/test/included/unit_test.hpp>
+
+#include "Artus/Utility/interface/SharedResourceCache.h"
+
+BOOST_AUTO_TEST_CASE(test_shared_resource_cache)
+{
+	size_t nCreated = 0;
+	auto create = [&nCreated]() { ++nCreated; return new std::vector<int>(3, 42); };
+
+	std::shared_ptr<std::vector<int> const> resource1 = SharedResourceCache::Get<std::vector<int> >("file.root", "pileup", create);
+	std::shared_ptr<std::vector<int> const> resource2 = SharedResourceCache::Get<std::vector<int> >("file.root", "pileup", create);
+	BOOST_CHECK_EQUAL(nCreated, 1);
+	BOOST_CHECK(resource1.get() == resource2.get());
+	BOOST_CHECK_EQUAL(resource2->at(2), 42);
+	BOOST_CHECK_EQUAL(SharedResourceCache::GetNumberOfResources(), 1);
+
+	// different parameters or types identify different resources
+	std::shared_ptr<std::vector<int> const> resource3 = SharedResourceCache::Get<std::vector<int> >("file.root", "other", create);
+	BOOST_CHECK_EQUAL(nCreated, 2);
+	BOOST_CHECK(resource1.get() != resource3.get());
+	std::shared_ptr<std::string const> resource4 = SharedResourceCache::Get<std::string>("file.root", "pileup",
+			[]() { return new std::string("pileup"); });
+	BOOST_CHECK_EQUAL(*resource4, "pileup");
+	BOOST_CHECK_EQUAL(SharedResourceCache::GetNumberOfResources(), 3);
+
+	// resources are released with the last user and loaded again afterwards
+	resource1.reset();
+	resource2.reset();
+	resource3.reset();
+	resource4.reset();
+	BOOST_CHECK_EQUAL(SharedResourceCache::GetNumberOfResources(), 0);
+	resource1 = SharedResourceCache::Get<std::vector<int> >("file.root", "pileup", create);
+	BOOST_CHECK_EQUAL(nCreated, 3);
+}
+
@@ -7,6 +7,12 @@
 #pragma once
 
 #include "Artus/Core/interface/Pipeline.h"
+#include "Artus/Core/interface/PipelineResults.h"
+#include "Artus/Core/interface/OsSignalHandler.h"
+#include "Artus/Consumer/interface/CutFlowConsumerBase.h"
+
+#include <csignal>
+#include <fstream>
 
 class TestConsumer: public ConsumerBase<TestTypes> {
 public:
@@ -97,4 +103,123 @@ public:
 	int m_iLocalValue;
 };
 
+// counts the processed events and hands the result over to higher level pipelines
+class TestResultProducingConsumer: public ConsumerBase<TestTypes> {
+public:
+	TestResultProducingConsumer() : m_nEvents(new int(0)) {
+	}
+
+	std::string GetConsumerId() const override {
+		return "test_result_producing_consumer";
+	}
+
+	void ProcessFilteredEvent(TestEvent const& event,
+			TestProduct const& product,
+			TestSettings const& setting) override
+	{
+		++(*m_nEvents);
+	}
+
+	void Finish (TestSettings const& setting) override {
+		PipelineResults::Register(setting.GetName(), "nEvents", m_nEvents);
+	}
+
+	std::shared_ptr<int> m_nEvents;
+};
+
+// reads the result of a lower level pipeline
+class TestResultReadingConsumer: public ConsumerBase<TestTypes> {
+public:
+	explicit TestResultReadingConsumer(std::string const& inputPipeline) :
+		m_inputPipeline(inputPipeline), m_nEvents(0) {
+	}
+
+	std::string GetConsumerId() const override {
+		return "test_result_reading_consumer";
+	}
+
+	void Process(TestSettings const& setting) override {
+		m_nEvents = *(PipelineResults::Get<int>(m_inputPipeline, "nEvents"));
+	}
+
+	void Finish (TestSettings const& setting) override {}
+
+	std::string m_inputPipeline;
+	int m_nEvents;
+};
+
+// counts the processed events, the count survives an interruption via checkpoints
+class TestCheckpointConsumer: public ConsumerBase<TestTypes> {
+public:
+	explicit TestCheckpointConsumer(long long interruptAfter = -1) :
+		m_interruptAfter(interruptAfter), m_nEvents(0) {
+	}
 
+	std::string GetConsumerId() const override {
+		return "test_checkpoint_consumer";
+	}
+
+	bool SupportsCheckpoints() const override {
+		return true;
+	}
+
+	void ProcessFilteredEvent(TestEvent const& event,
+			TestProduct const& product,
+			TestSettings const& setting) override
+	{
+		++m_nEvents;
+		if (m_nEvents == m_interruptAfter)
+		{
+			// same as a SIGUSR1 sent by the batch system
+			osSignalHandler(SIGUSR1);
+		}
+	}
+
+	void SaveCheckpoint(TestSettings const& setting, Checkpoint & checkpoint) override {
+		checkpoint.SetValue(Checkpoint::GetKey(setting.GetName(), GetConsumerId(), "nEvents"), m_nEvents);
+	}
+
+	void RestoreCheckpoint(TestSettings const& setting, Checkpoint const& checkpoint) override {
+		m_nEvents = checkpoint.GetValue(Checkpoint::GetKey(setting.GetName(), GetConsumerId(), "nEvents"), 0ll);
+	}
+
+	void Finish (TestSettings const& setting) override {}
+
+	long long m_interruptAfter;
+	long long m_nEvents;
+};
+
+// appends the number of processed events to a file in Finish, which is also called in forked workers
+class TestForkConsumer: public ConsumerBase<TestTypes> {
+public:
+	explicit TestForkConsumer(std::string const& fileName) :
+		m_fileName(fileName), m_nEvents(0) {
+	}
+
+	std::string GetConsumerId() const override {
+		return "test_fork_consumer";
+	}
+
+	void ProcessFilteredEvent(TestEvent const& event,
+			TestProduct const& product,
+			TestSettings const& setting) override
+	{
+		++m_nEvents;
+	}
+
+	void Finish (TestSettings const& setting) override {
+		std::ofstream file(m_fileName.c_str(), std::ios::app);
+		file << m_nEvents << std::endl;
+	}
+
+	std::string m_fileName;
+	int m_nEvents;
+};
+
+// exposes the cut flow, which is merged from forked workers
+class TestCutFlowConsumer: public CutFlowConsumerBase<TestTypes> {
+public:
+	CutFlow const& GetCutFlow() const {
+		return m_flow;
+	}
+};
@@ -78,3 +78,61 @@ public:
 		return ( product.iGlobalProduct2 == 1 );
 	}
 };
+
+class TestSharedFilter: public FilterBase<TestTypes> {
+public:
+
+	explicit TestSharedFilter(int * evaluationCounter) : m_evaluationCounter(evaluationCounter) {}
+
+	std::string GetFilterId() const override {
+		return "testsharedfilter";
+	}
+
+	std::string GetFingerprint(TestSettings const& settings) const override {
+		return GetFilterId() + ":" + std::to_string(settings.GetOffset());
+	}
+
+	bool DoesEventPass(const TestEvent & event,
+			TestProduct const& product, TestSettings const& settings) const	override
+	{
+		++(*m_evaluationCounter);
+		return (event.iVal < 2);
+	}
+
+	int * m_evaluationCounter;
+};
+
+class TestCutsFilter: public FilterBase<TestTypes> {
+public:
+
+	std::string GetFilterId() const override {
+		return "testcutsfilter";
+	}
+
+	std::vector<std::string> const& GetCutNames() const override {
+		return m_cutNames;
+	}
+
+	size_t GetNPassedCuts() const override {
+		return m_nPassedCuts;
+	}
+
+	bool DoesEventPass(const TestEvent & event,
+			TestProduct const& product, TestSettings const& settings) const	override
+	{
+		m_nPassedCuts = 0;
+		if (event.iVal < 0)
+			return false;
+		++m_nPassedCuts;
+		if (event.iVal >= 2)
+			return false;
+		++m_nPassedCuts;
+		if (event.iVal != 0)
+			return false;
+		++m_nPassedCuts;
+		return true;
+	}
+
+	std::vector<std::string> m_cutNames = { "positive", "small", "zero" };
+	mutable size_t m_nPassedCuts = 0;
+};
@@ -11,10 +11,10 @@
 class TestSettings : public SettingsBase {
 public:
 
-	TestSettings() : SettingsBase(), m_Level( 1), m_Offset(23) {
+	TestSettings() : SettingsBase(), m_Level( 1), m_Offset(23), m_PostProcessingThreads(1) {
 	}
 
-	explicit TestSettings(std::string lineName) : SettingsBase(lineName), m_Level(1) {
+	explicit TestSettings(std::string lineName) : SettingsBase(lineName), m_Level(1), m_Offset(23), m_PostProcessingThreads(1) {
 	}
 
 	std::string ToString() const {
@@ -31,7 +31,7 @@ public:
 	{
 		return stringvector();
 	}
-	stringvector & GetTaggingFilters () const override
+	stringvector const& GetTaggingFilters () const override
 	{
 		return m_taggingFilters;
 	}
@@ -48,5 +48,13 @@ public:
 	}
 
 	IMPL_PROPERTY(unsigned int, Offset)
+
+	IMPL_PROPERTY(size_t, PostProcessingThreads)
+
+	IMPL_PROPERTY_INITIALIZE(std::string, CheckpointFile, "")
+	IMPL_PROPERTY_INITIALIZE(long long, CheckpointEveryNEvents, 0)
+	IMPL_PROPERTY_INITIALIZE(long long, CheckpointEveryNSeconds, 0)
+
+	IMPL_PROPERTY_INITIALIZE(size_t, ForkWorkers, 1)
 };
 
@@ -0,0 +1,98 @@
+/* Copyright (c) 2013 - All Rights Reserved
+ *   Thomas Hauth  <Thomas.Hauth@cern.ch>
+ *   Joram Berger  <Joram.Berger@cern.ch>
+ *   Dominik Haitz <Dominik.Haitz@kit.edu>
+ */
+
+#pragma once
+
+#include <boost/test/included/unit_test.hpp>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "Artus/Core/interface/WorkUnitScheduler.h"
+
+BOOST_AUTO_TEST_CASE( test_work_unit_splitting )
+{
+	std::vector<WorkUnit> workUnits = WorkUnitScheduler::GetWorkUnits(5, 30, 10);
+	BOOST_CHECK_EQUAL( workUnits.size(), 3 );
+	BOOST_CHECK_EQUAL( workUnits[0].firstEntry, 5 );
+	BOOST_CHECK_EQUAL( workUnits[1].endEntry, 25 );
+	BOOST_CHECK_EQUAL( workUnits[2].endEntry, 30 );
+}
+
+BOOST_AUTO_TEST_CASE( test_work_unit_scheduler )
+{
+	// three files of very different size, not ordered
+	std::vector<WorkUnit> workUnits = {
+		{ 35, 50, 2 }, { 0, 10, 0 }, { 50, 65, 2 }, { 10, 20, 0 }, { 30, 35, 1 },
+		{ 65, 80, 2 }, { 20, 30, 0 }, { 80, 100, 2 }
+	};
+	WorkUnitScheduler scheduler(workUnits);
+	BOOST_CHECK_EQUAL( scheduler.GetTotalEntries(), 100 );
+
+	WorkUnitScheduler::WorkerState state0 = scheduler.GetInitialState(0, 2);
+	WorkUnitScheduler::WorkerState state1 = scheduler.GetInitialState(1, 2);
+	WorkUnit unit;
+
+	BOOST_CHECK( scheduler.GetNextWorkUnit(state0, unit) );
+	BOOST_CHECK_EQUAL( unit.firstEntry, 0 );
+	BOOST_CHECK( scheduler.GetNextWorkUnit(state1, unit) );
+	BOOST_CHECK_EQUAL( unit.firstEntry, 30 );
+
+	// the second worker is done with its file and steals from the end of the largest one
+	BOOST_CHECK( scheduler.GetNextWorkUnit(state1, unit) );
+	BOOST_CHECK_EQUAL( unit.firstEntry, 80 );
+	BOOST_CHECK( state1.stealing );
+	BOOST_CHECK( scheduler.GetNextWorkUnit(state0, unit) );
+	BOOST_CHECK_EQUAL( unit.firstEntry, 10 );
+	BOOST_CHECK( scheduler.GetNextWorkUnit(state1, unit) );
+	BOOST_CHECK_EQUAL( unit.firstEntry, 65 );
+	BOOST_CHECK( scheduler.GetNextWorkUnit(state0, unit) );
+	BOOST_CHECK_EQUAL( unit.firstEntry, 20 );
+	BOOST_CHECK_EQUAL( scheduler.GetScheduledEntries(), 70 );
+
+	BOOST_CHECK( scheduler.GetNextWorkUnit(state0, unit) );
+	BOOST_CHECK_EQUAL( unit.firstEntry, 50 );
+	BOOST_CHECK( scheduler.GetNextWorkUnit(state1, unit) );
+	BOOST_CHECK_EQUAL( unit.firstEntry, 35 );
+
+	// every unit is handed out exactly once
+	BOOST_CHECK( ! scheduler.GetNextWorkUnit(state0, unit) );
+	BOOST_CHECK( ! scheduler.GetNextWorkUnit(state1, unit) );
+	BOOST_CHECK_EQUAL( scheduler.GetScheduledEntries(), 100 );
+}
+
+BOOST_AUTO_TEST_CASE( test_work_unit_scheduler_forked )
+{
+	std::vector<WorkUnit> workUnits = WorkUnitScheduler::GetWorkUnits(0, 100, 10);
+	WorkUnitScheduler scheduler(workUnits, true);
+
+	// the units taken by a forked process are not handed out again
+	pid_t pid = fork();
+	if (pid == 0)
+	{
+		WorkUnitScheduler::WorkerState state = scheduler.GetInitialState(1, 2);
+		WorkUnit unit;
+		for (int i = 0; i < 3; ++i)
+		{
+			scheduler.GetNextWorkUnit(state, unit);
+		}
+		_exit(0);
+	}
+	int status = 0;
+	BOOST_REQUIRE( waitpid(pid, &status, 0) == pid );
+	BOOST_CHECK( WIFEXITED(status) && (WEXITSTATUS(status) == 0) );
+	BOOST_CHECK_EQUAL( scheduler.GetScheduledEntries(), 30 );
+
+	WorkUnitScheduler::WorkerState state = scheduler.GetInitialState(0, 2);
+	WorkUnit unit;
+	int nUnits = 0;
+	while (scheduler.GetNextWorkUnit(state, unit))
+	{
+		++nUnits;
+	}
+	BOOST_CHECK_EQUAL( nUnits, 7 );
+	BOOST_CHECK_EQUAL( scheduler.GetScheduledEntries(), 100 );
+}
@@ -6,5 +6,7 @@
 #define ELPP_DISABLE_VERBOSE_LOGS
 #define ELPP_DISABLE_TRACE_LOGS
 #define ELPP_STACKTRACE_ON_CRASH
+// pipelines are initialised and post-processed in parallel threads
+#define ELPP_THREAD_SAFE
 #include "Artus/Utility/interface/easylogging++.h"
 
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+
+#include <boost/property_tree/ptree.hpp>
+
+
+/**
+   \brief Evaluator of boosted decision trees read from TMVA BDT weight files (XML).
+
+   The weight file is parsed once into flat arrays of the nodes of all trees (feature index,
+   threshold, indices of both children and leaf value). The boost weights and the leaf type
+   (UseYesNoLeaf) are folded into the leaf values. Leaves point to themselves, such that every
+   tree is traversed with a fixed number of steps given by its depth and no check for leaves:
+       node = children[2 * node + (inputs[features[node]] >= thresholds[node])]
+
+   The outputs are those of TMVA::Reader::EvaluateMVA:
+   - AdaBoost and others: sum of boostWeight * (nodeType or purity) divided by the sum of the boost weights
+   - Grad: 2 / (1 + exp(-2 * sum of responses)) - 1
+   The cuts are compared in single precision as in TMVA. Input variable transformations,
+   preselections, Fisher cuts, regression and multiclass BDTs are not supported. The trees of
+   classifiers trained with Grad are regression trees (AnalysisType 1), all others are classification
+   trees (AnalysisType 0).
+
+   The evaluator does not change after construction and can be used concurrently.
+
+       BdtEvaluator bdt("weights/TMVAClassification_BDT.weights.xml");
+       double mva = bdt.Evaluate(inputs.data());  // inputs in the order of GetVariableNames()
+*/
+class BdtEvaluator
+{
+public:
+
+	explicit BdtEvaluator(std::string const& weightFileName);
+	/// reads the weight file from a stream, the name is only used for error messages
+	BdtEvaluator(std::istream& weightFile, std::string const& weightFileName);
+
+	/// expressions of the input variables as given in the weight file
+	std::vector<std::string> const& GetVariableNames() const
+	{
+		return m_variableNames;
+	}
+
+	size_t GetNVariables() const
+	{
+		return m_variableNames.size();
+	}
+
+	size_t GetNTrees() const
+	{
+		return m_treeRoots.size();
+	}
+
+	double Evaluate(float const* inputs) const;
+
+	/// results[entry] = output for the inputs inputs[entry * GetNVariables() + variableIndex]
+	void EvaluateBatch(float const* inputs, size_t nEntries, double* results) const;
+
+private:
+
+	void ReadWeights(std::istream& weightFile);
+	/// appends the node and its children, returns the depth of the sub-tree
+	uint32_t AddNode(boost::property_tree::ptree const& node, double boostWeight, bool useYesNoLeaf);
+
+	// number of entries processed at once by EvaluateBatch
+	static const size_t s_batchBlockSize = 64;
+
+	std::string m_weightFileName;
+	std::vector<std::string> m_variableNames;
+	bool m_gradientBoost = false;
+	// sum of the boost weights
+	double m_normalisation = 0.0;
+
+	// index of the root node and depth of every tree
+	std::vector<uint32_t> m_treeRoots;
+	std::vector<uint32_t> m_treeDepths;
+
+	// nodes of all trees
+	std::vector<uint32_t> m_features;
+	std::vector<float> m_thresholds;
+	// child for inputs below the threshold and child for inputs at or above the threshold
+	std::vector<uint32_t> m_children;
+	// contribution to the sum, zero for inner nodes
+	std::vector<double> m_leafValues;
+};
+
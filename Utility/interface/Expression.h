@@ -0,0 +1,128 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+
+/**
+   \brief Arithmetic and boolean expression over named variables, compiled once into bytecode.
+
+   Supported are numbers, variables (identifiers), the operators
+       ?:  ||  &&  !  <  <=  >  >=  ==  !=  +  -  *  /
+   with the precedence of C++, parentheses and the functions abs, sqrt, log, log10, exp, min,
+   max and pow, e.g.
+       nMuons>=2 && leadingMuonPt>25 && abs(leadingMuonEta)<2.1
+       (nJets >= 2) ? abs(leadingJetEta - trailingJetEta) : -1
+   Booleans are represented by 0 and 1, all non-zero values count as true. In Evaluate, the
+   operators &&, || and ?: are evaluated with short-circuiting, such that variables are only
+   loaded if needed. Sub-expressions consisting only of numbers are folded at compile time.
+
+   The variables are numbered in the list of variable names passed to the constructor, which can
+   be shared between several expressions. Their values are requested during the evaluation via
+   the loader function. Syntax errors are fatal.
+
+   EvaluateBatch evaluates the expression for many entries at once from columns of variable
+   values. It runs a separate program without jumps, where every instruction is a simple loop
+   over a block of entries, and evaluates all operands of &&, || and ?:.
+*/
+class Expression
+{
+public:
+
+	typedef std::function<double(size_t variableIndex)> VariableLoader;
+
+	Expression();
+
+	/// compiles the expression, new variable names are appended to variableNames
+	Expression(std::string const& text, std::vector<std::string> & variableNames);
+
+	double Evaluate(VariableLoader const& loadVariable) const;
+
+	bool IsTrue(VariableLoader const& loadVariable) const
+	{
+		return (Evaluate(loadVariable) != 0.0);
+	}
+
+	/// results[entry] = value for the variables variableValues[variableIndex][entry]
+	void EvaluateBatch(std::vector<double const*> const& variableValues, size_t nEntries, double* results) const;
+
+	std::string const& GetText() const
+	{
+		return m_text;
+	}
+
+	size_t GetNInstructions() const
+	{
+		return m_instructions.size();
+	}
+
+	/// splits a conjunction "a && b && c" at the outermost level into its clauses "a", "b" and "c"
+	/// expressions containing || or ?: at the outermost level are returned unsplit
+	static std::vector<std::string> SplitConjunction(std::string const& text);
+
+private:
+
+	enum class OpCode : unsigned char
+	{
+		Constant,
+		Variable,
+		Negate,
+		Not,
+		ToBool,
+		Add,
+		Subtract,
+		Multiply,
+		Divide,
+		Less,
+		LessEqual,
+		Greater,
+		GreaterEqual,
+		Equal,
+		NotEqual,
+		Abs,
+		Sqrt,
+		Min,
+		Max,
+		Log,
+		Log10,
+		Exp,
+		Pow,
+		And,
+		Or,
+		// condition ? first : second
+		Select,
+		// leave false on the stack and jump if the top of the stack is false, pop otherwise
+		AndJump,
+		// leave true on the stack and jump if the top of the stack is true, pop otherwise
+		OrJump,
+		// pop and jump if false
+		JumpIfFalse,
+		Jump
+	};
+
+	struct Instruction
+	{
+		OpCode opCode;
+		// variable index or jump target
+		size_t argument;
+		double constant;
+	};
+
+	// limit for the nesting of the expressions, the stack lives on the stack of the caller
+	static const size_t s_maxStackSize = 64;
+	// number of entries processed at once by EvaluateBatch
+	static const size_t s_batchBlockSize = 128;
+
+	friend class ExpressionCompiler;
+
+	static double Apply(OpCode opCode, double value);
+	static double Apply(OpCode opCode, double left, double right);
+	static double Apply(OpCode opCode, double condition, double first, double second);
+
+	std::string m_text;
+	std::vector<Instruction> m_instructions;
+	std::vector<Instruction> m_batchInstructions;
+	size_t m_batchStackSize = 0;
+};
+
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+
+/**
+   \brief Kinematic functions for collections of objects stored as structure of arrays.
+
+   The objects are passed as separate arrays of their coordinates (pt, eta, phi, mass), such that
+   the loops over them can be vectorised. The functions are compiled for several instruction sets
+   (baseline, AVX2 and AVX-512) and the best one supported by the CPU is chosen at runtime. The
+   results do not depend on the instruction set apart from rounding.
+
+   The azimuthal angles are expected to be in [-pi, pi], as returned by ROOT. Delta phi and delta R
+   follow the conventions of ROOT::Math::VectorUtil.
+
+       Kinematics::Objects leptons(pt.data(), eta.data(), phi.data(), mass.data(), pt.size());
+       std::vector<float> deltaR2(leptons.size * jets.size);
+       Kinematics::DeltaR2Matrix(leptons, jets, deltaR2.data());
+*/
+class Kinematics
+{
+public:
+
+	struct Objects
+	{
+		Objects(float const* pt, float const* eta, float const* phi, float const* mass, size_t size) :
+			pt(pt), eta(eta), phi(phi), mass(mass), size(size)
+		{
+		}
+
+		float const* pt;
+		float const* eta;
+		float const* phi;
+		float const* mass; // only needed for the invariant masses, can be nullptr otherwise
+		size_t size;
+	};
+
+	enum class InstructionSet : int
+	{
+		BASELINE = 0,
+		AVX2 = 1,
+		AVX512 = 2
+	};
+
+	/// instruction set used for the kernels, the best one supported by the CPU by default
+	static InstructionSet GetInstructionSet();
+	static InstructionSet GetBestSupportedInstructionSet();
+	/// restricts the instruction set, e.g. for comparisons, is limited to the supported ones
+	static void SetInstructionSet(InstructionSet instructionSet);
+	static std::string ToString(InstructionSet instructionSet);
+
+	/// deltaPhi[i] = phi1[i] - phi2[i] in [-pi, pi]
+	static void DeltaPhi(float const* phi1, float const* phi2, size_t size, float* deltaPhi);
+
+	/// deltaR2[i * objects2.size + j] = delta R^2 between objects1[i] and objects2[j]
+	static void DeltaR2Matrix(Objects const& objects1, Objects const& objects2, float* deltaR2);
+
+	/// selected[i] = 1 if pt > ptMin and |eta| < absEtaMax, otherwise 0, returns the number of selected objects
+	static size_t SelectPtAbsEta(Objects const& objects, float ptMin, float absEtaMax, unsigned char* selected);
+
+	/// mass[i * objects2.size + j] = invariant mass of the sum of objects1[i] and objects2[j]
+	static void PairMassMatrix(Objects const& objects1, Objects const& objects2, float* mass);
+
+	/// matchedIndices[i] = index of the object in objects2 closest in delta R to objects1[i] within deltaRMax,
+	/// -1 if there is none. The first object is taken in case of equal distances.
+	static void MatchDeltaR(Objects const& objects1, Objects const& objects2, float deltaRMax, int* matchedIndices);
+};
+
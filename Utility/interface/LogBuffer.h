@@ -0,0 +1,61 @@
+/* Copyright (c) 2013 - All Rights Reserved
+ *   Thomas Hauth  <Thomas.Hauth@cern.ch>
+ *   Joram Berger  <Joram.Berger@cern.ch>
+ *   Dominik Haitz <Dominik.Haitz@kit.edu>
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+#include "Artus/Utility/interface/ArtusLogging.h"
+
+/**
+   \brief Buffer for the log messages of one thread, e.g. while initialising a pipeline in parallel.
+
+   While a buffer is activated in a thread, the messages logged by this thread are kept in the
+   buffer instead of being written. Flush writes them later, such that the messages of pipelines
+   initialised in parallel are not interleaved and can be written in the order of the
+   configuration. Fatal messages are always written immediately, since they end the program.
+
+   The buffering only takes effect between Install and Uninstall, which replace the default log
+   dispatching of easylogging++ and must not be called while other threads are logging.
+*/
+class LogBuffer: public boost::noncopyable {
+public:
+
+	~LogBuffer();
+
+	/// keep the messages of the calling thread in this buffer until Deactivate is called
+	void Activate();
+	void Deactivate();
+
+	/// write and remove all buffered messages
+	void Flush();
+
+	size_t GetNumberOfMessages() const;
+
+	static void Install();
+	static void Uninstall();
+
+private:
+
+	class DispatchCallback;
+
+	struct Message {
+		el::Level level;
+		std::string file;
+		unsigned long int line;
+		std::string function;
+		el::base::type::VerboseLevel verboseLevel;
+		el::Logger* logger;
+		std::string text;
+	};
+
+	std::vector<Message> m_messages;
+
+	static LogBuffer* & GetActiveBuffer();
+};
@@ -7,6 +7,8 @@
 #pragma once
 
 #include <iostream>
+#include <map>
+#include <mutex>
 
 #include <TH1D.h>
 #include <TH2D.h>
@@ -16,6 +18,8 @@
 #include <TFile.h>
 #include <TGraphErrors.h>
 
+class TChain;
+
 #include "KappaTools/Toolbox/interface/String.h"
 
 #include "ArtusLogging.h"
@@ -45,6 +49,7 @@ public:
 	static T* SafeGet(std::string const& fileName, std::string const& objectName,
 	                 bool detachFromDirectory=true)
 	{
+		std::lock_guard<std::recursive_mutex> lock(GetRootMutex());
 		TFile* rootFile = new TFile(fileName.c_str(), "READ");
 		T* object = RootFileHelper::SafeGet<T>(rootFile, objectName, detachFromDirectory);
 		if (detachFromDirectory)
@@ -90,6 +95,7 @@ public:
 	                                     std::vector<std::string> const& objectNames,
 	                                     bool detachFromDirectory=true)
 	{
+		std::lock_guard<std::recursive_mutex> lock(GetRootMutex());
 		TFile* rootFile = new TFile(fileName.c_str(), "READ");
 		std::vector<T*> objects = RootFileHelper::SafeGetVector<T>(rootFile, objectNames, detachFromDirectory);
 		if (detachFromDirectory)
@@ -110,6 +116,7 @@ public:
 		for (std::vector<std::string>::const_iterator fileName = fileNames.begin();
 		     fileName != fileNames.end(); ++fileName)
 		{
+			std::lock_guard<std::recursive_mutex> lock(GetRootMutex());
 			TFile* rootFile = new TFile(fileName->c_str(), "READ");
 			objects[index++] = RootFileHelper::SafeGet<T>(rootFile, objectName, detachFromDirectory);
 			if (detachFromDirectory)
@@ -154,6 +161,7 @@ public:
 	                                     std::map<TKey, std::string> const& objectNames,
 	                                     bool detachFromDirectory=true)
 	{
+		std::lock_guard<std::recursive_mutex> lock(GetRootMutex());
 		TFile* rootFile = new TFile(fileName.c_str(), "READ");
 		std::map<TKey, T*> objects = RootFileHelper::SafeGetMap<TKey, T>(rootFile, objectNames, detachFromDirectory);
 		if (detachFromDirectory)
@@ -173,6 +181,7 @@ public:
 		for (typename std::map<TKey, std::string>::const_iterator fileName = fileNames.begin();
 		     fileName != fileNames.end(); ++fileName)
 		{
+			std::lock_guard<std::recursive_mutex> lock(GetRootMutex());
 			TFile* rootFile = new TFile(fileName->second.c_str(), "READ");
 			objects[fileName->first] = RootFileHelper::SafeGet<T>(rootFile, objectName, detachFromDirectory);
 			if (detachFromDirectory)
@@ -217,6 +226,7 @@ public:
 	                                                   std::map<TKey, std::vector<std::string> > const& objectNames,
 	                                                   bool detachFromDirectory=true)
 	{
+		std::lock_guard<std::recursive_mutex> lock(GetRootMutex());
 		TFile* rootFile = new TFile(fileName.c_str(), "READ");
 		std::map<TKey, std::vector<T*> > objects = RootFileHelper::SafeGetMap<TKey, T>(rootFile, objectNames, detachFromDirectory);
 		if (detachFromDirectory)
@@ -242,6 +252,26 @@ public:
 	}
 
 	static void SafeCd(TDirectory* directory, std::string const& dirName);
+
+	// serialises the access to the global state of ROOT (gROOT, gDirectory, opening of files)
+	// from code which may run in parallel, e.g. the initialisation of the pipelines
+	static std::recursive_mutex & GetRootMutex();
+
+	// objects taken over while merging, which are not owned by any consumer
+	typedef std::map<std::pair<TDirectory*, std::string>, TObject*> AdoptedObjects;
+
+	// move all histograms and trees attached to the source directory (recursively) to the target directory
+	static void MoveObjects(TDirectory* source, TDirectory* target);
+	// merge the objects stored in the source file into the objects in memory attached to the target
+	// directory: histograms are added and trees are concatenated, objects not found in the target
+	// directory are adopted and have to be written by WriteAdoptedObjects
+	static void MergeObjects(TDirectory* source, TDirectory* target, AdoptedObjects & adoptedObjects);
+	static void WriteAdoptedObjects(AdoptedObjects const& adoptedObjects);
+
+	// close the file currently opened by the chain, the chain opens it again with a new file
+	// descriptor when the next entry is loaded, e.g. in a forked process
+	static void CloseCurrentFile(TChain & chain);
+
 	static TH1D* GetStandaloneTH1D_1(std::string sName, std::string sCaption,
 			int binCount, double dCustomBins[255]);
 	static TH1D* GetStandaloneTH1D_2(std::string sName, std::string sCaption,
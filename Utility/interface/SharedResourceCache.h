@@ -0,0 +1,79 @@
+/* Copyright (c) 2013 - All Rights Reserved
+ *   Thomas Hauth  <Thomas.Hauth@cern.ch>
+ *   Joram Berger  <Joram.Berger@cern.ch>
+ *   Dominik Haitz <Dominik.Haitz@kit.edu>
+ */
+
+#pragma once
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <typeindex>
+#include <typeinfo>
+
+#include "Artus/Utility/interface/ArtusLogging.h"
+
+/**
+   \brief Process-wide cache of immutable resources, e.g. correction parameters read from files.
+
+   Producers acquire the resources in their Init. A resource is identified by its type, the path
+   of the file it is read from and a string of further parameters. All pipelines requesting the
+   same resource share one instance, which is only created once and deleted as soon as the last
+   user has released it.
+
+   The resources are only handed out as const objects, since the pipelines using them may run in
+   parallel. Only types whose const methods are thread-safe may be cached. Stateful objects, e.g.
+   TMVA::Reader, which stores the input variables, have to be created by every producer.
+
+       std::shared_ptr<Payload const> payload = SharedResourceCache::Get<Payload>(
+               fileName, "",
+               [&fileName]() { return new Payload(fileName); }
+       );
+*/
+class SharedResourceCache
+{
+public:
+
+	template<class TResource>
+	static std::shared_ptr<TResource const> Get(std::string const& path, std::string const& parameters,
+	                                      std::function<TResource*()> const& create)
+	{
+		std::shared_ptr<Entry> entry = GetEntry(std::type_index(typeid(TResource)), path, parameters);
+
+		// only lock this entry, such that different resources can be loaded in parallel
+		std::lock_guard<std::mutex> lock(entry->mutex);
+		std::shared_ptr<TResource const> resource = std::static_pointer_cast<TResource const>(entry->resource.lock());
+		if (! resource)
+		{
+			LOG(DEBUG) << "\tLoading shared resource \"" << path << "\" (" << parameters << ")...";
+			resource.reset(create());
+			entry->resource = resource;
+		}
+		return resource;
+	}
+
+	/// number of resources currently in use
+	static size_t GetNumberOfResources();
+
+private:
+
+	struct Entry
+	{
+		std::mutex mutex;
+		std::weak_ptr<void const> resource;
+	};
+
+	typedef std::tuple<std::type_index, std::string, std::string> Key;
+
+	static std::shared_ptr<Entry> GetEntry(std::type_index const& type, std::string const& path,
+	                                       std::string const& parameters);
+
+	// function-local statics to be independent of the static initialisation order
+	static std::map<Key, std::shared_ptr<Entry> > & GetEntries();
+	static std::mutex & GetMutex();
+};
+
@@ -0,0 +1,246 @@
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+
+#include <boost/property_tree/xml_parser.hpp>
+
+#include "Artus/Utility/interface/ArtusLogging.h"
+#include "Artus/Utility/interface/BdtEvaluator.h"
+
+
+const size_t BdtEvaluator::s_batchBlockSize;
+
+BdtEvaluator::BdtEvaluator(std::string const& weightFileName) :
+	m_weightFileName(weightFileName)
+{
+	std::ifstream weightFile(weightFileName.c_str());
+	if (! weightFile.good())
+	{
+		LOG(FATAL) << "Could not open the BDT weight file \"" << weightFileName << "\"!";
+	}
+	ReadWeights(weightFile);
+}
+
+BdtEvaluator::BdtEvaluator(std::istream& weightFile, std::string const& weightFileName) :
+	m_weightFileName(weightFileName)
+{
+	ReadWeights(weightFile);
+}
+
+double BdtEvaluator::Evaluate(float const* inputs) const
+{
+	double result = 0.0;
+	EvaluateBatch(inputs, 1, &result);
+	return result;
+}
+
+void BdtEvaluator::EvaluateBatch(float const* inputs, size_t nEntries, double* results) const
+{
+	size_t const nVariables = m_variableNames.size();
+	uint32_t nodes[s_batchBlockSize];
+	double sums[s_batchBlockSize];
+
+	for (size_t blockBegin = 0; blockBegin < nEntries; blockBegin += s_batchBlockSize)
+	{
+		size_t const blockSize = std::min(s_batchBlockSize, nEntries - blockBegin);
+		float const* blockInputs = inputs + (blockBegin * nVariables);
+		std::fill(sums, sums + blockSize, 0.0);
+
+		// trees in the outer loop to keep the nodes of one tree in the cache
+		for (size_t treeIndex = 0; treeIndex < m_treeRoots.size(); ++treeIndex)
+		{
+			std::fill(nodes, nodes + blockSize, m_treeRoots[treeIndex]);
+			for (uint32_t depth = 0; depth < m_treeDepths[treeIndex]; ++depth)
+			{
+				for (size_t entry = 0; entry < blockSize; ++entry)
+				{
+					uint32_t const node = nodes[entry];
+					size_t const above = ((blockInputs[(entry * nVariables) + m_features[node]] >= m_thresholds[node]) ? 1 : 0);
+					nodes[entry] = m_children[(2 * node) + above];
+				}
+			}
+			for (size_t entry = 0; entry < blockSize; ++entry)
+			{
+				sums[entry] += m_leafValues[nodes[entry]];
+			}
+		}
+
+		for (size_t entry = 0; entry < blockSize; ++entry)
+		{
+			if (m_gradientBoost)
+			{
+				results[blockBegin + entry] = (2.0 / (1.0 + std::exp(-2.0 * sums[entry]))) - 1.0;
+			}
+			else
+			{
+				results[blockBegin + entry] = ((m_normalisation > std::numeric_limits<double>::epsilon()) ?
+				                               (sums[entry] / m_normalisation) : 0.0);
+			}
+		}
+	}
+}
+
+void BdtEvaluator::ReadWeights(std::istream& weightFile)
+{
+	boost::property_tree::ptree weights;
+	try
+	{
+		boost::property_tree::read_xml(weightFile, weights, boost::property_tree::xml_parser::trim_whitespace);
+	}
+	catch (boost::property_tree::xml_parser_error const& error)
+	{
+		LOG(FATAL) << "Could not parse the BDT weight file \"" << m_weightFileName << "\": " << error.what();
+	}
+
+	boost::property_tree::ptree const* methodSetup = nullptr;
+	try
+	{
+		methodSetup = &weights.get_child("MethodSetup");
+	}
+	catch (boost::property_tree::ptree_error const& error)
+	{
+		LOG(FATAL) << "The file \"" << m_weightFileName << "\" is no TMVA weight file: " << error.what();
+	}
+	if (methodSetup->get<std::string>("<xmlattr>.Method", "").compare(0, 3, "BDT") != 0)
+	{
+		LOG(FATAL) << "The TMVA weight file \"" << m_weightFileName << "\" does not contain a BDT!";
+	}
+
+	// options needed for the evaluation
+	std::string boostType = "AdaBoost";
+	bool useYesNoLeaf = true;
+	for (boost::property_tree::ptree::const_iterator option = methodSetup->get_child("Options").begin();
+	     option != methodSetup->get_child("Options").end(); ++option)
+	{
+		std::string const name = option->second.get<std::string>("<xmlattr>.name", "");
+		if (name == "BoostType")
+		{
+			boostType = option->second.data();
+		}
+		else if (name == "UseYesNoLeaf")
+		{
+			useYesNoLeaf = (option->second.data() == "True");
+		}
+		else if ((name == "DoPreselection") && (option->second.data() == "True"))
+		{
+			LOG(FATAL) << "BDTs with preselection (\"" << m_weightFileName << "\") are not supported!";
+		}
+	}
+	m_gradientBoost = (boostType == "Grad");
+
+	if (methodSetup->get<int>("Transformations.<xmlattr>.NTransformations", 0) != 0)
+	{
+		LOG(FATAL) << "BDTs with transformations of the input variables (\"" << m_weightFileName << "\") are not supported!";
+	}
+
+	m_variableNames.assign(methodSetup->get<size_t>("Variables.<xmlattr>.NVar"), "");
+	for (boost::property_tree::ptree::const_iterator variable = methodSetup->get_child("Variables").begin();
+	     variable != methodSetup->get_child("Variables").end(); ++variable)
+	{
+		if (variable->first == "Variable")
+		{
+			m_variableNames.at(variable->second.get<size_t>("<xmlattr>.VarIndex")) = variable->second.get<std::string>("<xmlattr>.Expression");
+		}
+	}
+
+	boost::optional<boost::property_tree::ptree const&> generalInfo = methodSetup->get_child_optional("GeneralInfo");
+	if (generalInfo)
+	{
+		for (boost::property_tree::ptree::const_iterator info = generalInfo->begin(); info != generalInfo->end(); ++info)
+		{
+			if ((info->second.get<std::string>("<xmlattr>.name", "") == "AnalysisType") &&
+			    (info->second.get<std::string>("<xmlattr>.value", "") != "Classification"))
+			{
+				LOG(FATAL) << "Only BDTs for classification are supported (\"" << m_weightFileName << "\")!";
+			}
+		}
+	}
+
+	// the trees of gradient boosted classifiers are regression trees (TMVA::Types::kRegression)
+	int const treeAnalysisType = (m_gradientBoost ? 1 : 0);
+	boost::property_tree::ptree const& forest = methodSetup->get_child("Weights");
+	int const forestAnalysisType = forest.get<int>("<xmlattr>.AnalysisType", treeAnalysisType);
+
+	m_normalisation = 0.0;
+	for (boost::property_tree::ptree::const_iterator tree = forest.begin(); tree != forest.end(); ++tree)
+	{
+		if (tree->first != "BinaryTree")
+		{
+			continue;
+		}
+		if (tree->second.get<int>("<xmlattr>.AnalysisType", forestAnalysisType) != treeAnalysisType)
+		{
+			LOG(FATAL) << "Unsupported type of the trees in the BDT weight file \"" << m_weightFileName << "\"!";
+		}
+		double const boostWeight = tree->second.get<double>("<xmlattr>.boostWeight", 1.0);
+		m_normalisation += boostWeight;
+
+		m_treeRoots.push_back(static_cast<uint32_t>(m_features.size()));
+		m_treeDepths.push_back(AddNode(tree->second.get_child("Node"), boostWeight, useYesNoLeaf));
+	}
+	if (m_treeRoots.empty())
+	{
+		LOG(FATAL) << "The BDT weight file \"" << m_weightFileName << "\" does not contain any tree!";
+	}
+}
+
+uint32_t BdtEvaluator::AddNode(boost::property_tree::ptree const& node, double boostWeight, bool useYesNoLeaf)
+{
+	uint32_t const index = static_cast<uint32_t>(m_features.size());
+	m_features.push_back(0);
+	m_thresholds.push_back(0.0f);
+	m_children.push_back(index);
+	m_children.push_back(index);
+	m_leafValues.push_back(0.0);
+
+	int const nodeType = node.get<int>("<xmlattr>.nType");
+	if (nodeType != 0)
+	{
+		// leaves point to themselves
+		if (m_gradientBoost)
+		{
+			m_leafValues[index] = node.get<float>("<xmlattr>.res");
+		}
+		else
+		{
+			m_leafValues[index] = boostWeight * (useYesNoLeaf ? double(nodeType) : double(node.get<float>("<xmlattr>.purity")));
+		}
+		return 0;
+	}
+
+	if ((node.get<int>("<xmlattr>.NCoef", 0) != 0) || (node.get<int>("<xmlattr>.IVar") < 0) ||
+	    (node.get<size_t>("<xmlattr>.IVar") >= m_variableNames.size()))
+	{
+		LOG(FATAL) << "Unsupported node in the BDT weight file \"" << m_weightFileName << "\"!";
+	}
+	m_features[index] = node.get<uint32_t>("<xmlattr>.IVar");
+	m_thresholds[index] = node.get<float>("<xmlattr>.Cut");
+
+	boost::property_tree::ptree const* left = nullptr;
+	boost::property_tree::ptree const* right = nullptr;
+	for (boost::property_tree::ptree::const_iterator child = node.begin(); child != node.end(); ++child)
+	{
+		if (child->first == "Node")
+		{
+			((child->second.get<std::string>("<xmlattr>.pos") == "l") ? left : right) = &(child->second);
+		}
+	}
+	if ((left == nullptr) || (right == nullptr))
+	{
+		LOG(FATAL) << "Inner node without two children in the BDT weight file \"" << m_weightFileName << "\"!";
+	}
+
+	// TMVA goes to the right child for inputs >= cut if cType is 1 and for inputs < cut otherwise
+	uint32_t const leftIndex = static_cast<uint32_t>(m_features.size());
+	uint32_t const leftDepth = AddNode(*left, boostWeight, useYesNoLeaf);
+	uint32_t const rightIndex = static_cast<uint32_t>(m_features.size());
+	uint32_t const rightDepth = AddNode(*right, boostWeight, useYesNoLeaf);
+	bool const rightIsAbove = (node.get<int>("<xmlattr>.cType") == 1);
+	m_children[2 * index] = (rightIsAbove ? leftIndex : rightIndex);
+	m_children[(2 * index) + 1] = (rightIsAbove ? rightIndex : leftIndex);
+
+	return 1 + std::max(leftDepth, rightDepth);
+}
+
@@ -0,0 +1,858 @@
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+
+#include <boost/algorithm/string/trim.hpp>
+
+#include "Artus/Utility/interface/ArtusLogging.h"
+#include "Artus/Utility/interface/Expression.h"
+
+
+namespace
+{
+	struct ExpressionToken
+	{
+		enum class Type { Number, Identifier, Operator, End };
+
+		Type type;
+		std::string text;
+		double value;
+		size_t position;
+	};
+
+	void FailExpression(std::string const& text, size_t position, std::string const& message)
+	{
+		LOG(FATAL) << "Error in expression \"" << text << "\" at position " << position << ": " << message;
+	}
+
+	std::vector<ExpressionToken> TokenizeExpression(std::string const& text)
+	{
+		static const std::vector<std::string> operators = {
+			"||", "&&", "<=", ">=", "==", "!=", "<", ">", "!", "+", "-", "*", "/", "(", ")", ",", "?", ":"
+		};
+
+		std::vector<ExpressionToken> tokens;
+		size_t position = 0;
+		while (position < text.size())
+		{
+			char character = text[position];
+			if (std::isspace(static_cast<unsigned char>(character)))
+			{
+				++position;
+			}
+			else if (std::isdigit(static_cast<unsigned char>(character)) || (character == '.'))
+			{
+				char const* begin = text.c_str() + position;
+				char* end = nullptr;
+				double value = std::strtod(begin, &end);
+				size_t length = static_cast<size_t>(end - begin);
+				if ((length == 0) || std::isalpha(static_cast<unsigned char>(text[position + length])) ||
+				    (text[position + length] == '_'))
+				{
+					FailExpression(text, position, "invalid number");
+				}
+				tokens.push_back(ExpressionToken{ ExpressionToken::Type::Number, text.substr(position, length), value, position });
+				position += length;
+			}
+			else if (std::isalpha(static_cast<unsigned char>(character)) || (character == '_'))
+			{
+				size_t length = 1;
+				while ((position + length < text.size()) &&
+				       (std::isalnum(static_cast<unsigned char>(text[position + length])) || (text[position + length] == '_')))
+				{
+					++length;
+				}
+				tokens.push_back(ExpressionToken{ ExpressionToken::Type::Identifier, text.substr(position, length), 0.0, position });
+				position += length;
+			}
+			else
+			{
+				bool found = false;
+				for (std::vector<std::string>::const_iterator op = operators.begin(); (! found) && (op != operators.end()); ++op)
+				{
+					if (text.compare(position, op->size(), *op) == 0)
+					{
+						tokens.push_back(ExpressionToken{ ExpressionToken::Type::Operator, *op, 0.0, position });
+						position += op->size();
+						found = true;
+					}
+				}
+				if (! found)
+				{
+					FailExpression(text, position, std::string("unexpected character '") + character + "'");
+				}
+			}
+		}
+		tokens.push_back(ExpressionToken{ ExpressionToken::Type::End, "", 0.0, text.size() });
+		return tokens;
+	}
+}
+
+
+/**
+   Recursive descent parser building a syntax tree, from which the programs are generated.
+   The grammar in the order of increasing precedence is
+       conditional := or ("?" conditional ":" conditional)?
+       or          := and ("||" and)*
+       and         := not ("&&" not)*
+       not         := "!" not | comparison
+       comparison  := sum (("<" | "<=" | ">" | ">=" | "==" | "!=") sum)?
+       sum         := product (("+" | "-") product)*
+       product     := unary (("*" | "/") unary)*
+       unary       := "-" unary | primary
+       primary     := number | variable | function "(" conditional ("," conditional)* ")" | "(" conditional ")"
+   Operations on numbers only are folded while building the tree.
+*/
+class ExpressionCompiler
+{
+public:
+	typedef Expression::OpCode OpCode;
+	typedef Expression::Instruction Instruction;
+
+	ExpressionCompiler(std::string const& text, std::vector<std::string> & variableNames) :
+		m_text(text),
+		m_tokens(TokenizeExpression(text)),
+		m_variableNames(variableNames)
+	{
+	}
+
+	void Compile(Expression & expression)
+	{
+		if (Peek().type == ExpressionToken::Type::End)
+		{
+			FailExpression(m_text, 0, "empty expression");
+		}
+		Node root = ParseConditional();
+		if (Peek().type != ExpressionToken::Type::End)
+		{
+			FailExpression(m_text, Peek().position, "unexpected \"" + Peek().text + "\"");
+		}
+
+		size_t stackSize = 0;
+		size_t maxStackSize = 0;
+		EmitScalar(root, expression.m_instructions, stackSize, maxStackSize);
+		stackSize = 0;
+		EmitBatch(root, expression.m_batchInstructions, stackSize, expression.m_batchStackSize);
+		if (std::max(maxStackSize, expression.m_batchStackSize) > Expression::s_maxStackSize)
+		{
+			FailExpression(m_text, 0, "expression is nested too deeply");
+		}
+	}
+
+private:
+
+	struct Node
+	{
+		OpCode opCode;
+		double constant;
+		size_t variableIndex;
+		std::vector<Node> operands;
+	};
+
+	static Node MakeConstant(double constant)
+	{
+		return Node{ OpCode::Constant, constant, 0, std::vector<Node>() };
+	}
+
+	static Node MakeOperation(OpCode opCode, std::vector<Node> const& operands)
+	{
+		// operations on constants are folded, the operations have at most three operands
+		double constants[3] = { 0.0, 0.0, 0.0 };
+		size_t nConstants = 0;
+		for (std::vector<Node>::const_iterator operand = operands.begin(); operand != operands.end(); ++operand)
+		{
+			if ((operand->opCode != OpCode::Constant) || (nConstants == 3))
+			{
+				return Node{ opCode, 0.0, 0, operands };
+			}
+			constants[nConstants++] = operand->constant;
+		}
+		switch (nConstants)
+		{
+		case 1:
+			return MakeConstant(Expression::Apply(opCode, constants[0]));
+		case 2:
+			return MakeConstant(Expression::Apply(opCode, constants[0], constants[1]));
+		case 3:
+			return MakeConstant(Expression::Apply(opCode, constants[0], constants[1], constants[2]));
+		default:
+			return Node{ opCode, 0.0, 0, operands };
+		}
+	}
+
+	// code for the evaluation of single entries with short-circuiting
+	static void EmitScalar(Node const& node, std::vector<Instruction> & instructions, size_t & stackSize, size_t & maxStackSize)
+	{
+		switch (node.opCode)
+		{
+		case OpCode::Constant:
+		case OpCode::Variable:
+			instructions.push_back(Instruction{ node.opCode, node.variableIndex, node.constant });
+			maxStackSize = std::max(maxStackSize, ++stackSize);
+			break;
+		case OpCode::And:
+		case OpCode::Or:
+		{
+			EmitScalar(node.operands[0], instructions, stackSize, maxStackSize);
+			size_t jump = instructions.size();
+			instructions.push_back(Instruction{ ((node.opCode == OpCode::And) ? OpCode::AndJump : OpCode::OrJump), 0, 0.0 });
+			--stackSize;
+			EmitScalar(node.operands[1], instructions, stackSize, maxStackSize);
+			instructions.push_back(Instruction{ OpCode::ToBool, 0, 0.0 });
+			instructions[jump].argument = instructions.size();
+			break;
+		}
+		case OpCode::Select:
+		{
+			EmitScalar(node.operands[0], instructions, stackSize, maxStackSize);
+			size_t jumpToSecond = instructions.size();
+			instructions.push_back(Instruction{ OpCode::JumpIfFalse, 0, 0.0 });
+			--stackSize;
+			EmitScalar(node.operands[1], instructions, stackSize, maxStackSize);
+			size_t jumpToEnd = instructions.size();
+			instructions.push_back(Instruction{ OpCode::Jump, 0, 0.0 });
+			--stackSize;
+			instructions[jumpToSecond].argument = instructions.size();
+			EmitScalar(node.operands[2], instructions, stackSize, maxStackSize);
+			instructions[jumpToEnd].argument = instructions.size();
+			break;
+		}
+		case OpCode::Negate:
+		case OpCode::Not:
+		case OpCode::ToBool:
+		case OpCode::Abs:
+		case OpCode::Sqrt:
+		case OpCode::Log:
+		case OpCode::Log10:
+		case OpCode::Exp:
+		case OpCode::Add:
+		case OpCode::Subtract:
+		case OpCode::Multiply:
+		case OpCode::Divide:
+		case OpCode::Less:
+		case OpCode::LessEqual:
+		case OpCode::Greater:
+		case OpCode::GreaterEqual:
+		case OpCode::Equal:
+		case OpCode::NotEqual:
+		case OpCode::Min:
+		case OpCode::Max:
+		case OpCode::Pow:
+			for (std::vector<Node>::const_iterator operand = node.operands.begin(); operand != node.operands.end(); ++operand)
+			{
+				EmitScalar(*operand, instructions, stackSize, maxStackSize);
+			}
+			instructions.push_back(Instruction{ node.opCode, 0, 0.0 });
+			stackSize -= (node.operands.size() - 1);
+			break;
+		case OpCode::AndJump:
+		case OpCode::OrJump:
+		case OpCode::JumpIfFalse:
+		case OpCode::Jump:
+		default:
+			LOG(FATAL) << "Operation " << static_cast<int>(node.opCode) << " cannot be part of an expression tree!";
+			break;
+		}
+	}
+
+	// code for the evaluation of blocks of entries without any jumps
+	static void EmitBatch(Node const& node, std::vector<Instruction> & instructions, size_t & stackSize, size_t & maxStackSize)
+	{
+		if ((node.opCode == OpCode::Constant) || (node.opCode == OpCode::Variable))
+		{
+			instructions.push_back(Instruction{ node.opCode, node.variableIndex, node.constant });
+			maxStackSize = std::max(maxStackSize, ++stackSize);
+		}
+		else
+		{
+			for (std::vector<Node>::const_iterator operand = node.operands.begin(); operand != node.operands.end(); ++operand)
+			{
+				EmitBatch(*operand, instructions, stackSize, maxStackSize);
+			}
+			instructions.push_back(Instruction{ node.opCode, 0, 0.0 });
+			stackSize -= (node.operands.size() - 1);
+		}
+	}
+
+	ExpressionToken const& Peek() const
+	{
+		return m_tokens[m_position];
+	}
+
+	bool Accept(std::string const& op)
+	{
+		if ((Peek().type == ExpressionToken::Type::Operator) && (Peek().text == op))
+		{
+			++m_position;
+			return true;
+		}
+		return false;
+	}
+
+	void Expect(std::string const& op)
+	{
+		if (! Accept(op))
+		{
+			FailExpression(m_text, Peek().position, "expected \"" + op + "\"");
+		}
+	}
+
+	Node ParseConditional()
+	{
+		Node condition = ParseOr();
+		if (Accept("?"))
+		{
+			Node first = ParseConditional();
+			Expect(":");
+			Node second = ParseConditional();
+			return MakeOperation(OpCode::Select, { condition, first, second });
+		}
+		return condition;
+	}
+
+	Node ParseOr()
+	{
+		Node node = ParseAnd();
+		while (Accept("||"))
+		{
+			node = MakeOperation(OpCode::Or, { node, ParseAnd() });
+		}
+		return node;
+	}
+
+	Node ParseAnd()
+	{
+		Node node = ParseNot();
+		while (Accept("&&"))
+		{
+			node = MakeOperation(OpCode::And, { node, ParseNot() });
+		}
+		return node;
+	}
+
+	Node ParseNot()
+	{
+		if (Accept("!"))
+		{
+			return MakeOperation(OpCode::Not, { ParseNot() });
+		}
+		return ParseComparison();
+	}
+
+	Node ParseComparison()
+	{
+		Node node = ParseSum();
+		static const std::vector<std::pair<std::string, OpCode> > comparisons = {
+			{ "<", OpCode::Less }, { "<=", OpCode::LessEqual }, { ">", OpCode::Greater },
+			{ ">=", OpCode::GreaterEqual }, { "==", OpCode::Equal }, { "!=", OpCode::NotEqual }
+		};
+		for (std::vector<std::pair<std::string, OpCode> >::const_iterator comparison = comparisons.begin();
+		     comparison != comparisons.end(); ++comparison)
+		{
+			if (Accept(comparison->first))
+			{
+				return MakeOperation(comparison->second, { node, ParseSum() });
+			}
+		}
+		return node;
+	}
+
+	Node ParseSum()
+	{
+		Node node = ParseProduct();
+		while (true)
+		{
+			if (Accept("+"))
+			{
+				node = MakeOperation(OpCode::Add, { node, ParseProduct() });
+			}
+			else if (Accept("-"))
+			{
+				node = MakeOperation(OpCode::Subtract, { node, ParseProduct() });
+			}
+			else
+			{
+				return node;
+			}
+		}
+	}
+
+	Node ParseProduct()
+	{
+		Node node = ParseUnary();
+		while (true)
+		{
+			if (Accept("*"))
+			{
+				node = MakeOperation(OpCode::Multiply, { node, ParseUnary() });
+			}
+			else if (Accept("/"))
+			{
+				node = MakeOperation(OpCode::Divide, { node, ParseUnary() });
+			}
+			else
+			{
+				return node;
+			}
+		}
+	}
+
+	Node ParseUnary()
+	{
+		if (Accept("-"))
+		{
+			return MakeOperation(OpCode::Negate, { ParseUnary() });
+		}
+		return ParsePrimary();
+	}
+
+	Node ParsePrimary()
+	{
+		ExpressionToken const token = Peek();
+		if (token.type == ExpressionToken::Type::Number)
+		{
+			++m_position;
+			return MakeConstant(token.value);
+		}
+		else if (token.type == ExpressionToken::Type::Identifier)
+		{
+			++m_position;
+			if (Accept("("))
+			{
+				return ParseFunction(token);
+			}
+			return Node{ OpCode::Variable, 0.0, GetVariableIndex(token.text), std::vector<Node>() };
+		}
+		else if (Accept("("))
+		{
+			Node node = ParseConditional();
+			Expect(")");
+			return node;
+		}
+
+		FailExpression(m_text, token.position,
+		               (token.type == ExpressionToken::Type::End) ? "unexpected end" : "unexpected \"" + token.text + "\"");
+		return MakeConstant(0.0);
+	}
+
+	Node ParseFunction(ExpressionToken const& name)
+	{
+		std::vector<Node> arguments;
+		do
+		{
+			arguments.push_back(ParseConditional());
+		}
+		while (Accept(","));
+		Expect(")");
+
+		if ((name.text == "abs") && (arguments.size() == 1))
+		{
+			return MakeOperation(OpCode::Abs, arguments);
+		}
+		else if ((name.text == "sqrt") && (arguments.size() == 1))
+		{
+			return MakeOperation(OpCode::Sqrt, arguments);
+		}
+		else if ((name.text == "log") && (arguments.size() == 1))
+		{
+			return MakeOperation(OpCode::Log, arguments);
+		}
+		else if ((name.text == "log10") && (arguments.size() == 1))
+		{
+			return MakeOperation(OpCode::Log10, arguments);
+		}
+		else if ((name.text == "exp") && (arguments.size() == 1))
+		{
+			return MakeOperation(OpCode::Exp, arguments);
+		}
+		else if ((name.text == "min") && (arguments.size() == 2))
+		{
+			return MakeOperation(OpCode::Min, arguments);
+		}
+		else if ((name.text == "max") && (arguments.size() == 2))
+		{
+			return MakeOperation(OpCode::Max, arguments);
+		}
+		else if ((name.text == "pow") && (arguments.size() == 2))
+		{
+			return MakeOperation(OpCode::Pow, arguments);
+		}
+
+		FailExpression(m_text, name.position, "unknown function " + name.text + " with " + std::to_string(arguments.size()) + " argument(s)");
+		return MakeConstant(0.0);
+	}
+
+	size_t GetVariableIndex(std::string const& name)
+	{
+		for (size_t index = 0; index < m_variableNames.size(); ++index)
+		{
+			if (m_variableNames[index] == name)
+			{
+				return index;
+			}
+		}
+		m_variableNames.push_back(name);
+		return m_variableNames.size() - 1;
+	}
+
+	std::string const& m_text;
+	std::vector<ExpressionToken> m_tokens;
+	size_t m_position = 0;
+
+	std::vector<std::string> & m_variableNames;
+};
+
+
+const size_t Expression::s_maxStackSize;
+const size_t Expression::s_batchBlockSize;
+
+Expression::Expression()
+{
+}
+
+Expression::Expression(std::string const& text, std::vector<std::string> & variableNames) :
+	m_text(text)
+{
+	ExpressionCompiler compiler(m_text, variableNames);
+	compiler.Compile(*this);
+}
+
+double Expression::Evaluate(VariableLoader const& loadVariable) const
+{
+	double stack[s_maxStackSize];
+	size_t stackSize = 0;
+
+	size_t index = 0;
+	while (index < m_instructions.size())
+	{
+		Instruction const& instruction = m_instructions[index];
+		switch (instruction.opCode)
+		{
+		case OpCode::Constant:
+			stack[stackSize++] = instruction.constant;
+			break;
+		case OpCode::Variable:
+			stack[stackSize++] = loadVariable(instruction.argument);
+			break;
+		case OpCode::AndJump:
+			if (stack[stackSize - 1] == 0.0)
+			{
+				index = instruction.argument;
+				continue;
+			}
+			--stackSize;
+			break;
+		case OpCode::OrJump:
+			if (stack[stackSize - 1] != 0.0)
+			{
+				stack[stackSize - 1] = 1.0;
+				index = instruction.argument;
+				continue;
+			}
+			--stackSize;
+			break;
+		case OpCode::JumpIfFalse:
+			if (stack[--stackSize] == 0.0)
+			{
+				index = instruction.argument;
+				continue;
+			}
+			break;
+		case OpCode::Jump:
+			index = instruction.argument;
+			continue;
+		case OpCode::Negate:
+		case OpCode::Not:
+		case OpCode::ToBool:
+		case OpCode::Abs:
+		case OpCode::Sqrt:
+		case OpCode::Log:
+		case OpCode::Log10:
+		case OpCode::Exp:
+			stack[stackSize - 1] = Apply(instruction.opCode, stack[stackSize - 1]);
+			break;
+		case OpCode::Add:
+		case OpCode::Subtract:
+		case OpCode::Multiply:
+		case OpCode::Divide:
+		case OpCode::Less:
+		case OpCode::LessEqual:
+		case OpCode::Greater:
+		case OpCode::GreaterEqual:
+		case OpCode::Equal:
+		case OpCode::NotEqual:
+		case OpCode::Min:
+		case OpCode::Max:
+		case OpCode::Pow:
+		case OpCode::And:
+		case OpCode::Or:
+			--stackSize;
+			stack[stackSize - 1] = Apply(instruction.opCode, stack[stackSize - 1], stack[stackSize]);
+			break;
+		case OpCode::Select:
+		default:
+			// conditionals are compiled to jumps for the evaluation of single entries
+			LOG(FATAL) << "Operation " << static_cast<int>(instruction.opCode) << " cannot be evaluated for single entries!";
+			break;
+		}
+		++index;
+	}
+
+	return ((stackSize > 0) ? stack[stackSize - 1] : 0.0);
+}
+
+void Expression::EvaluateBatch(std::vector<double const*> const& variableValues, size_t nEntries, double* results) const
+{
+	// column stack: entry i of stack slot s is stored at columns[s * s_batchBlockSize + i]
+	std::vector<double> columns(std::max(m_batchStackSize, size_t(1)) * s_batchBlockSize, 0.0);
+
+	for (size_t blockBegin = 0; blockBegin < nEntries; blockBegin += s_batchBlockSize)
+	{
+		size_t const blockSize = std::min(s_batchBlockSize, nEntries - blockBegin);
+		size_t stackSize = 0;
+
+		for (std::vector<Instruction>::const_iterator instruction = m_batchInstructions.begin();
+		     instruction != m_batchInstructions.end(); ++instruction)
+		{
+			double* top = columns.data() + (stackSize * s_batchBlockSize);
+			switch (instruction->opCode)
+			{
+			case OpCode::Constant:
+				std::fill(top, top + blockSize, instruction->constant);
+				++stackSize;
+				break;
+			case OpCode::Variable:
+				std::copy(variableValues[instruction->argument] + blockBegin,
+				          variableValues[instruction->argument] + blockBegin + blockSize, top);
+				++stackSize;
+				break;
+			case OpCode::Negate:
+			case OpCode::Not:
+			case OpCode::ToBool:
+			case OpCode::Abs:
+			case OpCode::Sqrt:
+			case OpCode::Log:
+			case OpCode::Log10:
+			case OpCode::Exp:
+			{
+				double* operand = top - s_batchBlockSize;
+				for (size_t entry = 0; entry < blockSize; ++entry)
+				{
+					operand[entry] = Apply(instruction->opCode, operand[entry]);
+				}
+				break;
+			}
+			case OpCode::Select:
+			{
+				double* condition = top - (3 * s_batchBlockSize);
+				double const* first = top - (2 * s_batchBlockSize);
+				double const* second = top - s_batchBlockSize;
+				for (size_t entry = 0; entry < blockSize; ++entry)
+				{
+					condition[entry] = ((condition[entry] != 0.0) ? first[entry] : second[entry]);
+				}
+				stackSize -= 2;
+				break;
+			}
+			case OpCode::Add:
+			case OpCode::Subtract:
+			case OpCode::Multiply:
+			case OpCode::Divide:
+			case OpCode::Less:
+			case OpCode::LessEqual:
+			case OpCode::Greater:
+			case OpCode::GreaterEqual:
+			case OpCode::Equal:
+			case OpCode::NotEqual:
+			case OpCode::Min:
+			case OpCode::Max:
+			case OpCode::Pow:
+			case OpCode::And:
+			case OpCode::Or:
+			{
+				double* left = top - (2 * s_batchBlockSize);
+				double const* right = top - s_batchBlockSize;
+				for (size_t entry = 0; entry < blockSize; ++entry)
+				{
+					left[entry] = Apply(instruction->opCode, left[entry], right[entry]);
+				}
+				--stackSize;
+				break;
+			}
+			case OpCode::AndJump:
+			case OpCode::OrJump:
+			case OpCode::JumpIfFalse:
+			case OpCode::Jump:
+			default:
+				// blocks of entries are evaluated without any jumps
+				LOG(FATAL) << "Operation " << static_cast<int>(instruction->opCode) << " cannot be evaluated for blocks of entries!";
+				break;
+			}
+		}
+
+		if (stackSize > 0)
+		{
+			std::copy(columns.begin(), columns.begin() + blockSize, results + blockBegin);
+		}
+		else
+		{
+			std::fill(results + blockBegin, results + blockBegin + blockSize, 0.0);
+		}
+	}
+}
+
+std::vector<std::string> Expression::SplitConjunction(std::string const& text)
+{
+	std::vector<ExpressionToken> tokens = TokenizeExpression(text);
+
+	std::vector<size_t> separators;
+	int depth = 0;
+	for (std::vector<ExpressionToken>::const_iterator token = tokens.begin(); token != tokens.end(); ++token)
+	{
+		if (token->type != ExpressionToken::Type::Operator)
+		{
+			continue;
+		}
+		if (token->text == "(")
+		{
+			++depth;
+		}
+		else if (token->text == ")")
+		{
+			--depth;
+		}
+		else if ((depth == 0) && (token->text == "&&"))
+		{
+			separators.push_back(token->position);
+		}
+		else if ((depth == 0) && ((token->text == "||") || (token->text == "?")))
+		{
+			return std::vector<std::string>(1, boost::algorithm::trim_copy(text));
+		}
+	}
+
+	std::vector<std::string> clauses;
+	size_t begin = 0;
+	for (std::vector<size_t>::const_iterator separator = separators.begin(); separator != separators.end(); ++separator)
+	{
+		clauses.push_back(boost::algorithm::trim_copy(text.substr(begin, *separator - begin)));
+		begin = *separator + 2;
+	}
+	clauses.push_back(boost::algorithm::trim_copy(text.substr(begin)));
+	return clauses;
+}
+
+double Expression::Apply(OpCode opCode, double value)
+{
+	switch (opCode)
+	{
+	case OpCode::Negate:
+		return -value;
+	case OpCode::Not:
+		return ((value == 0.0) ? 1.0 : 0.0);
+	case OpCode::ToBool:
+		return ((value != 0.0) ? 1.0 : 0.0);
+	case OpCode::Abs:
+		return std::abs(value);
+	case OpCode::Sqrt:
+		return std::sqrt(value);
+	case OpCode::Log:
+		return std::log(value);
+	case OpCode::Log10:
+		return std::log10(value);
+	case OpCode::Exp:
+		return std::exp(value);
+	case OpCode::Constant:
+	case OpCode::Variable:
+	case OpCode::Add:
+	case OpCode::Subtract:
+	case OpCode::Multiply:
+	case OpCode::Divide:
+	case OpCode::Less:
+	case OpCode::LessEqual:
+	case OpCode::Greater:
+	case OpCode::GreaterEqual:
+	case OpCode::Equal:
+	case OpCode::NotEqual:
+	case OpCode::Min:
+	case OpCode::Max:
+	case OpCode::Pow:
+	case OpCode::And:
+	case OpCode::Or:
+	case OpCode::Select:
+	case OpCode::AndJump:
+	case OpCode::OrJump:
+	case OpCode::JumpIfFalse:
+	case OpCode::Jump:
+	default:
+		LOG(FATAL) << "Operation " << static_cast<int>(opCode) << " is not unary!";
+		return 0.0;
+	}
+}
+
+double Expression::Apply(OpCode opCode, double left, double right)
+{
+	switch (opCode)
+	{
+	case OpCode::Add:
+		return left + right;
+	case OpCode::Subtract:
+		return left - right;
+	case OpCode::Multiply:
+		return left * right;
+	case OpCode::Divide:
+		return left / right;
+	case OpCode::Less:
+		return ((left < right) ? 1.0 : 0.0);
+	case OpCode::LessEqual:
+		return ((left <= right) ? 1.0 : 0.0);
+	case OpCode::Greater:
+		return ((left > right) ? 1.0 : 0.0);
+	case OpCode::GreaterEqual:
+		return ((left >= right) ? 1.0 : 0.0);
+	case OpCode::Equal:
+		return ((left == right) ? 1.0 : 0.0);
+	case OpCode::NotEqual:
+		return ((left != right) ? 1.0 : 0.0);
+	case OpCode::Min:
+		return std::min(left, right);
+	case OpCode::Max:
+		return std::max(left, right);
+	case OpCode::Pow:
+		return std::pow(left, right);
+	case OpCode::And:
+		return (((left != 0.0) && (right != 0.0)) ? 1.0 : 0.0);
+	case OpCode::Or:
+		return (((left != 0.0) || (right != 0.0)) ? 1.0 : 0.0);
+	case OpCode::Constant:
+	case OpCode::Variable:
+	case OpCode::Negate:
+	case OpCode::Not:
+	case OpCode::ToBool:
+	case OpCode::Abs:
+	case OpCode::Sqrt:
+	case OpCode::Log:
+	case OpCode::Log10:
+	case OpCode::Exp:
+	case OpCode::Select:
+	case OpCode::AndJump:
+	case OpCode::OrJump:
+	case OpCode::JumpIfFalse:
+	case OpCode::Jump:
+	default:
+		LOG(FATAL) << "Operation " << static_cast<int>(opCode) << " is not binary!";
+		return 0.0;
+	}
+}
+
+double Expression::Apply(OpCode opCode, double condition, double first, double second)
+{
+	if (opCode != OpCode::Select)
+	{
+		LOG(FATAL) << "Operation " << static_cast<int>(opCode) << " is not ternary!";
+	}
+	return ((condition != 0.0) ? first : second);
+}
+
@@ -0,0 +1,295 @@
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+#include "Artus/Utility/interface/Kinematics.h"
+
+// the kernels are compiled for several instruction sets with the target attributes of gcc and clang
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define ARTUS_KINEMATICS_DISPATCH 1
+#define ARTUS_KINEMATICS_INLINE inline __attribute__((always_inline))
+#else
+#define ARTUS_KINEMATICS_DISPATCH 0
+#define ARTUS_KINEMATICS_INLINE inline
+#endif
+
+
+namespace
+{
+	// the vectorised loops run over a multiple of this number of elements (one AVX-512 register of floats),
+	// which allows the compiler to vectorise them without remainder loops already at -O2
+	const size_t BlockSize = 16;
+
+	size_t GetNPaddedBlocks(size_t size)
+	{
+		return ((size + BlockSize - 1) / BlockSize);
+	}
+
+	ARTUS_KINEMATICS_INLINE float WrapDeltaPhi(float deltaPhi)
+	{
+		return (deltaPhi + ((deltaPhi > float(M_PI)) ? float(-2.0 * M_PI) : ((deltaPhi <= float(-M_PI)) ? float(2.0 * M_PI) : 0.0f)));
+	}
+
+	ARTUS_KINEMATICS_INLINE unsigned char IsSelected(float pt, float eta, float ptMin, float absEtaMax)
+	{
+		return static_cast<unsigned char>((pt > ptMin) & (std::fabs(eta) < absEtaMax));
+	}
+
+	ARTUS_KINEMATICS_INLINE float GetMass(double e, double px, double py, double pz)
+	{
+		double mass2 = (e * e) - (px * px) - (py * py) - (pz * pz);
+		double mass = std::sqrt(std::fabs(mass2));
+		return static_cast<float>((mass2 >= 0.0) ? mass : -mass);
+	}
+
+	// kernels over nBlocks * BlockSize elements
+
+	ARTUS_KINEMATICS_INLINE void DeltaPhiKernel(float const* phi1, float const* phi2, size_t nBlocks, float* deltaPhi)
+	{
+#pragma GCC ivdep
+		for (size_t index = 0; index < (nBlocks * BlockSize); ++index)
+		{
+			deltaPhi[index] = WrapDeltaPhi(phi1[index] - phi2[index]);
+		}
+	}
+
+	ARTUS_KINEMATICS_INLINE void DeltaR2Kernel(float eta, float phi, float const* eta2, float const* phi2, size_t nBlocks, float* deltaR2)
+	{
+#pragma GCC ivdep
+		for (size_t index = 0; index < (nBlocks * BlockSize); ++index)
+		{
+			float deltaEta = eta - eta2[index];
+			float deltaPhi = WrapDeltaPhi(phi - phi2[index]);
+			deltaR2[index] = (deltaEta * deltaEta) + (deltaPhi * deltaPhi);
+		}
+	}
+
+	ARTUS_KINEMATICS_INLINE void SelectKernel(float const* pt, float const* eta, size_t nBlocks, float ptMin, float absEtaMax,
+	                                          unsigned char* selected)
+	{
+#pragma GCC ivdep
+		for (size_t index = 0; index < (nBlocks * BlockSize); ++index)
+		{
+			selected[index] = IsSelected(pt[index], eta[index], ptMin, absEtaMax);
+		}
+	}
+
+	ARTUS_KINEMATICS_INLINE void PairMassKernel(double e, double px, double py, double pz,
+	                                            double const* e2, double const* px2, double const* py2, double const* pz2,
+	                                            size_t nBlocks, float* mass)
+	{
+#pragma GCC ivdep
+		for (size_t index = 0; index < (nBlocks * BlockSize); ++index)
+		{
+			mass[index] = GetMass(e + e2[index], px + px2[index], py + py2[index], pz + pz2[index]);
+		}
+	}
+
+	struct KernelTable
+	{
+		void (*deltaPhi)(float const*, float const*, size_t, float*);
+		void (*deltaR2)(float, float, float const*, float const*, size_t, float*);
+		void (*select)(float const*, float const*, size_t, float, float, unsigned char*);
+		void (*pairMass)(double, double, double, double, double const*, double const*, double const*, double const*, size_t, float*);
+	};
+
+#define ARTUS_KINEMATICS_KERNEL_TABLE(NAME, ATTRIBUTES) \
+	ATTRIBUTES void DeltaPhi##NAME(float const* phi1, float const* phi2, size_t nBlocks, float* deltaPhi) \
+	{ DeltaPhiKernel(phi1, phi2, nBlocks, deltaPhi); } \
+	ATTRIBUTES void DeltaR2##NAME(float eta, float phi, float const* eta2, float const* phi2, size_t nBlocks, float* deltaR2) \
+	{ DeltaR2Kernel(eta, phi, eta2, phi2, nBlocks, deltaR2); } \
+	ATTRIBUTES void Select##NAME(float const* pt, float const* eta, size_t nBlocks, float ptMin, float absEtaMax, unsigned char* selected) \
+	{ SelectKernel(pt, eta, nBlocks, ptMin, absEtaMax, selected); } \
+	ATTRIBUTES void PairMass##NAME(double e, double px, double py, double pz, double const* e2, double const* px2, \
+	                               double const* py2, double const* pz2, size_t nBlocks, float* mass) \
+	{ PairMassKernel(e, px, py, pz, e2, px2, py2, pz2, nBlocks, mass); } \
+	const KernelTable NAME##Kernels = { &DeltaPhi##NAME, &DeltaR2##NAME, &Select##NAME, &PairMass##NAME };
+
+	ARTUS_KINEMATICS_KERNEL_TABLE(Baseline, )
+#if ARTUS_KINEMATICS_DISPATCH
+	ARTUS_KINEMATICS_KERNEL_TABLE(Avx2, __attribute__((target("avx2,fma"))))
+	ARTUS_KINEMATICS_KERNEL_TABLE(Avx512, __attribute__((target("avx512f,avx512bw,avx512vl"))))
+#endif
+
+#undef ARTUS_KINEMATICS_KERNEL_TABLE
+
+	std::atomic<int>& GetSelectedInstructionSet()
+	{
+		static std::atomic<int> instructionSet(static_cast<int>(Kinematics::GetBestSupportedInstructionSet()));
+		return instructionSet;
+	}
+
+	KernelTable const& GetKernels()
+	{
+		switch (static_cast<Kinematics::InstructionSet>(GetSelectedInstructionSet().load(std::memory_order_relaxed)))
+		{
+#if ARTUS_KINEMATICS_DISPATCH
+			case Kinematics::InstructionSet::AVX512:
+				return Avx512Kernels;
+			case Kinematics::InstructionSet::AVX2:
+				return Avx2Kernels;
+#else
+			case Kinematics::InstructionSet::AVX512:
+			case Kinematics::InstructionSet::AVX2:
+#endif
+			case Kinematics::InstructionSet::BASELINE:
+			default:
+				return BaselineKernels;
+		}
+	}
+
+	// copies the objects into arrays with a multiple of BlockSize elements, the padded objects are far away from all others
+	void PadDirections(Kinematics::Objects const& objects, std::vector<float>& eta, std::vector<float>& phi)
+	{
+		eta.assign(objects.eta, objects.eta + objects.size);
+		phi.assign(objects.phi, objects.phi + objects.size);
+		eta.resize((GetNPaddedBlocks(objects.size) * BlockSize), 1.0e10f);
+		phi.resize((GetNPaddedBlocks(objects.size) * BlockSize), 0.0f);
+	}
+
+	// same conventions as ROOT::Math::PtEtaPhiM4D, the padded objects have zero momenta
+	void ToCartesian(Kinematics::Objects const& objects, size_t paddedSize,
+	                 std::vector<double>& e, std::vector<double>& px, std::vector<double>& py, std::vector<double>& pz)
+	{
+		e.assign(paddedSize, 0.0);
+		px.assign(paddedSize, 0.0);
+		py.assign(paddedSize, 0.0);
+		pz.assign(paddedSize, 0.0);
+		for (size_t index = 0; index < objects.size; ++index)
+		{
+			double pt = objects.pt[index];
+			double mass = objects.mass[index];
+			px[index] = pt * std::cos(objects.phi[index]);
+			py[index] = pt * std::sin(objects.phi[index]);
+			pz[index] = pt * std::sinh(objects.eta[index]);
+			double p2 = (px[index] * px[index]) + (py[index] * py[index]) + (pz[index] * pz[index]);
+			e[index] = ((mass >= 0.0) ? std::sqrt(p2 + (mass * mass)) : std::sqrt(std::max(p2 - (mass * mass), 0.0)));
+		}
+	}
+}
+
+Kinematics::InstructionSet Kinematics::GetInstructionSet()
+{
+	return static_cast<InstructionSet>(GetSelectedInstructionSet().load());
+}
+
+Kinematics::InstructionSet Kinematics::GetBestSupportedInstructionSet()
+{
+#if ARTUS_KINEMATICS_DISPATCH
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512vl"))
+	{
+		return InstructionSet::AVX512;
+	}
+	else if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+	{
+		return InstructionSet::AVX2;
+	}
+#endif
+	return InstructionSet::BASELINE;
+}
+
+void Kinematics::SetInstructionSet(InstructionSet instructionSet)
+{
+	int bestSupportedInstructionSet = static_cast<int>(GetBestSupportedInstructionSet());
+	GetSelectedInstructionSet().store(std::min(static_cast<int>(instructionSet), bestSupportedInstructionSet));
+}
+
+std::string Kinematics::ToString(InstructionSet instructionSet)
+{
+	switch (instructionSet)
+	{
+		case InstructionSet::AVX512:
+			return "AVX-512";
+		case InstructionSet::AVX2:
+			return "AVX2";
+		case InstructionSet::BASELINE:
+		default:
+			return "baseline";
+	}
+}
+
+void Kinematics::DeltaPhi(float const* phi1, float const* phi2, size_t size, float* deltaPhi)
+{
+	size_t nFullBlocks = size / BlockSize;
+	GetKernels().deltaPhi(phi1, phi2, nFullBlocks, deltaPhi);
+	for (size_t index = (nFullBlocks * BlockSize); index < size; ++index)
+	{
+		deltaPhi[index] = WrapDeltaPhi(phi1[index] - phi2[index]);
+	}
+}
+
+void Kinematics::DeltaR2Matrix(Objects const& objects1, Objects const& objects2, float* deltaR2)
+{
+	std::vector<float> eta2, phi2;
+	PadDirections(objects2, eta2, phi2);
+	std::vector<float> row(eta2.size());
+
+	KernelTable const& kernels = GetKernels();
+	for (size_t index1 = 0; index1 < objects1.size; ++index1)
+	{
+		kernels.deltaR2(objects1.eta[index1], objects1.phi[index1], eta2.data(), phi2.data(), (row.size() / BlockSize), row.data());
+		std::copy(row.begin(), row.begin() + objects2.size, deltaR2 + (index1 * objects2.size));
+	}
+}
+
+size_t Kinematics::SelectPtAbsEta(Objects const& objects, float ptMin, float absEtaMax, unsigned char* selected)
+{
+	size_t nFullBlocks = objects.size / BlockSize;
+	GetKernels().select(objects.pt, objects.eta, nFullBlocks, ptMin, absEtaMax, selected);
+	for (size_t index = (nFullBlocks * BlockSize); index < objects.size; ++index)
+	{
+		selected[index] = IsSelected(objects.pt[index], objects.eta[index], ptMin, absEtaMax);
+	}
+
+	size_t nSelected = 0;
+	for (size_t index = 0; index < objects.size; ++index)
+	{
+		nSelected += selected[index];
+	}
+	return nSelected;
+}
+
+void Kinematics::PairMassMatrix(Objects const& objects1, Objects const& objects2, float* mass)
+{
+	std::vector<double> e1, px1, py1, pz1;
+	ToCartesian(objects1, objects1.size, e1, px1, py1, pz1);
+	std::vector<double> e2, px2, py2, pz2;
+	ToCartesian(objects2, (GetNPaddedBlocks(objects2.size) * BlockSize), e2, px2, py2, pz2);
+	std::vector<float> row(e2.size());
+
+	KernelTable const& kernels = GetKernels();
+	for (size_t index1 = 0; index1 < objects1.size; ++index1)
+	{
+		kernels.pairMass(e1[index1], px1[index1], py1[index1], pz1[index1], e2.data(), px2.data(), py2.data(), pz2.data(),
+		                 (row.size() / BlockSize), row.data());
+		std::copy(row.begin(), row.begin() + objects2.size, mass + (index1 * objects2.size));
+	}
+}
+
+void Kinematics::MatchDeltaR(Objects const& objects1, Objects const& objects2, float deltaRMax, int* matchedIndices)
+{
+	std::vector<float> eta2, phi2;
+	PadDirections(objects2, eta2, phi2);
+	std::vector<float> row(eta2.size());
+	float deltaR2Max = deltaRMax * deltaRMax;
+
+	KernelTable const& kernels = GetKernels();
+	for (size_t index1 = 0; index1 < objects1.size; ++index1)
+	{
+		kernels.deltaR2(objects1.eta[index1], objects1.phi[index1], eta2.data(), phi2.data(), (row.size() / BlockSize), row.data());
+
+		matchedIndices[index1] = -1;
+		float deltaR2Min = deltaR2Max;
+		for (size_t index2 = 0; index2 < objects2.size; ++index2)
+		{
+			if (row[index2] < deltaR2Min)
+			{
+				deltaR2Min = row[index2];
+				matchedIndices[index1] = static_cast<int>(index2);
+			}
+		}
+	}
+}
+
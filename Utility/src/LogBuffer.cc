@@ -0,0 +1,80 @@
+
+#include "Artus/Utility/interface/LogBuffer.h"
+
+#include <cassert>
+
+
+class LogBuffer::DispatchCallback: public el::base::DefaultLogDispatchCallback {
+protected:
+	void handle(el::LogDispatchData const* data) override
+	{
+		el::LogMessage const* message = data->logMessage();
+		LogBuffer* buffer = LogBuffer::GetActiveBuffer();
+		if ((buffer != nullptr) && (message->level() != el::Level::Fatal) &&
+		    (data->dispatchAction() == el::base::DispatchAction::NormalLog))
+		{
+			buffer->m_messages.push_back(Message{message->level(), message->file(), message->line(),
+			                                     message->func(), message->verboseLevel(),
+			                                     message->logger(), message->message()});
+		}
+		else
+		{
+			el::base::DefaultLogDispatchCallback::handle(data);
+		}
+	}
+};
+
+LogBuffer::~LogBuffer()
+{
+	Deactivate();
+}
+
+void LogBuffer::Activate()
+{
+	assert((GetActiveBuffer() == nullptr) || (GetActiveBuffer() == this));
+	GetActiveBuffer() = this;
+}
+
+void LogBuffer::Deactivate()
+{
+	if (GetActiveBuffer() == this)
+	{
+		GetActiveBuffer() = nullptr;
+	}
+}
+
+void LogBuffer::Flush()
+{
+	std::vector<Message> messages;
+	messages.swap(m_messages);
+
+	// the messages are dispatched again, which stores them in the buffer active in this thread, if any
+	for (std::vector<Message>::const_iterator message = messages.begin(); message != messages.end(); ++message)
+	{
+		el::base::Writer(message->level, message->file.c_str(), message->line, message->function.c_str(),
+		                 el::base::DispatchAction::NormalLog, message->verboseLevel).construct(message->logger) << message->text;
+	}
+}
+
+size_t LogBuffer::GetNumberOfMessages() const
+{
+	return m_messages.size();
+}
+
+void LogBuffer::Install()
+{
+	el::Helpers::uninstallLogDispatchCallback<el::base::DefaultLogDispatchCallback>("DefaultLogDispatchCallback");
+	el::Helpers::installLogDispatchCallback<DispatchCallback>("LogBuffer");
+}
+
+void LogBuffer::Uninstall()
+{
+	el::Helpers::uninstallLogDispatchCallback<DispatchCallback>("LogBuffer");
+	el::Helpers::installLogDispatchCallback<el::base::DefaultLogDispatchCallback>("DefaultLogDispatchCallback");
+}
+
+LogBuffer* & LogBuffer::GetActiveBuffer()
+{
+	static thread_local LogBuffer* activeBuffer = nullptr;
+	return activeBuffer;
+}
@@ -2,16 +2,137 @@
 #include "Artus/Utility/interface/RootFileHelper.h"
 
 #include <cassert>
+#include <set>
+
+#include <TChain.h>
+#include <TH1.h>
+#include <TKey.h>
+#include <TList.h>
+#include <TTree.h>
 
 
 void RootFileHelper::SafeCd(TDirectory * pDir, std::string const& dirName) {
 	assert(pDir);
+	std::lock_guard<std::recursive_mutex> lock(GetRootMutex());
 
 	if (pDir->GetDirectory(dirName.c_str()) == nullptr) {
 		pDir->mkdir(dirName.c_str());
 	}
 	pDir->cd(dirName.c_str());
 }
+
+std::recursive_mutex & RootFileHelper::GetRootMutex() {
+	static std::recursive_mutex mutex;
+	return mutex;
+}
+
+void RootFileHelper::MoveObjects(TDirectory* source, TDirectory* target) {
+	assert(source);
+	assert(target);
+
+	// the list is modified while moving the objects
+	std::vector<TObject*> objects;
+	TIter nextObject(source->GetList());
+	while (TObject* object = nextObject()) {
+		objects.push_back(object);
+	}
+
+	for (std::vector<TObject*>::iterator object = objects.begin(); object != objects.end(); ++object) {
+		if (TDirectory* directory = dynamic_cast<TDirectory*>(*object)) {
+			TDirectory* targetDirectory = target->GetDirectory(directory->GetName());
+			if (targetDirectory == nullptr) {
+				targetDirectory = target->mkdir(directory->GetName());
+			}
+			MoveObjects(directory, targetDirectory);
+		}
+		else if (TTree* tree = dynamic_cast<TTree*>(*object)) {
+			tree->SetDirectory(target);
+		}
+		else if (TH1* histogram = dynamic_cast<TH1*>(*object)) {
+			histogram->SetDirectory(target);
+		}
+	}
+}
+
+void RootFileHelper::CloseCurrentFile(TChain & chain) {
+	// TChain::GetFile would open the first file if none is open
+	TFile* file = chain.GetCurrentFile();
+	if (file != nullptr) {
+		// the chain is notified about the deletion and forgets the tree of this file
+		delete file;
+	}
+}
+
+void RootFileHelper::MergeObjects(TDirectory* source, TDirectory* target, AdoptedObjects & adoptedObjects) {
+	assert(source);
+	assert(target);
+
+	// keys of older cycles are skipped
+	std::set<std::string> mergedNames;
+
+	TIter nextKey(source->GetListOfKeys());
+	while (TKey* key = static_cast<TKey*>(nextKey())) {
+		std::string name = key->GetName();
+		if (! mergedNames.insert(name).second) {
+			continue;
+		}
+
+		TObject* object = key->ReadObj();
+		if (TDirectory* directory = dynamic_cast<TDirectory*>(object)) {
+			TDirectory* targetDirectory = target->GetDirectory(name.c_str());
+			if (targetDirectory == nullptr) {
+				targetDirectory = target->mkdir(name.c_str());
+			}
+			MergeObjects(directory, targetDirectory, adoptedObjects);
+			continue;
+		}
+
+		std::pair<TDirectory*, std::string> adoptedKey(target, name);
+		TObject* existing = nullptr;
+		if (adoptedObjects.count(adoptedKey) > 0) {
+			existing = adoptedObjects[adoptedKey];
+		}
+		else {
+			existing = target->GetList()->FindObject(name.c_str());
+		}
+
+		if (TH1* histogram = dynamic_cast<TH1*>(object)) {
+			if (TH1* existingHistogram = dynamic_cast<TH1*>(existing)) {
+				existingHistogram->Add(histogram);
+				delete histogram;
+			}
+			else {
+				histogram->SetDirectory(target);
+				adoptedObjects[adoptedKey] = histogram;
+			}
+		}
+		else if (TTree* tree = dynamic_cast<TTree*>(object)) {
+			if (TTree* existingTree = dynamic_cast<TTree*>(existing)) {
+				existingTree->CopyEntries(tree);
+			}
+			else {
+				target->cd();
+				adoptedObjects[adoptedKey] = tree->CloneTree(-1, "fast");
+			}
+			delete tree;
+		}
+		else if (existing == nullptr) {
+			// other objects cannot be merged, the first one is kept
+			target->Append(object);
+			adoptedObjects[adoptedKey] = object;
+		}
+		else {
+			delete object;
+		}
+	}
+}
+
+void RootFileHelper::WriteAdoptedObjects(AdoptedObjects const& adoptedObjects) {
+	for (AdoptedObjects::const_iterator object = adoptedObjects.begin(); object != adoptedObjects.end(); ++object) {
+		object->first.first->cd();
+		object->second->Write(object->first.second.c_str(), TObject::kOverwrite);
+	}
+}
 TH1D * RootFileHelper::GetStandaloneTH1D_1(std::string sName, std::string sCaption,
 		int binCount, double dCustomBins[255]) {
 	return new TH1D(sName.c_str(), sCaption.c_str(), binCount,
@@ -0,0 +1,44 @@
+
+#include "Artus/Utility/interface/SharedResourceCache.h"
+
+
+size_t SharedResourceCache::GetNumberOfResources()
+{
+	std::lock_guard<std::mutex> lock(GetMutex());
+	size_t nResources = 0;
+	for (std::map<Key, std::shared_ptr<Entry> >::const_iterator entry = GetEntries().begin();
+	     entry != GetEntries().end(); ++entry)
+	{
+		if (! entry->second->resource.expired())
+		{
+			++nResources;
+		}
+	}
+	return nResources;
+}
+
+std::shared_ptr<SharedResourceCache::Entry> SharedResourceCache::GetEntry(std::type_index const& type,
+                                                                          std::string const& path,
+                                                                          std::string const& parameters)
+{
+	std::lock_guard<std::mutex> lock(GetMutex());
+	std::shared_ptr<Entry> & entry = GetEntries()[Key(type, path, parameters)];
+	if (! entry)
+	{
+		entry = std::make_shared<Entry>();
+	}
+	return entry;
+}
+
+std::map<SharedResourceCache::Key, std::shared_ptr<SharedResourceCache::Entry> > & SharedResourceCache::GetEntries()
+{
+	static std::map<Key, std::shared_ptr<Entry> > entries;
+	return entries;
+}
+
+std::mutex & SharedResourceCache::GetMutex()
+{
+	static std::mutex mutex;
+	return mutex;
+}
+